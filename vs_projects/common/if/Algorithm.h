@@ -56,8 +56,10 @@ inline const Type modulo(const Type& a, const Type& b)
 
 
 
+#ifdef _WIN32
 inline DWORD 
 floatToDWORD(Float f)             { return *((DWORD*)&f); }
+#endif
 
 
 Int random(Int max = 100);
@@ -0,0 +1,76 @@
+/**
+* Common library
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __COMMON_ATOMIC_H__
+#define __COMMON_ATOMIC_H__
+
+#include <Common/If/Common.h>
+
+
+// The few atomic operations the lock-free containers need. A load
+// acquires, so nothing after it is read before it; a store releases, so
+// everything written before it is seen by whoever loads what it stored.
+// An exchange does both.
+class Atomic
+{
+public:
+    static Int      load(const volatile Int& source);
+    static void     store(volatile Int& target, Int value);
+    static Int      exchange(volatile Int& target, Int value);
+};
+
+
+#ifdef _WIN32
+
+inline Int
+Atomic::load(const volatile Int& source)
+{
+    Int value = source;
+    MemoryBarrier( );
+    return value;
+}
+
+
+inline void
+Atomic::store(volatile Int& target, Int value)
+{
+    MemoryBarrier( );
+    target = value;
+}
+
+
+inline Int
+Atomic::exchange(volatile Int& target, Int value)
+{
+    return (Int)InterlockedExchange((volatile LONG*)&target, (LONG)value);
+}
+
+#else
+
+inline Int
+Atomic::load(const volatile Int& source)
+{
+    return __atomic_load_n(&source, __ATOMIC_ACQUIRE);
+}
+
+
+inline void
+Atomic::store(volatile Int& target, Int value)
+{
+    __atomic_store_n(&target, value, __ATOMIC_RELEASE);
+}
+
+
+inline Int
+Atomic::exchange(volatile Int& target, Int value)
+{
+    return __atomic_exchange_n(&target, value, __ATOMIC_ACQ_REL);
+}
+
+#endif
+
+
+#endif /* __COMMON_ATOMIC_H__ */
@@ -23,16 +23,20 @@
 #define _common_ __declspec(dllimport)
 #endif
 
-#ifdef COMMON_STATIC
+#if defined(COMMON_STATIC) || !defined(_WIN32)
 #undef _common_
 #define _common_ 
 #endif
 
 #include <Common/If/File.h>
 #include <Common/If/Tracer.h>
+#ifdef _WIN32
 #include <Common/If/Window.h>
+#endif
 #include <Common/If/Mutex.h>
+#ifdef _WIN32
 #include <Common/If/Network.h>
+#endif
 
 
 class Tracer;
@@ -8,6 +8,9 @@
 #define __COMMON_MUTEX_H__
 
 #include <Common/If/Common.h>
+#ifndef _WIN32
+#include <pthread.h>
+#endif
 
 class CMutex;
 class CSingleLock;
@@ -27,7 +30,11 @@ public:
 public:
     class Guard;
 private:
+#ifdef _WIN32
     CRITICAL_SECTION    m_criticalSection;
+#else
+    pthread_mutex_t     m_mutex;            // recursive, like a critical section
+#endif
 };
 
 
@@ -0,0 +1,69 @@
+/**
+* Common library
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __COMMON_SOUNDPACKFORMAT_H__
+#define __COMMON_SOUNDPACKFORMAT_H__
+
+#include <Common/If/Types.h>
+
+#define SOUNDPACKMAGIC      0x4b505354  // "TSPK"
+#define SOUNDPACKVERSION    1
+#define SOUNDPACKALIGNMENT  4096        // every sound starts on a page of its own
+#define SOUNDPACKMAXKEY     260         // MAX_PATH, with the terminating 0
+
+
+// The layout of a sound pack: the header, then nEntries entries sorted by
+// key, then the keys, 0 terminated, and then the PCM data of the sounds,
+// each aligned to SOUNDPACKALIGNMENT so it can be used where it is mapped.
+// All fields are little endian.
+struct SoundPackHeader
+{
+    UInt            magic;
+    UInt            version;
+    UInt            nEntries;
+    UInt            keysSize;       // bytes of the keys after the entries
+};
+
+
+// The format fields are those of the WAVEFORMATEX of the sound.
+struct SoundPackEntry
+{
+    UInt            key;            // offset of the key in the file
+    UInt            data;           // offset of the PCM data in the file
+    UInt            size;           // bytes of PCM data
+    UShort          formatTag;
+    UShort          channels;
+    UInt            samplesPerSec;
+    UInt            avgBytesPerSec;
+    UShort          blockAlign;
+    UShort          bitsPerSample;
+};
+
+
+// The key of a file: its path as the game opens it, in lower case and with
+// backslashes, so "Sounds/en/Race/Go.ogg" and "sounds\en\race\go.ogg" match.
+// Returns false if the path does not fit.
+inline Boolean
+soundPackKey(const Char* path, Char* key)
+{
+    UInt i = 0;
+    for (; path[i] != 0; ++i)
+    {
+        if (i + 1 >= SOUNDPACKMAXKEY)
+            return false;
+        Char c = path[i];
+        if (c == '/')
+            c = '\\';
+        else if ((c >= 'A') && (c <= 'Z'))
+            c = Char(c - 'A' + 'a');
+        key[i] = c;
+    }
+    key[i] = 0;
+    return true;
+}
+
+
+#endif /* __COMMON_SOUNDPACKFORMAT_H__ */
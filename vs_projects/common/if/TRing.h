@@ -0,0 +1,81 @@
+/**
+* Common library
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __COMMON_TRING_H__
+#define __COMMON_TRING_H__
+
+#include <Common/If/Atomic.h>
+
+
+// A queue of at most SIZE - 1 items between one producer thread and one
+// consumer thread that never locks. Only the producer moves the head and
+// only the consumer moves the tail; push( ) fails when the ring is full.
+template <class Type, Int SIZE>
+class TRing
+{
+public:
+    TRing( );
+    virtual ~TRing( );
+
+public:
+    Boolean         push(const Type& item);
+    Boolean         pop(Type& item);
+    void            clear( );
+
+private:
+    Type            m_items[SIZE];
+    volatile Int    m_head;
+    volatile Int    m_tail;
+};
+
+
+
+template <class Type, Int SIZE> TRing<Type, SIZE>::TRing( ) :
+    m_head(0),
+    m_tail(0)
+{
+}
+
+
+template <class Type, Int SIZE> TRing<Type, SIZE>::~TRing( )
+{
+}
+
+
+template <class Type, Int SIZE> Boolean
+TRing<Type, SIZE>::push(const Type& item)
+{
+    Int head = m_head;
+    Int next = (head + 1) % SIZE;
+    if (next == Atomic::load(m_tail))
+        return false;
+    m_items[head] = item;
+    Atomic::store(m_head, next);
+    return true;
+}
+
+
+template <class Type, Int SIZE> Boolean
+TRing<Type, SIZE>::pop(Type& item)
+{
+    Int tail = m_tail;
+    if (tail == Atomic::load(m_head))
+        return false;
+    item = m_items[tail];
+    Atomic::store(m_tail, (tail + 1) % SIZE);
+    return true;
+}
+
+
+// Drops everything queued so far; only the consumer may call this.
+template <class Type, Int SIZE> void
+TRing<Type, SIZE>::clear( )
+{
+    Atomic::store(m_tail, Atomic::load(m_head));
+}
+
+
+#endif /* __COMMON_TRING_H__ */
@@ -0,0 +1,71 @@
+/**
+* Common library
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __COMMON_TTRIPLEBUFFER_H__
+#define __COMMON_TTRIPLEBUFFER_H__
+
+#include <Common/If/Atomic.h>
+
+
+// Hands the latest copy of a value from one thread to another without
+// either of them ever waiting. The producer fills back( ) and publishes
+// it; the consumer gets the newest published copy from front( ), which
+// stays untouched until it calls front( ) again. Of the three buffers the
+// one in the middle is swapped between them, so there must be one
+// producer and one consumer at a time.
+template <class Type>
+class TTripleBuffer
+{
+public:
+    TTripleBuffer( );
+    virtual ~TTripleBuffer( );
+
+public:
+    Type&           back( )         { return m_buffer[m_back];  }
+    void            publish( );
+    const Type&     front( );
+
+private:
+    enum { fresh = 4 };             // set on the middle when the consumer has not seen it
+
+    Type            m_buffer[3];
+    Int             m_back;
+    Int             m_front;
+    volatile Int    m_middle;
+};
+
+
+
+template <class Type> TTripleBuffer<Type>::TTripleBuffer( ) :
+    m_back(0),
+    m_front(1),
+    m_middle(2)
+{
+}
+
+
+template <class Type> TTripleBuffer<Type>::~TTripleBuffer( )
+{
+}
+
+
+template <class Type> void
+TTripleBuffer<Type>::publish( )
+{
+    m_back = Atomic::exchange(m_middle, m_back | fresh) & ~fresh;
+}
+
+
+template <class Type> const Type&
+TTripleBuffer<Type>::front( )
+{
+    if (Atomic::load(m_middle) & fresh)
+        m_front = Atomic::exchange(m_middle, m_front) & ~fresh;
+    return m_buffer[m_front];
+}
+
+
+#endif /* __COMMON_TTRIPLEBUFFER_H__ */
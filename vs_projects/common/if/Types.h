@@ -18,8 +18,13 @@ typedef unsigned short            UShort;
 typedef char                      Byte;
 typedef unsigned char             UByte;
 typedef char                      Char;
+#ifdef _MSC_VER
 typedef signed __int64            Huge; 
 typedef unsigned __int64          UHuge; 
+#else
+typedef signed long long          Huge;
+typedef unsigned long long        UHuge;
+#endif
 typedef double                    Double;
 typedef float                     Float;
 
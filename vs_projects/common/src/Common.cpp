@@ -4,11 +4,13 @@
 * Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
 * This program is distributed under the terms of the GNU General Public License version 3.
 */
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <Common/If/Common.h>
 
 
-#ifndef COMMON_STATIC
+#if defined(_WIN32) && !defined(COMMON_STATIC)
 
 BOOL APIENTRY DllMain( HANDLE hModule, 
                        DWORD  ul_reason_for_call, 
@@ -9,25 +9,45 @@
 
 Mutex::Mutex( )
 {
+#ifdef _WIN32
     ::InitializeCriticalSection(&m_criticalSection);
+#else
+    pthread_mutexattr_t attributes;
+    pthread_mutexattr_init(&attributes);
+    pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&m_mutex, &attributes);
+    pthread_mutexattr_destroy(&attributes);
+#endif
 }
 
 
 Mutex::~Mutex( )
 {
+#ifdef _WIN32
     ::DeleteCriticalSection(&m_criticalSection);
+#else
+    pthread_mutex_destroy(&m_mutex);
+#endif
 }
 
 
 void
 Mutex::lock( )
 {
+#ifdef _WIN32
     ::EnterCriticalSection(&m_criticalSection); 
+#else
+    pthread_mutex_lock(&m_mutex);
+#endif
 }
 
 
 void
 Mutex::unlock( )
 {
+#ifdef _WIN32
     ::LeaveCriticalSection(&m_criticalSection);
+#else
+    pthread_mutex_unlock(&m_mutex);
+#endif
 }
@@ -7,8 +7,14 @@
 #include <Common/If/Tracer.h>
 
 #include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#ifdef _WIN32
 #include <windows.h>
 #include <tchar.h> // _vsntprintf
+#else
+#define _vsntprintf vsnprintf
+#endif
 
 
 Tracer::Tracer(const Char name[] ) :
@@ -41,15 +47,16 @@ void Tracer::trace(const Char* fmt, ...)
         sprintf(buffer, "[%s] ", m_name);
         va_list args;
         va_start(args, fmt);
-        _vsntprintf( buffer + strlen(buffer), 512, fmt, args );
+        _vsntprintf( buffer + strlen(buffer), sizeof(buffer) - strlen(buffer) - 1, fmt, args );
+        buffer[sizeof(buffer) - 2] = '\0';
         sprintf(buffer + strlen(buffer), "\n");
         va_end(args);
         if (m_file)
         {
-            fprintf(m_file->getStream(), buffer);
+            fprintf(m_file->getStream(), "%s", buffer);
             fflush(m_file->getStream());
         }
         else
-            printf(buffer);
+            printf("%s", buffer);
     }
 }
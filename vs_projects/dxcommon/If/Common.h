@@ -11,6 +11,8 @@
 #include <DxCommon/If/Internal.h>
 #include <DxCommon/If/Utilities.h>
 #include <DxCommon/If/Sound.h>
+#include <DxCommon/If/SoundLoader.h>
+#include <DxCommon/If/Emitter.h>
 #include <DxCommon/If/Input.h>
 #include <DxCommon/If/Timer.h>
 #include <DxCommon/If/D3DFont.h>
@@ -0,0 +1,60 @@
+/**
+* DXCommon library
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __DXCOMMON_EMITTER_H__
+#define __DXCOMMON_EMITTER_H__
+
+#include <DxCommon/If/Internal.h>
+
+#define EMITTERMAXSOUNDS    16          // sounds one emitter can hold
+
+namespace DirectX
+{
+
+class Sound;
+class VoiceManager;
+
+
+/*************************************************************************************
+ *@class Emitter
+ *@description
+ *    The sounds of one thing in the world, such as a car, that are all heard from
+ *    the same place. The emitter owns them, and places them all at once: in 3D
+ *    from one position, whose distance is worked out once and which is not sent
+ *    again while it does not change; in 2D from one pan and one volume, which the
+ *    owner works out once by its own pan law. So the cost of placing sounds grows
+ *    with the number of emitters instead of the number of sounds.
+ *************************************************************************************/
+class Emitter
+{
+public:
+    _dxcommon_ Emitter( );
+    _dxcommon_ virtual ~Emitter( );
+
+public:
+    _dxcommon_ Sound*   add(Sound* sound);
+    _dxcommon_ void     clear( );
+    _dxcommon_ void     voiceManager(VoiceManager* manager);
+    _dxcommon_ UInt     nSounds( ) const            { return m_nSounds;     }
+
+    ///@name interface 'placement' methods
+    //@{
+    _dxcommon_ void     position(Vector3 pos);
+    _dxcommon_ void     pan(Int value);             // value in [-100, +100]
+    _dxcommon_ void     volume(Int value);          // value in [0, +100]
+    //@}
+
+private:
+    Sound*      m_sounds[EMITTERMAXSOUNDS];
+    UInt        m_nSounds;
+    Vector3     m_position;
+    Boolean     m_placed;       // m_position was given to the sounds
+};
+
+} // namespace DirectX
+
+
+#endif /* __DXCOMMON_EMITTER_H__ */
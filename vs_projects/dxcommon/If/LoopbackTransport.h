@@ -0,0 +1,206 @@
+/**
+* DXCommon library
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __DXCOMMON_LOOPBACKTRANSPORT_H__
+#define __DXCOMMON_LOOPBACKTRANSPORT_H__
+
+#include <DxCommon/If/Transport.h>
+#include <vector>
+#include <map>
+
+#define LOOPBACK_MAXQUEUE       1000        // ms of packets a link holds before it drops what is not secure
+
+namespace DirectX
+{
+
+class LoopbackServerTransport;
+class LoopbackClientTransport;
+
+
+/*************************************************************************************
+ *@class LoopbackNetwork
+ *@description
+ *    Connects a LoopbackServerTransport to any number of LoopbackClientTransports
+ *    in one process, over emulated links with latency, jitter, loss, reordering and
+ *    a bandwidth cap in each direction. It has no thread of its own: the owner calls
+ *    deliverToServer and deliverToClients with the time, and the IServer and the
+ *    IClients are called from there, so a whole session can run on one thread.
+ *    The delivery guarantees are those of ServerTransport. A secure packet is never
+ *    lost, but each lost try delays it by a round trip, and it waits for the secure
+ *    packets before it. Any other packet may be lost, and one that is overtaken by
+ *    a newer packet is dropped when it arrives, as UdpTransport drops it.
+ *************************************************************************************/
+class LoopbackNetwork
+{
+public:
+    struct Link
+    {
+        UInt            latency;        // ms one way
+        UInt            jitter;         // at most this many ms are added to the latency
+        Float           loss;           // chance that a packet is lost, 0 to 1
+        Float           reorder;        // chance that a packet is held up by another latency
+        UInt            bandwidth;      // bytes per second each way, 0 for no limit
+    };
+
+    struct Statistics
+    {
+        UHuge           bytesToServer;
+        UHuge           bytesToClient;
+        UInt            packetsToServer;
+        UInt            packetsToClient;
+        UInt            packetsLost;
+        UInt            packetsOvertaken;
+        UInt            packetsDropped;     // by a full link
+    };
+
+public:
+    LoopbackNetwork(const Link& link, UInt seed);
+    virtual ~LoopbackNetwork( );
+
+public:
+    void        deliverToServer(UInt now);
+    void        deliverToClients(UInt now);
+
+    Statistics  statistics(UInt id);
+    Statistics  total( )                        { return m_total;       }
+
+private:
+    friend class LoopbackServerTransport;
+    friend class LoopbackClientTransport;
+
+    enum Kind
+    {
+        kindData,
+        kindConnect,
+        kindDisconnect
+    };
+
+    struct Packet
+    {
+        UInt                id;
+        Boolean             toServer;
+        Kind                kind;
+        Boolean             secure;
+        UInt                sequence;
+        std::vector<UByte>  data;
+    };
+
+    // One direction of the link of a client.
+    struct Direction
+    {
+        Double          busyUntil;      // the cap has sent everything queued by then
+        Double          lastSecure;     // arrival of the last secure packet
+        UInt            nextSequence;
+        UInt            lastDelivered;
+        Boolean         delivered;
+    };
+
+    struct Peer
+    {
+        LoopbackClientTransport*    client;
+        Boolean                     added;      // the server knows the client
+        Direction                   up;
+        Direction                   down;
+        Statistics                  statistics;
+    };
+
+    typedef std::map<UInt, Peer>                TPeerMap;
+    typedef std::multimap<Double, Packet>       TPacketMap;
+
+    UInt        connect(LoopbackClientTransport* client);
+    void        disconnect(UInt id);
+    void        send(UInt id, Boolean toServer, Kind kind, const void* buffer, UInt size, Boolean secure);
+    void        deliver(UInt now, Boolean toServer);
+    Boolean     chance(Float p);
+    UInt        nextRandom(UInt max);
+
+private:
+    Link                        m_link;
+    UInt                        m_seed;
+    UInt                        m_now;
+    LoopbackServerTransport*    m_server;
+    TPeerMap                    m_peers;
+    TPacketMap                  m_inFlight;     // by arrival time
+    UInt                        m_nextId;
+    Statistics                  m_total;
+};
+
+
+
+/*************************************************************************************
+ *@class LoopbackServerTransport
+ *@description
+ *    Hosts the session of a LoopbackNetwork; the port is not used.
+ *************************************************************************************/
+class LoopbackServerTransport : public ServerTransport
+{
+public:
+    LoopbackServerTransport(LoopbackNetwork& network);
+    virtual ~LoopbackServerTransport( );
+
+public:
+    Boolean     startSession(const Char* name, UInt port);
+    void        stopSession( );
+    void        sendPacket(UInt to, void* buffer, UInt size, Boolean secure);
+
+    void        setIServer(IServer* server)             { m_iServer = server;           }
+    void        setApplication(UInt application)        { m_application = application;  }
+
+private:
+    friend class LoopbackNetwork;
+    friend class LoopbackClientTransport;
+
+    LoopbackNetwork&    m_network;
+    IServer*            m_iServer;
+    UInt                m_application;
+    Char                m_name[64];
+};
+
+
+
+/*************************************************************************************
+ *@class LoopbackClientTransport
+ *@description
+ *    Joins the session of a LoopbackNetwork, which is the only session it finds.
+ *    Joining succeeds at once; the server hears of it after the latency.
+ *************************************************************************************/
+class LoopbackClientTransport : public ClientTransport
+{
+public:
+    LoopbackClientTransport(LoopbackNetwork& network);
+    virtual ~LoopbackClientTransport( );
+
+public:
+    Boolean     initialize( );
+    void        finalize( );
+    Boolean     sendPacket(void* buffer, UInt size, Boolean secure);
+
+    Boolean     startSessionEnum(UInt port, const Char* address);
+    void        stopSessionEnum( );
+    UInt        nSessions( );
+    Boolean     sessionName(UInt i, Char* name, UInt size);
+    Boolean     joinSession(UInt i);
+    Boolean     joinSessionAt(UInt port, const Char* address);
+
+    void        setIClient(IClient* client)             { m_iClient = client;           }
+    void        setApplication(UInt application)        { m_application = application;  }
+
+    UInt        id( )                                   { return m_id;                  }
+
+private:
+    friend class LoopbackNetwork;
+    friend class LoopbackServerTransport;
+
+    LoopbackNetwork&    m_network;
+    IClient*           m_iClient;
+    UInt                m_application;
+    UInt                m_id;           // 0 when not joined
+};
+
+} // namespace DirectX
+
+
+#endif /* __DXCOMMON_LOOPBACKTRANSPORT_H__ */
@@ -8,6 +8,7 @@
 #define __DXCOMMON_NETWORK_H__
 
 #include <DxCommon/If/Common.h>
+#include <DxCommon/If/Transport.h>
 #include <dplay8.h>
 
 #define DXCOMMON_NMAXSESSIONS       (256)
@@ -16,29 +17,21 @@ namespace DirectX
 {
 
 class Server;
-class IServer;
 class Client;
-class IClient;
-
-
-class IServer
-{
-public:
-    virtual ~IServer() { };
-
-public:
-    virtual void    onPacket(UInt from, void* buffer, UInt size) = 0;
-    virtual void    onAddConnection(UInt id) = 0;
-    virtual void    onRemoveConnection(UInt id) = 0;
-    virtual void    onSessionLost( ) = 0;
-};
-
+class ServerAdapter;
 
 
+/*************************************************************************************
+ *@class Server
+ *@description
+ *    Hosts a session that Clients can join. By default it uses DirectPlay; with
+ *    the udp transport it uses a UdpServerTransport instead, which also runs
+ *    outside Windows. Either way the IServer gets the same callbacks.
+ *************************************************************************************/
 class Server
 {
 public:
-    _dxcommon_  Server( );
+    _dxcommon_  Server(Transport transport = directPlay);
     _dxcommon_  virtual ~Server( );
 
 public:
@@ -48,8 +41,9 @@ public:
     _dxcommon_  virtual void    sendPacket(UInt to, void* buffer, UInt size, Boolean secure, UInt timeout = 0);
 
 public:
-    _dxcommon_  void        setIServer(IServer* server)     { m_iServer = server;       }
+    _dxcommon_  void        setIServer(IServer* server);
     _dxcommon_  void        setGUID(GUID& guid)             { m_applicationGUID = guid; }
+    _dxcommon_  Transport   transport( )                    { return (m_transport) ? udp : directPlay; }
 
 
 public:
@@ -63,22 +57,43 @@ private:
     DPN_APPLICATION_DESC        m_directPlayAppDesc;
     GUID                        m_applicationGUID;
     IServer*                    m_iServer;
+    ServerTransport*            m_transport;        // 0 when DirectPlay is used
     Boolean                     m_started;
 };
 
 
 
-class IClient
+/*************************************************************************************
+ *@class ServerAdapter
+ *@description
+ *    Lets code that hosts its session through a ServerTransport use a Server,
+ *    so it runs over DirectPlay as well as over UDP.
+ *************************************************************************************/
+class ServerAdapter : public ServerTransport
 {
 public:
-    virtual ~IClient() { };
+    ServerAdapter(Transport transport, GUID& guid) : m_server(transport)   { m_server.setGUID(guid);  }
+    virtual ~ServerAdapter( )                                               { }
 
 public:
-    virtual void    onPacket(UInt from, void* buffer, UInt size) = 0;
-    virtual void    onSessionLost( ) = 0;
+    Boolean     startSession(const Char* name, UInt port)       { return (m_server.startSession(const_cast<Char*>(name), port) == dxSuccess); }
+    void        stopSession( )                                  { m_server.stopSession( );                  }
+    void        sendPacket(UInt to, void* buffer, UInt size, Boolean secure)    { m_server.sendPacket(to, buffer, size, secure); }
+
+    void        setIServer(IServer* server)                     { m_server.setIServer(server);              }
+    void        setApplication(UInt application)                { }
+
+private:
+    Server      m_server;
 };
 
 
+
+/*************************************************************************************
+ *@class Client
+ *@description
+ *    Finds and joins sessions hosted by a Server with the same transport.
+ *************************************************************************************/
 class Client
 {
 public:
@@ -91,7 +106,7 @@ public:
     };
 
 public:
-    _dxcommon_  Client( );
+    _dxcommon_  Client(Transport transport = directPlay);
     _dxcommon_  virtual ~Client( );
 
 public:
@@ -104,7 +119,7 @@ public:
     _dxcommon_  virtual Int     startSessionEnum(UInt port, const Char* ipaddress = 0);
     _dxcommon_  virtual Int     stopSessionEnum( );
 
-    _dxcommon_  virtual UInt    nSessions( )                { return m_nSessions;   }
+    _dxcommon_  virtual UInt    nSessions( );
     _dxcommon_  virtual Int     session(UInt i, SessionInfo& info);
 
     _dxcommon_  virtual Int     joinSession(UInt i);
@@ -116,8 +131,9 @@ private:
                                                 IDirectPlay8Address* addressDevice);
 
 public:
-    _dxcommon_  void        setIClient(IClient* client)     { m_iClient = client;       }
+    _dxcommon_  void        setIClient(IClient* client);
     _dxcommon_  void        setGUID(GUID& guid)             { m_applicationGUID = guid; }
+    _dxcommon_  Transport   transport( )                    { return (m_transport) ? udp : directPlay; }
 
 public:
     static HRESULT WINAPI   directPlayMessageHandler(void* pvUserContext, DWORD dwMessageId, void* pMsgBuffer);
@@ -128,6 +144,7 @@ public:
 private:
     IDirectPlay8Client*         m_directPlayClient;
     IClient*                    m_iClient;
+    ClientTransport*            m_transport;        // 0 when DirectPlay is used
     DPNHANDLE                   m_directPlayEnumHandle;
     GUID                        m_applicationGUID;
 
@@ -12,6 +12,8 @@
 #include <DxCommon/If/Common.h>
 #include <mmsystem.h>  
 #include <dsound.h>
+#include <DxCommon/If/VoiceManager.h>
+#include <DxCommon/If/SoundPack.h>
 
 
 #ifdef _USE_VORBIS_
@@ -26,6 +28,7 @@ class SoundManager;
 class Sound;
 class WaveFile;
 class Listener3D;
+class SoundStream;
 
 /*************************************************************************************
  *@class SoundManager
@@ -33,6 +36,7 @@ class Listener3D;
  *    This class represents the DirectSound interface. It's responsible for 
  *    initiliasing the DirectSound interface and setting the default buffer format.
  *    It has an interface for creating new Sound objects given a Wave file.
+ *    When a SoundPack is opened, the files in it are taken from the pack instead.
  *************************************************************************************/
 class SoundManager
 {
@@ -45,6 +49,20 @@ public:
         AlgoLightHrtf
     };
 
+    // A decoded file kept by the SoundManager. Every Sound created from
+    // the same file shares the PCM data of 'master' through duplicated
+    // buffers, so the file is read and decoded only once.
+    struct CachedSound
+    {
+        Char            name[MAX_PATH];
+        Boolean         enable3d;
+        Boolean         vorbis;
+        Sound*          master;
+        UInt            users;
+        UInt            lastUsed;
+        CachedSound*    next;
+    };
+
 public:
     ///@name interface 'constructor/desctructor'
     //@{
@@ -59,6 +77,7 @@ public:
     _dxcommon_ Sound* create(DSBUFFERDESC& bufferDesc, Boolean enable3d = false, UInt nBuffers = 1);
 #ifdef _USE_VORBIS_
     _dxcommon_ Sound* createVorbis(Char* filename, Boolean enable3d = false, UInt nBuffers = 1);
+    _dxcommon_ Sound* createVorbisStream(Char* filename, Boolean enable3d = false);
 #endif
     //@}
 
@@ -71,14 +90,69 @@ public:
     _dxcommon_ Int            listener3DInterface(LPDIRECTSOUND3DLISTENER* listener);
     _dxcommon_ Algorithm      algorithm( ) const           { return m_3dAlgorithm;   }
     _dxcommon_ void           algorithm(Algorithm algo)    { m_3dAlgorithm = algo;   }
+    _dxcommon_ void           cacheLimit(UInt bytes)       { m_cacheLimit = bytes; trimCache( ); }
+    _dxcommon_ UInt           cacheLimit( ) const          { return m_cacheLimit;    }
+    _dxcommon_ VoiceManager*  voiceManager( )              { return &m_voices;       }
     //@}    
 
+    ///@name interface 'cache' methods
+    //@{
+    _dxcommon_ void           flushCache( );
+    _dxcommon_ CachedSound*   prefetch(Char* filename, Boolean enable3d = false, Boolean vorbis = false);
+    _dxcommon_ CachedSound*   prefetch(Int resource, Boolean enable3d = false);
+    _dxcommon_ void           release(CachedSound* cached);
+    //@}
+
+    ///@name interface 'batch' methods
+    //@{
+    _dxcommon_ void           commit( );
+    //@}
+
+    ///@name interface 'pack' methods
+    //@{
+    _dxcommon_ Boolean        openPack(const Char* filename);
+    _dxcommon_ Boolean        packed(const Char* filename) const { return (m_pack.find(filename) != 0); }
+    //@}
+
+private:
+    friend class Sound;
+    Sound*          load(Char* filename, Boolean enable3d, UInt nBuffers);
+#ifdef _USE_VORBIS_
+    Sound*          loadVorbis(Char* filename, Boolean enable3d, UInt nBuffers);
+#endif
+    Sound*          loadFile(Char* filename, Boolean enable3d, UInt nBuffers, Boolean vorbis);
+    Sound*          loadPacked(const SoundPackEntry* entry, Boolean enable3d, UInt nBuffers);
+    Sound*          createCached(Char* filename, Boolean enable3d, UInt nBuffers, Boolean vorbis);
+    Sound*          duplicate(CachedSound* cached, UInt nBuffers);
+    CachedSound*    findCached(Char* filename, Boolean enable3d, Boolean vorbis);
+    void            trimCache( );
+    void            unlist(Sound* sound);
+    LPDIRECTSOUND3DLISTENER listener3D( );
+#ifdef _USE_VORBIS_
+    void            addStream(SoundStream* stream);
+    void            removeStream(SoundStream* stream);
+    static DWORD WINAPI streamThread(LPVOID param);
+#endif
+
 private:
     LPDIRECTSOUND8 m_directSound;
     Boolean        m_created;
     Boolean        m_playInSoftware;
     Boolean        m_reverseStereo;
     Algorithm      m_3dAlgorithm;
+    CachedSound*   m_cache;
+    UInt           m_cacheClock;
+    UInt           m_cacheLimit;    // bytes of unused sounds we keep around
+    Mutex          m_cacheMutex;    // the cache is shared with the SoundLoader threads
+    SoundStream*   m_streams;
+    Mutex          m_streamMutex;   // guards m_streams and the state of every stream
+    HANDLE         m_streamThread;
+    HANDLE         m_streamStop;
+    VoiceManager   m_voices;
+    Sound*         m_changed;       // sounds with settings to commit
+    LPDIRECTSOUND3DLISTENER m_listener;  // commits the deferred 3D settings
+    Boolean        m_listenerTried;
+    SoundPack      m_pack;          // mapped until the SoundManager is deleted
 };
 
 
@@ -87,17 +161,23 @@ private:
  *@description
  *    The sound class represents a sound. Besides the normal 'play' and 'stop' 
  *    methods, it has different control methods for controlling volume, pan and
- *    frequency. A sound will usually be created by a 'SoundManager'.
+ *    frequency. A sound will usually be created by a 'SoundManager'; then those
+ *    settings, and its 3D position, only reach its buffers when the SoundManager
+ *    commits them, once a frame, or when it is played. A setting that did not
+ *    change since it was last committed costs nothing.
  *************************************************************************************/
 class Sound
 {
 public:
     _dxcommon_ Sound(LPDIRECTSOUNDBUFFER* buffer, UInt bufferSize, UInt nBuffers, WaveFile* waveFile);
     _dxcommon_ Sound(LPDIRECTSOUNDBUFFER* buffer, UInt bufferSize, UInt nBuffers, LPWAVEFORMATEX waveFormat);
+    _dxcommon_ Sound(LPDIRECTSOUNDBUFFER* buffer, UInt bufferSize, UInt nBuffers, LPWAVEFORMATEX waveFormat, const UByte* packed);
 #ifdef _USE_VORBIS_
     _dxcommon_ Sound(LPDIRECTSOUNDBUFFER* buffer, UInt bufferSize, UInt nBuffers, 
                      OggVorbis_File* vorbisFile, UShort bitsPerSample, UInt avgBytesPerSec);
 #endif
+    _dxcommon_ Sound(LPDIRECTSOUNDBUFFER* buffer, UInt nBuffers, SoundManager* manager, SoundManager::CachedSound* cached);
+    _dxcommon_ Sound(LPDIRECTSOUNDBUFFER buffer, SoundManager* manager, SoundStream* stream);
     _dxcommon_ virtual ~Sound();
 
     _dxcommon_ Int fillBufferWithSound(LPDIRECTSOUNDBUFFER buffer);
@@ -113,6 +193,7 @@ public:
     _dxcommon_ Boolean playing();
     _dxcommon_ void playInSoftware(Boolean val)  { m_playInSoftware = val; }
     _dxcommon_ void reverseStereo(Boolean val)   { m_reverseStereo = val ? -1 : 1; }
+    _dxcommon_ void voiceManager(VoiceManager* manager);
 
     ///@name interface 'pan/frequency/volume' methods
     //@{
@@ -150,12 +231,99 @@ protected:
     LPDIRECTSOUND3DBUFFER   m_buffer3D;
     DS3DBUFFER              m_parameters;
     Float                   m_length; // ORDER DEPENDENCY
+    SoundManager*               m_manager;
+    SoundManager::CachedSound*  m_cached;   // shared data this sound was duplicated from, if any
+    SoundStream*                m_stream;   // decoder feeding the buffer, if this sound is streamed
+    const UByte*                m_packed;   // PCM data mapped from a SoundPack, if the sound came from one
+    VoiceManager*               m_voices;   // decides which plays of this sound really play, if any
+    Int                     m_volume;
+    Float                   m_distance;     // from the listener, when in 3D
+    Int                     m_rate;         // set by frequency, 0 for that of the buffer
+    Int                     m_pan;          // in DirectSound units
+    UInt                    m_changes;      // settings made since they were last applied
+    UInt                    m_applied;      // settings applied at least once
+    Int                     m_appliedPan;
+    Int                     m_appliedVolume;
+    Int                     m_appliedRate;
+    D3DVECTOR               m_appliedPosition;
+    Boolean                 m_listed;       // on the list of the SoundManager to commit
+    Sound*                  m_nextChanged;
     
+    enum Setting
+    {
+        settingPan          = 1,
+        settingVolume       = 2,
+        settingFrequency    = 4,
+        settingPosition     = 8
+    };
+
+    friend class SoundManager;
+    friend class VoiceManager;
+    friend class Emitter;
     Int restoreBuffer(LPDIRECTSOUNDBUFFER buffer, Boolean* wasRestored);
+    Int playBuffer(LPDIRECTSOUNDBUFFER buffer, UInt priority, Boolean looped);
+    Float level( );
+    void change(UInt setting);
+    void place(const Vector3& pos, Float distance);
+    Boolean apply(Boolean deferred);
+#ifdef _USE_VORBIS_
+    Int playStream(UInt priority, Boolean looped, Boolean restored);
+#endif
 };
 
 
 
+#ifdef _USE_VORBIS_
+/*************************************************************************************
+ *@class SoundStream
+ *@description
+ *    Plays an Ogg Vorbis file without decoding it up front. The sound buffer is
+ *    a ring of a few short segments; the SoundManager's stream thread refills
+ *    every segment the play cursor has left with the next part of the file.
+ *    A stream is owned by the Sound it was created for.
+ *************************************************************************************/
+class SoundStream
+{
+public:
+    SoundStream( );
+    virtual ~SoundStream( );
+
+public:
+    Boolean         open(Char* filename);
+    void            attach(LPDIRECTSOUNDBUFFER buffer);
+    void            rewind( );
+    void            update( );
+    void            looped(Boolean val)     { m_looped = val;       }
+    WAVEFORMATEX*   waveFormat( )           { return &m_waveFormat; }
+    UInt            bufferSize( )           { return m_segmentSize*m_nSegments; }
+    Float           length( )               { return m_length;      }
+
+private:
+    void            fill(UInt segment);
+
+public:
+    SoundStream*        m_next;
+
+private:
+    FILE*               m_file;
+    OggVorbis_File      m_vorbisFile;
+    Boolean             m_opened;
+    WAVEFORMATEX        m_waveFormat;
+    Float               m_length;
+    LPDIRECTSOUNDBUFFER m_buffer;
+    UInt                m_segmentSize;
+    UInt                m_nSegments;
+    UInt                m_nextSegment;  // first segment to refill once the play cursor has left it
+    Boolean             m_looped;
+    Boolean             m_ended;
+    Huge                m_written;      // bytes of the stream put in the buffer so far
+    Huge                m_played;       // bytes of the stream played so far
+    Huge                m_endPosition;  // value of m_played at which the file has ended
+    UInt                m_lastPosition;
+};
+#endif
+
+
 //-----------------------------------------------------------------------------
 // Name: class CWaveFile
 // Desc: Encapsulates reading or writing sound data to or from a wave file
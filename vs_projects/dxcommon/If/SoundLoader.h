@@ -0,0 +1,76 @@
+/**
+* DXCommon library
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __DXCOMMON_SOUNDLOADER_H__
+#define __DXCOMMON_SOUNDLOADER_H__
+
+#include <DxCommon/If/Sound.h>
+
+#define SOUNDLOADERMAXTHREADS 4
+
+namespace DirectX
+{
+
+/*************************************************************************************
+ *@class SoundLoader
+ *@description
+ *    Loads sounds into the cache of a SoundManager from a few worker threads, so
+ *    reading files and decoding them happen in parallel and in the background.
+ *    Prefetched sounds stay in the cache until release is called; creating a Sound
+ *    from a prefetched file only duplicates the cached buffer.
+ *************************************************************************************/
+class SoundLoader
+{
+public:
+    ///@name interface 'constructor/desctructor'
+    //@{
+    _dxcommon_ SoundLoader(SoundManager* soundManager, UInt nThreads = 0);
+    _dxcommon_ virtual ~SoundLoader( );
+    //@}
+
+    ///@name interface 'loading' methods
+    //@{
+    _dxcommon_ void     prefetch(Char* filename, Boolean enable3d = false, Boolean vorbis = false);
+    _dxcommon_ void     prefetch(Int resource, Boolean enable3d = false);
+    _dxcommon_ UInt     pending( );
+    _dxcommon_ void     cancel( );
+    _dxcommon_ void     release( );
+    //@}
+
+private:
+    struct Request
+    {
+        Char                        name[MAX_PATH];
+        Boolean                     enable3d;
+        Boolean                     vorbis;
+        UInt                        generation;     // m_generation when it was queued
+        SoundManager::CachedSound*  cached;
+        Request*                    next;
+    };
+
+private:
+    static DWORD WINAPI worker(LPVOID param);
+    void                work( );
+
+private:
+    SoundManager*       m_soundManager;
+    Mutex               m_mutex;
+    Request*            m_queue;        // requests still to be loaded, oldest first
+    Request*            m_queueTail;
+    Request*            m_done;         // loaded requests, holding their cache entry
+    UInt                m_pending;      // queued plus being loaded
+    UInt                m_generation;   // counts the cancels, so older loads are dropped
+    HANDLE              m_wake;
+    HANDLE              m_stop;
+    HANDLE              m_threads[SOUNDLOADERMAXTHREADS];
+    UInt                m_nThreads;
+};
+
+
+} // namespace DirectX
+
+
+#endif /* __DXCOMMON_SOUNDLOADER_H__ */
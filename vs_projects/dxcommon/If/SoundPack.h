@@ -0,0 +1,58 @@
+/**
+* DXCommon library
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __DXCOMMON_SOUNDPACK_H__
+#define __DXCOMMON_SOUNDPACK_H__
+
+#include <DxCommon/If/Internal.h>
+#include <Common/If/SoundPackFormat.h>
+#include <mmsystem.h>
+
+namespace DirectX
+{
+
+/*************************************************************************************
+ *@class SoundPack
+ *@description
+ *    A pack of decoded sounds, built by the soundpack tool from the Sounds folder.
+ *    The whole file is mapped into memory when it is opened, so finding a sound
+ *    is a binary search of the index and its PCM data is used where it is mapped:
+ *    nothing is read or decoded, and the pages of a sound are only read from disk
+ *    when it is copied into a buffer. The pack is only read after it is opened,
+ *    so it can be used from any thread.
+ *************************************************************************************/
+class SoundPack
+{
+public:
+    _dxcommon_ SoundPack( );
+    _dxcommon_ virtual ~SoundPack( );
+
+public:
+    _dxcommon_ Boolean  open(const Char* filename);
+    _dxcommon_ void     close( );
+    _dxcommon_ Boolean  opened( ) const             { return (m_view != 0);         }
+    _dxcommon_ UInt     nEntries( ) const           { return (m_header) ? m_header->nEntries : 0; }
+
+    _dxcommon_ const SoundPackEntry*    find(const Char* filename) const;
+    _dxcommon_ const UByte*             data(const SoundPackEntry* entry) const { return m_view + entry->data; }
+    _dxcommon_ static void              format(const SoundPackEntry* entry, WAVEFORMATEX& waveFormat);
+
+private:
+    Boolean     valid( ) const;
+
+private:
+    HANDLE                  m_file;
+    HANDLE                  m_mapping;
+    const UByte*            m_view;
+    UInt                    m_size;
+    const SoundPackHeader*  m_header;
+    const SoundPackEntry*   m_entries;
+};
+
+} // namespace DirectX
+
+
+#endif /* __DXCOMMON_SOUNDPACK_H__ */
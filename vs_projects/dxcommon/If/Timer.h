@@ -32,7 +32,7 @@ public:
     _dxcommon_ void  stop( );
     _dxcommon_ void  reset( );
     _dxcommon_ UInt  elapsed(Boolean reset = true);
-    _dxcommon_ Huge  microElapsed( );
+    _dxcommon_ Huge  microElapsed(Boolean reset = true);
 
 
 private:
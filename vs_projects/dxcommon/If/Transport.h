@@ -0,0 +1,109 @@
+/**
+* DXCommon library
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __DXCOMMON_TRANSPORT_H__
+#define __DXCOMMON_TRANSPORT_H__
+
+#include <Common/If/Types.h>
+
+namespace DirectX
+{
+
+class IServer;
+class IClient;
+class ServerTransport;
+class ClientTransport;
+
+
+enum Transport
+{
+    directPlay  = 0,
+    udp         = 1
+};
+
+
+class IServer
+{
+public:
+    virtual ~IServer() { };
+
+public:
+    virtual void    onPacket(UInt from, void* buffer, UInt size) = 0;
+    virtual void    onAddConnection(UInt id) = 0;
+    virtual void    onRemoveConnection(UInt id) = 0;
+    virtual void    onSessionLost( ) = 0;
+};
+
+
+
+class IClient
+{
+public:
+    virtual ~IClient() { };
+
+public:
+    virtual void    onPacket(UInt from, void* buffer, UInt size) = 0;
+    virtual void    onSessionLost( ) = 0;
+};
+
+
+
+/*************************************************************************************
+ *@class ServerTransport
+ *@description
+ *    Carries the packets of a DirectX::Server when it does not use DirectPlay.
+ *    Implementations call the IServer from their own thread, like DirectPlay does.
+ *    A secure packet arrives exactly once and in the order it was sent; any
+ *    other packet may be lost, but is never delivered after a newer one.
+ *************************************************************************************/
+class ServerTransport
+{
+public:
+    virtual ~ServerTransport( )         { }
+
+public:
+    virtual Boolean startSession(const Char* name, UInt port) = 0;
+    virtual void    stopSession( ) = 0;
+    virtual void    sendPacket(UInt to, void* buffer, UInt size, Boolean secure) = 0;
+
+    virtual void    setIServer(IServer* server) = 0;
+    virtual void    setApplication(UInt application) = 0;
+};
+
+
+
+/*************************************************************************************
+ *@class ClientTransport
+ *@description
+ *    Carries the packets of a DirectX::Client when it does not use DirectPlay,
+ *    with the same delivery guarantees as ServerTransport.
+ *************************************************************************************/
+class ClientTransport
+{
+public:
+    virtual ~ClientTransport( )         { }
+
+public:
+    virtual Boolean initialize( ) = 0;
+    virtual void    finalize( ) = 0;
+    virtual Boolean sendPacket(void* buffer, UInt size, Boolean secure) = 0;
+
+    virtual Boolean startSessionEnum(UInt port, const Char* address) = 0;
+    virtual void    stopSessionEnum( ) = 0;
+    virtual UInt    nSessions( ) = 0;
+    virtual Boolean sessionName(UInt i, Char* name, UInt size) = 0;
+    virtual Boolean joinSession(UInt i) = 0;
+    virtual Boolean joinSessionAt(UInt port, const Char* address) = 0;
+
+    virtual void    setIClient(IClient* client) = 0;
+    virtual void    setApplication(UInt application) = 0;
+};
+
+
+} // namespace DirectX
+
+
+#endif /* __DXCOMMON_TRANSPORT_H__ */
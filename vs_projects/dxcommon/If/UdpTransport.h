@@ -0,0 +1,269 @@
+/**
+* DXCommon library
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __DXCOMMON_UDPTRANSPORT_H__
+#define __DXCOMMON_UDPTRANSPORT_H__
+
+#include <DxCommon/If/Transport.h>
+#include <vector>
+#include <deque>
+#include <map>
+
+#define UDPTRANSPORT_MAXCONNECTIONS     256
+#define UDPTRANSPORT_MAXSESSIONS        256
+#define UDPTRANSPORT_MAXPAYLOAD         1200        // bytes of a packet per datagram
+#define UDPTRANSPORT_MAXPACKET          (1024*1024) // largest secure packet
+#define UDPTRANSPORT_WINDOW             256         // secure datagrams in flight
+#define UDPTRANSPORT_TIMEOUT            10000       // ms of silence before a peer is dropped
+#define UDPTRANSPORT_KEEPALIVE          1000        // ms of our own silence before we send an ack
+#define UDPTRANSPORT_CONNECTTIMEOUT     5000        // ms to wait for a server to accept us
+
+namespace DirectX
+{
+
+struct UdpPlatform;
+
+
+/*************************************************************************************
+ *@class UdpTransport
+ *@description
+ *    The part of UdpServerTransport and UdpClientTransport that they share: a
+ *    non-blocking UDP socket serviced by one network thread (epoll on Linux,
+ *    select on Windows), and the two channels of a connection.
+ *    Secure packets go over a reliable ordered channel: they are split into
+ *    datagrams of at most UDPTRANSPORT_MAXPAYLOAD bytes, numbered, and resent
+ *    until the peer acknowledges them. Every datagram carries the acknowledgements
+ *    for the other direction. Other packets go over an unreliable sequenced
+ *    channel, which drops anything older than what it already delivered.
+ *    The IServer and IClient are called from the network thread, outside the lock.
+ *************************************************************************************/
+class UdpTransport
+{
+public:
+    UdpTransport( );
+    virtual ~UdpTransport( );
+
+public:
+    // ms on a clock that only goes forward, also used to time the race packets
+    static UInt     now( );
+
+protected:
+    struct Address
+    {
+        UInt            ip;             // host byte order
+        UShort          port;
+    };
+
+    struct Message
+    {
+        UShort              sequence;
+        Boolean             last;           // last datagram of its packet
+        UInt                sent;           // time of the last transmission
+        UInt                nSent;
+        std::vector<UByte>  data;
+    };
+
+    struct Connection
+    {
+        UInt                        id;
+        Address                     address;
+        UInt                        nonce;          // picked by the client, tells retries from reconnects
+        UInt                        lastReceived;
+        UInt                        lastSent;
+        UInt                        rtt;            // smoothed round trip time in ms
+        UInt                        rttVariance;
+
+        UShort                      nextReliable;
+        std::deque<Message>         unacked;        // sent or waiting for the window, oldest first
+        UShort                      expectedReliable;
+        std::map<UShort, Message>   early;          // arrived before expectedReliable
+        std::vector<UByte>          assembly;       // the packet being put together
+        Boolean                     overflow;       // it grew past UDPTRANSPORT_MAXPACKET
+        Boolean                     ackPending;
+
+        UShort                      nextUnreliable;
+        UShort                      lastUnreliable;
+        Boolean                     receivedUnreliable;
+    };
+
+    struct Event
+    {
+        enum Type
+        {
+            packet,
+            added,
+            removed,
+            lost
+        };
+
+        Type                type;
+        UInt                id;
+        std::vector<UByte>  data;
+    };
+
+    typedef std::vector<Event>  TEvents;
+
+    class Guard
+    {
+    public:
+        Guard(UdpTransport& transport) : m_transport(transport)  { m_transport.lock( );      }
+        ~Guard( )                                               { m_transport.unlock( );    }
+    private:
+        Guard& operator= (const Guard&);
+        UdpTransport&   m_transport;
+    };
+
+protected:
+    Boolean     open(UShort port);
+    void        close( );
+    Boolean     opened( )                       { return m_running;         }
+    void        lock( );
+    void        unlock( );
+
+    static void     sleep(UInt ms);
+    static Boolean  resolve(const Char* host, UInt port, Address& address);
+
+    void        sendDatagram(const Address& to, const UByte* data, UInt size);
+    void        sendControl(const Address& to, UByte kind, UInt value1, UInt value2);
+    void        resetConnection(Connection& connection);
+    void        sendReliable(Connection& connection, const UByte* data, UInt size);
+    void        sendUnreliable(Connection& connection, const UByte* data, UInt size);
+    void        sendDisconnect(Connection& connection);
+    void        receive(Connection& connection, const UByte* data, UInt size, TEvents& events);
+    Boolean     service(Connection& connection);
+
+    virtual void    onDatagram(const Address& from, const UByte* data, UInt size, TEvents& events) = 0;
+    virtual void    onTick(TEvents& events) = 0;
+    virtual void    deliver(Event& event) = 0;
+
+private:
+    UInt        writeHeader(Connection& connection, UByte kind, UByte* data);
+    void        transmit(Connection& connection, Message& message);
+    void        flush(Connection& connection);
+    void        acknowledge(Connection& connection, UShort ack, UInt ackBits);
+    void        accept(Connection& connection, const UByte* data, UInt size, Boolean last, TEvents& events);
+    UInt        timeout(Connection& connection);
+
+#ifdef _WIN32
+    static unsigned long __stdcall  thread(void* param);
+#else
+    static void*                    thread(void* param);
+#endif
+    void        run( );
+
+protected:
+    UInt                m_application;
+
+private:
+    UdpPlatform*        m_platform;
+    volatile Boolean    m_running;
+};
+
+
+
+/*************************************************************************************
+ *@class UdpServerTransport
+ *@description
+ *    Hosts a session over UDP. Clients find it by broadcasting an enumeration
+ *    request to its port, and join it with a connect request, after which the
+ *    IServer gets onAddConnection with the id the client is known by from then on.
+ *************************************************************************************/
+class UdpServerTransport : public ServerTransport, protected UdpTransport
+{
+public:
+    UdpServerTransport( );
+    virtual ~UdpServerTransport( );
+
+public:
+    Boolean     startSession(const Char* name, UInt port);
+    void        stopSession( );
+    void        sendPacket(UInt to, void* buffer, UInt size, Boolean secure);
+
+    void        setIServer(IServer* server)             { m_iServer = server;           }
+    void        setApplication(UInt application)        { m_application = application;  }
+
+    UInt        nConnections( );
+
+protected:
+    void        onDatagram(const Address& from, const UByte* data, UInt size, TEvents& events);
+    void        onTick(TEvents& events);
+    void        deliver(Event& event);
+
+private:
+    typedef std::map<UInt, Connection>  TConnectionMap;
+    typedef std::map<UHuge, UInt>       TAddressMap;
+
+    Connection* find(const Address& address);
+    void        remove(UInt id, TEvents& events);
+
+private:
+    IServer*            m_iServer;
+    Char                m_name[64];
+    TConnectionMap      m_connections;
+    TAddressMap         m_addresses;
+    UInt                m_nextId;
+};
+
+
+
+/*************************************************************************************
+ *@class UdpClientTransport
+ *@description
+ *    Finds sessions hosted by a UdpServerTransport and connects to one of them.
+ *    Joining waits until the server accepts, or UDPTRANSPORT_CONNECTTIMEOUT passes.
+ *************************************************************************************/
+class UdpClientTransport : public ClientTransport, protected UdpTransport
+{
+public:
+    UdpClientTransport( );
+    virtual ~UdpClientTransport( );
+
+public:
+    Boolean     initialize( );
+    void        finalize( );
+    Boolean     sendPacket(void* buffer, UInt size, Boolean secure);
+
+    Boolean     startSessionEnum(UInt port, const Char* address);
+    void        stopSessionEnum( );
+    UInt        nSessions( );
+    Boolean     sessionName(UInt i, Char* name, UInt size);
+    Boolean     joinSession(UInt i);
+    Boolean     joinSessionAt(UInt port, const Char* address);
+
+    void        setIClient(IClient* client)             { m_iClient = client;           }
+    void        setApplication(UInt application)        { m_application = application;  }
+
+protected:
+    void        onDatagram(const Address& from, const UByte* data, UInt size, TEvents& events);
+    void        onTick(TEvents& events);
+    void        deliver(Event& event);
+
+private:
+    struct Session
+    {
+        Address         address;
+        Char            name[64];
+    };
+
+    Boolean     join(const Address& address);
+
+private:
+    IClient*                m_iClient;
+    Connection              m_server;
+    Boolean                 m_connecting;
+    Boolean                 m_connected;
+    UInt                    m_lastConnect;
+    Boolean                 m_enumerating;
+    Address                 m_enumAddress;
+    UInt                    m_lastEnum;
+    std::vector<Session>    m_sessions;
+};
+
+
+} // namespace DirectX
+
+
+#endif /* __DXCOMMON_UDPTRANSPORT_H__ */
@@ -0,0 +1,91 @@
+/**
+* DXCommon library
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __DXCOMMON_VOICEMANAGER_H__
+#define __DXCOMMON_VOICEMANAGER_H__
+
+#include <DxCommon/If/Internal.h>
+
+#define VOICEBUDGET         24          // voices that really play, by default
+#define VOICEPOOLSIZE       128         // voices that play at all, real or virtual
+#define VOICEINAUDIBLE      -60.0f      // dB under which a voice is virtual, whatever the budget
+#define VOICEHYSTERESIS     3.0f        // dB a real voice is ranked above what it is, so voices do not flap
+
+namespace DirectX
+{
+
+class Sound;
+
+
+/*************************************************************************************
+ *@class VoiceManager
+ *@description
+ *    Keeps the number of sound buffers that really play under a budget. Every
+ *    play of a Sound that was handed to the VoiceManager becomes a voice. Once a
+ *    frame, update ranks the voices by the priority they were played with and
+ *    then by how loud they are, from the volume and the 3D position of their
+ *    Sound. The best ones within the budget play; the others are virtual: their
+ *    buffer is stopped and costs nothing, but the voice keeps time, so it comes
+ *    back at the right place once it ranks high enough again. A Sound whose
+ *    voices are all virtual still says it is playing.
+ *    The VoiceManager is used from the thread of the game only.
+ *************************************************************************************/
+class VoiceManager
+{
+public:
+    _dxcommon_ VoiceManager(UInt budget = VOICEBUDGET);
+    _dxcommon_ virtual ~VoiceManager( );
+
+public:
+    _dxcommon_ void     update( );
+
+    _dxcommon_ void     budget(UInt budget);
+    _dxcommon_ UInt     budget( ) const             { return m_budget;              }
+    _dxcommon_ UInt     nVoices( ) const            { return m_nVoices;             }
+    _dxcommon_ UInt     nReal( ) const              { return m_nReal;               }
+
+private:
+    friend class Sound;
+
+    struct Voice
+    {
+        Sound*          sound;
+        UInt            buffer;         // index in the buffers of the sound
+        UInt            priority;
+        Boolean         looped;
+        Boolean         real;
+        UInt            blockAlign;
+        UInt            frequency;      // of the buffer, used while the sound does not set one
+        Float           position;       // bytes into the buffer while the voice is virtual
+        Float           level;          // dB, as last ranked
+    };
+
+    UInt        freeBuffer(Sound* sound);
+    Int         play(Sound* sound, UInt buffer, UInt priority, Boolean looped);
+    void        stop(Sound* sound);
+    void        rewind(Sound* sound);
+    Boolean     playing(Sound* sound);
+
+    static Float    rank(const Voice& voice);
+    static Boolean  outranks(const Voice& a, const Voice& b);
+    Boolean     makeReal(Voice& voice);
+    void        makeVirtual(Voice& voice);
+    Boolean     advance(Voice& voice, UInt elapsed);
+    void        remove(UInt i);
+    Int         lowest(Sound* sound, Boolean realOnly);
+
+private:
+    Voice       m_voices[VOICEPOOLSIZE];
+    UInt        m_nVoices;
+    UInt        m_nReal;
+    UInt        m_budget;
+    UInt        m_lastUpdate;   // ms
+};
+
+} // namespace DirectX
+
+
+#endif /* __DXCOMMON_VOICEMANAGER_H__ */
@@ -0,0 +1,100 @@
+/**
+* DXCommon library
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#include <DxCommon/If/Common.h>
+#include <math.h>
+
+
+namespace DirectX
+{
+
+Emitter::Emitter( ) :
+    m_nSounds(0),
+    m_position(0.0f, 0.0f, 0.0f),
+    m_placed(false)
+{
+}
+
+
+Emitter::~Emitter( )
+{
+    clear( );
+}
+
+
+/*************************************************************************************
+ *@class Emitter
+ *@method
+ *    Sound* add(Sound* sound)
+ *@returns
+ *    The sound, which the emitter deletes from then on; 0 if the sound is 0 or
+ *    the emitter is full, in which case the sound is deleted at once.
+ *************************************************************************************/
+Sound*
+Emitter::add(Sound* sound)
+{
+    if (sound == 0)
+        return 0;
+    if (m_nSounds == EMITTERMAXSOUNDS)
+    {
+        DXCOMMON("(!) Emitter::add : more than %d sounds", EMITTERMAXSOUNDS);
+        SAFE_DELETE(sound);
+        return 0;
+    }
+    m_sounds[m_nSounds++] = sound;
+    if (m_placed)
+        sound->place(m_position, sqrtf(m_position.lengthSquare( )));
+    return sound;
+}
+
+
+void
+Emitter::clear( )
+{
+    for (UInt i = 0; i < m_nSounds; ++i)
+        SAFE_DELETE(m_sounds[i]);
+    m_nSounds = 0;
+    m_placed = false;
+}
+
+
+void
+Emitter::voiceManager(VoiceManager* manager)
+{
+    for (UInt i = 0; i < m_nSounds; ++i)
+        m_sounds[i]->voiceManager(manager);
+}
+
+
+void
+Emitter::position(Vector3 pos)
+{
+    if ((m_placed) && (pos.x == m_position.x) && (pos.y == m_position.y) && (pos.z == m_position.z))
+        return;
+    m_position = pos;
+    m_placed = true;
+    Float distance = sqrtf(pos.lengthSquare( ));
+    for (UInt i = 0; i < m_nSounds; ++i)
+        m_sounds[i]->place(pos, distance);
+}
+
+
+void
+Emitter::pan(Int value)
+{
+    for (UInt i = 0; i < m_nSounds; ++i)
+        m_sounds[i]->pan(value);
+}
+
+
+void
+Emitter::volume(Int value)
+{
+    for (UInt i = 0; i < m_nSounds; ++i)
+        m_sounds[i]->volume(value);
+}
+
+} // namespace DirectX
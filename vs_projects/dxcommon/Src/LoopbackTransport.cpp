@@ -0,0 +1,381 @@
+/**
+* DXCommon library
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#include <DxCommon/If/LoopbackTransport.h>
+#include <string.h>
+
+
+namespace DirectX
+{
+
+LoopbackNetwork::LoopbackNetwork(const Link& link, UInt seed) :
+    m_link(link),
+    m_seed(seed),
+    m_now(0),
+    m_server(0),
+    m_nextId(1)
+{
+    memset(&m_total, 0, sizeof(m_total));
+}
+
+
+LoopbackNetwork::~LoopbackNetwork( )
+{
+}
+
+
+void
+LoopbackNetwork::deliverToServer(UInt now)
+{
+    deliver(now, true);
+}
+
+
+void
+LoopbackNetwork::deliverToClients(UInt now)
+{
+    deliver(now, false);
+}
+
+
+LoopbackNetwork::Statistics
+LoopbackNetwork::statistics(UInt id)
+{
+    TPeerMap::iterator peer = m_peers.find(id);
+    if (peer != m_peers.end( ))
+        return (*peer).second.statistics;
+    Statistics none;
+    memset(&none, 0, sizeof(none));
+    return none;
+}
+
+
+UInt
+LoopbackNetwork::connect(LoopbackClientTransport* client)
+{
+    UInt id = m_nextId++;
+    Peer& peer = m_peers[id];
+    memset(&peer, 0, sizeof(peer));
+    peer.client = client;
+    send(id, true, kindConnect, 0, 0, true);
+    return id;
+}
+
+
+// The server hears of it after the packets the client sent before.
+void
+LoopbackNetwork::disconnect(UInt id)
+{
+    TPeerMap::iterator peer = m_peers.find(id);
+    if (peer == m_peers.end( ))
+        return;
+    (*peer).second.client = 0;
+    send(id, true, kindDisconnect, 0, 0, true);
+}
+
+
+// The bandwidth cap sends the packets of a direction one after the other;
+// each then takes the latency and some jitter to arrive.
+void
+LoopbackNetwork::send(UInt id, Boolean toServer, Kind kind, const void* buffer, UInt size, Boolean secure)
+{
+    TPeerMap::iterator it = m_peers.find(id);
+    if (it == m_peers.end( ))
+        return;
+    Peer& peer = (*it).second;
+    Direction& direction = (toServer) ? peer.up : peer.down;
+    Double start = (direction.busyUntil > m_now) ? direction.busyUntil : Double(m_now);
+    if ((!secure) && (start - m_now > LOOPBACK_MAXQUEUE))
+    {
+        ++peer.statistics.packetsDropped;
+        ++m_total.packetsDropped;
+        return;
+    }
+    if (m_link.bandwidth > 0)
+        direction.busyUntil = start + Double(size) * 1000.0 / m_link.bandwidth;
+    else
+        direction.busyUntil = start;
+    if (toServer)
+    {
+        peer.statistics.bytesToServer += size;
+        ++peer.statistics.packetsToServer;
+        m_total.bytesToServer += size;
+        ++m_total.packetsToServer;
+    }
+    else
+    {
+        peer.statistics.bytesToClient += size;
+        ++peer.statistics.packetsToClient;
+        m_total.bytesToClient += size;
+        ++m_total.packetsToClient;
+    }
+
+    Double arrival = direction.busyUntil + m_link.latency + nextRandom(m_link.jitter + 1);
+    if (secure)
+    {
+        while (chance(m_link.loss))
+            arrival += 2*m_link.latency + m_link.jitter;
+        if (arrival < direction.lastSecure)
+            arrival = direction.lastSecure;
+        direction.lastSecure = arrival;
+    }
+    else
+    {
+        if (chance(m_link.loss))
+        {
+            ++peer.statistics.packetsLost;
+            ++m_total.packetsLost;
+            return;
+        }
+        if (chance(m_link.reorder))
+            arrival += m_link.latency + m_link.jitter;
+    }
+    Packet packet;
+    packet.id       = id;
+    packet.toServer = toServer;
+    packet.kind     = kind;
+    packet.secure   = secure;
+    packet.sequence = (secure) ? 0 : direction.nextSequence++;
+    if (size > 0)
+        packet.data.assign((const UByte*)buffer, (const UByte*)buffer + size);
+    m_inFlight.insert(TPacketMap::value_type(arrival, packet));
+}
+
+
+// Takes out everything that arrived before it calls anyone, as they send
+// packets of their own.
+void
+LoopbackNetwork::deliver(UInt now, Boolean toServer)
+{
+    m_now = now;
+    std::vector<Packet> arrived;
+    TPacketMap::iterator it = m_inFlight.begin( );
+    while ((it != m_inFlight.end( )) && ((*it).first <= now))
+    {
+        if ((*it).second.toServer == toServer)
+        {
+            arrived.push_back((*it).second);
+            m_inFlight.erase(it++);
+        }
+        else
+            ++it;
+    }
+
+    for (UInt i = 0; i < arrived.size( ); ++i)
+    {
+        Packet& packet = arrived[i];
+        TPeerMap::iterator peer = m_peers.find(packet.id);
+        if (peer == m_peers.end( ))
+            continue;
+        Direction& direction = (toServer) ? (*peer).second.up : (*peer).second.down;
+        if (!packet.secure)
+        {
+            if ((direction.delivered) && (Int(packet.sequence - direction.lastDelivered) < 0))
+            {
+                ++(*peer).second.statistics.packetsOvertaken;
+                ++m_total.packetsOvertaken;
+                continue;
+            }
+            direction.lastDelivered = packet.sequence;
+            direction.delivered = true;
+        }
+        void* data = (packet.data.empty( )) ? 0 : &packet.data[0];
+        if (toServer)
+        {
+            IServer* server = (m_server) ? m_server->m_iServer : 0;
+            switch (packet.kind)
+            {
+                case kindConnect :
+                    (*peer).second.added = true;
+                    if (server)
+                        server->onAddConnection(packet.id);
+                    break;
+                case kindDisconnect :
+                    m_peers.erase(peer);
+                    if (server)
+                        server->onRemoveConnection(packet.id);
+                    break;
+                default :
+                    if ((server) && ((*peer).second.added))
+                        server->onPacket(packet.id, data, UInt(packet.data.size( )));
+                    break;
+            }
+        }
+        else
+        {
+            LoopbackClientTransport* client = (*peer).second.client;
+            if ((client) && (client->m_iClient))
+                client->m_iClient->onPacket(0, data, UInt(packet.data.size( )));
+        }
+    }
+}
+
+
+Boolean
+LoopbackNetwork::chance(Float p)
+{
+    return (p > 0.0f) && (Float(nextRandom(10000)) < p * 10000.0f);
+}
+
+
+// The generator of the C library, but with our own seed, so the same seed
+// always gives the same network.
+UInt
+LoopbackNetwork::nextRandom(UInt max)
+{
+    m_seed = m_seed * 1103515245 + 12345;
+    return (max == 0) ? 0 : ((m_seed >> 16) & 0x7fff) % max;
+}
+
+
+
+LoopbackServerTransport::LoopbackServerTransport(LoopbackNetwork& network) :
+    m_network(network),
+    m_iServer(0),
+    m_application(0)
+{
+    m_name[0] = '\0';
+}
+
+
+LoopbackServerTransport::~LoopbackServerTransport( )
+{
+    stopSession( );
+}
+
+
+Boolean
+LoopbackServerTransport::startSession(const Char* name, UInt port)
+{
+    if ((m_network.m_server) && (m_network.m_server != this))
+        return false;
+    strncpy(m_name, name, sizeof(m_name) - 1);
+    m_name[sizeof(m_name) - 1] = '\0';
+    m_network.m_server = this;
+    return true;
+}
+
+
+void
+LoopbackServerTransport::stopSession( )
+{
+    if (m_network.m_server != this)
+        return;
+    m_network.m_server = 0;
+    LoopbackNetwork::TPeerMap::iterator it;
+    for (it = m_network.m_peers.begin( ); it != m_network.m_peers.end( ); ++it)
+    {
+        LoopbackClientTransport* client = (*it).second.client;
+        if ((client) && (client->m_iClient))
+        {
+            client->m_id = 0;
+            client->m_iClient->onSessionLost( );
+        }
+    }
+    m_network.m_peers.clear( );
+}
+
+
+void
+LoopbackServerTransport::sendPacket(UInt to, void* buffer, UInt size, Boolean secure)
+{
+    m_network.send(to, false, LoopbackNetwork::kindData, buffer, size, secure);
+}
+
+
+
+LoopbackClientTransport::LoopbackClientTransport(LoopbackNetwork& network) :
+    m_network(network),
+    m_iClient(0),
+    m_application(0),
+    m_id(0)
+{
+}
+
+
+LoopbackClientTransport::~LoopbackClientTransport( )
+{
+    finalize( );
+}
+
+
+Boolean
+LoopbackClientTransport::initialize( )
+{
+    return true;
+}
+
+
+void
+LoopbackClientTransport::finalize( )
+{
+    if (m_id == 0)
+        return;
+    m_network.disconnect(m_id);
+    m_id = 0;
+}
+
+
+Boolean
+LoopbackClientTransport::sendPacket(void* buffer, UInt size, Boolean secure)
+{
+    if (m_id == 0)
+        return false;
+    m_network.send(m_id, true, LoopbackNetwork::kindData, buffer, size, secure);
+    return true;
+}
+
+
+Boolean
+LoopbackClientTransport::startSessionEnum(UInt port, const Char* address)
+{
+    return true;
+}
+
+
+void
+LoopbackClientTransport::stopSessionEnum( )
+{
+}
+
+
+UInt
+LoopbackClientTransport::nSessions( )
+{
+    return (m_network.m_server) ? 1 : 0;
+}
+
+
+Boolean
+LoopbackClientTransport::sessionName(UInt i, Char* name, UInt size)
+{
+    if ((i != 0) || (m_network.m_server == 0) || (size == 0))
+        return false;
+    strncpy(name, m_network.m_server->m_name, size - 1);
+    name[size - 1] = '\0';
+    return true;
+}
+
+
+Boolean
+LoopbackClientTransport::joinSession(UInt i)
+{
+    if ((i != 0) || (m_network.m_server == 0) || (m_id != 0))
+        return false;
+    if ((m_application != 0) && (m_network.m_server->m_application != 0) && (m_application != m_network.m_server->m_application))
+        return false;
+    m_id = m_network.connect(this);
+    return true;
+}
+
+
+Boolean
+LoopbackClientTransport::joinSessionAt(UInt port, const Char* address)
+{
+    return joinSession(0);
+}
+
+} // namespace DirectX
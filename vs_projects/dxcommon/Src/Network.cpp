@@ -5,26 +5,40 @@
 * This program is distributed under the terms of the GNU General Public License version 3.
 */
 #include "DxCommon/If/Network.h"
+#include "DxCommon/If/UdpTransport.h"
 #include <tchar.h>
 
 
 namespace DirectX
 {
 
-Server::Server( ) :
+Server::Server(Transport transport) :
     m_directPlayServer(0),
     m_directPlayAddress(0),
     m_iServer(0),
+    m_transport(0),
     m_started(false)
 {
     DXCOMMON("(+) Server");
     ZeroMemory(&m_directPlayAppDesc, sizeof(DPN_APPLICATION_DESC));
+    if (transport == udp)
+        m_transport = new UdpServerTransport( );
 }
 
 
 Server::~Server( )
 {
     DXCOMMON("(-) Server");
+    SAFE_DELETE(m_transport);
+}
+
+
+void
+Server::setIServer(IServer* server)
+{
+    m_iServer = server;
+    if (m_transport)
+        m_transport->setIServer(server);
 }
 
 
@@ -36,6 +50,14 @@ Server::startSession(Char* name, UInt port)
 
     DXCOMMON("Server::startSession(%s, %d)", name, port);
 
+    if (m_transport)
+    {
+        m_transport->setApplication(m_applicationGUID.Data1);
+        if (!m_transport->startSession(name, port))
+            return dxFailed;
+        m_started = true;
+        return dxSuccess;
+    }
 
     HRESULT hr;
     if (FAILED(hr = CoCreateInstance(CLSID_DirectPlay8Server,
@@ -117,6 +139,9 @@ Server::startSession(Char* name, UInt port)
 void
 Server::stopSession( )
 {
+    if (m_transport)
+        m_transport->stopSession( );
+
     if (m_directPlayServer != 0)
         m_directPlayServer->Close(0);
 
@@ -132,6 +157,12 @@ Server::stopSession( )
 void
 Server::sendPacket(UInt to, void* buffer, UInt size, Boolean secure, UInt timeout)
 {
+    if (m_transport)
+    {
+        m_transport->sendPacket(to, buffer, size, secure);
+        return;
+    }
+
     DPNHANDLE       hAsync;
     DPNHANDLE*      phAsync;
     DWORD           dwFlags = 0;
@@ -248,19 +279,32 @@ Server::localMessageHandler(/* void* context, */
 
 
 
-Client::Client( ) : 
+Client::Client(Transport transport) : 
     m_directPlayClient(NULL),
     m_iClient(NULL),
+    m_transport(NULL),
     m_directPlayEnumHandle(NULL),
     m_nSessions(0)
 {
     DXCOMMON("(+) Client");
+    if (transport == udp)
+        m_transport = new UdpClientTransport( );
 }    
 
 
 Client::~Client( )
 {
     DXCOMMON("(-) Client");
+    SAFE_DELETE(m_transport);
+}
+
+
+void
+Client::setIClient(IClient* client)
+{
+    m_iClient = client;
+    if (m_transport)
+        m_transport->setIClient(client);
 }
 
 
@@ -268,6 +312,12 @@ Int
 Client::initialize( )
 {
     DXCOMMON("Client::initialize");
+    if (m_transport)
+    {
+        m_transport->setApplication(m_applicationGUID.Data1);
+        return (m_transport->initialize( )) ? dxSuccess : dxFailed;
+    }
+
     HRESULT hr;
     if (FAILED(hr = CoCreateInstance(CLSID_DirectPlay8Client, NULL, 
                                      CLSCTX_ALL, IID_IDirectPlay8Client,
@@ -297,6 +347,11 @@ Int
 Client::finalize( )
 {
     DXCOMMON("Client::finalize");
+    if (m_transport)
+    {
+        m_transport->finalize( );
+        return dxSuccess;
+    }
     /*
     for( DWORD dwIndex = 0; dwIndex < MAX_SESSIONS; dwIndex++ )
     {
@@ -325,6 +380,9 @@ Int
 Client::sendPacket(void* buffer, UInt size, 
                    Boolean secure, UInt timeout)
 {
+    if (m_transport)
+        return (m_transport->sendPacket(buffer, size, secure)) ? dxSuccess : dxFailed;
+
     if (m_directPlayClient == NULL)
     {
         DXCOMMON("(!) Client::sendPacket : DirectPlay client not initialized");
@@ -370,6 +428,9 @@ Int
 Client::startSessionEnum(UInt port, const Char* ipaddress) 
 {
     DXCOMMON("Client::startSessionEnum");
+    if (m_transport)
+        return (m_transport->startSessionEnum(port, ipaddress)) ? dxSuccess : dxFailed;
+
     if (m_directPlayClient == NULL)
     {
         DXCOMMON("(!) Client::startSessionEnum : DirectPlay client not initialized");
@@ -481,6 +542,12 @@ Client::startSessionEnum(UInt port, const Char* ipaddress)
 Int Client::stopSessionEnum( )
 {
     DXCOMMON("Client::stopSessionEnum");
+    if (m_transport)
+    {
+        m_transport->stopSessionEnum( );
+        return dxSuccess;
+    }
+
     if (m_directPlayClient == NULL)
     {
         DXCOMMON("(!) Client::stopSessionEnum : not initialized");
@@ -563,9 +630,24 @@ Client::sessionEnumCallback(const DPN_APPLICATION_DESC* appDesc,
 }
 
 
+UInt
+Client::nSessions( )
+{
+    if (m_transport)
+        return m_transport->nSessions( );
+    return m_nSessions;
+}
+
+
 Int
 Client::session(UInt i, SessionInfo& info)
 {
+    if (m_transport)
+    {
+        ZeroMemory(&info, sizeof(SessionInfo));
+        return (m_transport->sessionName(i, info.sessionName, MAX_PATH)) ? dxSuccess : dxFailed;
+    }
+
     if (i >= m_nSessions)
         return dxFailed;
     info.appDesc = m_sessions[i].appDesc;
@@ -578,6 +660,8 @@ Int
 Client::joinSession(UInt i)
 {
     DXCOMMON("Client::joinSession %d", i);
+    if (m_transport)
+        return (m_transport->joinSession(i)) ? dxSuccess : dxFailed;
     
     HRESULT hr;
     // IDirectPlay8Address* hostAddress = NULL;
@@ -636,6 +720,8 @@ Int
 Client::joinSessionAt(UInt port, const Char* ipaddress)
 {
     DXCOMMON("Client::joinSessionAt : port = %d, address = %s", port, ipaddress);
+    if (m_transport)
+        return (m_transport->joinSessionAt(port, ipaddress)) ? dxSuccess : dxFailed;
 
     Mutex::Guard guard(m_mutex);
     
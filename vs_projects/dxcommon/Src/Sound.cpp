@@ -7,6 +7,12 @@
 #include <DxCommon/If/Common.h>
 #include <Common/If/Algorithm.h>  // minimum, maximum
 #include <dxerr8.h>
+#include <math.h>
+
+#define SOUNDCACHELIMIT (16*1024*1024)
+#define STREAMSEGMENTS 4
+#define STREAMSEGMENTTIME 250   // milliseconds of sound per segment
+#define STREAMPOLLTIME 50       // milliseconds between refills of the streams
 
 
 
@@ -29,7 +35,16 @@ SoundManager::SoundManager(::Window::Handle handle, UInt nChannels, UInt frequen
     m_created(true),
     m_playInSoftware(false),
     m_reverseStereo(false),
-    m_3dAlgorithm(AlgoFullHrtf)
+    m_3dAlgorithm(AlgoFullHrtf),
+    m_cache(0),
+    m_cacheClock(0),
+    m_cacheLimit(SOUNDCACHELIMIT),
+    m_streams(0),
+    m_streamThread(0),
+    m_streamStop(0),
+    m_changed(0),
+    m_listener(0),
+    m_listenerTried(false)
 {
 	DXCOMMON("(+) SoundManager : %d channels, %d freq, %d bitrate", nChannels, frequency, bitrate);
     // m_directSound = 0;
@@ -73,11 +88,86 @@ SoundManager::SoundManager(::Window::Handle handle, UInt nChannels, UInt frequen
 SoundManager::~SoundManager()
 {
     DXCOMMON("(-) SoundManager");
+    if (m_streamThread)
+    {
+        SetEvent(m_streamStop);
+        WaitForSingleObject(m_streamThread, INFINITE);
+        CloseHandle(m_streamThread);
+    }
+    if (m_streamStop)
+        CloseHandle(m_streamStop);
+    if (m_streams)
+        DXCOMMON("(!) ~SoundManager : streams still in use");
+    while (m_cache)
+    {
+        CachedSound* cached = m_cache;
+        m_cache = cached->next;
+        if (cached->users > 0)
+            DXCOMMON("(!) ~SoundManager : %s still used by %d sounds", cached->name, cached->users);
+        SAFE_DELETE(cached->master);
+        SAFE_DELETE(cached);
+    }
+    SAFE_RELEASE(m_listener);
     SAFE_RELEASE(m_directSound); 
 }
 
 
 
+/*************************************************************************************
+ *@class SoundManager
+ *@method
+ *    void commit( )
+ *@description
+ *    Writes what was set on the sounds since the last commit to their buffers,
+ *    and then commits all the 3D positions at once, so DirectSound remixes once
+ *    instead of after every one. Called once a frame.
+ *************************************************************************************/
+void
+SoundManager::commit( )
+{
+    Boolean deferred = false;
+    while (m_changed)
+    {
+        Sound* sound = m_changed;
+        m_changed = sound->m_nextChanged;
+        sound->m_nextChanged = 0;
+        sound->m_listed = false;
+        if (sound->apply((sound->m_buffer3D != 0) && (listener3D( ) != 0)))
+            deferred = true;
+    }
+    if (deferred)
+        m_listener->CommitDeferredSettings( );
+}
+
+
+void
+SoundManager::unlist(Sound* sound)
+{
+    Sound** link = &m_changed;
+    while ((*link) && (*link != sound))
+        link = &(*link)->m_nextChanged;
+    if (*link)
+        *link = sound->m_nextChanged;
+    sound->m_listed = false;
+}
+
+
+// The listener is only asked for once; without one, 3D positions are
+// applied at once.
+LPDIRECTSOUND3DLISTENER
+SoundManager::listener3D( )
+{
+    if (!m_listenerTried)
+    {
+        m_listenerTried = true;
+        if (listener3DInterface(&m_listener) != dxSuccess)
+            m_listener = 0;
+    }
+    return m_listener;
+}
+
+
+
 /*************************************************************************************
  *@class SoundManager
  *@method
@@ -205,9 +295,16 @@ Sound* SoundManager::create(Int resource, Boolean enable3d, UInt nBuffers)
  *@description
  *    This method of the SoundManager is the reason for it's existence. This method
  *    will perform the necessary actions to load a WaveFile and make a Sound object 
- *    out of it, ready-to-play.    
+ *    out of it, ready-to-play. A file is only loaded the first time, after that
+ *    the new Sound shares the data of the earlier ones.
  *************************************************************************************/
 Sound* SoundManager::create(Char* filename, Boolean enable3d, UInt nBuffers)
+{
+    return createCached(filename, enable3d, nBuffers, false);
+}
+
+
+Sound* SoundManager::load(Char* filename, Boolean enable3d, UInt nBuffers)
 {
     HRESULT res;
     // Int     result = dxSuccess;
@@ -329,6 +426,78 @@ Sound* SoundManager::create(Char* filename, Boolean enable3d, UInt nBuffers)
     return sound;
 }
 
+/*************************************************************************************
+ *@class SoundManager
+ *@method
+ *    Sound* loadPacked(const SoundPackEntry* entry, Boolean enable3d, UInt nBuffers)
+ *@description
+ *    Like load, but the sound is already decoded in the mapped pack, so there is no
+ *    file to open and the data is copied straight into the buffer. The buffer gets
+ *    the flags of a wave file, which has every control a decoded file has.
+ *************************************************************************************/
+Sound* SoundManager::loadPacked(const SoundPackEntry* entry, Boolean enable3d, UInt nBuffers)
+{
+    if (m_directSound == 0)
+        return 0;
+    if (nBuffers < 1)
+        return 0;
+
+    WAVEFORMATEX waveFormat;
+    SoundPack::format(entry, waveFormat);
+    DSBUFFERDESC bufferDesc;
+    ZeroMemory(&bufferDesc, sizeof(DSBUFFERDESC));
+    bufferDesc.dwSize          = sizeof(DSBUFFERDESC);
+    if (enable3d)
+        bufferDesc.dwFlags = DSBCAPS_CTRL3D | DSBCAPS_CTRLFREQUENCY | DSBCAPS_LOCDEFER;
+    else
+        bufferDesc.dwFlags = DSBCAPS_GLOBALFOCUS | DSBCAPS_CTRLPAN | DSBCAPS_CTRLVOLUME | DSBCAPS_CTRLFREQUENCY | DSBCAPS_LOCDEFER;
+    bufferDesc.dwBufferBytes   = entry->size;
+    bufferDesc.guid3DAlgorithm = GUID_NULL;
+    if (enable3d)
+    {
+        switch (m_3dAlgorithm)
+        {
+        case AlgoNoVirtualization:
+            bufferDesc.guid3DAlgorithm = DS3DALG_NO_VIRTUALIZATION;
+            break;
+        case AlgoFullHrtf:
+            bufferDesc.guid3DAlgorithm = DS3DALG_HRTF_FULL;
+            break;
+        case AlgoLightHrtf:
+            bufferDesc.guid3DAlgorithm = DS3DALG_HRTF_LIGHT;
+            break;
+        }
+    }
+    bufferDesc.lpwfxFormat     = &waveFormat;
+
+    LPDIRECTSOUNDBUFFER* buffer = new LPDIRECTSOUNDBUFFER[nBuffers];
+    HRESULT res = m_directSound->CreateSoundBuffer(&bufferDesc, &buffer[0], NULL);
+    if (FAILED(res))
+    {
+        DXCOMMON("(!) SoundManager::loadPacked : Error 0x%x creating soundbuffer. (%s)", res, DXGetErrorDescription8(res));
+        SAFE_DELETE_ARRAY(buffer);
+        return 0;
+    }
+    for (UInt i = 1; i < nBuffers; ++i)
+    {
+        if (FAILED(m_directSound->DuplicateSoundBuffer(buffer[0], &buffer[i])))
+        {
+            DXCOMMON("(!) SoundManager::loadPacked : Error duplicating the soundbuffer for the %dth time.", i);
+            for (UInt j = 0; j < i; ++j)
+                SAFE_RELEASE(buffer[j]);
+            SAFE_DELETE_ARRAY(buffer);
+            return 0;
+        }
+    }
+
+    Sound* sound = new Sound(buffer, entry->size, nBuffers, &waveFormat, m_pack.data(entry));
+    sound->playInSoftware(m_playInSoftware);
+    sound->reverseStereo(m_reverseStereo);
+    SAFE_DELETE_ARRAY(buffer);
+    return sound;
+}
+
+
 Sound* SoundManager::create(DSBUFFERDESC& bufferDesc, Boolean enable3d, UInt nBuffers)
 {
     HRESULT res;
@@ -425,6 +594,88 @@ Sound* SoundManager::create(DSBUFFERDESC& bufferDesc, Boolean enable3d, UInt nBu
 
 #ifdef _USE_VORBIS_
 Sound* SoundManager::createVorbis(Char* filename, Boolean enable3d, UInt nBuffers)
+{
+    return createCached(filename, enable3d, nBuffers, true);
+}
+
+
+/*************************************************************************************
+ *@class SoundManager
+ *@method
+ *    Sound* createVorbisStream(Char* filename, Boolean enable3d)
+ *@description
+ *    Creates a Sound that decodes the file while it plays, instead of holding all
+ *    of it in memory. Meant for music and other long sounds. A streamed sound has
+ *    a single buffer and is never shared, so copyBuffer only sees the part of the
+ *    file that is currently buffered.
+ *************************************************************************************/
+Sound* SoundManager::createVorbisStream(Char* filename, Boolean enable3d)
+{
+    HRESULT res;
+    LPDIRECTSOUNDBUFFER buffer = 0;
+
+    if (m_directSound == 0)
+        return 0;
+    if (filename == 0)
+        return 0;
+
+    SoundStream* stream = new SoundStream( );
+    if (!stream->open(filename))
+    {
+        DXCOMMON("(!) SoundManager::createVorbisStream : could not open %s", filename);
+        SAFE_DELETE(stream);
+        return 0;
+    }
+
+    DSBUFFERDESC bufferDesc;
+    ZeroMemory(&bufferDesc, sizeof(DSBUFFERDESC));
+    bufferDesc.dwSize          = sizeof(DSBUFFERDESC);
+    if (enable3d)
+        bufferDesc.dwFlags = DSBCAPS_CTRL3D | DSBCAPS_LOCDEFER;
+    else
+        bufferDesc.dwFlags = DSBCAPS_GLOBALFOCUS | DSBCAPS_CTRLPAN | DSBCAPS_CTRLVOLUME | DSBCAPS_LOCDEFER;
+    // the stream thread follows the play cursor
+    bufferDesc.dwFlags        |= DSBCAPS_GETCURRENTPOSITION2;
+    bufferDesc.dwBufferBytes   = stream->bufferSize( );
+    bufferDesc.guid3DAlgorithm = GUID_NULL;
+    if (enable3d)
+    {
+        switch (m_3dAlgorithm)
+        {
+        case AlgoDefault:
+            bufferDesc.guid3DAlgorithm = GUID_NULL;
+            break;
+        case AlgoNoVirtualization:
+            bufferDesc.guid3DAlgorithm = DS3DALG_NO_VIRTUALIZATION;
+            break;
+        case AlgoFullHrtf:
+            bufferDesc.guid3DAlgorithm = DS3DALG_HRTF_FULL;
+            break;
+        case AlgoLightHrtf:
+            bufferDesc.guid3DAlgorithm = DS3DALG_HRTF_LIGHT;
+            break;
+        }
+    }
+    bufferDesc.lpwfxFormat     = stream->waveFormat( );
+
+    res = m_directSound->CreateSoundBuffer(&bufferDesc, &buffer, NULL);
+    if (FAILED(res))
+    {
+        DXCOMMON("(!) SoundManager::createVorbisStream : Error 0x%x creating soundbuffer. (%s)", res, DXGetErrorDescription8(res));
+        SAFE_DELETE(stream);
+        return 0;
+    }
+    stream->attach(buffer);
+
+    Sound* sound = new Sound(buffer, this, stream);
+    sound->playInSoftware(m_playInSoftware);
+    sound->reverseStereo(m_reverseStereo);
+    addStream(stream);
+    return sound;
+}
+
+
+Sound* SoundManager::loadVorbis(Char* filename, Boolean enable3d, UInt nBuffers)
 {
     HRESULT res;
     Int     result = dxSuccess;
@@ -559,6 +810,278 @@ Sound* SoundManager::createVorbis(Char* filename, Boolean enable3d, UInt nBuffer
 
 
 
+/*************************************************************************************
+ *@class SoundManager
+ *@method
+ *    Sound* createCached(Char* filename, Boolean enable3d, UInt nBuffers, Boolean vorbis)
+ *@description
+ *    Looks the file up in the cache, loading it into a new master Sound the first
+ *    time, and hands out a Sound with buffers duplicated from that master. If the
+ *    buffers can't be duplicated, the file is loaded into a Sound of its own.
+ *************************************************************************************/
+Sound* SoundManager::createCached(Char* filename, Boolean enable3d, UInt nBuffers, Boolean vorbis)
+{
+    if (m_directSound == 0)
+        return 0;
+    if (filename == 0 || nBuffers < 1)
+        return 0;
+    if (strlen(filename) >= MAX_PATH)
+        return loadFile(filename, enable3d, nBuffers, vorbis);
+
+    CachedSound* cached = prefetch(filename, enable3d, vorbis);
+    if (cached == 0)
+        return 0;
+    Sound* sound = duplicate(cached, nBuffers);
+    release(cached);
+    if (sound == 0)
+    {
+        DXCOMMON("(!) SoundManager::createCached : could not share %s, loading a copy", filename);
+        return loadFile(filename, enable3d, nBuffers, vorbis);
+    }
+    return sound;
+}
+
+
+/*************************************************************************************
+ *@class SoundManager
+ *@method
+ *    CachedSound* prefetch(Char* filename, Boolean enable3d, Boolean vorbis)
+ *@returns
+ *    The cache entry of the file, or 0 if it could not be loaded.
+ *@description
+ *    Makes sure the file is in the cache, without creating a Sound for it. The
+ *    entry counts as used until it is handed back to release, so it can't be
+ *    trimmed in the meantime. This may be called from any thread; the file is
+ *    decoded outside the cache lock, so several threads can load at once.
+ *************************************************************************************/
+SoundManager::CachedSound* SoundManager::prefetch(Char* filename, Boolean enable3d, Boolean vorbis)
+{
+    if (m_directSound == 0)
+        return 0;
+    if ((filename == 0) || (strlen(filename) >= MAX_PATH))
+        return 0;
+
+    CachedSound* cached;
+    {
+        Mutex::Guard guard(m_cacheMutex);
+        cached = findCached(filename, enable3d, vorbis);
+        if (cached)
+        {
+            ++cached->users;
+            cached->lastUsed = ++m_cacheClock;
+            return cached;
+        }
+    }
+
+    Sound* master = loadFile(filename, enable3d, 1, vorbis);
+    if (master == 0)
+        return 0;
+
+    Mutex::Guard guard(m_cacheMutex);
+    cached = findCached(filename, enable3d, vorbis);
+    if (cached)
+    {
+        // another thread loaded the same file in the meantime
+        SAFE_DELETE(master);
+    }
+    else
+    {
+        cached = new CachedSound;
+        strcpy(cached->name, filename);
+        cached->enable3d = enable3d;
+        cached->vorbis   = vorbis;
+        cached->master   = master;
+        cached->users    = 0;
+        cached->lastUsed = 0;
+        cached->next     = m_cache;
+        m_cache = cached;
+    }
+    ++cached->users;
+    cached->lastUsed = ++m_cacheClock;
+    return cached;
+}
+
+
+SoundManager::CachedSound* SoundManager::prefetch(Int resource, Boolean enable3d)
+{
+    Char resourceName[128];
+    sprintf(resourceName, "#%d", resource);
+    return prefetch(resourceName, enable3d, false);
+}
+
+
+SoundManager::CachedSound* SoundManager::findCached(Char* filename, Boolean enable3d, Boolean vorbis)
+{
+    CachedSound* cached = m_cache;
+    while ((cached) && ((cached->enable3d != enable3d) || (cached->vorbis != vorbis) || (_stricmp(cached->name, filename) != 0)))
+        cached = cached->next;
+    return cached;
+}
+
+
+Sound* SoundManager::loadFile(Char* filename, Boolean enable3d, UInt nBuffers, Boolean vorbis)
+{
+    const SoundPackEntry* entry = m_pack.find(filename);
+    if (entry)
+        return loadPacked(entry, enable3d, nBuffers);
+#ifdef _USE_VORBIS_
+    if (vorbis)
+        return loadVorbis(filename, enable3d, nBuffers);
+#endif
+    return load(filename, enable3d, nBuffers);
+}
+
+
+Sound* SoundManager::duplicate(CachedSound* cached, UInt nBuffers)
+{
+    Mutex::Guard guard(m_cacheMutex);
+    LPDIRECTSOUNDBUFFER* buffer = new LPDIRECTSOUNDBUFFER[nBuffers];
+    for (UInt i = 0; i < nBuffers; ++i)
+    {
+        if (FAILED(m_directSound->DuplicateSoundBuffer(cached->master->buffer()[0], &buffer[i])))
+        {
+            DXCOMMON("(!) SoundManager::duplicate : Error duplicating the soundbuffer of %s.", cached->name);
+            for (UInt j = 0; j < i; ++j)
+                SAFE_RELEASE(buffer[j]);
+            SAFE_DELETE_ARRAY(buffer);
+            return 0;
+        }
+    }
+    ++cached->users;
+    cached->lastUsed = ++m_cacheClock;
+    Sound* sound = new Sound(buffer, nBuffers, this, cached);
+    sound->playInSoftware(m_playInSoftware);
+    sound->reverseStereo(m_reverseStereo);
+    SAFE_DELETE_ARRAY(buffer);
+    return sound;
+}
+
+
+void SoundManager::release(CachedSound* cached)
+{
+    Mutex::Guard guard(m_cacheMutex);
+    if (cached->users > 0)
+        --cached->users;
+    if (cached->users == 0)
+        trimCache( );
+}
+
+
+/*************************************************************************************
+ *@class SoundManager
+ *@method
+ *    void trimCache( )
+ *@description
+ *    Unused sounds stay in the cache, so the menu and the levels find their sounds
+ *    again when they are recreated. When the unused sounds take more than the cache
+ *    limit, the ones that were used longest ago are released.
+ *************************************************************************************/
+void SoundManager::trimCache( )
+{
+    Mutex::Guard guard(m_cacheMutex);
+    for (;;)
+    {
+        UInt unused = 0;
+        CachedSound* oldest = 0;
+        for (CachedSound* cached = m_cache; cached; cached = cached->next)
+        {
+            if (cached->users > 0)
+                continue;
+            unused += cached->master->bufferSize( );
+            if ((oldest == 0) || (cached->lastUsed < oldest->lastUsed))
+                oldest = cached;
+        }
+        if ((oldest == 0) || (unused <= m_cacheLimit))
+            return;
+        CachedSound** link = &m_cache;
+        while (*link != oldest)
+            link = &(*link)->next;
+        *link = oldest->next;
+        SAFE_DELETE(oldest->master);
+        SAFE_DELETE(oldest);
+    }
+}
+
+
+#ifdef _USE_VORBIS_
+void SoundManager::addStream(SoundStream* stream)
+{
+    Mutex::Guard guard(m_streamMutex);
+    stream->m_next = m_streams;
+    m_streams = stream;
+    if (m_streamThread == 0)
+    {
+        m_streamStop   = CreateEvent(0, TRUE, FALSE, 0);
+        m_streamThread = CreateThread(0, 0, streamThread, this, 0, 0);
+        if (m_streamThread == 0)
+            DXCOMMON("(!) SoundManager::addStream : failed to start the stream thread.");
+        else
+            SetThreadPriority(m_streamThread, THREAD_PRIORITY_ABOVE_NORMAL);
+    }
+}
+
+
+void SoundManager::removeStream(SoundStream* stream)
+{
+    Mutex::Guard guard(m_streamMutex);
+    SoundStream** link = &m_streams;
+    while ((*link) && (*link != stream))
+        link = &(*link)->m_next;
+    if (*link)
+        *link = stream->m_next;
+}
+
+
+DWORD WINAPI SoundManager::streamThread(LPVOID param)
+{
+    SoundManager* manager = (SoundManager*) param;
+    while (WaitForSingleObject(manager->m_streamStop, STREAMPOLLTIME) == WAIT_TIMEOUT)
+    {
+        Mutex::Guard guard(manager->m_streamMutex);
+        for (SoundStream* stream = manager->m_streams; stream; stream = stream->m_next)
+            stream->update( );
+    }
+    return 0;
+}
+#endif
+
+
+/*************************************************************************************
+ *@class SoundManager
+ *@method
+ *    Boolean openPack(const Char* filename)
+ *@returns
+ *    true if the pack could be opened.
+ *@description
+ *    From then on, a file that is in the pack is created from it rather than read
+ *    and decoded, whether it is asked for as a wave or an Ogg Vorbis file; other
+ *    files are still loaded from disk. Sounds point into the pack, so it can only
+ *    be opened once, and stays open until the SoundManager is deleted. Open it
+ *    before the sounds are loaded, or the cache keeps the copies read from disk.
+ *************************************************************************************/
+Boolean SoundManager::openPack(const Char* filename)
+{
+    if (m_pack.opened( ))
+    {
+        DXCOMMON("(!) SoundManager::openPack : a pack is open already");
+        return false;
+    }
+    return m_pack.open(filename);
+}
+
+
+void SoundManager::flushCache( )
+{
+    Mutex::Guard guard(m_cacheMutex);
+    UInt limit = m_cacheLimit;
+    m_cacheLimit = 0;
+    trimCache( );
+    m_cacheLimit = limit;
+}
+
+
+
+
 
 /*************************************************************************************
  *@class Sound
@@ -574,7 +1097,23 @@ Sound::Sound( LPDIRECTSOUNDBUFFER* buffer, UInt bufferSize,
     m_reverseStereo(1),
     // calculate the length of the sound
     m_length(Float(m_bufferSize)/Float(m_waveFile->m_waveFormat->nAvgBytesPerSec)),
-    m_buffer3D(0)
+    m_buffer3D(0),
+    m_manager(0),
+    m_cached(0),
+    m_stream(0),
+    m_packed(0),
+    m_voices(0),
+    m_volume(100),
+    m_distance(0.0f),
+    m_rate(0),
+    m_pan(DSBPAN_CENTER),
+    m_changes(0),
+    m_applied(0),
+    m_appliedPan(0),
+    m_appliedVolume(0),
+    m_appliedRate(0),
+    m_listed(false),
+    m_nextChanged(0)
 {
     UInt i;
     m_buffer = new LPDIRECTSOUNDBUFFER[nBuffers];
@@ -595,7 +1134,23 @@ Sound::Sound(LPDIRECTSOUNDBUFFER* buffer, UInt bufferSize, UInt nBuffers, LPWAVE
     m_reverseStereo(1),
     // calculate the length of the sound
     m_length(Float(m_bufferSize)/Float(waveFormat->nAvgBytesPerSec)),
-    m_buffer3D(0)
+    m_buffer3D(0),
+    m_manager(0),
+    m_cached(0),
+    m_stream(0),
+    m_packed(0),
+    m_voices(0),
+    m_volume(100),
+    m_distance(0.0f),
+    m_rate(0),
+    m_pan(DSBPAN_CENTER),
+    m_changes(0),
+    m_applied(0),
+    m_appliedPan(0),
+    m_appliedVolume(0),
+    m_appliedRate(0),
+    m_listed(false),
+    m_nextChanged(0)
 {
     UInt i;
     m_buffer = new LPDIRECTSOUNDBUFFER[nBuffers];
@@ -609,6 +1164,46 @@ Sound::Sound(LPDIRECTSOUNDBUFFER* buffer, UInt bufferSize, UInt nBuffers, LPWAVE
 }
 
 
+// A sound from a SoundPack: the buffer is filled from where the pack is
+// mapped, which it can be again whenever the buffer is lost.
+Sound::Sound(LPDIRECTSOUNDBUFFER* buffer, UInt bufferSize, UInt nBuffers, LPWAVEFORMATEX waveFormat, const UByte* packed) :
+    m_bufferSize(bufferSize),
+    m_nBuffers(nBuffers),
+    m_waveFile(0),
+    m_playInSoftware(false),
+    m_reverseStereo(1),
+    // calculate the length of the sound
+    m_length(Float(m_bufferSize)/Float(waveFormat->nAvgBytesPerSec)),
+    m_buffer3D(0),
+    m_manager(0),
+    m_cached(0),
+    m_stream(0),
+    m_packed(packed),
+    m_voices(0),
+    m_volume(100),
+    m_distance(0.0f),
+    m_rate(0),
+    m_pan(DSBPAN_CENTER),
+    m_changes(0),
+    m_applied(0),
+    m_appliedPan(0),
+    m_appliedVolume(0),
+    m_appliedRate(0),
+    m_listed(false),
+    m_nextChanged(0)
+{
+    UInt i;
+    m_buffer = new LPDIRECTSOUNDBUFFER[nBuffers];
+    for (i = 0; i < nBuffers; ++i)
+        m_buffer[i] = buffer[i];
+    fillBufferWithSound(m_buffer[0]);
+
+    // Rewind all buffers
+    for (i = 0; i < nBuffers; ++i)
+        m_buffer[i]->SetCurrentPosition(0);
+}
+
+
 
 #ifdef _USE_VORBIS_
 Sound::Sound(LPDIRECTSOUNDBUFFER* buffer, UInt bufferSize, UInt nBuffers,
@@ -620,7 +1215,23 @@ Sound::Sound(LPDIRECTSOUNDBUFFER* buffer, UInt bufferSize, UInt nBuffers,
     m_reverseStereo(1),
     // calculate the length of the sound
     m_length(Float(m_bufferSize)/Float(avgBytesPerSec)),
-    m_buffer3D(0)
+    m_buffer3D(0),
+    m_manager(0),
+    m_cached(0),
+    m_stream(0),
+    m_packed(0),
+    m_voices(0),
+    m_volume(100),
+    m_distance(0.0f),
+    m_rate(0),
+    m_pan(DSBPAN_CENTER),
+    m_changes(0),
+    m_applied(0),
+    m_appliedPan(0),
+    m_appliedVolume(0),
+    m_appliedRate(0),
+    m_listed(false),
+    m_nextChanged(0)
 {
     UInt i;
     m_buffer = new LPDIRECTSOUNDBUFFER[nBuffers];
@@ -635,6 +1246,73 @@ Sound::Sound(LPDIRECTSOUNDBUFFER* buffer, UInt bufferSize, UInt nBuffers,
 #endif
 
 
+Sound::Sound(LPDIRECTSOUNDBUFFER* buffer, UInt nBuffers, SoundManager* manager, SoundManager::CachedSound* cached) :
+    m_bufferSize(cached->master->bufferSize( )),
+    m_nBuffers(nBuffers),
+    m_waveFile(0),
+    m_playInSoftware(false),
+    m_reverseStereo(1),
+    m_length(cached->master->length( )),
+    m_buffer3D(0),
+    m_manager(manager),
+    m_cached(cached),
+    m_stream(0),
+    m_packed(0),
+    m_voices(0),
+    m_volume(100),
+    m_distance(0.0f),
+    m_rate(0),
+    m_pan(DSBPAN_CENTER),
+    m_changes(0),
+    m_applied(0),
+    m_appliedPan(0),
+    m_appliedVolume(0),
+    m_appliedRate(0),
+    m_listed(false),
+    m_nextChanged(0)
+{
+    UInt i;
+    m_buffer = new LPDIRECTSOUNDBUFFER[nBuffers];
+    // the duplicated buffers already hold the data of the master
+    for (i = 0; i < nBuffers; ++i)
+    {
+        m_buffer[i] = buffer[i];
+        m_buffer[i]->SetCurrentPosition(0);
+    }
+}
+
+
+Sound::Sound(LPDIRECTSOUNDBUFFER buffer, SoundManager* manager, SoundStream* stream) :
+    m_bufferSize(stream->bufferSize( )),
+    m_nBuffers(1),
+    m_waveFile(0),
+    m_playInSoftware(false),
+    m_reverseStereo(1),
+    m_length(stream->length( )),
+    m_buffer3D(0),
+    m_manager(manager),
+    m_cached(0),
+    m_stream(stream),
+    m_packed(0),
+    m_voices(0),
+    m_volume(100),
+    m_distance(0.0f),
+    m_rate(0),
+    m_pan(DSBPAN_CENTER),
+    m_changes(0),
+    m_applied(0),
+    m_appliedPan(0),
+    m_appliedVolume(0),
+    m_appliedRate(0),
+    m_listed(false),
+    m_nextChanged(0)
+{
+    // the stream has already filled the buffer with the start of the file
+    m_buffer = new LPDIRECTSOUNDBUFFER[1];
+    m_buffer[0] = buffer;
+}
+
+
 /*************************************************************************************
  *@class Sound
  *@method
@@ -642,12 +1320,25 @@ Sound::Sound(LPDIRECTSOUNDBUFFER* buffer, UInt bufferSize, UInt nBuffers,
  *************************************************************************************/
 Sound::~Sound()
 {
-    if (playing( ))
+    // a managed sound can hold voices whose buffers stopped since the last
+    // update, and playing says false for those
+    if (m_voices)
+        m_voices->stop(this);
+    else if (playing( ))
         stop( );
+    if (m_listed)
+        m_manager->unlist(this);
+#ifdef _USE_VORBIS_
+    if (m_stream)
+        m_manager->removeStream(m_stream);
+    SAFE_DELETE(m_stream);
+#endif
     for (UInt i = 0; i < m_nBuffers; ++i)
         SAFE_RELEASE(m_buffer[i]); 
     SAFE_DELETE_ARRAY(m_buffer); 
     SAFE_DELETE(m_waveFile);
+    if (m_cached)
+        m_manager->release(m_cached);
 }
 
 
@@ -673,6 +1364,10 @@ Sound::fillBufferWithSound(LPDIRECTSOUNDBUFFER buffer)
 
     if (buffer == 0)
         return dxFailed;
+    if (m_cached)
+        return m_cached->master->fillBufferWithSound(buffer);
+    if ((m_waveFile == 0) && (m_packed == 0))
+        return dxFailed;
 
     // Make sure we have focus, and we didn't just switch in from
     // an app which had a DirectSound device
@@ -691,6 +1386,14 @@ Sound::fillBufferWithSound(LPDIRECTSOUNDBUFFER buffer)
         return dxFailed;
     }
 
+    if (m_packed)
+    {
+        // already decoded, so a single copy from the mapped pack
+        CopyMemory(lockedBuffer, m_packed, minimum<UInt>(lockedBufferSize, m_bufferSize));
+        buffer->Unlock(lockedBuffer, lockedBufferSize, 0, 0);
+        return dxSuccess;
+    }
+
     // Reset the wave file to the beginning 
     m_waveFile->resetFile();
 
@@ -877,12 +1580,15 @@ Int Sound::restoreBuffer(LPDIRECTSOUNDBUFFER buffer, Boolean* wasRestored)
  *    LPDIRECTSOUNDBUFFER getFreeBuffer()
  *@returns
  *    A free SoundBuffer associated with this Sound, or, when none being available, a
- *    random one.
+ *    random one. With a VoiceManager, the buffer of the voice that ranks lowest is
+ *    taken instead of a random one.
  *************************************************************************************/
 LPDIRECTSOUNDBUFFER Sound::getFreeBuffer()
 {
     if (m_buffer == 0)
         return 0; 
+    if (m_voices)
+        return m_buffer[m_voices->freeBuffer(this)];
 
     UInt i;
     for (i = 0; i < m_nBuffers; ++i)
@@ -925,7 +1631,8 @@ Int Sound::play(UInt priority, Boolean looped)
     if (m_buffer == 0)
         return dxFailed;
 
-    LPDIRECTSOUNDBUFFER buffer = getFreeBuffer();
+    UInt index = (m_voices) ? m_voices->freeBuffer(this) : 0;
+    LPDIRECTSOUNDBUFFER buffer = (m_voices) ? m_buffer[index] : getFreeBuffer();
 
     if (buffer == 0)
     {
@@ -939,6 +1646,11 @@ Int Sound::play(UInt priority, Boolean looped)
         return dxFailed;
     }
 
+#ifdef _USE_VORBIS_
+    if (m_stream)
+        return playStream(priority, looped, restored);
+#endif
+
     if (restored)
     {
         // The buffer was restored, so we need to fill it with new data
@@ -952,6 +1664,20 @@ Int Sound::play(UInt priority, Boolean looped)
         reset();
     }
 
+    if (m_voices)
+        return m_voices->play(this, index, priority, looped);
+    return playBuffer(buffer, priority, looped);
+}
+
+
+// Starts the given buffer of this sound, whether a VoiceManager decided to
+// or the sound is not managed.
+Int Sound::playBuffer(LPDIRECTSOUNDBUFFER buffer, UInt priority, Boolean looped)
+{
+    // it starts with what was set this frame, not with what was committed
+    if (m_changes)
+        apply(false);
+
     // Set the loop flag if necessary
     UInt flags = 0;
     if (m_playInSoftware)
@@ -986,6 +1712,30 @@ Int Sound::play(UInt priority, Boolean looped)
 
 
 
+#ifdef _USE_VORBIS_
+Int Sound::playStream(UInt priority, Boolean looped, Boolean restored)
+{
+    Mutex::Guard guard(m_manager->m_streamMutex);
+    if (restored)
+        m_stream->rewind( );
+    m_stream->looped(looped);
+
+    // The buffer itself always loops, the stream decides when the sound ends
+    UInt flags = DSBPLAY_LOOPING;
+    if (m_playInSoftware)
+        flags |= DSBPLAY_LOCSOFTWARE;
+    if (FAILED(m_buffer[0]->Play(0, priority, flags)))
+    {
+        DXCOMMON("(!) Sound::playStream : failed to play the stream");
+        return dxFailed;
+    }
+    return dxSuccess;
+}
+#endif
+
+
+
+
 /*************************************************************************************
  *@class Sound
  *@method
@@ -1001,6 +1751,8 @@ Int Sound::stop()
 {
     if (m_buffer == 0)
         return dxFailed;
+    if (m_voices)
+        m_voices->stop(this);
 
     HRESULT hr = 0;
     for (UInt i = 0; i < m_nBuffers; ++i)
@@ -1028,7 +1780,17 @@ Int Sound::reset()
 {
     if (m_buffer == 0)
         return dxFailed;
+#ifdef _USE_VORBIS_
+    if (m_stream)
+    {
+        Mutex::Guard guard(m_manager->m_streamMutex);
+        m_stream->rewind( );
+        return dxSuccess;
+    }
+#endif
 
+    if (m_voices)
+        m_voices->rewind(this);
     HRESULT result = 0;
     for (UInt i = 0; i < m_nBuffers; ++i)
         result |= m_buffer[i]->SetCurrentPosition(0);
@@ -1054,6 +1816,8 @@ Boolean Sound::playing()
 {
     if (m_buffer == 0)
         return false; 
+    if (m_voices)
+        return m_voices->playing(this);
 
     Boolean playing = false;
     for (UInt i = 0; i < m_nBuffers; ++i)
@@ -1117,27 +1881,13 @@ Int Sound::initializeBuffer3D(UInt index)
  *************************************************************************************/
 void Sound::pan(Int value)
 {   
-    UInt i;
     if (value == 0)
-    {
-        for (i = 0; i < m_nBuffers; ++i)
-            if (m_buffer[i])
-                m_buffer[i]->SetPan(DSBPAN_CENTER);
-    }
+        m_pan = DSBPAN_CENTER;
     else if (value > 0)
-    {
-        for (i = 0; i < m_nBuffers; ++i)
-            if (m_buffer[i])
-                m_buffer[i]->SetPan(minimum<Int>(value, 100)* m_reverseStereo * DSBPAN_RIGHT/100);
-                //m_buffer[i]->SetPan(value*6);
-    }
-    else if (value < 0)
-    {
-        for (i = 0; i < m_nBuffers; ++i)
-            if (m_buffer[i])
-                m_buffer[i]->SetPan(maximum<Int>(value, -100)* m_reverseStereo * DSBPAN_LEFT/-100);
-                //m_buffer[i]->SetPan(value*6);
-    }
+        m_pan = minimum<Int>(value, 100)* m_reverseStereo * DSBPAN_RIGHT/100;
+    else
+        m_pan = maximum<Int>(value, -100)* m_reverseStereo * DSBPAN_LEFT/-100;
+    change(settingPan);
 }
 
 
@@ -1153,25 +1903,8 @@ void Sound::pan(Int value)
  *************************************************************************************/
 void Sound::frequency(Int value)
 {
-    UInt i;
-    if (value < DSBFREQUENCY_MIN)
-    {
-        for (i = 0; i < m_nBuffers; ++i)
-            if (m_buffer[i])
-                m_buffer[i]->SetFrequency(DSBFREQUENCY_MIN);
-    }
-    else if (value > DSBFREQUENCY_MAX)
-    {
-        for (i = 0; i < m_nBuffers; ++i)
-            if (m_buffer[i])
-                m_buffer[i]->SetFrequency(DSBFREQUENCY_MAX);
-    }
-    else
-    {
-        for (i = 0; i < m_nBuffers; ++i)
-            if (m_buffer[i])
-                m_buffer[i]->SetFrequency(value);
-    }
+    m_rate = minimum<Int>(maximum<Int>(value, DSBFREQUENCY_MIN), DSBFREQUENCY_MAX);
+    change(settingFrequency);
 }
 
 
@@ -1182,6 +1915,8 @@ void Sound::frequency(Int value)
  *************************************************************************************/
 Int Sound::frequency( )
 {
+    if (m_rate != 0)
+        return m_rate;
     DWORD freq;
     m_buffer[0]->GetFrequency(&freq);
     return (Int) freq;
@@ -1199,25 +1934,8 @@ Int Sound::frequency( )
  *************************************************************************************/
 void Sound::volume(Int value)
 {
-    UInt i;
-    if (value < 0)
-    {
-        for (i = 0; i < m_nBuffers; ++i)
-            if (m_buffer[i])
-                m_buffer[i]->SetVolume(DSBVOLUME_MIN);
-    }
-    else if (value > 100)
-    {
-        for (i = 0; i < m_nBuffers; ++i)
-            if (m_buffer[i])
-                m_buffer[i]->SetVolume(DSBVOLUME_MAX);
-    }
-    else
-    {
-        for (i = 0; i < m_nBuffers; ++i)
-            if (m_buffer[i])
-                m_buffer[i]->SetVolume(DSBVOLUME_MIN + (value * (DSBVOLUME_MAX - DSBVOLUME_MIN) / 100));
-    }
+    m_volume = minimum<Int>(maximum<Int>(value, 0), 100);
+    change(settingVolume);
 }
 
 /*************************************************************************************
@@ -1227,9 +1945,7 @@ void Sound::volume(Int value)
  *************************************************************************************/
 Int Sound::volume( )
 {
-    long vol;
-    m_buffer[0]->GetVolume(&vol);
-    return Int((vol / 100.0L) + 100.0L);
+    return m_volume;
 }
 
 /* Float 
@@ -1241,14 +1957,120 @@ Sound::length( )
 void 
 Sound::position(Vector3 pos)
 {
-    DWORD applyFlag = DS3D_IMMEDIATE;
+    place(pos, sqrtf(pos.lengthSquare( )));
+}
+
+
+// The distance is that of pos to the listener, which an Emitter works out
+// once for all its sounds.
+void
+Sound::place(const Vector3& pos, Float distance)
+{
     m_parameters.vPosition.x = pos.x;
     m_parameters.vPosition.y = pos.y;
     m_parameters.vPosition.z = pos.z;
-    
-    m_buffer3D->SetPosition(pos.x, pos.y, pos.z, applyFlag);
+    m_distance = distance;
+    change(settingPosition);
+}
+
+
+// A sound of a SoundManager waits for it to commit; any other sound has
+// no one to wait for.
+void
+Sound::change(UInt setting)
+{
+    m_changes |= setting;
+    if (m_manager == 0)
+        apply(false);
+    else if (!m_listed)
+    {
+        m_listed = true;
+        m_nextChanged = m_manager->m_changed;
+        m_manager->m_changed = this;
+    }
 }
 
+
+/*************************************************************************************
+ *@class Sound
+ *@method
+ *    Boolean apply(Boolean deferred)
+ *@returns
+ *    - true : if the 3D position was deferred, to be committed by the listener
+ *    - false : otherwise
+ *@description
+ *    Writes the settings made since the last time to the buffers, leaving out
+ *    the ones that have the value the buffers already have.
+ *************************************************************************************/
+Boolean
+Sound::apply(Boolean deferred)
+{
+    UInt changes = m_changes;
+    m_changes = 0;
+    UInt i;
+    if ((changes & settingPan) && (((m_applied & settingPan) == 0) || (m_pan != m_appliedPan)))
+    {
+        for (i = 0; i < m_nBuffers; ++i)
+            if (m_buffer[i])
+                m_buffer[i]->SetPan(m_pan);
+        m_appliedPan = m_pan;
+    }
+    if ((changes & settingVolume) && (((m_applied & settingVolume) == 0) || (m_volume != m_appliedVolume)))
+    {
+        for (i = 0; i < m_nBuffers; ++i)
+            if (m_buffer[i])
+                m_buffer[i]->SetVolume(DSBVOLUME_MIN + (m_volume * (DSBVOLUME_MAX - DSBVOLUME_MIN) / 100));
+        m_appliedVolume = m_volume;
+    }
+    if ((changes & settingFrequency) && (((m_applied & settingFrequency) == 0) || (m_rate != m_appliedRate)))
+    {
+        for (i = 0; i < m_nBuffers; ++i)
+            if (m_buffer[i])
+                m_buffer[i]->SetFrequency(m_rate);
+        m_appliedRate = m_rate;
+    }
+    Boolean wasDeferred = false;
+    const D3DVECTOR& pos = m_parameters.vPosition;
+    if ((changes & settingPosition) && (m_buffer3D) &&
+        (((m_applied & settingPosition) == 0) || (pos.x != m_appliedPosition.x) ||
+         (pos.y != m_appliedPosition.y) || (pos.z != m_appliedPosition.z)))
+    {
+        m_buffer3D->SetPosition(pos.x, pos.y, pos.z, (deferred) ? DS3D_DEFERRED : DS3D_IMMEDIATE);
+        m_appliedPosition = pos;
+        wasDeferred = deferred;
+    }
+    m_applied |= changes;
+    return wasDeferred;
+}
+
+// A sound is stopped before it changes hands, so no voice is left behind,
+// not even one whose buffer stopped since the last update; a stream always
+// plays as it did.
+void
+Sound::voiceManager(VoiceManager* manager)
+{
+    if (m_stream)
+        return;
+    if (m_voices)
+        m_voices->stop(this);
+    else if (playing( ))
+        stop( );
+    m_voices = manager;
+}
+
+
+// How loud the sound plays in dB, from its volume and, in 3D, its distance
+// to the listener at the default rolloff.
+Float
+Sound::level( )
+{
+    Float level = Float(m_volume - 100);
+    if (m_distance > 1.0f)
+        level -= 20.0f*log10f(m_distance);
+    return level;
+}
+
+
 /* UInt
 Sound::bufferSize( )
 { 
@@ -1258,6 +2080,14 @@ Sound::bufferSize( )
 WAVEFORMATEX*
 Sound::waveFormat( )
 { 
+    if (m_cached)
+        return m_cached->master->waveFormat( );
+#ifdef _USE_VORBIS_
+    if (m_stream)
+        return m_stream->waveFormat( );
+#endif
+    if (m_waveFile == 0)
+        return 0;
     return m_waveFile->waveFormat( );
 }
 
@@ -1347,6 +2177,199 @@ Sound::insertSilence(UInt bufferOffset, UInt bufferSize)
     return dxSuccess;
 }
 
+#ifdef _USE_VORBIS_
+/*************************************************************************************
+ *@class SoundStream
+ *@method
+ *    constuctor
+ *************************************************************************************/
+SoundStream::SoundStream( ) :
+    m_next(0),
+    m_file(0),
+    m_opened(false),
+    m_length(0.0f),
+    m_buffer(0),
+    m_segmentSize(0),
+    m_nSegments(STREAMSEGMENTS),
+    m_nextSegment(0),
+    m_looped(false),
+    m_ended(false),
+    m_written(0),
+    m_played(0),
+    m_endPosition(0),
+    m_lastPosition(0)
+{
+    ZeroMemory(&m_waveFormat, sizeof(WAVEFORMATEX));
+}
+
+
+/*************************************************************************************
+ *@class SoundStream
+ *@method
+ *    destructor
+ *************************************************************************************/
+SoundStream::~SoundStream( )
+{
+    // ov_clear closes the file as well
+    if (m_opened)
+        ov_clear(&m_vorbisFile);
+    else if (m_file)
+        fclose(m_file);
+}
+
+
+Boolean SoundStream::open(Char* filename)
+{
+    m_file = fopen(filename, "rb");
+    if (m_file == 0)
+        return false;
+    if (ov_open(m_file, &m_vorbisFile, NULL, 0) != 0)
+        return false;
+    m_opened = true;
+
+    vorbis_info* vi = ov_info(&m_vorbisFile, -1);
+    m_waveFormat.cbSize           = sizeof(WAVEFORMATEX);
+    m_waveFormat.nChannels        = (WORD)vi->channels;
+    m_waveFormat.wBitsPerSample   = 16; // vorbis is always 16
+    m_waveFormat.nSamplesPerSec   = vi->rate;
+    m_waveFormat.nAvgBytesPerSec  = m_waveFormat.nSamplesPerSec*m_waveFormat.nChannels*2;
+    m_waveFormat.nBlockAlign      = 2*m_waveFormat.nChannels;
+    m_waveFormat.wFormatTag       = 1;
+
+    m_length = Float(ov_time_total(&m_vorbisFile, -1));
+    m_segmentSize = (m_waveFormat.nAvgBytesPerSec*STREAMSEGMENTTIME)/1000;
+    m_segmentSize -= m_segmentSize % m_waveFormat.nBlockAlign;
+    return true;
+}
+
+
+/*************************************************************************************
+ *@class SoundStream
+ *@method
+ *    void attach(LPDIRECTSOUNDBUFFER buffer)
+ *@description
+ *    Hands the stream the buffer it plays through and fills it with the start
+ *    of the file. The buffer stays owned by the Sound.
+ *************************************************************************************/
+void SoundStream::attach(LPDIRECTSOUNDBUFFER buffer)
+{
+    m_buffer = buffer;
+    rewind( );
+}
+
+
+/*************************************************************************************
+ *@class SoundStream
+ *@method
+ *    void rewind( )
+ *@description
+ *    Puts the stream back at the start of the file, with the whole buffer filled.
+ *************************************************************************************/
+void SoundStream::rewind( )
+{
+    if (m_buffer == 0)
+        return;
+    ov_pcm_seek(&m_vorbisFile, 0);
+    m_ended        = false;
+    m_written      = 0;
+    m_played       = 0;
+    m_endPosition  = 0;
+    m_lastPosition = 0;
+    m_nextSegment  = 0;
+    for (UInt i = 0; i < m_nSegments; ++i)
+        fill(i);
+    m_buffer->SetCurrentPosition(0);
+}
+
+
+/*************************************************************************************
+ *@class SoundStream
+ *@method
+ *    void update( )
+ *@description
+ *    Called from the stream thread. Refills the segments the play cursor has
+ *    left since the last call, and stops the buffer once the end of the file
+ *    has been played.
+ *************************************************************************************/
+void SoundStream::update( )
+{
+    ULong status = 0;
+    if (FAILED(m_buffer->GetStatus(&status)))
+        return;
+    // a lost buffer is restored and refilled by the next play
+    if (((status & DSBSTATUS_PLAYING) == 0) || (status & DSBSTATUS_BUFFERLOST))
+        return;
+
+    ULong position = 0;
+    if (FAILED(m_buffer->GetCurrentPosition(&position, 0)))
+        return;
+    UInt size = bufferSize( );
+    m_played += (position + size - m_lastPosition) % size;
+    m_lastPosition = position;
+    if ((m_ended) && (m_played >= m_endPosition))
+    {
+        m_buffer->Stop( );
+        rewind( );
+        return;
+    }
+
+    UInt segment = position / m_segmentSize;
+    while (m_nextSegment != segment)
+    {
+        fill(m_nextSegment);
+        m_nextSegment = (m_nextSegment + 1) % m_nSegments;
+    }
+}
+
+
+void SoundStream::fill(UInt segment)
+{
+    void*   lockedBuffer     = 0; // Pointer to locked buffer memory
+    UInt    lockedBufferSize = 0; // Size of the locked DirectSound buffer
+
+    if (FAILED(m_buffer->Lock(segment*m_segmentSize, m_segmentSize,
+                              &lockedBuffer, (unsigned long*) &lockedBufferSize,
+                              0, 0, 0L)))
+    {
+        DXCOMMON("(!) SoundStream::fill : failed to lock buffer.");
+        return;
+    }
+
+    UInt    pos     = 0;
+    Boolean rewound = false;
+    int     sec     = 0;
+    while ((!m_ended) && (pos < lockedBufferSize))
+    {
+        long read = ov_read(&m_vorbisFile, (char*)(lockedBuffer) + pos, lockedBufferSize - pos, 0, 2, 1, &sec);
+        if (read > 0)
+        {
+            pos += read;
+            rewound = false;
+        }
+        else if (read == OV_HOLE)
+            continue;
+        else if ((read == 0) && (m_looped) && (!rewound))
+        {
+            ov_pcm_seek(&m_vorbisFile, 0);
+            rewound = true;
+        }
+        else
+        {
+            m_ended       = true;
+            m_endPosition = m_written + pos;
+        }
+    }
+
+    // fill the remainder with silence
+    if (pos < lockedBufferSize)
+        FillMemory((UByte*) lockedBuffer + pos, lockedBufferSize - pos, 0);
+
+    m_buffer->Unlock(lockedBuffer, lockedBufferSize, 0, 0);
+    m_written += m_segmentSize;
+}
+#endif
+
+
 /*************************************************************************************
  *@class WaveFile
  *@method
@@ -0,0 +1,237 @@
+/**
+* DXCommon library
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#include <DxCommon/If/Common.h>
+
+
+
+namespace DirectX
+{
+
+/*************************************************************************************
+ *@class SoundLoader
+ *@method
+ *    constructor
+ *@parameters
+ *    - soundManager : the SoundManager whose cache is filled
+ *    - nThreads : the number of worker threads, 0 for one per processor
+ *************************************************************************************/
+SoundLoader::SoundLoader(SoundManager* soundManager, UInt nThreads) :
+    m_soundManager(soundManager),
+    m_queue(0),
+    m_queueTail(0),
+    m_done(0),
+    m_pending(0),
+    m_generation(0),
+    m_nThreads(0)
+{
+    if (nThreads == 0)
+    {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        nThreads = info.dwNumberOfProcessors;
+    }
+    if (nThreads > SOUNDLOADERMAXTHREADS)
+        nThreads = SOUNDLOADERMAXTHREADS;
+    if (nThreads < 1)
+        nThreads = 1;
+    DXCOMMON("(+) SoundLoader : %d threads", nThreads);
+
+    m_wake = CreateSemaphore(0, 0, 0x7fffffff, 0);
+    m_stop = CreateEvent(0, TRUE, FALSE, 0);
+    for (UInt i = 0; i < nThreads; ++i)
+    {
+        m_threads[m_nThreads] = CreateThread(0, 0, worker, this, 0, 0);
+        if (m_threads[m_nThreads] == 0)
+        {
+            DXCOMMON("(!) SoundLoader : failed to start worker thread %d.", i);
+            continue;
+        }
+        // loading should not take time away from the game itself
+        SetThreadPriority(m_threads[m_nThreads], THREAD_PRIORITY_BELOW_NORMAL);
+        ++m_nThreads;
+    }
+}
+
+
+/*************************************************************************************
+ *@class SoundLoader
+ *@method
+ *    destructor
+ *************************************************************************************/
+SoundLoader::~SoundLoader( )
+{
+    DXCOMMON("(-) SoundLoader");
+    cancel( );
+    SetEvent(m_stop);
+    WaitForMultipleObjects(m_nThreads, m_threads, TRUE, INFINITE);
+    for (UInt i = 0; i < m_nThreads; ++i)
+        CloseHandle(m_threads[i]);
+    CloseHandle(m_wake);
+    CloseHandle(m_stop);
+    release( );
+}
+
+
+/*************************************************************************************
+ *@class SoundLoader
+ *@method
+ *    void prefetch(Char* filename, Boolean enable3d, Boolean vorbis)
+ *@description
+ *    Queues a file to be loaded into the cache. Returns immediately; use pending
+ *    to find out whether everything has been loaded.
+ *************************************************************************************/
+void SoundLoader::prefetch(Char* filename, Boolean enable3d, Boolean vorbis)
+{
+    if ((filename == 0) || (strlen(filename) >= MAX_PATH))
+        return;
+    if (m_nThreads == 0)
+    {
+        // no workers, so load it right away
+        SoundManager::CachedSound* cached = m_soundManager->prefetch(filename, enable3d, vorbis);
+        if (cached)
+            m_soundManager->release(cached);
+        return;
+    }
+
+    Request* request  = new Request;
+    strcpy(request->name, filename);
+    request->enable3d = enable3d;
+    request->vorbis   = vorbis;
+    request->cached   = 0;
+    request->next     = 0;
+    {
+        Mutex::Guard guard(m_mutex);
+        if (m_queueTail)
+            m_queueTail->next = request;
+        else
+            m_queue = request;
+        m_queueTail = request;
+        request->generation = m_generation;
+        ++m_pending;
+    }
+    ReleaseSemaphore(m_wake, 1, 0);
+}
+
+
+void SoundLoader::prefetch(Int resource, Boolean enable3d)
+{
+    Char resourceName[128];
+    sprintf(resourceName, "#%d", resource);
+    prefetch(resourceName, enable3d, false);
+}
+
+
+/*************************************************************************************
+ *@class SoundLoader
+ *@method
+ *    UInt pending( )
+ *@returns
+ *    The number of requests that are queued or still being loaded.
+ *************************************************************************************/
+UInt SoundLoader::pending( )
+{
+    Mutex::Guard guard(m_mutex);
+    return m_pending;
+}
+
+
+/*************************************************************************************
+ *@class SoundLoader
+ *@method
+ *    void cancel( )
+ *@description
+ *    Drops the requests no worker has started on yet. Files that are being
+ *    loaded at the moment are let go of as soon as they are done, instead of
+ *    being held until release.
+ *************************************************************************************/
+void SoundLoader::cancel( )
+{
+    Mutex::Guard guard(m_mutex);
+    while (m_queue)
+    {
+        Request* request = m_queue;
+        m_queue = request->next;
+        SAFE_DELETE(request);
+        --m_pending;
+    }
+    m_queueTail = 0;
+    ++m_generation;
+}
+
+
+/*************************************************************************************
+ *@class SoundLoader
+ *@method
+ *    void release( )
+ *@description
+ *    Lets go of every sound loaded so far. Sounds that were created from them in
+ *    the meantime keep the cached data alive; the others may now be trimmed.
+ *************************************************************************************/
+void SoundLoader::release( )
+{
+    Request* done;
+    {
+        Mutex::Guard guard(m_mutex);
+        done   = m_done;
+        m_done = 0;
+    }
+    while (done)
+    {
+        Request* request = done;
+        done = request->next;
+        m_soundManager->release(request->cached);
+        SAFE_DELETE(request);
+    }
+}
+
+
+DWORD WINAPI SoundLoader::worker(LPVOID param)
+{
+    ((SoundLoader*) param)->work( );
+    return 0;
+}
+
+
+void SoundLoader::work( )
+{
+    HANDLE handles[2] = { m_stop, m_wake };
+    while (WaitForMultipleObjects(2, handles, FALSE, INFINITE) == WAIT_OBJECT_0 + 1)
+    {
+        Request* request;
+        {
+            Mutex::Guard guard(m_mutex);
+            // the request may have been cancelled
+            request = m_queue;
+            if (request == 0)
+                continue;
+            m_queue = request->next;
+            if (m_queue == 0)
+                m_queueTail = 0;
+        }
+        request->cached = m_soundManager->prefetch(request->name, request->enable3d, request->vorbis);
+        if (request->cached == 0)
+            DXCOMMON("(!) SoundLoader : could not load %s", request->name);
+
+        {
+            Mutex::Guard guard(m_mutex);
+            --m_pending;
+            if ((request->cached) && (request->generation == m_generation))
+            {
+                request->next = m_done;
+                m_done = request;
+                continue;
+            }
+        }
+        // it failed, or was cancelled while it was loading, so nobody waits for it
+        if (request->cached)
+            m_soundManager->release(request->cached);
+        SAFE_DELETE(request);
+    }
+}
+
+
+} // namespace DirectX
@@ -0,0 +1,168 @@
+/**
+* DXCommon library
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#include <DxCommon/If/Common.h>
+
+
+namespace DirectX
+{
+
+SoundPack::SoundPack( ) :
+    m_file(INVALID_HANDLE_VALUE),
+    m_mapping(0),
+    m_view(0),
+    m_size(0),
+    m_header(0),
+    m_entries(0)
+{
+}
+
+
+SoundPack::~SoundPack( )
+{
+    close( );
+}
+
+
+/*************************************************************************************
+ *@class SoundPack
+ *@method
+ *    Boolean open(const Char* filename)
+ *@returns
+ *    true if the file is a sound pack and could be mapped.
+ *@description
+ *    Maps the pack and checks its index once, so find and data can trust it.
+ *************************************************************************************/
+Boolean
+SoundPack::open(const Char* filename)
+{
+    close( );
+    m_file = CreateFile(filename, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING,
+                        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, 0);
+    if (m_file == INVALID_HANDLE_VALUE)
+        return false;
+    m_size = GetFileSize(m_file, 0);
+    if ((m_size == INVALID_FILE_SIZE) || (m_size < sizeof(SoundPackHeader)))
+    {
+        DXCOMMON("(!) SoundPack::open : %s is too small", filename);
+        close( );
+        return false;
+    }
+    m_mapping = CreateFileMapping(m_file, 0, PAGE_READONLY, 0, 0, 0);
+    if (m_mapping)
+        m_view = (const UByte*) MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+    if (m_view == 0)
+    {
+        DXCOMMON("(!) SoundPack::open : failed to map %s", filename);
+        close( );
+        return false;
+    }
+    m_header  = (const SoundPackHeader*) m_view;
+    m_entries = (const SoundPackEntry*) (m_view + sizeof(SoundPackHeader));
+    if (!valid( ))
+    {
+        DXCOMMON("(!) SoundPack::open : %s is not a valid sound pack", filename);
+        close( );
+        return false;
+    }
+    DXCOMMON("SoundPack::open : %s holds %d sounds", filename, m_header->nEntries);
+    return true;
+}
+
+
+void
+SoundPack::close( )
+{
+    if (m_view)
+        UnmapViewOfFile(m_view);
+    if (m_mapping)
+        CloseHandle(m_mapping);
+    if (m_file != INVALID_HANDLE_VALUE)
+        CloseHandle(m_file);
+    m_file    = INVALID_HANDLE_VALUE;
+    m_mapping = 0;
+    m_view    = 0;
+    m_size    = 0;
+    m_header  = 0;
+    m_entries = 0;
+}
+
+
+/*************************************************************************************
+ *@class SoundPack
+ *@method
+ *    const SoundPackEntry* find(const Char* filename) const
+ *@returns
+ *    The entry of the file, by the path the game would open it by, or 0 if it
+ *    is not in the pack.
+ *************************************************************************************/
+const SoundPackEntry*
+SoundPack::find(const Char* filename) const
+{
+    Char key[SOUNDPACKMAXKEY];
+    if ((m_header == 0) || (filename == 0) || (!soundPackKey(filename, key)))
+        return 0;
+    // the entries are sorted by key
+    UInt low  = 0;
+    UInt high = m_header->nEntries;
+    while (low < high)
+    {
+        UInt middle = (low + high) / 2;
+        Int order = strcmp((const Char*) (m_view + m_entries[middle].key), key);
+        if (order == 0)
+            return &m_entries[middle];
+        if (order < 0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return 0;
+}
+
+
+void
+SoundPack::format(const SoundPackEntry* entry, WAVEFORMATEX& waveFormat)
+{
+    ZeroMemory(&waveFormat, sizeof(WAVEFORMATEX));
+    waveFormat.wFormatTag       = entry->formatTag;
+    waveFormat.nChannels        = entry->channels;
+    waveFormat.nSamplesPerSec   = entry->samplesPerSec;
+    waveFormat.nAvgBytesPerSec  = entry->avgBytesPerSec;
+    waveFormat.nBlockAlign      = entry->blockAlign;
+    waveFormat.wBitsPerSample   = entry->bitsPerSample;
+}
+
+
+// Every key has to end inside the keys and every sound inside the file,
+// and the keys have to be in order for find.
+Boolean
+SoundPack::valid( ) const
+{
+    if ((m_header->magic != SOUNDPACKMAGIC) || (m_header->version != SOUNDPACKVERSION))
+        return false;
+    if (m_header->nEntries > (m_size - sizeof(SoundPackHeader)) / sizeof(SoundPackEntry))
+        return false;
+    UInt keys = sizeof(SoundPackHeader) + m_header->nEntries*sizeof(SoundPackEntry);
+    if ((m_header->keysSize == 0) || (m_header->keysSize > m_size - keys))
+        return false;
+    if (m_view[keys + m_header->keysSize - 1] != 0)
+        return false;
+    for (UInt i = 0; i < m_header->nEntries; ++i)
+    {
+        const SoundPackEntry& entry = m_entries[i];
+        if ((entry.key < keys) || (entry.key >= keys + m_header->keysSize))
+            return false;
+        if ((entry.data > m_size) || (entry.size > m_size - entry.data))
+            return false;
+        if ((entry.avgBytesPerSec == 0) || (entry.blockAlign == 0))
+            return false;
+        if ((i > 0) && (strcmp((const Char*) (m_view + m_entries[i - 1].key), (const Char*) (m_view + entry.key)) >= 0))
+            return false;
+    }
+    return true;
+}
+
+} // namespace DirectX
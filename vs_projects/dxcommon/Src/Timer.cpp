@@ -83,21 +83,23 @@ UInt Timer::elapsed(Boolean reset)
 }
 
 
-Huge Timer::microElapsed( )
+Huge Timer::microElapsed(Boolean reset)
 {
     if (m_usingQPT)
     {
         LARGE_INTEGER queryTime;
         QueryPerformanceCounter( &queryTime );
         Huge elapsed = (Huge)((queryTime.QuadPart - m_lastTimed)*1000000.0 / ((double) m_ticksPerSec));
-        m_lastTimed = queryTime.QuadPart;
+        if (reset)
+            m_lastTimed = queryTime.QuadPart;
         return elapsed;
     }
     else
     {
         Huge time = timeGetTime( );
         Huge elapsed = (Huge) ((time - m_lastTimed) * 1000);
-        m_lastTimed = time;
+        if (reset)
+            m_lastTimed = time;
         return elapsed;
     }
 }
@@ -0,0 +1,1204 @@
+/**
+* DXCommon library
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <DxCommon/If/Internal.h>
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netdb.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include <errno.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
+#include <stdio.h>
+#define DXCOMMON(...)   (fprintf(stderr, __VA_ARGS__), fputc('\n', stderr))
+#endif
+#include <DxCommon/If/UdpTransport.h>
+#include <string.h>
+
+
+namespace DirectX
+{
+
+// The first byte of every datagram.
+enum
+{
+    kindEnumRequest     = 1,    // application
+    kindEnumResponse    = 2,    // application, session name
+    kindConnect         = 3,    // application, nonce
+    kindAccept          = 4,    // nonce, connection id
+    kindDisconnect      = 5,
+    kindReliable        = 6,    // header, sequence, flags, data
+    kindUnreliable      = 7,    // header, sequence, data
+    kindAck             = 8     // header
+};
+
+// The header of the datagrams of a connection: the kind, the next secure
+// sequence number expected from the peer, and a bit for each of the 32
+// after it that already arrived.
+#define HEADERSIZE      7
+#define FLAGLAST        0x01
+#define MAXDATAGRAM     (UDPTRANSPORT_MAXPAYLOAD + HEADERSIZE + 3)
+#define POLLTIME        10      // ms the network thread waits for datagrams
+
+
+struct UdpPlatform
+{
+    Boolean             threaded;   // the network thread was started
+#ifdef _WIN32
+    SOCKET              socket;
+    HANDLE              thread;
+    CRITICAL_SECTION    lock;
+#else
+    int                 socket;
+    int                 poll;       // the epoll descriptor on Linux
+    pthread_t           thread;
+    pthread_mutex_t     lock;
+#endif
+};
+
+
+static void
+putUShort(UByte* p, UShort value)
+{
+    p[0] = UByte(value);
+    p[1] = UByte(value >> 8);
+}
+
+
+static void
+putUInt(UByte* p, UInt value)
+{
+    p[0] = UByte(value);
+    p[1] = UByte(value >> 8);
+    p[2] = UByte(value >> 16);
+    p[3] = UByte(value >> 24);
+}
+
+
+static UShort
+getUShort(const UByte* p)
+{
+    return UShort(p[0] | (p[1] << 8));
+}
+
+
+static UInt
+getUInt(const UByte* p)
+{
+    return UInt(p[0]) | (UInt(p[1]) << 8) | (UInt(p[2]) << 16) | (UInt(p[3]) << 24);
+}
+
+
+static UHuge
+addressKey(UInt ip, UShort port)
+{
+    return (UHuge(ip) << 16) | port;
+}
+
+
+
+UdpTransport::UdpTransport( ) :
+    m_application(0),
+    m_platform(new UdpPlatform),
+    m_running(false)
+{
+    m_platform->threaded = false;
+#ifdef _WIN32
+    m_platform->socket = INVALID_SOCKET;
+    m_platform->thread = 0;
+    InitializeCriticalSection(&m_platform->lock);
+#else
+    m_platform->socket = -1;
+    m_platform->poll = -1;
+    pthread_mutex_init(&m_platform->lock, 0);
+#endif
+}
+
+
+UdpTransport::~UdpTransport( )
+{
+    close( );
+#ifdef _WIN32
+    DeleteCriticalSection(&m_platform->lock);
+#else
+    pthread_mutex_destroy(&m_platform->lock);
+#endif
+    delete m_platform;
+}
+
+
+/**
+ * Opens the socket on the given port, 0 for any, and starts the network thread.
+ */
+Boolean
+UdpTransport::open(UShort port)
+{
+    close( );
+
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+    {
+        DXCOMMON("(!) UdpTransport::open : failed to start winsock");
+        return false;
+    }
+    m_platform->socket = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (m_platform->socket == INVALID_SOCKET)
+    {
+        DXCOMMON("(!) UdpTransport::open : failed to create socket, errno = %d", WSAGetLastError( ));
+        WSACleanup( );
+        return false;
+    }
+    u_long nonBlocking = 1;
+    ioctlsocket(m_platform->socket, FIONBIO, &nonBlocking);
+#else
+    m_platform->socket = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (m_platform->socket < 0)
+    {
+        DXCOMMON("(!) UdpTransport::open : failed to create socket, errno = %d", errno);
+        return false;
+    }
+    fcntl(m_platform->socket, F_SETFL, fcntl(m_platform->socket, F_GETFL, 0) | O_NONBLOCK);
+#endif
+
+    int enable = 1;
+    setsockopt(m_platform->socket, SOL_SOCKET, SO_BROADCAST, (const char*) &enable, sizeof(enable));
+    // room for a full window of every connection, so a track does not push out player data
+    int bufferSize = 1024 * 1024;
+    setsockopt(m_platform->socket, SOL_SOCKET, SO_RCVBUF, (const char*) &bufferSize, sizeof(bufferSize));
+    setsockopt(m_platform->socket, SOL_SOCKET, SO_SNDBUF, (const char*) &bufferSize, sizeof(bufferSize));
+
+    sockaddr_in local;
+    memset(&local, 0, sizeof(local));
+    local.sin_family      = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    local.sin_port        = htons(port);
+    if (bind(m_platform->socket, (sockaddr*) &local, sizeof(local)) != 0)
+    {
+        DXCOMMON("(!) UdpTransport::open : failed to bind to port %d", port);
+        close( );
+        return false;
+    }
+
+#ifdef __linux__
+    m_platform->poll = epoll_create(1);
+    epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    epoll_ctl(m_platform->poll, EPOLL_CTL_ADD, m_platform->socket, &event);
+#endif
+
+    m_running = true;
+#ifdef _WIN32
+    m_platform->thread   = CreateThread(0, 0, thread, this, 0, 0);
+    m_platform->threaded = (m_platform->thread != 0);
+#else
+    m_platform->threaded = (pthread_create(&m_platform->thread, 0, thread, this) == 0);
+#endif
+    if (!m_platform->threaded)
+    {
+        DXCOMMON("(!) UdpTransport::open : failed to start network thread");
+        close( );
+        return false;
+    }
+    DXCOMMON("UdpTransport::open : listening on port %d", port);
+    return true;
+}
+
+
+/**
+ * Stops the network thread and closes the socket. This must not be called
+ * from the network thread, so not from the IServer or IClient either.
+ */
+void
+UdpTransport::close( )
+{
+    m_running = false;
+
+#ifdef _WIN32
+    if (m_platform->threaded)
+    {
+        WaitForSingleObject(m_platform->thread, INFINITE);
+        CloseHandle(m_platform->thread);
+        m_platform->thread = 0;
+    }
+    if (m_platform->socket != INVALID_SOCKET)
+    {
+        closesocket(m_platform->socket);
+        m_platform->socket = INVALID_SOCKET;
+        WSACleanup( );
+    }
+#else
+    if (m_platform->threaded)
+        pthread_join(m_platform->thread, 0);
+    if (m_platform->poll >= 0)
+        ::close(m_platform->poll);
+    m_platform->poll = -1;
+    if (m_platform->socket >= 0)
+        ::close(m_platform->socket);
+    m_platform->socket = -1;
+#endif
+    m_platform->threaded = false;
+}
+
+
+void
+UdpTransport::lock( )
+{
+#ifdef _WIN32
+    EnterCriticalSection(&m_platform->lock);
+#else
+    pthread_mutex_lock(&m_platform->lock);
+#endif
+}
+
+
+void
+UdpTransport::unlock( )
+{
+#ifdef _WIN32
+    LeaveCriticalSection(&m_platform->lock);
+#else
+    pthread_mutex_unlock(&m_platform->lock);
+#endif
+}
+
+
+UInt
+UdpTransport::now( )
+{
+#ifdef _WIN32
+    return GetTickCount( );
+#else
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return UInt(time.tv_sec * 1000 + time.tv_nsec / 1000000);
+#endif
+}
+
+
+void
+UdpTransport::sleep(UInt ms)
+{
+#ifdef _WIN32
+    Sleep(ms);
+#else
+    timespec time;
+    time.tv_sec  = ms / 1000;
+    time.tv_nsec = (ms % 1000) * 1000000;
+    nanosleep(&time, 0);
+#endif
+}
+
+
+Boolean
+UdpTransport::resolve(const Char* host, UInt port, Address& address)
+{
+    addrinfo  hints;
+    addrinfo* result = 0;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family   = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    if ((getaddrinfo(host, 0, &hints, &result) != 0) || (result == 0))
+    {
+        DXCOMMON("(!) UdpTransport::resolve : unknown host %s", host);
+        return false;
+    }
+    address.ip   = ntohl(((sockaddr_in*) result->ai_addr)->sin_addr.s_addr);
+    address.port = UShort(port);
+    freeaddrinfo(result);
+    return true;
+}
+
+
+#ifdef _WIN32
+DWORD WINAPI
+UdpTransport::thread(LPVOID param)
+#else
+void*
+UdpTransport::thread(void* param)
+#endif
+{
+    ((UdpTransport*) param)->run( );
+    return 0;
+}
+
+
+void
+UdpTransport::run( )
+{
+    TEvents events;
+    UByte   buffer[2048];
+    while (m_running)
+    {
+#if defined(_WIN32)
+        fd_set readable;
+        FD_ZERO(&readable);
+        FD_SET(m_platform->socket, &readable);
+        timeval wait = { 0, POLLTIME * 1000 };
+        select(0, &readable, 0, 0, &wait);
+#elif defined(__linux__)
+        epoll_event event;
+        epoll_wait(m_platform->poll, &event, 1, POLLTIME);
+#else
+        pollfd readable = { m_platform->socket, POLLIN, 0 };
+        ::poll(&readable, 1, POLLTIME);
+#endif
+        {
+            Guard guard(*this);
+            for (UInt i = 0; i < 256; ++i)
+            {
+                sockaddr_in from;
+#ifdef _WIN32
+                int fromSize = sizeof(from);
+                int size = recvfrom(m_platform->socket, (char*) buffer, sizeof(buffer), 0, (sockaddr*) &from, &fromSize);
+                if (size == SOCKET_ERROR)
+                {
+                    // a datagram we sent earlier was refused, which says nothing about this one
+                    if (WSAGetLastError( ) == WSAECONNRESET)
+                        continue;
+                    break;
+                }
+#else
+                socklen_t fromSize = sizeof(from);
+                ssize_t size = recvfrom(m_platform->socket, buffer, sizeof(buffer), 0, (sockaddr*) &from, &fromSize);
+                if (size < 0)
+                    break;
+#endif
+                Address address;
+                address.ip   = ntohl(from.sin_addr.s_addr);
+                address.port = ntohs(from.sin_port);
+                onDatagram(address, buffer, UInt(size), events);
+            }
+            onTick(events);
+        }
+        for (UInt i = 0; i < events.size( ); ++i)
+            deliver(events[i]);
+        events.clear( );
+    }
+}
+
+
+void
+UdpTransport::sendDatagram(const Address& to, const UByte* data, UInt size)
+{
+    sockaddr_in remote;
+    memset(&remote, 0, sizeof(remote));
+    remote.sin_family      = AF_INET;
+    remote.sin_addr.s_addr = htonl(to.ip);
+    remote.sin_port        = htons(to.port);
+    // a full socket buffer counts as a lost datagram
+    sendto(m_platform->socket, (const char*) data, size, 0, (sockaddr*) &remote, sizeof(remote));
+}
+
+
+void
+UdpTransport::sendControl(const Address& to, UByte kind, UInt value1, UInt value2)
+{
+    UByte datagram[9];
+    datagram[0] = kind;
+    putUInt(datagram + 1, value1);
+    putUInt(datagram + 5, value2);
+    sendDatagram(to, datagram, sizeof(datagram));
+}
+
+
+void
+UdpTransport::resetConnection(Connection& connection)
+{
+    connection.lastReceived       = now( );
+    connection.lastSent           = connection.lastReceived;
+    connection.rtt                = 100;
+    connection.rttVariance        = 50;
+    connection.nextReliable       = 0;
+    connection.unacked.clear( );
+    connection.expectedReliable   = 0;
+    connection.early.clear( );
+    connection.assembly.clear( );
+    connection.overflow           = false;
+    connection.ackPending         = false;
+    connection.nextUnreliable     = 0;
+    connection.lastUnreliable     = 0;
+    connection.receivedUnreliable = false;
+}
+
+
+UInt
+UdpTransport::writeHeader(Connection& connection, UByte kind, UByte* data)
+{
+    UInt ackBits = 0;
+    for (std::map<UShort, Message>::iterator i = connection.early.begin( ); i != connection.early.end( ); ++i)
+    {
+        Short distance = Short(i->first - connection.expectedReliable - 1);
+        if ((distance >= 0) && (distance < 32))
+            ackBits |= 1u << distance;
+    }
+    data[0] = kind;
+    putUShort(data + 1, connection.expectedReliable);
+    putUInt(data + 3, ackBits);
+    connection.ackPending = false;
+    connection.lastSent   = now( );
+    return HEADERSIZE;
+}
+
+
+void
+UdpTransport::transmit(Connection& connection, Message& message)
+{
+    UByte datagram[MAXDATAGRAM];
+    UInt size = writeHeader(connection, kindReliable, datagram);
+    putUShort(datagram + size, message.sequence);
+    datagram[size + 2] = message.last ? FLAGLAST : 0;
+    size += 3;
+    if (message.data.size( ) > 0)
+        memcpy(datagram + size, &message.data[0], message.data.size( ));
+    size += UInt(message.data.size( ));
+    sendDatagram(connection.address, datagram, size);
+    message.sent = connection.lastSent;
+    message.nSent++;
+}
+
+
+/**
+ * Sends the secure datagrams that were waiting for room in the window.
+ */
+void
+UdpTransport::flush(Connection& connection)
+{
+    if (connection.unacked.empty( ))
+        return;
+    UShort oldest = connection.unacked.front( ).sequence;
+    for (std::deque<Message>::iterator i = connection.unacked.begin( ); i != connection.unacked.end( ); ++i)
+    {
+        if (UShort(i->sequence - oldest) >= UDPTRANSPORT_WINDOW)
+            break;
+        if (i->nSent == 0)
+            transmit(connection, *i);
+    }
+}
+
+
+void
+UdpTransport::sendReliable(Connection& connection, const UByte* data, UInt size)
+{
+    UInt offset = 0;
+    do
+    {
+        UInt n = size - offset;
+        if (n > UDPTRANSPORT_MAXPAYLOAD)
+            n = UDPTRANSPORT_MAXPAYLOAD;
+        connection.unacked.push_back(Message( ));
+        Message& message = connection.unacked.back( );
+        message.sequence = connection.nextReliable++;
+        message.last     = (offset + n == size);
+        message.sent     = 0;
+        message.nSent    = 0;
+        message.data.assign(data + offset, data + offset + n);
+        offset += n;
+    }
+    while (offset < size);
+    flush(connection);
+}
+
+
+void
+UdpTransport::sendUnreliable(Connection& connection, const UByte* data, UInt size)
+{
+    // too big for one datagram, and losing one of several would lose them all
+    if (size > UDPTRANSPORT_MAXPAYLOAD)
+    {
+        sendReliable(connection, data, size);
+        return;
+    }
+    UByte datagram[MAXDATAGRAM];
+    UInt header = writeHeader(connection, kindUnreliable, datagram);
+    putUShort(datagram + header, connection.nextUnreliable++);
+    memcpy(datagram + header + 2, data, size);
+    sendDatagram(connection.address, datagram, header + 2 + size);
+}
+
+
+void
+UdpTransport::sendDisconnect(Connection& connection)
+{
+    UByte kind = kindDisconnect;
+    sendDatagram(connection.address, &kind, 1);
+}
+
+
+void
+UdpTransport::acknowledge(Connection& connection, UShort ack, UInt ackBits)
+{
+    UInt time = now( );
+    std::deque<Message>::iterator i = connection.unacked.begin( );
+    while (i != connection.unacked.end( ))
+    {
+        Short distance = Short(i->sequence - ack);
+        Boolean acked = (distance < 0) ||
+                        ((distance >= 1) && (distance <= 32) && (ackBits & (1u << (distance - 1))));
+        if ((acked) && (i->nSent > 0))
+        {
+            // only datagrams sent once tell the round trip time
+            if (i->nSent == 1)
+            {
+                Int error = Int(time - i->sent) - Int(connection.rtt);
+                connection.rtt = UInt(Int(connection.rtt) + error / 8);
+                connection.rttVariance = UInt(Int(connection.rttVariance) + ((error < 0 ? -error : error) - Int(connection.rttVariance)) / 4);
+            }
+            i = connection.unacked.erase(i);
+        }
+        else
+            ++i;
+    }
+    flush(connection);
+}
+
+
+void
+UdpTransport::accept(Connection& connection, const UByte* data, UInt size, Boolean last, TEvents& events)
+{
+    if (connection.assembly.size( ) + size > UDPTRANSPORT_MAXPACKET)
+        connection.overflow = true;
+    if (!connection.overflow)
+        connection.assembly.insert(connection.assembly.end( ), data, data + size);
+    if (!last)
+        return;
+    if (connection.overflow)
+    {
+        DXCOMMON("(!) UdpTransport : dropped a packet of over %d bytes from connection %d", UDPTRANSPORT_MAXPACKET, connection.id);
+    }
+    else
+    {
+        events.push_back(Event( ));
+        events.back( ).type = Event::packet;
+        events.back( ).id   = connection.id;
+        events.back( ).data.swap(connection.assembly);
+    }
+    connection.assembly.clear( );
+    connection.overflow = false;
+}
+
+
+/**
+ * Handles a datagram of the connection, one with a header.
+ */
+void
+UdpTransport::receive(Connection& connection, const UByte* data, UInt size, TEvents& events)
+{
+    if (size < HEADERSIZE)
+        return;
+    connection.lastReceived = now( );
+    acknowledge(connection, getUShort(data + 1), getUInt(data + 3));
+
+    if ((data[0] == kindReliable) && (size >= HEADERSIZE + 3))
+    {
+        UShort       sequence = getUShort(data + HEADERSIZE);
+        Boolean      last     = (data[HEADERSIZE + 2] & FLAGLAST) != 0;
+        const UByte* payload  = data + HEADERSIZE + 3;
+        UInt         length   = size - HEADERSIZE - 3;
+        Short        distance = Short(sequence - connection.expectedReliable);
+        connection.ackPending = true;
+        if (distance == 0)
+        {
+            accept(connection, payload, length, last, events);
+            connection.expectedReliable++;
+            std::map<UShort, Message>::iterator next;
+            while ((next = connection.early.find(connection.expectedReliable)) != connection.early.end( ))
+            {
+                Message& message = next->second;
+                accept(connection, message.data.empty( ) ? 0 : &message.data[0], UInt(message.data.size( )), message.last, events);
+                connection.early.erase(next);
+                connection.expectedReliable++;
+            }
+        }
+        else if ((distance > 0) && (distance < UDPTRANSPORT_WINDOW) && (connection.early.find(sequence) == connection.early.end( )))
+        {
+            Message& message = connection.early[sequence];
+            message.sequence = sequence;
+            message.last     = last;
+            message.sent     = 0;
+            message.nSent    = 0;
+            message.data.assign(payload, payload + length);
+        }
+    }
+    else if ((data[0] == kindUnreliable) && (size >= HEADERSIZE + 2))
+    {
+        UShort sequence = getUShort(data + HEADERSIZE);
+        if ((!connection.receivedUnreliable) || (Short(sequence - connection.lastUnreliable) > 0))
+        {
+            connection.receivedUnreliable = true;
+            connection.lastUnreliable     = sequence;
+            events.push_back(Event( ));
+            events.back( ).type = Event::packet;
+            events.back( ).id   = connection.id;
+            events.back( ).data.assign(data + HEADERSIZE + 2, data + size);
+        }
+    }
+}
+
+
+UInt
+UdpTransport::timeout(Connection& connection)
+{
+    UInt timeout = connection.rtt + 4 * connection.rttVariance;
+    if (timeout < 50)
+        timeout = 50;
+    if (timeout > 1000)
+        timeout = 1000;
+    return timeout;
+}
+
+
+/**
+ * Resends what was not acknowledged in time and sends a pending ack.
+ * Returns false when the peer has been silent for too long.
+ */
+Boolean
+UdpTransport::service(Connection& connection)
+{
+    UInt time = now( );
+    if (time - connection.lastReceived > UDPTRANSPORT_TIMEOUT)
+        return false;
+
+    if (!connection.unacked.empty( ))
+    {
+        UInt   resend = timeout(connection);
+        UShort oldest = connection.unacked.front( ).sequence;
+        for (std::deque<Message>::iterator i = connection.unacked.begin( ); i != connection.unacked.end( ); ++i)
+        {
+            if ((UShort(i->sequence - oldest) >= UDPTRANSPORT_WINDOW) || (i->nSent == 0))
+                break;
+            // back off, but never so far that one lost datagram stalls the channel for long
+            UInt backoff = i->nSent - 1;
+            if (backoff > 4)
+                backoff = 4;
+            UInt interval = resend << backoff;
+            if (interval > 1000)
+                interval = 1000;
+            if (time - i->sent >= interval)
+                transmit(connection, *i);
+        }
+    }
+
+    if ((connection.ackPending) || (time - connection.lastSent >= UDPTRANSPORT_KEEPALIVE))
+    {
+        UByte datagram[HEADERSIZE];
+        writeHeader(connection, kindAck, datagram);
+        sendDatagram(connection.address, datagram, HEADERSIZE);
+    }
+    return true;
+}
+
+
+
+UdpServerTransport::UdpServerTransport( ) :
+    m_iServer(0),
+    m_nextId(1)
+{
+    m_name[0] = '\0';
+}
+
+
+UdpServerTransport::~UdpServerTransport( )
+{
+    stopSession( );
+}
+
+
+Boolean
+UdpServerTransport::startSession(const Char* name, UInt port)
+{
+    stopSession( );
+    DXCOMMON("UdpServerTransport::startSession(%s, %d)", name, port);
+    strncpy(m_name, name, sizeof(m_name) - 1);
+    m_name[sizeof(m_name) - 1] = '\0';
+    return open(UShort(port));
+}
+
+
+void
+UdpServerTransport::stopSession( )
+{
+    if (!opened( ))
+        return;
+    {
+        Guard guard(*this);
+        for (TConnectionMap::iterator i = m_connections.begin( ); i != m_connections.end( ); ++i)
+            sendDisconnect(i->second);
+        m_connections.clear( );
+        m_addresses.clear( );
+    }
+    close( );
+}
+
+
+void
+UdpServerTransport::sendPacket(UInt to, void* buffer, UInt size, Boolean secure)
+{
+    Guard guard(*this);
+    TConnectionMap::iterator i = m_connections.find(to);
+    if (i == m_connections.end( ))
+        return;
+    if (secure)
+        sendReliable(i->second, (const UByte*) buffer, size);
+    else
+        sendUnreliable(i->second, (const UByte*) buffer, size);
+}
+
+
+UInt
+UdpServerTransport::nConnections( )
+{
+    Guard guard(*this);
+    return UInt(m_connections.size( ));
+}
+
+
+UdpTransport::Connection*
+UdpServerTransport::find(const Address& address)
+{
+    TAddressMap::iterator i = m_addresses.find(addressKey(address.ip, address.port));
+    if (i == m_addresses.end( ))
+        return 0;
+    return &m_connections[i->second];
+}
+
+
+void
+UdpServerTransport::remove(UInt id, TEvents& events)
+{
+    TConnectionMap::iterator i = m_connections.find(id);
+    if (i == m_connections.end( ))
+        return;
+    m_addresses.erase(addressKey(i->second.address.ip, i->second.address.port));
+    m_connections.erase(i);
+    events.push_back(Event( ));
+    events.back( ).type = Event::removed;
+    events.back( ).id   = id;
+}
+
+
+void
+UdpServerTransport::onDatagram(const Address& from, const UByte* data, UInt size, TEvents& events)
+{
+    if (size == 0)
+        return;
+    switch (data[0])
+    {
+        case kindEnumRequest:
+        {
+            if ((size < 5) || (getUInt(data + 1) != m_application))
+                break;
+            UByte reply[5 + sizeof(m_name)];
+            UInt  length = UInt(strlen(m_name)) + 1;
+            reply[0] = kindEnumResponse;
+            putUInt(reply + 1, m_application);
+            memcpy(reply + 5, m_name, length);
+            sendDatagram(from, reply, 5 + length);
+            break;
+        }
+
+        case kindConnect:
+        {
+            if ((size < 9) || (getUInt(data + 1) != m_application))
+                break;
+            UInt nonce = getUInt(data + 5);
+            Connection* connection = find(from);
+            if ((connection) && (connection->nonce != nonce))
+            {
+                // the client restarted before we noticed it was gone
+                remove(connection->id, events);
+                connection = 0;
+            }
+            if (connection == 0)
+            {
+                if (m_connections.size( ) >= UDPTRANSPORT_MAXCONNECTIONS)
+                {
+                    DXCOMMON("(!) UdpServerTransport : refused a connection, the server is full");
+                    break;
+                }
+                UInt id = m_nextId++;
+                connection = &m_connections[id];
+                connection->id      = id;
+                connection->address = from;
+                connection->nonce   = nonce;
+                resetConnection(*connection);
+                m_addresses[addressKey(from.ip, from.port)] = id;
+                events.push_back(Event( ));
+                events.back( ).type = Event::added;
+                events.back( ).id   = id;
+                DXCOMMON("UdpServerTransport : connection %d from %d.%d.%d.%d:%d", id,
+                         from.ip >> 24, (from.ip >> 16) & 0xff, (from.ip >> 8) & 0xff, from.ip & 0xff, from.port);
+            }
+            // also sent again when the client did not get the first one
+            sendControl(from, kindAccept, nonce, connection->id);
+            break;
+        }
+
+        case kindDisconnect:
+        {
+            Connection* connection = find(from);
+            if (connection)
+                remove(connection->id, events);
+            break;
+        }
+
+        default:
+        {
+            Connection* connection = find(from);
+            if (connection)
+                receive(*connection, data, size, events);
+            break;
+        }
+    }
+}
+
+
+void
+UdpServerTransport::onTick(TEvents& events)
+{
+    std::vector<UInt> lost;
+    for (TConnectionMap::iterator i = m_connections.begin( ); i != m_connections.end( ); ++i)
+    {
+        if (!service(i->second))
+            lost.push_back(i->first);
+    }
+    for (UInt i = 0; i < lost.size( ); ++i)
+    {
+        DXCOMMON("UdpServerTransport : connection %d timed out", lost[i]);
+        remove(lost[i], events);
+    }
+}
+
+
+void
+UdpServerTransport::deliver(Event& event)
+{
+    if (m_iServer == 0)
+        return;
+    switch (event.type)
+    {
+        case Event::packet:
+            m_iServer->onPacket(event.id, event.data.empty( ) ? 0 : &event.data[0], UInt(event.data.size( )));
+            break;
+        case Event::added:
+            m_iServer->onAddConnection(event.id);
+            break;
+        case Event::removed:
+            m_iServer->onRemoveConnection(event.id);
+            break;
+        case Event::lost:
+            m_iServer->onSessionLost( );
+            break;
+    }
+}
+
+
+
+UdpClientTransport::UdpClientTransport( ) :
+    m_iClient(0),
+    m_connecting(false),
+    m_connected(false),
+    m_lastConnect(0),
+    m_enumerating(false),
+    m_lastEnum(0)
+{
+    m_server.id    = 0;
+    m_server.nonce = 0;
+    m_server.address.ip   = 0;
+    m_server.address.port = 0;
+    m_enumAddress.ip      = 0;
+    m_enumAddress.port    = 0;
+    resetConnection(m_server);
+}
+
+
+UdpClientTransport::~UdpClientTransport( )
+{
+    finalize( );
+}
+
+
+Boolean
+UdpClientTransport::initialize( )
+{
+    return open(0);
+}
+
+
+void
+UdpClientTransport::finalize( )
+{
+    if (!opened( ))
+        return;
+    {
+        Guard guard(*this);
+        if (m_connected)
+            sendDisconnect(m_server);
+        m_connected   = false;
+        m_connecting  = false;
+        m_enumerating = false;
+        m_sessions.clear( );
+    }
+    close( );
+}
+
+
+Boolean
+UdpClientTransport::sendPacket(void* buffer, UInt size, Boolean secure)
+{
+    Guard guard(*this);
+    if (!m_connected)
+        return false;
+    if (secure)
+        sendReliable(m_server, (const UByte*) buffer, size);
+    else
+        sendUnreliable(m_server, (const UByte*) buffer, size);
+    return true;
+}
+
+
+/**
+ * Looks for sessions at the given address, or on the local network when
+ * there is none, until stopSessionEnum or a join.
+ */
+Boolean
+UdpClientTransport::startSessionEnum(UInt port, const Char* address)
+{
+    if (!opened( ))
+        return false;
+    Address enumAddress;
+    if ((address != 0) && (address[0] != 0))
+    {
+        if (!resolve(address, port, enumAddress))
+            return false;
+    }
+    else
+    {
+        enumAddress.ip   = INADDR_BROADCAST;
+        enumAddress.port = UShort(port);
+    }
+    Guard guard(*this);
+    m_sessions.clear( );
+    m_enumAddress = enumAddress;
+    m_enumerating = true;
+    m_lastEnum    = now( );
+    sendControl(m_enumAddress, kindEnumRequest, m_application, 0);
+    return true;
+}
+
+
+void
+UdpClientTransport::stopSessionEnum( )
+{
+    Guard guard(*this);
+    m_enumerating = false;
+}
+
+
+UInt
+UdpClientTransport::nSessions( )
+{
+    Guard guard(*this);
+    return UInt(m_sessions.size( ));
+}
+
+
+Boolean
+UdpClientTransport::sessionName(UInt i, Char* name, UInt size)
+{
+    Guard guard(*this);
+    if ((i >= m_sessions.size( )) || (size == 0))
+        return false;
+    strncpy(name, m_sessions[i].name, size - 1);
+    name[size - 1] = '\0';
+    return true;
+}
+
+
+Boolean
+UdpClientTransport::joinSession(UInt i)
+{
+    Address address;
+    {
+        Guard guard(*this);
+        if (i >= m_sessions.size( ))
+            return false;
+        address = m_sessions[i].address;
+    }
+    return join(address);
+}
+
+
+Boolean
+UdpClientTransport::joinSessionAt(UInt port, const Char* address)
+{
+    Address server;
+    if (!resolve(address, port, server))
+        return false;
+    return join(server);
+}
+
+
+Boolean
+UdpClientTransport::join(const Address& address)
+{
+    if (!opened( ))
+        return false;
+    {
+        Guard guard(*this);
+        if (m_connected)
+            sendDisconnect(m_server);
+        m_server.id      = 0;
+        m_server.address = address;
+        m_server.nonce   = (m_server.nonce + 1) * 2654435761u ^ now( );
+        resetConnection(m_server);
+        m_connected   = false;
+        m_connecting  = true;
+        m_enumerating = false;
+        m_lastConnect = now( );
+        sendControl(address, kindConnect, m_application, m_server.nonce);
+    }
+
+    UInt start = now( );
+    while (now( ) - start < UDPTRANSPORT_CONNECTTIMEOUT)
+    {
+        {
+            Guard guard(*this);
+            if (m_connected)
+                return true;
+        }
+        sleep(10);
+    }
+
+    Guard guard(*this);
+    m_connecting = false;
+    if (!m_connected)
+        DXCOMMON("(!) UdpClientTransport::join : the server did not answer");
+    return m_connected;
+}
+
+
+void
+UdpClientTransport::onDatagram(const Address& from, const UByte* data, UInt size, TEvents& events)
+{
+    if (size == 0)
+        return;
+    Boolean fromServer = (from.ip == m_server.address.ip) && (from.port == m_server.address.port);
+    switch (data[0])
+    {
+        case kindEnumResponse:
+        {
+            if ((!m_enumerating) || (size < 6) || (getUInt(data + 1) != m_application))
+                break;
+            Session session;
+            session.address = from;
+            UInt length = size - 5;
+            if (length > sizeof(session.name) - 1)
+                length = sizeof(session.name) - 1;
+            memcpy(session.name, data + 5, length);
+            session.name[length] = '\0';
+            UInt i;
+            for (i = 0; i < m_sessions.size( ); ++i)
+            {
+                if ((m_sessions[i].address.ip == from.ip) && (m_sessions[i].address.port == from.port))
+                    break;
+            }
+            if (i < m_sessions.size( ))
+                m_sessions[i] = session;
+            else if (m_sessions.size( ) < UDPTRANSPORT_MAXSESSIONS)
+                m_sessions.push_back(session);
+            break;
+        }
+
+        case kindAccept:
+        {
+            if ((!m_connecting) || (!fromServer) || (size < 9) || (getUInt(data + 1) != m_server.nonce))
+                break;
+            m_server.id   = getUInt(data + 5);
+            m_server.lastReceived = now( );
+            m_connecting  = false;
+            m_connected   = true;
+            DXCOMMON("UdpClientTransport : connected as %d", m_server.id);
+            break;
+        }
+
+        case kindDisconnect:
+        {
+            if ((!m_connected) || (!fromServer))
+                break;
+            m_connected = false;
+            events.push_back(Event( ));
+            events.back( ).type = Event::lost;
+            events.back( ).id   = m_server.id;
+            break;
+        }
+
+        default:
+        {
+            if ((m_connected) && (fromServer))
+                receive(m_server, data, size, events);
+            break;
+        }
+    }
+}
+
+
+void
+UdpClientTransport::onTick(TEvents& events)
+{
+    UInt time = now( );
+    if ((m_connecting) && (time - m_lastConnect >= 250))
+    {
+        sendControl(m_server.address, kindConnect, m_application, m_server.nonce);
+        m_lastConnect = time;
+    }
+    if ((m_enumerating) && (time - m_lastEnum >= 1000))
+    {
+        sendControl(m_enumAddress, kindEnumRequest, m_application, 0);
+        m_lastEnum = time;
+    }
+    if ((m_connected) && (!service(m_server)))
+    {
+        DXCOMMON("UdpClientTransport : the server timed out");
+        m_connected = false;
+        events.push_back(Event( ));
+        events.back( ).type = Event::lost;
+        events.back( ).id   = m_server.id;
+    }
+}
+
+
+void
+UdpClientTransport::deliver(Event& event)
+{
+    if (m_iClient == 0)
+        return;
+    switch (event.type)
+    {
+        case Event::packet:
+            m_iClient->onPacket(event.id, event.data.empty( ) ? 0 : &event.data[0], UInt(event.data.size( )));
+            break;
+        case Event::lost:
+            m_iClient->onSessionLost( );
+            break;
+        default:
+            break;
+    }
+}
+
+
+} // namespace DirectX
@@ -0,0 +1,322 @@
+/**
+* DXCommon library
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#include <DxCommon/If/Common.h>
+#include <Common/If/Algorithm.h>  // minimum, maximum
+#include <math.h>
+#include <string.h>
+
+
+namespace DirectX
+{
+
+VoiceManager::VoiceManager(UInt budget) :
+    m_nVoices(0),
+    m_nReal(0),
+    m_budget(minimum<UInt>(budget, VOICEPOOLSIZE)),
+    m_lastUpdate(timeGetTime( ))
+{
+}
+
+
+VoiceManager::~VoiceManager( )
+{
+}
+
+
+void
+VoiceManager::budget(UInt budget)
+{
+    m_budget = minimum<UInt>(budget, VOICEPOOLSIZE);
+}
+
+
+/*************************************************************************************
+ *@class VoiceManager
+ *@method
+ *    void update( )
+ *@description
+ *    Called once a frame. Drops the voices that ended, lets the virtual ones keep
+ *    time, ranks them all again, and then stops the real voices that lost their
+ *    place before it starts the ones that won it, so the budget is never exceeded.
+ *************************************************************************************/
+void
+VoiceManager::update( )
+{
+    UInt now = timeGetTime( );
+    UInt elapsed = now - m_lastUpdate;
+    m_lastUpdate = now;
+
+    UInt i = 0;
+    while (i < m_nVoices)
+    {
+        Voice& voice = m_voices[i];
+        Boolean ended;
+        if (voice.real)
+        {
+            DWORD status = 0;
+            voice.sound->m_buffer[voice.buffer]->GetStatus(&status);
+            ended = ((status & DSBSTATUS_PLAYING) == 0);
+        }
+        else
+            ended = !advance(voice, elapsed);
+        if (ended)
+        {
+            remove(i);
+            continue;
+        }
+        voice.level = voice.sound->level( );
+        ++i;
+    }
+
+    // there are few voices, and they are nearly in order from the last frame
+    UInt order[VOICEPOOLSIZE];
+    for (i = 0; i < m_nVoices; ++i)
+    {
+        UInt j = i;
+        for (; (j > 0) && (outranks(m_voices[i], m_voices[order[j - 1]])); --j)
+            order[j] = order[j - 1];
+        order[j] = i;
+    }
+    for (i = 0; i < m_nVoices; ++i)
+    {
+        Voice& voice = m_voices[order[i]];
+        if ((voice.real) && ((i >= m_budget) || (rank(voice) <= VOICEINAUDIBLE)))
+            makeVirtual(voice);
+    }
+    for (i = 0; (i < m_nVoices) && (i < m_budget); ++i)
+    {
+        Voice& voice = m_voices[order[i]];
+        if ((!voice.real) && (rank(voice) > VOICEINAUDIBLE))
+            makeReal(voice);
+    }
+}
+
+
+// A buffer of the sound that has no voice, or else the buffer of its
+// voice that ranks lowest, rather than any busy one.
+UInt
+VoiceManager::freeBuffer(Sound* sound)
+{
+    for (UInt buffer = 0; buffer < sound->m_nBuffers; ++buffer)
+    {
+        UInt i = 0;
+        while ((i < m_nVoices) && ((m_voices[i].sound != sound) || (m_voices[i].buffer != buffer)))
+            ++i;
+        if (i == m_nVoices)
+            return buffer;
+    }
+    return m_voices[lowest(sound, false)].buffer;
+}
+
+
+// Playing a buffer that already has a voice only changes how it plays,
+// as it does for a DirectSound buffer. A new voice takes the place of the
+// lowest one when the pool or the budget is full and it outranks it.
+Int
+VoiceManager::play(Sound* sound, UInt buffer, UInt priority, Boolean looped)
+{
+    LPDIRECTSOUNDBUFFER soundBuffer = sound->m_buffer[buffer];
+    for (UInt i = 0; i < m_nVoices; ++i)
+    {
+        Voice& voice = m_voices[i];
+        if ((voice.sound == sound) && (voice.buffer == buffer))
+        {
+            voice.priority = priority;
+            voice.looped = looped;
+            if (voice.real)
+                return sound->playBuffer(soundBuffer, priority, looped);
+            return dxSuccess;
+        }
+    }
+
+    Voice voice;
+    voice.sound = sound;
+    voice.buffer = buffer;
+    voice.priority = priority;
+    voice.looped = looped;
+    voice.real = false;
+    WAVEFORMATEX format;
+    memset(&format, 0, sizeof(format));
+    soundBuffer->GetFormat(&format, sizeof(format), 0);
+    voice.blockAlign = maximum<UInt>(format.nBlockAlign, 1);
+    voice.frequency = format.nSamplesPerSec;
+    DWORD position = 0;
+    soundBuffer->GetCurrentPosition(&position, 0);
+    voice.position = Float(position);
+    voice.level = sound->level( );
+
+    if (m_nVoices == VOICEPOOLSIZE)
+    {
+        Int i = lowest(0, false);
+        if (!outranks(voice, m_voices[i]))
+            return dxFailed;
+        if (m_voices[i].real)
+            m_voices[i].sound->m_buffer[m_voices[i].buffer]->Stop( );
+        remove(i);
+    }
+    m_voices[m_nVoices] = voice;
+    Voice& added = m_voices[m_nVoices++];
+    if (rank(added) <= VOICEINAUDIBLE)
+        return dxSuccess;
+    if (m_nReal >= m_budget)
+    {
+        Int i = lowest(0, true);
+        if ((i < 0) || (!outranks(added, m_voices[i])))
+            return dxSuccess;
+        makeVirtual(m_voices[i]);
+    }
+    if (!makeReal(added))
+    {
+        remove(m_nVoices - 1);
+        return dxFailed;
+    }
+    return dxSuccess;
+}
+
+
+// A virtual voice leaves its buffer where it got to, so playing the
+// sound again goes on from there.
+void
+VoiceManager::stop(Sound* sound)
+{
+    UInt i = 0;
+    while (i < m_nVoices)
+    {
+        Voice& voice = m_voices[i];
+        if (voice.sound != sound)
+        {
+            ++i;
+            continue;
+        }
+        LPDIRECTSOUNDBUFFER buffer = sound->m_buffer[voice.buffer];
+        if (voice.real)
+            buffer->Stop( );
+        else
+            buffer->SetCurrentPosition(UInt(voice.position) / voice.blockAlign * voice.blockAlign);
+        remove(i);
+    }
+}
+
+
+void
+VoiceManager::rewind(Sound* sound)
+{
+    for (UInt i = 0; i < m_nVoices; ++i)
+    {
+        if ((m_voices[i].sound == sound) && (!m_voices[i].real))
+            m_voices[i].position = 0.0f;
+    }
+}
+
+
+Boolean
+VoiceManager::playing(Sound* sound)
+{
+    for (UInt i = 0; i < m_nVoices; ++i)
+    {
+        Voice& voice = m_voices[i];
+        if (voice.sound != sound)
+            continue;
+        if (!voice.real)
+            return true;
+        DWORD status = 0;
+        sound->m_buffer[voice.buffer]->GetStatus(&status);
+        if ((status & DSBSTATUS_PLAYING) != 0)
+            return true;
+    }
+    return false;
+}
+
+
+// A real voice ranks a little above its level, so two voices of about the
+// same level do not take turns every frame.
+Float
+VoiceManager::rank(const Voice& voice)
+{
+    return (voice.real) ? voice.level + VOICEHYSTERESIS : voice.level;
+}
+
+
+Boolean
+VoiceManager::outranks(const Voice& a, const Voice& b)
+{
+    if (a.priority != b.priority)
+        return (a.priority > b.priority);
+    return (rank(a) > rank(b));
+}
+
+
+Boolean
+VoiceManager::makeReal(Voice& voice)
+{
+    LPDIRECTSOUNDBUFFER buffer = voice.sound->m_buffer[voice.buffer];
+    buffer->SetCurrentPosition(UInt(voice.position) / voice.blockAlign * voice.blockAlign);
+    if (voice.sound->playBuffer(buffer, voice.priority, voice.looped) != dxSuccess)
+        return false;
+    voice.real = true;
+    ++m_nReal;
+    return true;
+}
+
+
+void
+VoiceManager::makeVirtual(Voice& voice)
+{
+    LPDIRECTSOUNDBUFFER buffer = voice.sound->m_buffer[voice.buffer];
+    DWORD position = 0;
+    buffer->GetCurrentPosition(&position, 0);
+    buffer->Stop( );
+    voice.position = Float(position);
+    voice.real = false;
+    --m_nReal;
+}
+
+
+// Moves a virtual voice on by the time that passed, at the frequency the
+// sound plays at; false once a voice that does not loop has ended.
+Boolean
+VoiceManager::advance(Voice& voice, UInt elapsed)
+{
+    UInt frequency = (voice.sound->m_rate != 0) ? voice.sound->m_rate : voice.frequency;
+    voice.position += Float(elapsed) * Float(frequency) * Float(voice.blockAlign) / 1000.0f;
+    Float size = Float(voice.sound->m_bufferSize);
+    if (voice.position < size)
+        return true;
+    if ((!voice.looped) || (size <= 0.0f))
+        return false;
+    voice.position = fmodf(voice.position, size);
+    return true;
+}
+
+
+// Forgets voice i, whose buffer the caller has stopped if need be.
+void
+VoiceManager::remove(UInt i)
+{
+    if (m_voices[i].real)
+        --m_nReal;
+    m_voices[i] = m_voices[--m_nVoices];
+}
+
+
+// The voice that ranks lowest, of the given sound if any; -1 if there is none.
+Int
+VoiceManager::lowest(Sound* sound, Boolean realOnly)
+{
+    Int found = -1;
+    for (UInt i = 0; i < m_nVoices; ++i)
+    {
+        const Voice& voice = m_voices[i];
+        if (((sound != 0) && (voice.sound != sound)) || ((realOnly) && (!voice.real)))
+            continue;
+        if ((found < 0) || (outranks(m_voices[found], voice)))
+            found = Int(i);
+    }
+    return found;
+}
+
+} // namespace DirectX
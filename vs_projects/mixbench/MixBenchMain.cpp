@@ -0,0 +1,195 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#include "../topspeed/SoundMixer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+
+#define SAMPLERATE      44100
+#define MAXENGINES      16
+#define IDLEFREQUENCY   11000       // Hz an engine idles at, about
+#define TOPFREQUENCY    50000       // Hz an engine plays at top speed, about
+#define UPDATEFRAMES    441         // frames between two changes of frequency, 10 ms
+#define TONERATE        22050       // Hz of the test tones, like the engine sounds
+#define TONEAMPLITUDE   16384       // half of full scale
+#define WARMUPFRAMES    1024
+#define MEASUREFRAMES   16384
+#define PI              3.14159265358979323846
+
+static const Char* _interpolationName[] = {"linear", "sinc"};
+
+
+static void
+usage( )
+{
+    printf("usage: mixbench [options]\n");
+    printf("  -v voices      engine voices mixed at once, at most %d (default 16)\n", SOUNDMIXER_MAXVOICES);
+    printf("  -t seconds     seconds of sound mixed per interpolation (default 60)\n");
+    printf("  -S folder      folder with the vehicle sounds (default ../topspeed/Sounds)\n");
+}
+
+
+// Mixes engines that sweep between idle and top speed, each at its own
+// pace, the way a field of cars does.
+static void
+throughput(SoundMixer::Interpolation interpolation, const SoundMixer::Sample* engines, UInt nEngines,
+           UInt nVoices, UInt seconds)
+{
+    NullAudioDevice device;
+    SoundMixer mixer(&device, SAMPLERATE);
+    mixer.interpolation(interpolation);
+    Int voices[SOUNDMIXER_MAXVOICES];
+    for (UInt i = 0; i < nVoices; ++i)
+        voices[i] = mixer.play(&engines[i % nEngines], true);
+
+    UInt nUpdates = seconds * SAMPLERATE / UPDATEFRAMES;
+    clock_t begin = clock( );
+    for (UInt update = 0; update < nUpdates; ++update)
+    {
+        Float t = Float(update) * UPDATEFRAMES / SAMPLERATE;
+        for (UInt i = 0; i < nVoices; ++i)
+        {
+            Float sweep = 0.5f - 0.5f*Float(cos(t * (0.2f + 0.05f*i)));
+            mixer.frequency(voices[i], Int(IDLEFREQUENCY + sweep*(TOPFREQUENCY - IDLEFREQUENCY)));
+        }
+        mixer.render(UPDATEFRAMES);
+    }
+    Double elapsed = Double(clock( ) - begin) / CLOCKS_PER_SEC;
+    Double mixed = Double(device.nFrames( )) / SAMPLERATE;
+    printf("%-8s %2u voices: %.1f s mixed in %.2f s, %.0f x real time, %.1f ns per voice and frame\n",
+           _interpolationName[interpolation], nVoices, mixed, elapsed,
+           (elapsed > 0.0) ? mixed / elapsed : 0.0,
+           elapsed * 1e9 / (Double(device.nFrames( )) * nVoices));
+}
+
+
+// Plays a tone of toneFrequency at playFrequency and returns, in dB of the
+// tone, what is left of the left channel once the tone it should become is
+// taken out. A tone that lands above the Nyquist frequency of the output
+// should be gone, so then all of the output counts.
+static Double
+distortion(SoundMixer::Interpolation interpolation, UInt toneFrequency, UInt playFrequency)
+{
+    // a second of tone holds a whole number of cycles, so the loop is seamless
+    Short* tone = new Short[TONERATE];
+    for (UInt i = 0; i < TONERATE; ++i)
+        tone[i] = Short(floor(TONEAMPLITUDE * sin(2.0*PI * Double(toneFrequency) * i / TONERATE) + 0.5));
+    SoundMixer::Sample sample;
+    SoundMixer::makeSample(tone, TONERATE, TONERATE, sample);
+    delete[] tone;
+
+    SoundMixer mixer(0, SAMPLERATE);
+    mixer.interpolation(interpolation);
+    Int voice = mixer.play(&sample, true);
+    mixer.frequency(voice, playFrequency);
+    Short* frames = new Short[(WARMUPFRAMES + MEASUREFRAMES)*2];
+    mixer.mix(frames, WARMUPFRAMES + MEASUREFRAMES);
+    SoundMixer::freeWave(sample);
+
+    // fit a*cos + b*sin of the expected frequency by least squares
+    Double expected = Double(toneFrequency) * playFrequency / TONERATE;
+    Boolean audible = (expected < SAMPLERATE / 2);
+    Double cc = 0.0, ss = 0.0, cs = 0.0, xc = 0.0, xs = 0.0, xx = 0.0;
+    for (UInt i = 0; i < MEASUREFRAMES; ++i)
+    {
+        Double x = frames[(WARMUPFRAMES + i)*2];
+        Double w = 2.0*PI * expected * i / SAMPLERATE;
+        Double c = cos(w);
+        Double s = sin(w);
+        cc += c*c;
+        ss += s*s;
+        cs += c*s;
+        xc += x*c;
+        xs += x*s;
+        xx += x*x;
+    }
+    delete[] frames;
+    Double residual = xx;
+    if (audible)
+    {
+        Double determinant = cc*ss - cs*cs;
+        Double a = (xc*ss - xs*cs) / determinant;
+        Double b = (xs*cc - xc*cs) / determinant;
+        residual = xx - a*xc - b*xs;
+    }
+    Double power = 0.5 * Double(TONEAMPLITUDE) * TONEAMPLITUDE * MEASUREFRAMES;
+    return 10.0 * log10(((residual > 0.0) ? residual : 0.0) / power + 1e-12);
+}
+
+
+int
+main(int argc, char** argv)
+{
+    UInt nVoices = 16;
+    UInt seconds = 60;
+    const Char* soundFolder = "../topspeed/Sounds";
+    for (Int i = 1; i < argc; ++i)
+    {
+        if ((argv[i][0] == '-') && (i + 1 < argc))
+        {
+            switch (argv[i][1])
+            {
+            case 'v': nVoices     = atoi(argv[++i]); break;
+            case 't': seconds     = atoi(argv[++i]); break;
+            case 'S': soundFolder = argv[++i]; break;
+            default:  usage( ); return 1;
+            }
+        }
+        else
+        {
+            usage( );
+            return 1;
+        }
+    }
+    if ((nVoices == 0) || (nVoices > SOUNDMIXER_MAXVOICES))
+    {
+        usage( );
+        return 1;
+    }
+
+    SoundMixer::Sample engines[MAXENGINES];
+    UInt nEngines = 0;
+    for (; nEngines < MAXENGINES; ++nEngines)
+    {
+        Char fileName[256];
+        sprintf(fileName, "%s/vehicle%u_e.wav", soundFolder, nEngines + 1);
+        if (!SoundMixer::loadWave(fileName, engines[nEngines]))
+            break;
+    }
+    if (nEngines == 0)
+    {
+        printf("mixbench: cannot load the engine sounds from %s\n", soundFolder);
+        return 1;
+    }
+
+    printf("mixbench: throughput, %u engine sounds\n", nEngines);
+    throughput(SoundMixer::linear, engines, nEngines, nVoices, seconds);
+    throughput(SoundMixer::sinc, engines, nEngines, nVoices, seconds);
+
+    static const UInt tones[] = {2000, 6000, 9000, 10500};
+    static const UInt plays[] = {16000, 30000, 50000, 75000};
+    printf("mixbench: distortion and aliasing in dB of the tone, sampled at %u Hz\n", TONERATE);
+    printf("tone Hz  played at  output Hz    linear      sinc\n");
+    for (UInt t = 0; t < sizeof(tones)/sizeof(tones[0]); ++t)
+    {
+        for (UInt p = 0; p < sizeof(plays)/sizeof(plays[0]); ++p)
+        {
+            UInt output = UInt(UHuge(tones[t]) * plays[p] / TONERATE);
+            printf("%7u  %9u  %9u%s  %6.1f    %6.1f\n", tones[t], plays[p], output,
+                   (output < SAMPLERATE / 2) ? " " : "*",
+                   distortion(SoundMixer::linear, tones[t], plays[p]),
+                   distortion(SoundMixer::sinc, tones[t], plays[p]));
+        }
+    }
+    printf("* above the Nyquist frequency of the output, so all of it is aliasing\n");
+
+    for (UInt i = 0; i < nEngines; ++i)
+        SoundMixer::freeWave(engines[i]);
+    return 0;
+}
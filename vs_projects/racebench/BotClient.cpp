@@ -0,0 +1,320 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#include "BotClient.h"
+#include "../topspeed/PlayerCodec.h"
+#include "../topspeed/TrackStream.h"
+#include <DxCommon/If/UdpTransport.h>
+#include <Common/If/Algorithm.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAXLOOKBACK     100         // sent positions searched for the one a snapshot holds
+
+
+BotClient::BotClient(DirectX::LoopbackNetwork& network, BotClient** bots) :
+    m_transport(network),
+    m_bots(bots),
+    m_playerNumber(-1),
+    m_playerId(0),
+    m_snapshotTime(0),
+    m_snapshotApplied(0),
+    m_lastSend(0),
+    m_gear(1),
+    m_state(RaceSim::waiting),
+    m_trackStreamSize(0),
+    m_trackHash(0),
+    m_trackLength(0),
+    m_lapLength(0),
+    m_trackRequested(0),
+    m_trackLoaded(false),
+    m_started(false),
+    m_finished(false),
+    m_stopped(false),
+    m_nBumps(0),
+    m_nTrackFailures(0)
+{
+    m_transport.setIClient(this);
+    m_transport.setApplication(RACEAPPLICATION);
+}
+
+
+BotClient::~BotClient( )
+{
+    leave( );
+}
+
+
+Boolean
+BotClient::join( )
+{
+    return (m_transport.initialize( )) && (m_transport.joinSession(0));
+}
+
+
+void
+BotClient::leave( )
+{
+    if ((m_playerNumber >= 0) && (m_playerNumber < NMAXPLAYERS) && (m_bots[m_playerNumber] == this))
+        m_bots[m_playerNumber] = 0;
+    m_transport.finalize( );
+}
+
+
+// Follows the car the way LevelMultiplayer follows the car of the player.
+void
+BotClient::update(UInt now, const RaceSim::Racer& racer)
+{
+    if ((!m_started) || (m_finished))
+        return;
+    if ((racer.state == RaceSim::crashing) && (m_state != RaceSim::crashing))
+        sendCommand(cmdPlayerCrashed);
+    m_state = racer.state;
+    if (racer.state == RaceSim::finished)
+    {
+        sendState(finished);
+        sendCommand(cmdPlayerFinished);
+        m_finished = true;
+        return;
+    }
+    if (now - m_lastSend < UInt(CLIENT_SEND_TIME * 1000.0f))
+        return;
+    m_lastSend = now;
+
+    PlayerData data;
+    data.id             = m_playerId;
+    data.playerNumber   = (UByte)m_playerNumber;
+    data.car            = (UByte)racer.vehicle;
+    data.posX           = racer.positionX;
+    data.posY           = racer.positionY;
+    data.speed          = (UShort)racer.speed;
+    Boolean shifting;
+    data.frequency      = CarPhysics::engineFrequency(racer.parameters, racer.speed, m_gear, shifting);
+    data.state          = racing;
+    data.engineRunning  = (racer.state == RaceSim::running);
+    data.braking        = false;
+    data.horning        = false;
+    data.backfiring     = false;
+
+    PacketPlayerDataToServer packet;
+    packet.command          = cmdPlayerDataToServer;
+    packet.snapshotAck      = m_snapshotReceiver.ack( );
+    packet.snapshotsApplied = m_snapshotReceiver.nApplied( );
+    packet.sendTime         = now;
+    packet.echoTime         = m_snapshotTime;
+    packet.echoDelay        = (m_snapshotReceiver.ack( ) != 0) ? (UShort)minimum<UInt>(now - m_snapshotApplied, NOECHO - 1) : NOECHO;
+    packet.playerNumber     = (UByte)m_playerNumber;
+    BitWriter writer(packet.data, sizeof(packet.data));
+    writer.writeVarint(m_lapLength);
+    PlayerCodec::write(writer, data, snapshotToServer, m_lapLength);
+    sendPacket(&packet, sizeof(PacketPlayerDataToServer) - sizeof(packet.data) + writer.size( ), false);
+
+    Sent sent;
+    sent.time = now;
+    sent.posX = racer.positionX;
+    sent.posY = racer.positionY;
+    m_sent.push_back(sent);
+}
+
+
+void
+BotClient::onPacket(UInt from, void* buffer, UInt size)
+{
+    PacketBase* packet = static_cast<PacketBase*>(buffer);
+    if ((size < sizeof(PacketBase)) || (packet->version != _TopSpeedVersion))
+        return;
+    switch (packet->command)
+    {
+        case cmdPlayerNumber :
+        {
+            PacketPlayer* player = static_cast<PacketPlayer*>(buffer);
+            m_playerId = player->playerId;
+            m_playerNumber = player->playerNumber;
+            if (m_playerNumber < NMAXPLAYERS)
+                m_bots[m_playerNumber] = this;
+            break;
+        }
+        case cmdLoadCustomTrack :
+        {
+            PacketLoadCustomTrack* loadTrack = static_cast<PacketLoadCustomTrack*>(buffer);
+            if ((m_trackLoaded) || (size < sizeof(PacketLoadCustomTrack)))
+                break;
+            m_trackStream.clear( );
+            m_trackStreamSize = loadTrack->streamSize;
+            m_trackHash = loadTrack->streamHash;
+            m_trackLength = loadTrack->trackLength;
+            m_trackRequested = 0;
+            receiveTrack( );
+            break;
+        }
+        case cmdTrackChunk :
+        {
+            PacketTrackChunk* chunk = static_cast<PacketTrackChunk*>(buffer);
+            UInt header = sizeof(PacketTrackChunk) - TRACKCHUNKSIZE;
+            if ((m_trackLoaded) || (size < header) || (chunk->size > size - header) || (chunk->streamHash != m_trackHash) ||
+                (chunk->offset != m_trackStream.size( )) || (chunk->offset + chunk->size > m_trackStreamSize))
+                break;
+            m_trackStream.insert(m_trackStream.end( ), chunk->data, chunk->data + chunk->size);
+            receiveTrack( );
+            break;
+        }
+        case cmdStartRace :
+            if ((m_trackLoaded) && (!m_started))
+            {
+                m_started = true;
+                // players do not all send at the same moment
+                m_lastSend = DirectX::UdpTransport::now( ) - (m_playerNumber * 37) % UInt(CLIENT_SEND_TIME * 1000.0f);
+                sendState(racing);
+                sendCommand(cmdPlayerStarted);
+            }
+            break;
+        case cmdStopRace :
+        case cmdRaceAborted :
+        case cmdDisconnect :
+            m_stopped = true;
+            break;
+        case cmdPlayerSnapshot :
+        {
+            Boolean updated[NMAXPLAYERS];
+            const PlayerSnapshot* snapshot = m_snapshotReceiver.apply(static_cast<PacketPlayerSnapshot*>(buffer), size, updated);
+            if (snapshot == 0)
+                break;
+            UInt now = DirectX::UdpTransport::now( );
+            m_snapshotTime = static_cast<PacketPlayerSnapshot*>(buffer)->serverTime;
+            m_snapshotApplied = now;
+            if (m_started)
+                measure(now, *snapshot, updated);
+            break;
+        }
+        case cmdPlayerBumped :
+            ++m_nBumps;
+            break;
+        default :
+            break;
+    }
+}
+
+
+void
+BotClient::onSessionLost( )
+{
+    m_stopped = true;
+}
+
+
+void
+BotClient::sendPacket(PacketBase* packet, UInt size, Boolean secure)
+{
+    packet->version = _TopSpeedVersion;
+    m_transport.sendPacket(packet, size, secure);
+}
+
+
+void
+BotClient::sendState(PlayerState state)
+{
+    PacketPlayerState packet;
+    packet.command      = cmdPlayerState;
+    packet.playerId     = m_playerId;
+    packet.playerNumber = (UByte)m_playerNumber;
+    packet.state        = (UByte)state;
+    sendPacket(&packet, sizeof(PacketPlayerState), true);
+}
+
+
+void
+BotClient::sendCommand(UByte command)
+{
+    PacketPlayer packet;
+    packet.command      = command;
+    packet.playerId     = m_playerId;
+    packet.playerNumber = (UByte)m_playerNumber;
+    sendPacket(&packet, sizeof(PacketPlayer), true);
+}
+
+
+void
+BotClient::requestTrack(UInt offset)
+{
+    PacketTrackRequest packet;
+    packet.command      = cmdTrackRequest;
+    packet.streamHash   = m_trackHash;
+    packet.offset       = offset;
+    sendPacket(&packet, sizeof(PacketTrackRequest), true);
+    m_trackRequested = offset + TRACKWINDOW*TRACKCHUNKSIZE;
+}
+
+
+// Asks for the track a window at a time like RaceClient, and says it is
+// ready to start once the whole track unpacked.
+void
+BotClient::receiveTrack( )
+{
+    UInt received = (UInt)m_trackStream.size( );
+    if (received < m_trackStreamSize)
+    {
+        if (received >= m_trackRequested)
+            requestTrack(received);
+        return;
+    }
+    const UByte* stream = (m_trackStream.empty( )) ? 0 : &m_trackStream[0];
+    std::vector<TrackGeometry::Definition> definitions(m_trackLength);
+    if ((TrackStream::hash(stream, received) != m_trackHash) ||
+        (!TrackStream::unpack(stream, received, (definitions.empty( )) ? 0 : &definitions[0], m_trackLength)))
+    {
+        ++m_nTrackFailures;
+        return;
+    }
+    m_lapLength = 0;
+    for (UInt i = 0; i < m_trackLength; ++i)
+        m_lapLength += definitions[i].length;
+    m_trackLoaded = true;
+    sendState(awaitingStart);
+}
+
+
+// Cars within SERVER_NEARDISTANCE of where we last were, the short way
+// round the lap, are also counted apart, as the server favours them.
+void
+BotClient::measure(UInt now, const PlayerSnapshot& snapshot, const Boolean* updated)
+{
+    for (Int i = 0; i < NMAXPLAYERS; ++i)
+    {
+        if ((!updated[i]) || (i == m_playerNumber) || (m_bots[i] == 0))
+            continue;
+        Int age = m_bots[i]->sentBefore(now, snapshot.player[i].posX, snapshot.player[i].posY);
+        if (age < 0)
+            continue;
+        m_staleness.push_back(UInt(age));
+        if (m_sent.empty( ))
+            continue;
+        UInt distance = (UInt)abs(snapshot.player[i].posY - m_sent.back( ).posY);
+        if (m_lapLength > 0)
+        {
+            distance %= m_lapLength;
+            distance = minimum(distance, m_lapLength - distance);
+        }
+        if (distance < SERVER_NEARDISTANCE)
+            m_nearStaleness.push_back(UInt(age));
+    }
+}
+
+
+// How long ago we sent the position a snapshot came back with, which it
+// holds rounded to POSITIONQUANTUM; -1 if it is none of the recent ones.
+Int
+BotClient::sentBefore(UInt now, Int posX, Int posY)
+{
+    UInt nSent = (UInt)m_sent.size( );
+    for (UInt i = nSent; (i > 0) && (i + MAXLOOKBACK > nSent); --i)
+    {
+        const Sent& sent = m_sent[i - 1];
+        if ((posX - sent.posX <= POSITIONQUANTUM) && (sent.posX - posX <= POSITIONQUANTUM) &&
+            (posY - sent.posY <= POSITIONQUANTUM) && (sent.posY - posY <= POSITIONQUANTUM))
+            return Int(now - sent.time);
+    }
+    return -1;
+}
@@ -0,0 +1,91 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __RACING_BOTCLIENT_H__
+#define __RACING_BOTCLIENT_H__
+
+#include "../topspeed/RaceSim.h"
+#include "../topspeed/RaceServer.h"
+#include "../topspeed/SnapshotReceiver.h"
+#include <DxCommon/If/LoopbackTransport.h>
+#include <vector>
+
+
+// A racer of the load test. It joins over a LoopbackNetwork, downloads the
+// track, and races the car a RaceSim drives, sending its data as often as
+// LevelMultiplayer does. For every position of another bot that reaches it,
+// it notes how long ago that bot sent it: the staleness of the state.
+class BotClient : public DirectX::IClient
+{
+public:
+    BotClient(DirectX::LoopbackNetwork& network, BotClient** bots);
+    virtual ~BotClient( );
+
+public:
+    Boolean     join( );
+    void        leave( );
+    void        update(UInt now, const RaceSim::Racer& racer);
+
+    Int         playerNumber( )                 { return m_playerNumber;    }
+    Boolean     trackLoaded( )                  { return m_trackLoaded;     }
+    Boolean     started( )                      { return m_started;         }
+    Boolean     stopped( )                      { return m_stopped;         }
+    UInt        id( )                           { return m_transport.id( ); }
+    UInt        nBumps( )                       { return m_nBumps;          }
+    UInt        nTrackFailures( )               { return m_nTrackFailures;  }
+    const std::vector<UInt>& staleness( )       { return m_staleness;       }
+    const std::vector<UInt>& nearStaleness( )   { return m_nearStaleness;   }
+
+public:
+    virtual void    onPacket(UInt from, void* buffer, UInt size);
+    virtual void    onSessionLost( );
+
+private:
+    struct Sent
+    {
+        UInt        time;
+        Int         posX;
+        Int         posY;
+    };
+
+    void        sendPacket(PacketBase* packet, UInt size, Boolean secure);
+    void        sendState(PlayerState state);
+    void        sendCommand(UByte command);
+    void        requestTrack(UInt offset);
+    void        receiveTrack( );
+    void        measure(UInt now, const PlayerSnapshot& snapshot, const Boolean* updated);
+    Int         sentBefore(UInt now, Int posX, Int posY);
+
+private:
+    DirectX::LoopbackClientTransport    m_transport;
+    BotClient**                         m_bots;             // by player number
+    Int                                 m_playerNumber;
+    UInt                                m_playerId;
+    SnapshotReceiver                    m_snapshotReceiver;
+    UInt                                m_snapshotTime;
+    UInt                                m_snapshotApplied;
+    UInt                                m_lastSend;
+    Int                                 m_gear;
+    RaceSim::State                      m_state;
+    std::vector<Sent>                   m_sent;
+    std::vector<UInt>                   m_staleness;
+    std::vector<UInt>                   m_nearStaleness;    // of the cars within SERVER_NEARDISTANCE
+    std::vector<UByte>                  m_trackStream;
+    UInt                                m_trackStreamSize;
+    UInt                                m_trackHash;
+    UInt                                m_trackLength;
+    UInt                                m_lapLength;
+    UInt                                m_trackRequested;
+    Boolean                             m_trackLoaded;
+    Boolean                             m_started;
+    Boolean                             m_finished;
+    Boolean                             m_stopped;
+    UInt                                m_nBumps;
+    UInt                                m_nTrackFailures;
+};
+
+
+#endif /* __RACING_BOTCLIENT_H__ */
@@ -0,0 +1,257 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#include "BotClient.h"
+#include <DxCommon/If/UdpTransport.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#define SETUPTIME       30000       // ms the bots get to join and load the track
+#define RACEGAP         20000       // distance between the grids of two races
+
+Tracer  _raceTracer("race");
+
+
+static void
+usage( )
+{
+    printf("usage: racebench [options] track\n");
+    printf("  -c clients     number of racers, at most %d (default 8)\n", NMAXPLAYERS);
+    printf("  -t seconds     seconds to race (default 30)\n");
+    printf("  -n laps        number of laps (default 3)\n");
+    printf("  -k tick        milliseconds between two server ticks (default 10)\n");
+    printf("  -l latency     milliseconds one way (default 50)\n");
+    printf("  -j jitter      milliseconds added to the latency at most (default 10)\n");
+    printf("  -L loss        percentage of packets lost (default 0)\n");
+    printf("  -r reorder     percentage of packets held up (default 0)\n");
+    printf("  -b bandwidth   bytes per second each way per client, 0 for no limit (default 0)\n");
+    printf("  -s seed        seed of the network and the races (default 1)\n");
+}
+
+
+static void
+sleepMilliseconds(UInt ms)
+{
+#ifdef _WIN32
+    Sleep(ms);
+#else
+    usleep(ms * 1000);
+#endif
+}
+
+
+// The value below which the given part of the sorted values lie.
+static UInt
+percentile(const std::vector<UInt>& sorted, Float part)
+{
+    if (sorted.empty( ))
+        return 0;
+    UInt i = UInt(part * Float(sorted.size( ) - 1) + 0.5f);
+    return sorted[i];
+}
+
+
+static void
+report(const Char* name, const Char* unit, std::vector<UInt>& values)
+{
+    std::sort(values.begin( ), values.end( ));
+    UHuge sum = 0;
+    for (UInt i = 0; i < values.size( ); ++i)
+        sum += values[i];
+    printf("%-22s mean %6u  p50 %6u  p90 %6u  p99 %6u  max %6u %s (%u samples)\n", name,
+           (values.empty( )) ? 0 : UInt(sum / values.size( )),
+           percentile(values, 0.5f), percentile(values, 0.9f), percentile(values, 0.99f),
+           percentile(values, 1.0f), unit, (UInt)values.size( ));
+}
+
+
+int
+main(int argc, char** argv)
+{
+    RaceSim::Settings settings = RaceSim::defaultSettings( );
+    DirectX::LoopbackNetwork::Link link;
+    link.latency   = 50;
+    link.jitter    = 10;
+    link.loss      = 0.0f;
+    link.reorder   = 0.0f;
+    link.bandwidth = 0;
+    UInt nClients = 8;
+    UInt seconds = 30;
+    UInt tick = 10;
+    const Char* trackName = 0;
+    for (Int i = 1; i < argc; ++i)
+    {
+        if ((argv[i][0] == '-') && (i + 1 < argc))
+        {
+            switch (argv[i][1])
+            {
+            case 'c': nClients          = atoi(argv[++i]); break;
+            case 't': seconds           = atoi(argv[++i]); break;
+            case 'n': settings.laps     = atoi(argv[++i]); break;
+            case 'k': tick              = atoi(argv[++i]); break;
+            case 'l': link.latency      = atoi(argv[++i]); break;
+            case 'j': link.jitter       = atoi(argv[++i]); break;
+            case 'L': link.loss         = Float(atof(argv[++i])) / 100.0f; break;
+            case 'r': link.reorder      = Float(atof(argv[++i])) / 100.0f; break;
+            case 'b': link.bandwidth    = atoi(argv[++i]); break;
+            case 's': settings.seed     = atoi(argv[++i]); break;
+            default:  usage( ); return 1;
+            }
+        }
+        else
+            trackName = argv[i];
+    }
+    if ((trackName == 0) || (nClients == 0) || (nClients > NMAXPLAYERS) || (tick == 0))
+    {
+        usage( );
+        return 1;
+    }
+
+    TrackGeometry track;
+    if (!track.load(trackName))
+    {
+        printf("racebench: cannot load the track %s\n", trackName);
+        usage( );
+        return 1;
+    }
+    track.buildIndex( );
+
+    DirectX::LoopbackNetwork network(link, settings.seed);
+    DirectX::LoopbackServerTransport transport(network);
+    RaceServer server;
+    server.initialize(&transport, "racebench", RACEPORT);
+
+    // RaceSim races at most RACESIM_MAXRACERS cars, so larger fields take
+    // several races, which all start together.
+    std::vector<RaceSim*> sims;
+    for (UInt i = 0; i < nClients; i += RACESIM_MAXRACERS)
+    {
+        RaceSim::Settings simSettings = settings;
+        simSettings.seed = settings.seed + (UInt)sims.size( );
+        sims.push_back(new RaceSim(&track, simSettings));
+    }
+    BotClient* bots[NMAXPLAYERS];
+    memset(bots, 0, sizeof(bots));
+    std::vector<BotClient*> clients;
+    for (UInt i = 0; i < nClients; ++i)
+    {
+        sims[i / RACESIM_MAXRACERS]->addRacer((settings.seed + i*5) % NVEHICLES);
+        BotClient* client = new BotClient(network, bots);
+        if (!client->join( ))
+        {
+            printf("racebench: client %u cannot join\n", i + 1);
+            return 1;
+        }
+        clients.push_back(client);
+    }
+
+    std::vector<UInt> tickTimes;
+    Boolean trackLoaded = false;
+    Boolean started = false;
+    UInt begin = DirectX::UdpTransport::now( );
+    UInt raceBegin = 0;
+    UInt last = begin;
+    for (;;)
+    {
+        sleepMilliseconds(tick);
+        UInt now = DirectX::UdpTransport::now( );
+        clock_t tickBegin = clock( );
+        network.deliverToServer(now);
+        server.run(Float(now - last) / 1000.0f);
+        tickTimes.push_back(UInt(UHuge(clock( ) - tickBegin) * 1000000 / CLOCKS_PER_SEC));
+        network.deliverToClients(now);
+        last = now;
+
+        if (!started)
+        {
+            if (now - begin > SETUPTIME)
+            {
+                printf("racebench: the racers did not get ready in time\n");
+                return 1;
+            }
+            if ((!trackLoaded) && (server.nPlayers( ) == nClients))
+            {
+                server.loadCustomTrack(trackName, settings.laps);
+                trackLoaded = true;
+            }
+            if ((trackLoaded) && (server.nPlayers(awaitingStart) == nClients))
+            {
+                server.startRace( );
+                for (UInt i = 0; i < sims.size( ); ++i)
+                    sims[i]->start( );
+                started = true;
+                raceBegin = now;
+                tickTimes.clear( );
+                printf("racebench: %u racers ready after %u ms\n", nClients, now - begin);
+            }
+            continue;
+        }
+
+        Float raceTime = Float(now - raceBegin) / 1000.0f;
+        for (UInt i = 0; i < sims.size( ); ++i)
+        {
+            while ((sims[i]->time( ) < raceTime) && (sims[i]->step( )))
+                ;
+        }
+        Boolean stopped = true;
+        for (UInt i = 0; i < nClients; ++i)
+        {
+            // each race drives on its own part of the track, so cars of
+            // different races do not bump
+            RaceSim::Racer racer = sims[i / RACESIM_MAXRACERS]->racer(i % RACESIM_MAXRACERS);
+            racer.positionY += (i / RACESIM_MAXRACERS) * RACEGAP;
+            clients[i]->update(now, racer);
+            stopped = (stopped) && (clients[i]->stopped( ));
+        }
+        if ((stopped) || (now - raceBegin >= seconds * 1000))
+            break;
+    }
+
+    Float raced = Float(last - raceBegin) / 1000.0f;
+    std::vector<UInt> staleness;
+    std::vector<UInt> nearStaleness;
+    std::vector<UInt> bytesDown;
+    std::vector<UInt> bytesUp;
+    UInt nBumps = 0;
+    UInt nTrackFailures = 0;
+    for (UInt i = 0; i < nClients; ++i)
+    {
+        const std::vector<UInt>& measured = clients[i]->staleness( );
+        staleness.insert(staleness.end( ), measured.begin( ), measured.end( ));
+        const std::vector<UInt>& measuredNear = clients[i]->nearStaleness( );
+        nearStaleness.insert(nearStaleness.end( ), measuredNear.begin( ), measuredNear.end( ));
+        DirectX::LoopbackNetwork::Statistics statistics = network.statistics(clients[i]->id( ));
+        bytesDown.push_back(UInt(Float(statistics.bytesToClient) / raced));
+        bytesUp.push_back(UInt(Float(statistics.bytesToServer) / raced));
+        nBumps += clients[i]->nBumps( );
+        nTrackFailures += clients[i]->nTrackFailures( );
+    }
+    DirectX::LoopbackNetwork::Statistics total = network.total( );
+    printf("racebench: %u racers for %.1f s, latency %u ms, jitter %u ms, loss %.1f%%, reorder %.1f%%, bandwidth %u bytes/s\n",
+           nClients, raced, link.latency, link.jitter, link.loss*100.0f, link.reorder*100.0f, link.bandwidth);
+    report("server tick", "us", tickTimes);
+    report("bytes/s to a client", "", bytesDown);
+    report("bytes/s from a client", "", bytesUp);
+    report("staleness", "ms", staleness);
+    report("staleness of near cars", "ms", nearStaleness);
+    printf("packets lost %u, overtaken %u, dropped by the cap %u, bumps %u, failed tracks %u\n",
+           total.packetsLost, total.packetsOvertaken, total.packetsDropped, nBumps, nTrackFailures);
+
+    for (UInt i = 0; i < nClients; ++i)
+        delete clients[i];
+    server.finalize( );
+    for (UInt i = 0; i < sims.size( ); ++i)
+        delete sims[i];
+    return 0;
+}
@@ -0,0 +1,235 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#include "../topspeed/RaceSim.h"
+#include "../topspeed/SoundMixer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+
+#define SAMPLERATE 44100
+
+
+static void
+usage( )
+{
+    printf("usage: racesim [options] track\n");
+    printf("  -l laps        number of laps (default 3)\n");
+    printf("  -d difficulty  0 = easy, 1 = normal, 2 = hard (default 1)\n");
+    printf("  -s seed        seed of the first race (default 1)\n");
+    printf("  -n races       number of races, each with the next seed (default 1)\n");
+    printf("  -c cars        number of cars, at most %d (default %d)\n", RACESIM_MAXRACERS, RACESIM_MAXRACERS);
+    printf("  -t timestep    seconds per step (default 0.01)\n");
+    printf("  -q             only print the summary\n");
+    printf("  -w file        mix the engine sounds into a wave file\n");
+    printf("  -a             mix the engine sounds without output, for profiling\n");
+    printf("  -S folder      folder with the vehicle sounds (default ../topspeed/Sounds)\n");
+    printf("  -i mode        interpolation of the mixer, linear or sinc (default linear)\n");
+}
+
+
+// Keeps one looping engine voice per car, heard from the first car
+// the way ComputerPlayer positions its sounds around the player.
+static void
+updateEngines(SoundMixer& mixer, RaceSim& sim, TrackGeometry& track, Int* voices, Int* gears)
+{
+    const RaceSim::Racer& listener = sim.racer(0);
+    for (UInt i = 0; i < sim.nRacers( ); ++i)
+    {
+        const RaceSim::Racer& racer = sim.racer(i);
+        Boolean shifting;
+        mixer.frequency(voices[i], CarPhysics::engineFrequency(racer.parameters, racer.speed, gears[i], shifting));
+        if (i == 0)
+        {
+            mixer.volume(voices[i], 80);
+            continue;
+        }
+        Float x = Float(racer.positionX - listener.positionX) / Float(track.laneWidth( ));
+        Float y = Float(racer.positionY - listener.positionY) / 12000.0f;
+        Float distance = Float(sqrt(sqrt(x*x) + sqrt(y*y)));
+        if (x < -2.0f)
+            mixer.pan(voices[i], -100);
+        else if (x > 2.0f)
+            mixer.pan(voices[i], 100);
+        else
+            mixer.pan(voices[i], Int(x*50.0f));
+        mixer.volume(voices[i], Int(100.0f - distance*10.0f));
+    }
+}
+
+
+int
+main(int argc, char** argv)
+{
+    RaceSim::Settings settings = RaceSim::defaultSettings( );
+    UInt races = 1;
+    UInt cars = RACESIM_MAXRACERS;
+    Boolean quiet = false;
+    Boolean audio = false;
+    const Char* trackName = 0;
+    const Char* waveName = 0;
+    const Char* soundFolder = "../topspeed/Sounds";
+    SoundMixer::Interpolation interpolation = SoundMixer::linear;
+    for (Int i = 1; i < argc; ++i)
+    {
+        if ((strcmp(argv[i], "-q") == 0))
+            quiet = true;
+        else if ((strcmp(argv[i], "-a") == 0))
+            audio = true;
+        else if ((argv[i][0] == '-') && (i + 1 < argc))
+        {
+            switch (argv[i][1])
+            {
+            case 'l': settings.laps       = atoi(argv[++i]); break;
+            case 'd': settings.difficulty = atoi(argv[++i]); break;
+            case 's': settings.seed       = atoi(argv[++i]); break;
+            case 'n': races               = atoi(argv[++i]); break;
+            case 'c': cars                = atoi(argv[++i]); break;
+            case 't': settings.timeStep   = Float(atof(argv[++i])); break;
+            case 'w': waveName            = argv[++i]; audio = true; break;
+            case 'S': soundFolder         = argv[++i]; break;
+            case 'i': interpolation       = (strcmp(argv[++i], "sinc") == 0) ? SoundMixer::sinc : SoundMixer::linear; break;
+            default:  usage( ); return 1;
+            }
+        }
+        else
+            trackName = argv[i];
+    }
+    if ((trackName == 0) || (cars == 0) || (cars > RACESIM_MAXRACERS) || (settings.timeStep <= 0.0f))
+    {
+        usage( );
+        return 1;
+    }
+
+    TrackGeometry track;
+    if (!track.load(trackName))
+    {
+        printf("racesim: cannot load the track %s\n", trackName);
+        usage( );
+        return 1;
+    }
+    track.buildIndex( );
+
+    UInt wins[NVEHICLES];
+    UInt starts[NVEHICLES];
+    Double finishTime[NVEHICLES];
+    UInt finishes[NVEHICLES];
+    memset(wins, 0, sizeof(wins));
+    memset(starts, 0, sizeof(starts));
+    memset(finishes, 0, sizeof(finishes));
+    for (UInt v = 0; v < NVEHICLES; ++v)
+        finishTime[v] = 0.0;
+
+    AudioDevice* device = 0;
+    SoundMixer::Sample engines[NVEHICLES];
+    memset(engines, 0, sizeof(engines));
+    if (audio)
+    {
+        if (waveName)
+            device = new WaveFileAudioDevice(waveName);
+        else
+            device = new NullAudioDevice( );
+        for (UInt v = 0; v < NVEHICLES; ++v)
+        {
+            Char fileName[256];
+            sprintf(fileName, "%s/vehicle%u_e.wav", soundFolder, v + 1);
+            if (!SoundMixer::loadWave(fileName, engines[v]))
+            {
+                printf("racesim: cannot load %s\n", fileName);
+                return 1;
+            }
+        }
+    }
+    SoundMixer* mixer = new SoundMixer(device, SAMPLERATE);
+    mixer->interpolation(interpolation);
+    clock_t mixTime = 0;
+    UHuge mixedFrames = 0;
+
+    UInt seed = settings.seed;
+    clock_t begin = clock( );
+    for (UInt race = 0; race < races; ++race)
+    {
+        settings.seed = seed + race;
+        RaceSim sim(&track, settings);
+        for (UInt i = 0; i < cars; ++i)
+            sim.addRacer((settings.seed + i*5) % NVEHICLES);
+        if (!audio)
+            sim.run( );
+        else
+        {
+            Int voices[RACESIM_MAXRACERS];
+            Int gears[RACESIM_MAXRACERS];
+            for (UInt i = 0; i < sim.nRacers( ); ++i)
+            {
+                voices[i] = mixer->play(&engines[sim.racer(i).vehicle], true);
+                gears[i]  = 1;
+            }
+            Double pending = 0.0;
+            sim.start( );
+            while (sim.step( ))
+            {
+                pending += settings.timeStep * SAMPLERATE;
+                UInt nFrames = UInt(pending);
+                pending -= nFrames;
+                clock_t mixBegin = clock( );
+                updateEngines(*mixer, sim, track, voices, gears);
+                mixer->render(nFrames);
+                mixTime += clock( ) - mixBegin;
+                mixedFrames += nFrames;
+            }
+            for (UInt i = 0; i < sim.nRacers( ); ++i)
+                mixer->stop(voices[i]);
+        }
+
+        Int winner = -1;
+        for (UInt i = 0; i < sim.nRacers( ); ++i)
+        {
+            const RaceSim::Racer& racer = sim.racer(i);
+            ++starts[racer.vehicle];
+            if (racer.state == RaceSim::finished)
+            {
+                ++finishes[racer.vehicle];
+                finishTime[racer.vehicle] += racer.finishTime;
+                if ((winner < 0) || (racer.finishTime < sim.racer(winner).finishTime))
+                    winner = i;
+            }
+            if (!quiet)
+                printf("seed %u car %u vehicle %2u: %s %8.2f s, %u crashes, %u mini crashes, %u bumps\n",
+                       settings.seed, i + 1, racer.vehicle + 1,
+                       (racer.state == RaceSim::finished) ? "finished" : "dnf     ",
+                       racer.finishTime, racer.crashes, racer.miniCrashes, racer.bumps);
+        }
+        if (winner >= 0)
+            ++wins[sim.racer(winner).vehicle];
+    }
+    Double seconds = Double(clock( ) - begin) / CLOCKS_PER_SEC;
+
+    printf("vehicle  starts  wins  finishes  average time\n");
+    for (UInt v = 0; v < NVEHICLES; ++v)
+    {
+        if (starts[v] == 0)
+            continue;
+        printf("%7u  %6u  %4u  %8u  %12.2f\n", v + 1, starts[v], wins[v], finishes[v],
+               (finishes[v] > 0) ? finishTime[v] / finishes[v] : 0.0);
+    }
+    printf("%u races in %.2f s\n", races, seconds);
+    if (audio)
+    {
+        Double mixSeconds = Double(mixTime) / CLOCKS_PER_SEC;
+        printf("%.2f s of audio mixed in %.2f s", Double(mixedFrames) / SAMPLERATE, mixSeconds);
+        if (mixSeconds > 0.0)
+            printf(" (%.0fx real time)", Double(mixedFrames) / SAMPLERATE / mixSeconds);
+        printf("\n");
+    }
+    // the mixer closes the device, which finishes the wave file
+    delete mixer;
+    delete device;
+    for (UInt v = 0; v < NVEHICLES; ++v)
+        SoundMixer::freeWave(engines[v]);
+    return 0;
+}
@@ -0,0 +1,400 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#include <Common/If/SoundPackFormat.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+#ifdef _USE_VORBIS_
+#include <vorbis/codec.h>
+#include <vorbis/vorbisfile.h>
+#endif
+
+#define MAXSOUNDSIZE    8192        // kilobytes of PCM a sound may decode to, by default
+
+
+struct Packed
+{
+    std::string         key;
+    SoundPackEntry      entry;
+    std::vector<UByte>  data;
+};
+
+
+static Boolean
+byKey(const Packed* a, const Packed* b)
+{
+    return (a->key < b->key);
+}
+
+
+static void
+usage( )
+{
+    printf("usage: soundpack [options] folder pack\n");
+    printf("  -m kilobytes   leave sounds that decode to more as files (default %d)\n", MAXSOUNDSIZE);
+    printf("  -q             only print the summary\n");
+    printf("The keys are the paths from the parent of the folder, so run it from\n");
+    printf("the folder of the game: soundpack Sounds Sounds.pak\n");
+}
+
+
+static UInt
+readUShort(const UByte* p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+
+static UInt
+readUInt(const UByte* p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (UInt(p[3]) << 24);
+}
+
+
+static void
+setFormat(Packed& packed, UInt formatTag, UInt channels, UInt frequency, UInt bits)
+{
+    packed.entry.formatTag      = UShort(formatTag);
+    packed.entry.channels       = UShort(channels);
+    packed.entry.samplesPerSec  = frequency;
+    packed.entry.blockAlign     = UShort(channels*bits/8);
+    packed.entry.avgBytesPerSec = frequency*packed.entry.blockAlign;
+    packed.entry.bitsPerSample  = UShort(bits);
+}
+
+
+// Only PCM is packed, the one format DirectSound is sure to play.
+static Boolean
+loadWave(const Char* fileName, Packed& packed)
+{
+    FILE* file = fopen(fileName, "rb");
+    if (file == 0)
+        return false;
+    UByte chunk[8];
+    UByte format[16];
+    Boolean haveFormat = false;
+    Boolean loaded = false;
+    if ((fread(chunk, 1, 8, file) != 8) || (memcmp(chunk, "RIFF", 4) != 0) ||
+        (fread(chunk, 1, 4, file) != 4) || (memcmp(chunk, "WAVE", 4) != 0))
+    {
+        fclose(file);
+        return false;
+    }
+    while (fread(chunk, 1, 8, file) == 8)
+    {
+        UInt size = readUInt(chunk + 4);
+        if ((memcmp(chunk, "fmt ", 4) == 0) && (size >= 16))
+        {
+            if (fread(format, 1, 16, file) != 16)
+                break;
+            fseek(file, long(size - 16 + (size & 1)), SEEK_CUR);
+            haveFormat = true;
+        }
+        else if ((memcmp(chunk, "data", 4) == 0) && (haveFormat))
+        {
+            UInt channels = readUShort(format + 2);
+            UInt bits     = readUShort(format + 14);
+            if ((readUShort(format) != 1) || (channels == 0) || ((bits != 8) && (bits != 16)))
+                break;
+            setFormat(packed, 1, channels, readUInt(format + 4), bits);
+            packed.data.resize(size);
+            size = UInt(fread(&packed.data[0], 1, size, file));
+            packed.data.resize(size - size % packed.entry.blockAlign);
+            loaded = !packed.data.empty( );
+            break;
+        }
+        else
+            fseek(file, long(size + (size & 1)), SEEK_CUR);
+    }
+    fclose(file);
+    return loaded;
+}
+
+
+#ifdef _USE_VORBIS_
+static Boolean
+loadVorbis(const Char* fileName, Packed& packed)
+{
+    FILE* file = fopen(fileName, "rb");
+    if (file == 0)
+        return false;
+    OggVorbis_File vorbisFile;
+    if (ov_open(file, &vorbisFile, 0, 0) != 0)
+    {
+        fclose(file);
+        return false;
+    }
+    // decoded the way SoundManager::loadVorbis does it
+    vorbis_info* info = ov_info(&vorbisFile, -1);
+    setFormat(packed, 1, info->channels, info->rate, 16);
+    Char buffer[4096];
+    Int bitstream = 0;
+    long n;
+    while ((n = ov_read(&vorbisFile, buffer, sizeof(buffer), 0, 2, 1, &bitstream)) > 0)
+        packed.data.insert(packed.data.end( ), (UByte*) buffer, (UByte*) buffer + n);
+    ov_clear(&vorbisFile);
+    return (n == 0) && (!packed.data.empty( ));
+}
+#endif
+
+
+static Boolean
+endsWith(const std::string& name, const Char* extension)
+{
+    UInt length = UInt(strlen(extension));
+    if (name.size( ) < length)
+        return false;
+    for (UInt i = 0; i < length; ++i)
+    {
+        Char c = name[name.size( ) - length + i];
+        if ((c >= 'A') && (c <= 'Z'))
+            c = Char(c - 'A' + 'a');
+        if (c != extension[i])
+            return false;
+    }
+    return true;
+}
+
+
+// The files and folders in a folder, without "." and "..".
+static void
+listFolder(const std::string& folder, std::vector<std::string>& files, std::vector<std::string>& folders)
+{
+#ifdef _WIN32
+    WIN32_FIND_DATA findData;
+    HANDLE find = FindFirstFile((folder + "\\*").c_str( ), &findData);
+    if (find == INVALID_HANDLE_VALUE)
+        return;
+    do
+    {
+        std::string name = findData.cFileName;
+        if ((name == ".") || (name == ".."))
+            continue;
+        if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+            folders.push_back(name);
+        else
+            files.push_back(name);
+    }
+    while (FindNextFile(find, &findData));
+    FindClose(find);
+#else
+    DIR* dir = opendir(folder.c_str( ));
+    if (dir == 0)
+        return;
+    while (struct dirent* found = readdir(dir))
+    {
+        std::string name = found->d_name;
+        if ((name == ".") || (name == ".."))
+            continue;
+        struct stat status;
+        if (stat((folder + "/" + name).c_str( ), &status) != 0)
+            continue;
+        if (S_ISDIR(status.st_mode))
+            folders.push_back(name);
+        else
+            files.push_back(name);
+    }
+    closedir(dir);
+#endif
+}
+
+
+// Decodes every sound under folder, whose key starts with prefix.
+static void
+collect(const std::string& folder, const std::string& prefix, UInt maxSize, Boolean quiet,
+        std::vector<Packed*>& sounds, UInt& nSkipped)
+{
+    std::vector<std::string> files;
+    std::vector<std::string> folders;
+    listFolder(folder, files, folders);
+    for (UInt i = 0; i < files.size( ); ++i)
+    {
+        std::string path = folder + "/" + files[i];
+        Packed* packed = new Packed;
+        memset(&packed->entry, 0, sizeof(packed->entry));
+        Boolean loaded = false;
+        if (endsWith(files[i], ".wav"))
+            loaded = loadWave(path.c_str( ), *packed);
+#ifdef _USE_VORBIS_
+        else if (endsWith(files[i], ".ogg"))
+            loaded = loadVorbis(path.c_str( ), *packed);
+#endif
+        else
+        {
+            delete packed;
+            continue;
+        }
+        Char key[SOUNDPACKMAXKEY];
+        const Char* why = 0;
+        if (!loaded)
+            why = "cannot be decoded";
+        else if (packed->data.size( ) > maxSize)
+            why = "is too large";
+        else if (!soundPackKey((prefix + "\\" + files[i]).c_str( ), key))
+            why = "has too long a path";
+        if (why)
+        {
+            if (!quiet)
+                printf("soundpack: %s %s, left as a file\n", path.c_str( ), why);
+            ++nSkipped;
+            delete packed;
+            continue;
+        }
+        packed->key = key;
+        packed->entry.size = UInt(packed->data.size( ));
+        sounds.push_back(packed);
+    }
+    for (UInt i = 0; i < folders.size( ); ++i)
+        collect(folder + "/" + folders[i], prefix + "\\" + folders[i], maxSize, quiet, sounds, nSkipped);
+}
+
+
+static UInt
+aligned(UHuge offset)
+{
+    return UInt((offset + SOUNDPACKALIGNMENT - 1) / SOUNDPACKALIGNMENT * SOUNDPACKALIGNMENT);
+}
+
+
+static Boolean
+writePack(const Char* fileName, std::vector<Packed*>& sounds)
+{
+    SoundPackHeader header;
+    header.magic    = SOUNDPACKMAGIC;
+    header.version  = SOUNDPACKVERSION;
+    header.nEntries = UInt(sounds.size( ));
+    header.keysSize = 0;
+    UInt keys = UInt(sizeof(SoundPackHeader) + sounds.size( )*sizeof(SoundPackEntry));
+    for (UInt i = 0; i < sounds.size( ); ++i)
+    {
+        sounds[i]->entry.key = keys + header.keysSize;
+        header.keysSize += UInt(sounds[i]->key.size( )) + 1;
+    }
+    UHuge offset = aligned(keys + header.keysSize);
+    for (UInt i = 0; i < sounds.size( ); ++i)
+    {
+        sounds[i]->entry.data = UInt(offset);
+        offset = UHuge(sounds[i]->entry.data) + sounds[i]->entry.size;
+        if (offset > 0xffffffffULL - SOUNDPACKALIGNMENT)
+        {
+            printf("soundpack: the sounds take more than 4 GB\n");
+            return false;
+        }
+        offset = aligned(offset);
+    }
+
+    FILE* file = fopen(fileName, "wb");
+    if (file == 0)
+    {
+        printf("soundpack: cannot create %s\n", fileName);
+        return false;
+    }
+    static const UByte zeros[SOUNDPACKALIGNMENT] = {0};
+    fwrite(&header, sizeof(header), 1, file);
+    for (UInt i = 0; i < sounds.size( ); ++i)
+        fwrite(&sounds[i]->entry, sizeof(SoundPackEntry), 1, file);
+    for (UInt i = 0; i < sounds.size( ); ++i)
+        fwrite(sounds[i]->key.c_str( ), sounds[i]->key.size( ) + 1, 1, file);
+    UInt written = keys + header.keysSize;
+    for (UInt i = 0; i < sounds.size( ); ++i)
+    {
+        fwrite(zeros, 1, sounds[i]->entry.data - written, file);
+        fwrite(&sounds[i]->data[0], 1, sounds[i]->entry.size, file);
+        written = sounds[i]->entry.data + sounds[i]->entry.size;
+    }
+    fwrite(zeros, 1, aligned(written) - written, file);
+    Boolean ok = (ferror(file) == 0);
+    ok = (fclose(file) == 0) && (ok);
+    if (!ok)
+        printf("soundpack: cannot write %s\n", fileName);
+    return ok;
+}
+
+
+int
+main(int argc, char** argv)
+{
+    UInt maxSize = MAXSOUNDSIZE*1024;
+    Boolean quiet = false;
+    const Char* folderName = 0;
+    const Char* packName = 0;
+    for (Int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-q") == 0)
+            quiet = true;
+        else if ((strcmp(argv[i], "-m") == 0) && (i + 1 < argc))
+            maxSize = atoi(argv[++i])*1024;
+        else if (argv[i][0] == '-')
+        {
+            usage( );
+            return 1;
+        }
+        else if (folderName == 0)
+            folderName = argv[i];
+        else
+            packName = argv[i];
+    }
+    if ((folderName == 0) || (packName == 0))
+    {
+        usage( );
+        return 1;
+    }
+
+    // the key starts with the name of the folder itself, "Sounds"
+    std::string folder = folderName;
+    while ((folder.size( ) > 1) && ((folder[folder.size( ) - 1] == '/') || (folder[folder.size( ) - 1] == '\\')))
+        folder.erase(folder.size( ) - 1);
+    std::string::size_type slash = folder.find_last_of("/\\");
+    std::string prefix = (slash == std::string::npos) ? folder : folder.substr(slash + 1);
+
+    std::vector<Packed*> sounds;
+    UInt nSkipped = 0;
+#ifndef _USE_VORBIS_
+    printf("soundpack: built without Ogg Vorbis, so .ogg files are left as files\n");
+#endif
+    collect(folder, prefix, maxSize, quiet, sounds, nSkipped);
+    std::sort(sounds.begin( ), sounds.end( ), byKey);
+    // on a case sensitive file system two files can have the same key
+    for (UInt i = 1; i < sounds.size( ); )
+    {
+        if (sounds[i]->key != sounds[i - 1]->key)
+        {
+            ++i;
+            continue;
+        }
+        printf("soundpack: %s is there twice, only the first is packed\n", sounds[i]->key.c_str( ));
+        delete sounds[i];
+        sounds.erase(sounds.begin( ) + i);
+        ++nSkipped;
+    }
+    if (sounds.empty( ))
+    {
+        printf("soundpack: no sounds found in %s\n", folderName);
+        return 1;
+    }
+
+    UHuge total = 0;
+    for (UInt i = 0; i < sounds.size( ); ++i)
+        total += sounds[i]->entry.size;
+    Boolean ok = writePack(packName, sounds);
+    if (ok)
+        printf("soundpack: %u sounds, %.1f MB of PCM in %s, %u left as files\n",
+               (UInt) sounds.size( ), Double(total) / (1024.0*1024.0), packName, nSkipped);
+    for (UInt i = 0; i < sounds.size( ); ++i)
+        delete sounds[i];
+    return (ok) ? 0 : 1;
+}
@@ -0,0 +1,211 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#include <errno.h>
+#endif
+#include "Lobby.h"
+
+
+struct LobbyPlatform
+{
+    Boolean             threaded;
+#ifdef _WIN32
+    HANDLE              thread;
+#else
+    pthread_t           thread;
+#endif
+};
+
+
+Lobby::Lobby(const Settings& settings) :
+    m_settings(settings),
+    m_platform(new LobbyPlatform),
+    m_running(false),
+    m_nextTrack(settings.firstTrack % settings.nTracks),
+    m_readyTime(0.0f),
+    m_nTicks(0),
+    m_nLateTicks(0)
+{
+    m_platform->threaded = false;
+    m_transport.setApplication(RACEAPPLICATION);
+}
+
+
+Lobby::~Lobby( )
+{
+    stop( );
+    SAFE_DELETE(m_platform);
+}
+
+
+Boolean
+Lobby::start( )
+{
+    if (m_running)
+        return true;
+    m_raceServer.initialize(&m_transport, m_settings.name, m_settings.port);
+    m_running = true;
+#ifdef _WIN32
+    m_platform->thread   = CreateThread(0, 0, thread, this, 0, 0);
+    m_platform->threaded = (m_platform->thread != 0);
+#else
+    m_platform->threaded = (pthread_create(&m_platform->thread, 0, thread, this) == 0);
+#endif
+    if (!m_platform->threaded)
+    {
+        SERVER("(!) Lobby %s : failed to start the worker thread", m_settings.name);
+        m_running = false;
+        m_raceServer.finalize( );
+        return false;
+    }
+    SERVER("Lobby %s : hosting on port %d", m_settings.name, m_settings.port);
+    return true;
+}
+
+
+void
+Lobby::stop( )
+{
+    if (!m_platform->threaded)
+        return;
+    m_running = false;
+#ifdef _WIN32
+    WaitForSingleObject(m_platform->thread, INFINITE);
+    CloseHandle(m_platform->thread);
+    m_platform->thread = 0;
+#else
+    pthread_join(m_platform->thread, 0);
+#endif
+    m_platform->threaded = false;
+    m_raceServer.finalize( );
+    SERVER("Lobby %s : stopped", m_settings.name);
+}
+
+
+/**
+ * A monotonic clock in microseconds, for the tick loop.
+ */
+UHuge
+Lobby::now( )
+{
+#ifdef _WIN32
+    static LARGE_INTEGER frequency = { 0 };
+    if (frequency.QuadPart == 0)
+        QueryPerformanceFrequency(&frequency);
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return UHuge(counter.QuadPart / frequency.QuadPart) * 1000000 +
+           UHuge(counter.QuadPart % frequency.QuadPart) * 1000000 / UHuge(frequency.QuadPart);
+#else
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return UHuge(time.tv_sec) * 1000000 + UHuge(time.tv_nsec) / 1000;
+#endif
+}
+
+
+void
+Lobby::sleepUntil(UHuge time)
+{
+#if defined(_WIN32)
+    UHuge current = now( );
+    if (time > current)
+        Sleep(DWORD((time - current) / 1000));
+#elif defined(__linux__)
+    struct timespec deadline;
+    deadline.tv_sec  = time_t(time / 1000000);
+    deadline.tv_nsec = long(time % 1000000) * 1000;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, 0) == EINTR)
+        ;
+#else
+    UHuge current = now( );
+    if (time > current)
+    {
+        struct timespec delay;
+        delay.tv_sec  = time_t((time - current) / 1000000);
+        delay.tv_nsec = long((time - current) % 1000000) * 1000;
+        nanosleep(&delay, 0);
+    }
+#endif
+}
+
+
+#ifdef _WIN32
+unsigned long __stdcall
+#else
+void*
+#endif
+Lobby::thread(void* param)
+{
+    static_cast<Lobby*>(param)->run( );
+    return 0;
+}
+
+
+// Ticks at fixed times rather than fixed intervals, so the rate does not
+// drift with the time a tick takes. When a tick runs late the next one
+// is scheduled from now instead of catching up with a burst.
+void
+Lobby::run( )
+{
+    UHuge last = now( );
+    UHuge next = last + m_settings.tickTime;
+    while (m_running)
+    {
+        sleepUntil(next);
+        UHuge current = now( );
+        update(Float(current - last) / 1000000.0f);
+        last = current;
+        next += m_settings.tickTime;
+        ++m_nTicks;
+        if (now( ) > next)
+        {
+            ++m_nLateTicks;
+            next = now( ) + m_settings.tickTime;
+        }
+    }
+}
+
+
+void
+Lobby::update(Float elapsed)
+{
+    m_raceServer.run(elapsed);
+    if (m_raceServer.raceStarted( ))
+        return;
+    UInt nPlayers = m_raceServer.nPlayers( );
+    if (nPlayers == 0)
+    {
+        m_readyTime = 0.0f;
+        return;
+    }
+    if (!m_raceServer.trackSelected( ))
+    {
+        const Char* track = m_settings.tracks[m_nextTrack];
+        m_nextTrack = (m_nextTrack + 1) % m_settings.nTracks;
+        SERVER("Lobby %s : %d players waiting, loading track %s", m_settings.name, nPlayers, track);
+        m_raceServer.loadCustomTrack(track, m_settings.nrOfLaps);
+        m_readyTime = 0.0f;
+        return;
+    }
+    if (m_raceServer.nPlayers(awaitingStart) < nPlayers)
+    {
+        m_readyTime = 0.0f;
+        return;
+    }
+    m_readyTime += elapsed;
+    if (m_readyTime >= m_settings.startDelay)
+    {
+        SERVER("Lobby %s : starting the race with %d players", m_settings.name, nPlayers);
+        m_raceServer.startRace( );
+        m_readyTime = 0.0f;
+    }
+}
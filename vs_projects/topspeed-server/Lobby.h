@@ -0,0 +1,77 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __RACING_LOBBY_H__
+#define __RACING_LOBBY_H__
+
+#include "../topspeed/RaceServer.h"
+#include <DxCommon/If/UdpTransport.h>
+
+extern Tracer  _serverTracer;
+#define  SERVER _serverTracer.trace
+
+struct LobbyPlatform;
+
+
+// One race session of the dedicated server: a RaceServer on its own
+// UDP port, ticked by its own worker thread. Nobody at the server picks
+// the track or presses enter, so the lobby takes the next track of the
+// rotation as soon as players are waiting, and starts the race once all
+// of them have been ready for a while.
+class Lobby
+{
+public:
+    struct Settings
+    {
+        UInt            port;
+        const Char*     name;
+        UInt            nrOfLaps;
+        UInt            tickTime;       // in microseconds
+        Float           startDelay;     // seconds all players must be ready before the race starts
+        const Char**    tracks;
+        UInt            nTracks;
+        UInt            firstTrack;
+    };
+
+public:
+    Lobby(const Settings& settings);
+    virtual ~Lobby( );
+
+public:
+    Boolean     start( );
+    void        stop( );
+
+    UInt        nPlayers( )             { return m_raceServer.nPlayers( );      }
+    Boolean     racing( )               { return m_raceServer.raceStarted( );   }
+    UHuge       nTicks( )               { return m_nTicks;                      }
+    UHuge       nLateTicks( )           { return m_nLateTicks;                  }
+
+    static UHuge    now( );
+
+private:
+#ifdef _WIN32
+    static unsigned long __stdcall  thread(void* param);
+#else
+    static void*                    thread(void* param);
+#endif
+    void        run( );
+    void        update(Float elapsed);
+    static void sleepUntil(UHuge time);
+
+private:
+    Settings                        m_settings;
+    DirectX::UdpServerTransport     m_transport;
+    RaceServer                      m_raceServer;
+    LobbyPlatform*                  m_platform;
+    volatile Boolean                m_running;
+    UInt                            m_nextTrack;
+    Float                           m_readyTime;
+    volatile UHuge                  m_nTicks;
+    volatile UHuge                  m_nLateTicks;   // ticks that started after the next one was due
+};
+
+
+#endif /* __RACING_LOBBY_H__ */
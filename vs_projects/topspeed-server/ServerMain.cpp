@@ -0,0 +1,162 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#include "Lobby.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#define MAXLOBBIES      64
+#define STATUSTIME      60          // seconds between two status lines
+
+Tracer  _raceTracer("race");
+Tracer  _serverTracer("server");
+
+static const Char* _defaultTracks[] =
+{
+    "america", "austria", "belgium", "brazil", "china", "england", "finland", "france",
+    "germany", "ireland", "italy", "netherlands", "portugal", "russia", "spain", "sweden",
+    "switserland"
+};
+
+static volatile Boolean _stopping = false;
+
+
+static void
+usage( )
+{
+    printf("usage: topspeed-server [options] [track ...]\n");
+    printf("  -p port        port of the first lobby, the others follow it (default %d)\n", RACEPORT);
+    printf("  -l lobbies     number of lobbies, at most %d (default 1)\n", MAXLOBBIES);
+    printf("  -n laps        number of laps (default 3)\n");
+    printf("  -t tick        milliseconds between two ticks of a lobby (default 10)\n");
+    printf("  -d delay       seconds all players must be ready before a race starts (default 5)\n");
+    printf("  -v             trace the race servers\n");
+    printf("Without tracks the lobbies take turns through the built-in circuits.\n");
+}
+
+
+static void
+onSignal(int)
+{
+    _stopping = true;
+}
+
+
+static void
+sleepSeconds(UInt seconds)
+{
+#ifdef _WIN32
+    Sleep(seconds * 1000);
+#else
+    sleep(seconds);
+#endif
+}
+
+
+int
+main(int argc, char** argv)
+{
+    UInt port = RACEPORT;
+    UInt nLobbies = 1;
+    UInt laps = 3;
+    Float tick = 10.0f;
+    Float delay = 5.0f;
+    const Char* tracks[256];
+    UInt nTracks = 0;
+    for (Int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-v") == 0)
+            _raceTracer.enable( );
+        else if ((argv[i][0] == '-') && (i + 1 < argc))
+        {
+            switch (argv[i][1])
+            {
+            case 'p': port      = atoi(argv[++i]); break;
+            case 'l': nLobbies  = atoi(argv[++i]); break;
+            case 'n': laps      = atoi(argv[++i]); break;
+            case 't': tick      = Float(atof(argv[++i])); break;
+            case 'd': delay     = Float(atof(argv[++i])); break;
+            default:  usage( ); return 1;
+            }
+        }
+        else if ((argv[i][0] != '-') && (nTracks < sizeof(tracks)/sizeof(tracks[0])))
+            tracks[nTracks++] = argv[i];
+        else
+        {
+            usage( );
+            return 1;
+        }
+    }
+    if ((nLobbies == 0) || (nLobbies > MAXLOBBIES) || (laps == 0) || (tick <= 0.0f) || (port == 0) || (port + nLobbies > 65536))
+    {
+        usage( );
+        return 1;
+    }
+    if (nTracks == 0)
+    {
+        for (nTracks = 0; nTracks < sizeof(_defaultTracks)/sizeof(_defaultTracks[0]); ++nTracks)
+            tracks[nTracks] = _defaultTracks[nTracks];
+    }
+    _serverTracer.enable( );
+    setvbuf(stdout, 0, _IOLBF, BUFSIZ);
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    Char names[MAXLOBBIES][16];
+    Lobby* lobbies[MAXLOBBIES];
+    UInt nStarted = 0;
+    for (UInt i = 0; i < nLobbies; ++i)
+    {
+        Lobby::Settings settings;
+        sprintf(names[i], "%d", i + 1);
+        settings.port       = port + i;
+        settings.name       = names[i];
+        settings.nrOfLaps   = laps;
+        settings.tickTime   = UInt(tick * 1000.0f);
+        settings.startDelay = delay;
+        settings.tracks     = tracks;
+        settings.nTracks    = nTracks;
+        // spread the lobbies over the rotation, so they do not all race the same track
+        settings.firstTrack = i % nTracks;
+        lobbies[i] = new Lobby(settings);
+        if (lobbies[i]->start( ))
+            ++nStarted;
+    }
+    if (nStarted == 0)
+    {
+        SERVER("(!) no lobby could be started");
+        for (UInt i = 0; i < nLobbies; ++i)
+            SAFE_DELETE(lobbies[i]);
+        return 1;
+    }
+
+    UInt seconds = 0;
+    while (!_stopping)
+    {
+        sleepSeconds(1);
+        if (++seconds % STATUSTIME != 0)
+            continue;
+        for (UInt i = 0; i < nLobbies; ++i)
+        {
+            if (lobbies[i]->nPlayers( ) > 0)
+                SERVER("Lobby %s : %d players, %s, %llu of %llu ticks late", names[i], lobbies[i]->nPlayers( ),
+                       (lobbies[i]->racing( )) ? "racing" : "waiting",
+                       (unsigned long long)lobbies[i]->nLateTicks( ), (unsigned long long)lobbies[i]->nTicks( ));
+        }
+    }
+
+    SERVER("shutting down");
+    for (UInt i = 0; i < nLobbies; ++i)
+        SAFE_DELETE(lobbies[i]);
+    return 0;
+}
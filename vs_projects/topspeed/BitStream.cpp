@@ -0,0 +1,139 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#include "BitStream.h"
+
+
+BitWriter::BitWriter(UByte* buffer, UInt size) :
+    m_buffer(buffer),
+    m_size(size),
+    m_position(0),
+    m_overflow(false)
+{
+}
+
+
+BitWriter::~BitWriter( )
+{
+}
+
+
+void
+BitWriter::write(UInt value, UInt nBits)
+{
+    if ((m_overflow) || (m_position + nBits > m_size*8))
+    {
+        m_overflow = true;
+        return;
+    }
+    while (nBits > 0)
+    {
+        UInt shift = m_position & 7;
+        UInt n = (8 - shift < nBits) ? 8 - shift : nBits;
+        UByte& byte = m_buffer[m_position >> 3];
+        if (shift == 0)
+            byte = 0;
+        byte |= (UByte)((value & ((1u << n) - 1)) << shift);
+        value >>= n;
+        nBits -= n;
+        m_position += n;
+    }
+}
+
+
+void
+BitWriter::writeVarint(UInt value, UInt groupBits)
+{
+    for (;;)
+    {
+        write(value, groupBits);
+        value = (groupBits < 32) ? value >> groupBits : 0;
+        writeBoolean(value != 0);
+        if (value == 0)
+            return;
+    }
+}
+
+
+void
+BitWriter::writeSigned(Int value, UInt groupBits)
+{
+    writeVarint((UInt(value) << 1) ^ UInt(value >> 31), groupBits);
+}
+
+
+UInt
+BitWriter::bitsFor(UInt value)
+{
+    UInt nBits = 0;
+    while (value)
+    {
+        ++nBits;
+        value >>= 1;
+    }
+    return nBits;
+}
+
+
+
+BitReader::BitReader(const UByte* buffer, UInt size) :
+    m_buffer(buffer),
+    m_size(size),
+    m_position(0),
+    m_failed(false)
+{
+}
+
+
+BitReader::~BitReader( )
+{
+}
+
+
+UInt
+BitReader::read(UInt nBits)
+{
+    if ((m_failed) || (m_position + nBits > m_size*8))
+    {
+        m_failed = true;
+        return 0;
+    }
+    UInt value = 0;
+    UInt done  = 0;
+    while (done < nBits)
+    {
+        UInt shift = m_position & 7;
+        UInt n = (8 - shift < nBits - done) ? 8 - shift : nBits - done;
+        UInt bits = (m_buffer[m_position >> 3] >> shift) & ((1u << n) - 1);
+        value |= bits << done;
+        done += n;
+        m_position += n;
+    }
+    return value;
+}
+
+
+UInt
+BitReader::readVarint(UInt groupBits)
+{
+    UInt value = 0;
+    for (UInt shift = 0; shift < 32; shift += groupBits)
+    {
+        value |= read(groupBits) << shift;
+        if (!readBoolean( ))
+            return (m_failed) ? 0 : value;
+    }
+    m_failed = true;
+    return 0;
+}
+
+
+Int
+BitReader::readSigned(UInt groupBits)
+{
+    UInt value = readVarint(groupBits);
+    return Int(value >> 1) ^ -Int(value & 1);
+}
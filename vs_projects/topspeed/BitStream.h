@@ -0,0 +1,68 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __RACING_BITSTREAM_H__
+#define __RACING_BITSTREAM_H__
+
+#include <Common/If/Types.h>
+
+
+// Writes values into a buffer with as many bits as each of them needs,
+// lowest bit first. Varints are written in groups of groupBits, each
+// followed by a bit that says whether another group comes, so small
+// values take few bits. Signed varints are zigzag encoded first, so
+// small negative values are small too. Writing past the end of the
+// buffer stops the writer and sets overflow.
+class BitWriter
+{
+public:
+    BitWriter(UByte* buffer, UInt size);
+    virtual ~BitWriter( );
+
+public:
+    void        write(UInt value, UInt nBits);
+    void        writeBoolean(Boolean value)     { write(value ? 1 : 0, 1);  }
+    void        writeVarint(UInt value, UInt groupBits = 7);
+    void        writeSigned(Int value, UInt groupBits = 7);
+
+    UInt        size( )                         { return (m_position + 7) / 8; }
+    Boolean     overflow( )                     { return m_overflow;        }
+
+    static UInt bitsFor(UInt value);
+
+private:
+    UByte*      m_buffer;
+    UInt        m_size;             // in bytes
+    UInt        m_position;         // in bits
+    Boolean     m_overflow;
+};
+
+
+// Reads what a BitWriter wrote. Reading past the end of the buffer, or a
+// varint longer than 32 bits, returns 0 from then on and sets failed.
+class BitReader
+{
+public:
+    BitReader(const UByte* buffer, UInt size);
+    virtual ~BitReader( );
+
+public:
+    UInt        read(UInt nBits);
+    Boolean     readBoolean( )                  { return read(1) != 0;      }
+    UInt        readVarint(UInt groupBits = 7);
+    Int         readSigned(UInt groupBits = 7);
+
+    Boolean     failed( )                       { return m_failed;          }
+
+private:
+    const UByte*    m_buffer;
+    UInt            m_size;
+    UInt            m_position;
+    Boolean         m_failed;
+};
+
+
+#endif /* __RACING_BITSTREAM_H__ */
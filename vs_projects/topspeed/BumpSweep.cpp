@@ -0,0 +1,93 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#include "BumpSweep.h"
+#include <algorithm>
+
+
+BumpSweep::BumpSweep( ) :
+    m_lapLength(0)
+{
+}
+
+
+BumpSweep::~BumpSweep( )
+{
+}
+
+
+void
+BumpSweep::reset(UInt lapLength)
+{
+    m_lapLength = lapLength;
+    m_cars.clear( );
+    m_pairs.clear( );
+}
+
+
+void
+BumpSweep::add(UInt id, Int positionX, Int positionY)
+{
+    Car car;
+    car.id        = id;
+    car.positionX = positionX;
+    car.positionY = positionY;
+    if (m_lapLength > 0)
+        car.key = UInt(((positionY % Int(m_lapLength)) + Int(m_lapLength)) % Int(m_lapLength));
+    else
+        car.key = UInt(positionY) ^ 0x80000000;     // keeps the order of negative positions
+    m_cars.push_back(car);
+}
+
+
+UInt
+BumpSweep::sweep( )
+{
+    m_pairs.clear( );
+    UInt n = (UInt)m_cars.size( );
+    if (n < 2)
+        return 0;
+    std::sort(m_cars.begin( ), m_cars.end( ));
+    // short laps would let a car reach the same car both ways round
+    Boolean wrap = (m_lapLength > 2*BUMPRANGEY);
+    for (UInt i = 0; i < n; ++i)
+    {
+        const Car& a = m_cars[i];
+        for (UInt step = 1; step < n; ++step)
+        {
+            UInt j = i + step;
+            UHuge key = m_cars[j % n].key;
+            if (j >= n)
+            {
+                if (!wrap)
+                    break;
+                key += m_lapLength;
+            }
+            if (key - a.key >= BUMPRANGEY)
+                break;
+            const Car& b = m_cars[j % n];
+            Int bumpX = a.positionX - b.positionX;
+            if ((bumpX <= -BUMPRANGEX) || (bumpX >= BUMPRANGEX))
+                continue;
+            Int bumpY = a.positionY - b.positionY;
+            if (m_lapLength > 0)
+            {
+                bumpY %= Int(m_lapLength);
+                if (bumpY > Int(m_lapLength/2))
+                    bumpY -= Int(m_lapLength);
+                else if (bumpY < -Int(m_lapLength/2))
+                    bumpY += Int(m_lapLength);
+            }
+            Pair pair;
+            pair.a     = a.id;
+            pair.b     = b.id;
+            pair.bumpX = bumpX;
+            pair.bumpY = bumpY;
+            m_pairs.push_back(pair);
+        }
+    }
+    return (UInt)m_pairs.size( );
+}
@@ -0,0 +1,62 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __RACING_BUMPSWEEP_H__
+#define __RACING_BUMPSWEEP_H__
+
+#include <Common/If/Types.h>
+#include <vector>
+
+#define BUMPRANGEX      1000    // cars closer than this sideways...
+#define BUMPRANGEY      500     // ...and along the track touch each other
+
+
+// Finds every pair of cars that touch, for RaceServer, LevelSingleRace and
+// RaceSim. The cars are sorted on their distance into the lap, then each
+// one is only compared with the cars after it that are within BUMPRANGEY,
+// which takes O(n log n) instead of comparing all pairs. Positions wrap at
+// the end of the lap, so a car lapping another one bumps it too.
+class BumpSweep
+{
+public:
+    struct Pair
+    {
+        UInt            a;
+        UInt            b;
+        Int             bumpX;          // a - b
+        Int             bumpY;          // a - b, the shortest way around the lap
+    };
+
+public:
+    BumpSweep( );
+    virtual ~BumpSweep( );
+
+public:
+    void        reset(UInt lapLength);
+    void        add(UInt id, Int positionX, Int positionY);
+    UInt        sweep( );
+
+    UInt        nPairs( )                   { return (UInt)m_pairs.size( ); }
+    const Pair& pair(UInt i)                { return m_pairs[i];            }
+
+private:
+    struct Car
+    {
+        UInt            id;
+        Int             positionX;
+        Int             positionY;
+        UInt            key;            // distance into the lap
+        bool            operator< (const Car& other) const   { return key < other.key; }
+    };
+
+private:
+    UInt                m_lapLength;    // 0 when positions do not wrap
+    std::vector<Car>    m_cars;
+    std::vector<Pair>   m_pairs;
+};
+
+
+#endif /* __RACING_BUMPSWEEP_H__ */
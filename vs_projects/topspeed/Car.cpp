@@ -4,7 +4,6 @@
 #include "DxCommon/If/Common.h"
 #include "resource.h"
 #include "RaceInput.h"
-#include "CarDefs.h"
 
 #define MAXSURFACEFREQ 100000
 
@@ -67,16 +66,8 @@ Car::Car(Game* game, Track* track, UInt vehicle, Char* vehicleFile) :
     {
         officialParameters = vehicles[vehicle];
         m_carType = (CarType)vehicle;
-        m_acceleration  = officialParameters.acceleration;
-        m_deceleration  = officialParameters.deceleration;
-        m_topspeed      = officialParameters.topspeed;
-        m_idlefreq      = officialParameters.idlefreq;
-        m_topfreq       = officialParameters.topfreq;
-        m_shiftfreq     = officialParameters.shiftfreq;
-        m_gears         = officialParameters.gears;
-        m_steering      = officialParameters.steering;
-        m_steeringFactor= officialParameters.steeringFactor;
-        m_frequency     = m_idlefreq;
+        m_parameters    = officialParameters;
+        m_frequency     = m_parameters.idlefreq;
         m_soundEngine   = m_soundManager->create(officialParameters.engineSound);
         // m_soundEngine->playInSoftware(true);
         m_soundStart    = m_soundManager->create(officialParameters.startSound);
@@ -101,15 +92,15 @@ Car::Car(Game* game, Track* track, UInt vehicle, Char* vehicleFile) :
         ::strncpy(m_customFile, vehicleFile, length-4);
         m_customFile[length-4] = '\0';
         File file(vehicleFile, File::read);
-        file.readInt("acceleration", m_acceleration, 10);
-        file.readInt("deceleration", m_deceleration, 40);
-        file.readInt("topspeed", m_topspeed, 15000);
-        file.readInt("idlefreq", m_idlefreq, 11000);
-        file.readInt("topfreq", m_topfreq, 50000);
-        file.readInt("shiftfreq", m_shiftfreq, 40000);
-        file.readInt("numberofgears", m_gears, 5);
-        file.readInt("steering", m_steering, 100);
-        file.readInt("steeringfactor", m_steeringFactor, 40);
+        file.readInt("acceleration", m_parameters.acceleration, 10);
+        file.readInt("deceleration", m_parameters.deceleration, 40);
+        file.readInt("topspeed", m_parameters.topspeed, 15000);
+        file.readInt("idlefreq", m_parameters.idlefreq, 11000);
+        file.readInt("topfreq", m_parameters.topfreq, 50000);
+        file.readInt("shiftfreq", m_parameters.shiftfreq, 40000);
+        file.readInt("numberofgears", m_parameters.gears, 5);
+        file.readInt("steering", m_parameters.steering, 100);
+        file.readInt("steeringfactor", m_parameters.steeringFactor, 40);
         Char    engineSound[64];
         Char    throttleSound[64];
         Char    startSound[64];
@@ -287,6 +278,35 @@ Car::Car(Game* game, Track* track, UInt vehicle, Char* vehicleFile) :
 }
 
 
+// Queues the sounds the constructor will create on the sound loader.
+// Sounds named in a custom vehicle file are left to the constructor.
+void
+Car::prefetch(Game* game, UInt vehicle, Char* vehicleFile)
+{
+    if (vehicleFile == NULL)
+    {
+        Parameters& parameters = vehicles[vehicle];
+        game->prefetchResource(parameters.engineSound);
+        game->prefetchResource(parameters.startSound);
+        game->prefetchResource(parameters.hornSound);
+        if (parameters.throttleSound)
+            game->prefetchResource(parameters.throttleSound);
+        game->prefetchResource(parameters.crashSound);
+        game->prefetchResource(parameters.brakeSound);
+        if (parameters.backfireSound)
+            game->prefetchResource(parameters.backfireSound);
+    }
+    game->prefetchResource(IDR_ASPHALT);
+    game->prefetchResource(IDR_GRAVEL);
+    game->prefetchResource(IDR_WATER);
+    game->prefetchResource(IDR_SAND);
+    game->prefetchResource(IDR_SNOW);
+    game->prefetchResource(IDR_CRASH_SHORT);
+    game->prefetchResource(IDR_BUMP1);
+    game->prefetchResource(IDR_BADSWITCH);
+}
+
+
 Car::~Car( )
 {
     RACE("(-) Car");
@@ -351,8 +371,8 @@ Car::start( )
     pushEvent(Event::carStart, m_soundStart->length()-0.1f);
     m_soundStart->play( );
     m_speed = 0;
-    m_prevFrequency = m_idlefreq;
-    m_frequency = m_idlefreq;
+    m_prevFrequency = m_parameters.idlefreq;
+    m_frequency = m_parameters.idlefreq;
     m_prevBrakeFrequency = 0;
     m_brakeFrequency = 0;
     m_prevSurfaceFrequency = 0;
@@ -478,32 +498,11 @@ void
 Car::bump(Int bumpX, Int bumpY, Int bumpSpeed)
 {
     RACE("Car::bump(%d, %d)", bumpX, bumpY);
-    if (bumpY > 0)
-    {
-        m_speed -= bumpSpeed;
-        m_positionY += bumpY;
-    }
-    else if (bumpY < 0)
-    {
-        m_speed -= bumpSpeed;
-        m_positionY += bumpY;
-    }
-    if (bumpX > 0)
-    {
-        m_positionX += 2*bumpX;
-        m_speed -= m_speed/5;
-        if (m_effectBumpLeft)
-            m_effectBumpLeft->play( );
-    }
-    else if (bumpX < 0)
-    {
-        m_positionX += 2*bumpX;
-        m_speed -= m_speed/5;
-        if (m_effectBumpRight)
-            m_effectBumpRight->play( );
-    }
-    if (m_speed < 0)
-        m_speed = 0;
+    CarPhysics::bump(m_positionX, m_positionY, m_speed, bumpX, bumpY, bumpSpeed);
+    if ((bumpX > 0) && (m_effectBumpLeft))
+        m_effectBumpLeft->play( );
+    else if ((bumpX < 0) && (m_effectBumpRight))
+        m_effectBumpRight->play( );
     m_soundBump1->play( );
 }
 
@@ -560,30 +559,8 @@ Car::run(Float elapsed)
         Boolean gearUp      = m_game->raceInput()->getGearUp( );
         Boolean gearDown    = m_game->raceInput()->getGearDown( );
         
-        m_currentAcceleration = m_acceleration;
-        m_currentDeceleration = m_deceleration;
         m_speedDiff = 0;
-        switch (m_surface)
-        {
-            case Track::gravel:
-                m_currentAcceleration = (m_currentAcceleration*2)/3;
-                m_currentDeceleration = (m_currentDeceleration*2)/3;
-                break;
-            case Track::water:
-                m_currentAcceleration = (m_currentAcceleration*3)/5;
-                m_currentDeceleration = (m_currentDeceleration*3)/5;
-                break;
-            case Track::sand:
-                m_currentAcceleration = (m_currentAcceleration)/2;
-                m_currentDeceleration = (m_currentDeceleration*3)/2;
-                break;
-            case Track::snow:
-                // m_currentAcceleration = m_currentAcceleration;
-                m_currentDeceleration = (m_currentDeceleration)/2;
-                break;
-            default:
-                break;
-        }
+        CarPhysics::surfaceGrip(m_parameters, m_surface, false, m_currentAcceleration, m_currentDeceleration);
         m_factor1 = 100;
         if (m_manualTransmission)
         {
@@ -596,7 +573,7 @@ Car::run(Float elapsed)
                 stickReleased = false;
                 m_switchingGear = -1;
                 --m_gear;
-                if (m_soundEngine->frequency( ) > 3 * m_topfreq / 2)
+                if (m_soundEngine->frequency( ) > 3 * m_parameters.topfreq / 2)
                     m_soundBadSwitch->play( );
                 if (m_soundBackfire != 0)
                 {
@@ -607,12 +584,12 @@ Car::run(Float elapsed)
                 }
                 pushEvent(Event::inGear, 0.2f);
             }
-            else if ((gearUp) && (m_gear < m_gears) && (stickReleased))
+            else if ((gearUp) && (m_gear < m_parameters.gears) && (stickReleased))
             {
                 stickReleased = false;
                 m_switchingGear = 1;
                 ++m_gear;
-                if (m_soundEngine->frequency( ) < m_idlefreq)
+                if (m_soundEngine->frequency( ) < m_parameters.idlefreq)
                     m_soundBadSwitch->play( );
                 if (m_soundBackfire != 0)
                 {
@@ -653,8 +630,8 @@ Car::run(Float elapsed)
                 else
                 {
                     m_throttleVolume -= 10.0f * elapsed;
-                    if (m_throttleVolume < Float(m_speed * 95 / m_topspeed))
-                        m_throttleVolume = Float(m_speed * 95 / m_topspeed);
+                    if (m_throttleVolume < Float(m_speed * 95 / m_parameters.topspeed))
+                        m_throttleVolume = Float(m_speed * 95 / m_parameters.topspeed);
                     if ((Int)m_throttleVolume != (Int)m_prevThrottleVolume)
                     {
                         m_soundThrottle->volume((Int)m_throttleVolume);
@@ -665,38 +642,14 @@ Car::run(Float elapsed)
             else if (m_soundThrottle->playing( ))
                 m_soundThrottle->stop( );
         }
-        m_thrust   = m_currentThrottle;
-        if (m_currentThrottle == 0)
-            m_thrust = m_currentBrake;
-        else if (m_currentBrake == 0)
-            m_thrust = m_currentThrottle;
-        else if (-m_currentBrake > m_currentThrottle)
-            m_thrust = m_currentBrake;
-
-		m_factor2 = 1.0;
-		if ((m_currentSteering != 0) && (m_speed > m_topspeed/2))
-		{
-			m_factor2 = 1.0 - (1.5*m_speed/m_topspeed)*absval<int>(m_currentSteering)/100;			
-		}
-
-        if (m_thrust > 10)
-        {
-            m_speedDiff = Int((elapsed*m_thrust*m_currentAcceleration*m_factor1*m_factor2)/100);
-            if (m_backfirePlayed == true)
-                m_backfirePlayed = false;
-        }
-        else if (m_thrust < -10)
-            m_speedDiff = Int(elapsed*m_thrust*m_currentDeceleration);
-        else
-            m_speedDiff = Int(elapsed*-1000);
-
-        if (m_speedDiff > 0)
-            m_speedDiff = (Int)(m_speedDiff * (2.0f - ((m_topspeed + m_speed)*1.0f/(2.0f*m_topspeed))));
-        m_speed += m_speedDiff;
-        if (m_speed > m_topspeed)
-            m_speed = m_topspeed;
-        if (m_speed < 0)
-            m_speed = 0;
+        m_thrust   = CarPhysics::thrust(m_currentThrottle, m_currentBrake);
+        m_factor2  = CarPhysics::corneringFactor(m_parameters, m_speed, m_currentSteering);
+        if ((m_thrust > 10) && (m_backfirePlayed == true))
+            m_backfirePlayed = false;
+        Int prevSpeed = m_speed;
+        m_speed = CarPhysics::accelerate(m_parameters, elapsed, m_speed, m_thrust,
+                                         m_currentAcceleration, m_currentDeceleration, m_factor1, m_factor2);
+        m_speedDiff = m_speed - prevSpeed;
 
 		if (m_thrust <= 0)
 		{
@@ -716,10 +669,10 @@ Car::run(Float elapsed)
                 brakeSound();
 
                 if (m_effectSpring)
-                    m_effectSpring->gain(5000*m_speed/m_topspeed);
+                    m_effectSpring->gain(5000*m_speed/m_parameters.topspeed);
                 m_currentSteering = m_currentSteering*2/3;
             }
-        else if ((m_currentSteering != 0) && (m_speed > m_topspeed/2))
+        else if ((m_currentSteering != 0) && (m_speed > m_parameters.topspeed/2))
 		{
 			if (m_thrust > -50)
 			{
@@ -738,16 +691,13 @@ Car::run(Float elapsed)
         }
 
         m_positionY += Int(m_speed*elapsed);
-        if (m_surface != Track::snow)
-            m_positionX += Int(m_currentSteering*elapsed*m_steering*((5000.0f + m_speed*m_steeringFactor/100)/m_topspeed));
-        else
-            m_positionX += Int(m_currentSteering*elapsed*(m_steering*1.44f)*((5000.0f + m_speed*m_steeringFactor/100)/m_topspeed));
+        m_positionX += CarPhysics::steer(m_parameters, elapsed, m_speed, m_surface, m_currentSteering);
 
         // update frequencies
         if (m_frame % 4 == 0)
         {
             m_frame = 0;
-            m_brakeFrequency = 11025 + 22050*m_speed/m_topspeed;
+            m_brakeFrequency = 11025 + 22050*m_speed/m_parameters.topspeed;
             if (m_brakeFrequency != m_prevBrakeFrequency)
             {
                 m_soundBrake->frequency(m_brakeFrequency);
@@ -765,7 +715,7 @@ Car::run(Float elapsed)
             if (m_effectGravel)
             {
                 if (m_surface == Track::gravel)
-                    m_effectGravel->gain(m_speed*10000/m_topspeed);
+                    m_effectGravel->gain(m_speed*10000/m_parameters.topspeed);
                 else
                     m_effectGravel->gain(0);
             }
@@ -774,12 +724,12 @@ Car::run(Float elapsed)
                 if (m_speed == 0)
                     m_effectSpring->gain(10000);
                 else
-                    m_effectSpring->gain(10000*m_speed/m_topspeed);
+                    m_effectSpring->gain(10000*m_speed/m_parameters.topspeed);
             }
             if (m_effectEngine)
             {
-                if (m_speed < m_topspeed / 10)
-                    m_effectEngine->gain(10000 - m_speed*10/m_topspeed);
+                if (m_speed < m_parameters.topspeed / 10)
+                    m_effectEngine->gain(10000 - m_speed*10/m_parameters.topspeed);
                 else
                     m_effectEngine->gain(0);
             }
@@ -839,9 +789,7 @@ Car::run(Float elapsed)
     }
     else if (m_state == stopping)
     {
-        m_speed -= Int(elapsed*100*m_deceleration);
-        if (m_speed < 0)
-            m_speed = 0;
+        m_speed = CarPhysics::decelerate(m_parameters, elapsed, m_speed);
         // update frequencies
         if (m_frame % 4 == 0)
         {
@@ -863,38 +811,33 @@ Car::run(Float elapsed)
     }
     // Handle events
     Event* e = 0;
-    while (e = m_eventList.next(e))
+    while (e = m_eventList.next(m_game->currentTime( )))
     {
-        if (e->time < m_game->currentTime( ))
+        switch (e->type)
         {
-            switch (e->type)
-            {
 		case Event::carStart:
-                m_soundEngine->frequency(m_idlefreq);
-                if (m_soundThrottle)
-                    m_soundThrottle->frequency(m_idlefreq);
-                if (m_effectStart)
-                    m_effectStart->stop( );
-                m_soundEngine->play(0, true);
-                if (m_hasWipers == 1)
-                    m_soundWipers->play(0, true);
-                m_state = running;
-                break;
+            m_soundEngine->frequency(m_parameters.idlefreq);
+            if (m_soundThrottle)
+                m_soundThrottle->frequency(m_parameters.idlefreq);
+            if (m_effectStart)
+                m_effectStart->stop( );
+            m_soundEngine->play(0, true);
+            if (m_hasWipers == 1)
+                m_soundWipers->play(0, true);
+            m_state = running;
+            break;
 		case Event::carRestart:
-                if (m_effectCrash)
-                    m_effectCrash->stop( );
-                start( );
-                break;
+            if (m_effectCrash)
+                m_effectCrash->stop( );
+            start( );
+            break;
 		case Event::inGear:
-                m_switchingGear = 0;
-                break;
-            default:
-                break;
-            }
-            m_eventList.purge(e);
-            delete e;
-            e = 0;
+            m_switchingGear = 0;
+            break;
+        default:
+            break;
         }
+        m_eventList.release(e);
     }
 }
 
@@ -990,7 +933,7 @@ Car::evaluate(Track::Road road)
     {
         if (m_frame % 4 == 0)
         {
-            m_relPos = (m_positionX - road.left) / Float(m_laneWidth);
+            m_relPos = CarPhysics::relativePosition(m_positionX, road, Float(m_laneWidth));
             if (m_relPos - 0.5f < 0)
             {
                 m_panPos = Int((m_relPos - 0.5f)*(m_relPos - 0.5f)*(-100));
@@ -1195,7 +1138,7 @@ Car::evaluate(Track::Road road)
             }
             m_surface = road.surface;
 
-            m_relPos = (m_positionX - road.left) / Float(m_laneWidth);
+            m_relPos = CarPhysics::relativePosition(m_positionX, road, Float(m_laneWidth));
             if (m_relPos - 0.5f < 0)
             {
                 m_panPos = Int((m_relPos - 0.5f)*(m_relPos - 0.5f)*(-100));
@@ -1264,7 +1207,7 @@ Car::evaluate(Track::Road road)
             }
             if (m_effectCurbLeft)
             {
-                if ((m_relPos < 0.05) && (m_speed > m_topspeed / 10))
+                if ((m_relPos < 0.05) && (m_speed > m_parameters.topspeed / 10))
                 {
                     m_effectCurbLeft->play( );
                 }
@@ -1273,7 +1216,7 @@ Car::evaluate(Track::Road road)
             }
             if (m_effectCurbRight)
             {
-                if ((m_relPos > 0.95) && (m_speed > m_topspeed / 10))
+                if ((m_relPos > 0.95) && (m_speed > m_parameters.topspeed / 10))
                 {
                     m_effectCurbRight->play( );
                 }
@@ -1282,7 +1225,7 @@ Car::evaluate(Track::Road road)
             }
             if ((m_relPos < 0) || (m_relPos > 1))
             {
-                if (m_speed < m_topspeed/2)
+                if (m_speed < m_parameters.topspeed/2)
                     miniCrash((road.right + road.left)/2);
                 else
                     crash( );
@@ -1301,51 +1244,28 @@ Car::evaluate(Track::Road road)
 void 
 Car::pushEvent(Event::Type type, Float time)
 {
-    Event* e = new Event;
-    e->type = type;
-    e->time = m_game->currentTime( ) + time;
-    m_eventList.push(e);
+    m_eventList.push(type, m_game->currentTime( ) + time);
 }
 
 
 void 
 Car::updateEngineFreq( )
 {
-    Int gearRange = m_topspeed / (m_gears + 1);
-    if ((m_speed / gearRange) < 2)
-    {
-        Float gearSpeed = (Float(m_speed) / (2.0f * Float(gearRange)));
-        m_frequency = Int(gearSpeed * (m_topfreq - m_idlefreq)) + m_idlefreq;
-    }
-    else
+    Boolean shifting;
+    m_frequency = CarPhysics::engineFrequency(m_parameters, m_speed, m_gear, shifting);
+    if (m_soundBackfire != 0)
     {
-        // Int gear = m_speed / gearRange;
-        m_gear = m_speed / gearRange;
-        if (m_gear > m_gears)
-            m_gear = m_gears;
-        Float gearSpeed = (Float(m_speed) - Float(m_gear) * Float(gearRange)) / Float(gearRange);
-        if (gearSpeed < 0.07f)
+        if (shifting)
         {
-            m_frequency = Int(((0.07f - gearSpeed) / 0.07f) * Float(m_topfreq - m_shiftfreq) + m_shiftfreq);
-            if (m_soundBackfire != 0)
+            if (!m_backfirePlayedAuto)
             {
-                if (!m_backfirePlayedAuto)
-                {
-                    if ((random(5) == 1) && (!m_soundBackfire->playing( )))
-                        m_soundBackfire->play( );
-                }
-                m_backfirePlayedAuto = true;
+                if ((random(5) == 1) && (!m_soundBackfire->playing( )))
+                    m_soundBackfire->play( );
             }
+            m_backfirePlayedAuto = true;
         }
-        else
-        {
-            m_frequency = Int(gearSpeed * (m_topfreq - m_shiftfreq) + m_shiftfreq);
-            if (m_soundBackfire != 0)
-            {
-                if (m_backfirePlayedAuto)
-                    m_backfirePlayedAuto = false;
-            }
-        }        
+        else if (m_backfirePlayedAuto)
+            m_backfirePlayedAuto = false;
     }
     if (m_frequency != m_prevFrequency)
     {
@@ -1367,30 +1287,7 @@ Car::updateEngineFreq( )
 void
 Car::updateEngineFreqManual( )
 {
-    Int gearRange = m_topspeed / m_gears;
-    // m_frequency = m_shiftfreq;
-    if (m_gear == 1)
-    {
-        if (m_speed < Int((4.0f / 3.0f) * Float(gearRange)))
-        {
-            m_frequency = m_idlefreq + Int((Float(m_speed) * 3.0f / Float(2 * gearRange)) * Float(m_topfreq - m_idlefreq));
-        }
-        else
-        {
-            m_frequency = m_idlefreq + 2 * (m_topfreq - m_idlefreq);
-        }
-    }
-    else
-    {
-        Float shiftPoint = ((2.0f / 3.0f) + Float(m_gear-1)) * Float(gearRange);
-        m_frequency = Int((Float(m_speed) / shiftPoint) * Float(m_topfreq));
-        if (m_frequency > 2 * m_topfreq)
-            m_frequency = 2 * m_topfreq;
-        if (m_frequency < m_idlefreq / 2)
-            m_frequency = m_idlefreq / 2;
-    }
-    if (m_switchingGear != 0)
-        m_frequency = (2 * m_prevFrequency + m_frequency) / 3;
+    m_frequency = CarPhysics::engineFrequencyManual(m_parameters, m_speed, m_gear, m_switchingGear, m_prevFrequency);
     if (m_frequency != m_prevFrequency)
     {
         m_soundEngine->frequency(m_frequency);
@@ -1411,41 +1308,7 @@ Car::updateEngineFreqManual( )
 Int
 Car::calculateAcceleration( )
 {
-    Int gearSpeed = m_topspeed/m_gears;
-    Int gearCenter = Int(Float(gearSpeed) * (Float(m_gear) - 0.82f));
-    m_speedDiff = m_speed - gearCenter;
-    Float relSpeedDiff = Float(m_speedDiff) / Float(gearSpeed);
-    /* if (!m_manualTransmission)
-    {
-        if (relSpeedDiff > 1.1f)
-        {
-            m_switchingGear = 1;
-            ++m_gear;
-            pushEvent(Event::inGear, 0.2f);
-        }
-        else if (relSpeedDiff < -1.1f)
-        {
-            m_switchingGear = -1;
-            --m_gear;
-            pushEvent(Event::inGear, 0.2f);
-        }
-    } */
-    if (absval<Float>(relSpeedDiff) < 1.9f)
-    {
-        Int acceleration = Int(100.0f * (0.5f + cosf(relSpeedDiff * (DirectX::Pi) * 0.5f)));
-        if (acceleration < 5)
-            return 5;
-        else 
-            return acceleration;
-    }
-    else
-    {
-        Int acceleration = Int(100.0f * (0.5f + cosf(0.95f * (DirectX::Pi))));
-        if (acceleration < 5)
-            return 5;
-        else
-            return acceleration;
-    }
+    return CarPhysics::gearAcceleration(m_parameters, m_speed, m_gear);
 }
 
 
@@ -10,6 +10,7 @@
 #include "Game.h"
 #include "Track.h"
 #include "Packets.h"
+#include "CarPhysics.h"
 
 class Track;
 // class Car;
@@ -30,6 +31,9 @@ public:
     Car(Game* game, Track* track, UInt vehicle, Char* vehicleFile = NULL);
     virtual ~Car( );
 
+public:
+    static void prefetch(Game* game, UInt vehicle, Char* vehicleFile = NULL);
+
 public:
     enum State
     {
@@ -42,28 +46,7 @@ public:
     };
 
 public:
-    struct Parameters
-    {
-        // parameters 
-        Int                     engineSound;
-        Int                     startSound;
-        Int                     hornSound;
-        Int                     throttleSound;
-        Int                     crashSound;
-        Int                     monoCrashSound;
-        Int                     brakeSound;
-        Int                     backfireSound;
-        Int                     hasWipers;
-        Int                     acceleration;
-        Int                     deceleration;
-        Int                     topspeed;
-        Int                     idlefreq;
-        Int                     topfreq;
-        Int                     shiftfreq;
-        Int                     gears;
-        Int                     steering;
-        Int                     steeringFactor;
-    };
+    typedef CarPhysics::Parameters Parameters;
 
 public:
     void initialize(Int positionX = 0, Int positionY = 0);
@@ -136,7 +119,7 @@ private:
     DirectX::Sound*         m_soundBump1;
     DirectX::Sound*         m_soundBadSwitch;
     DirectX::Sound*	    m_soundBackfire;
-    EventList               m_eventList;
+    EventQueue              m_eventList;
     Int                     m_frame;
 
     Float                   m_prevThrottleVolume;
@@ -157,15 +140,7 @@ private:
     CarListener*            m_listener;
 
     // parameters   
-    Int                     m_acceleration;
-    Int                     m_deceleration;
-    Int                     m_topspeed;
-    Int                     m_idlefreq;
-    Int                     m_topfreq;
-    Int                     m_shiftfreq;
-    Int                     m_gears;
-    Int                     m_steering;
-    Int                     m_steeringFactor;
+    CarPhysics::Parameters  m_parameters;
     Int                     m_thrust;
     Int                     m_prevFrequency;
     Int                     m_frequency;
@@ -35,7 +35,7 @@
     };
 */
 
-Car::Parameters _vhc1 = 
+CarPhysics::Parameters _vhc1 = 
 {
     IDR_VEHICLE1E,
     IDR_VEHICLE1S,
@@ -57,7 +57,7 @@ Car::Parameters _vhc1 =
     60
 };
 
-Car::Parameters _vhc2 = 
+CarPhysics::Parameters _vhc2 = 
 {
     IDR_VEHICLE2E,
     IDR_VEHICLE2S,
@@ -79,7 +79,7 @@ Car::Parameters _vhc2 =
     55
 };
 
-Car::Parameters _vhc3 = 
+CarPhysics::Parameters _vhc3 = 
 {
     IDR_VEHICLE3E,
     IDR_VEHICLE1S,
@@ -102,7 +102,7 @@ Car::Parameters _vhc3 =
 };
 
 
-Car::Parameters _vhc4 = 
+CarPhysics::Parameters _vhc4 = 
 {
     IDR_VEHICLE4E,
     IDR_VEHICLE1S,
@@ -125,7 +125,7 @@ Car::Parameters _vhc4 =
 };
 
 
-Car::Parameters _vhc5 = 
+CarPhysics::Parameters _vhc5 = 
 {
     IDR_VEHICLE5E,
     IDR_VEHICLE1S,
@@ -147,7 +147,7 @@ Car::Parameters _vhc5 =
     80
 };
 
-Car::Parameters _vhc6 =
+CarPhysics::Parameters _vhc6 =
 {
     IDR_VEHICLE6E,
     IDR_VEHICLE1S,
@@ -169,7 +169,7 @@ Car::Parameters _vhc6 =
     95
 };
 
-Car::Parameters _vhc7 = 
+CarPhysics::Parameters _vhc7 = 
 {
     IDR_VEHICLE7E,
     IDR_VEHICLE1S,
@@ -191,7 +191,7 @@ Car::Parameters _vhc7 =
     65
 };
 
-Car::Parameters _vhc8 = 
+CarPhysics::Parameters _vhc8 = 
 {
     IDR_VEHICLE8E,
     IDR_VEHICLE1S,
@@ -213,7 +213,7 @@ Car::Parameters _vhc8 =
     70
 };
 
-Car::Parameters _vhc9 =
+CarPhysics::Parameters _vhc9 =
 {
     IDR_VEHICLE9E,
     IDR_VEHICLE9S,
@@ -235,7 +235,7 @@ Car::Parameters _vhc9 =
     85
 };
 
-Car::Parameters _vhc10 = 
+CarPhysics::Parameters _vhc10 = 
 {
     IDR_VEHICLE10E,
     IDR_VEHICLE10S,
@@ -257,7 +257,7 @@ Car::Parameters _vhc10 =
     50
 };
 
-Car::Parameters _vhc11 =
+CarPhysics::Parameters _vhc11 =
 {
     IDR_VEHICLE11E,
     IDR_VEHICLE11S,
@@ -279,7 +279,7 @@ Car::Parameters _vhc11 =
     50
 };
 
-Car::Parameters _vhc12 =
+CarPhysics::Parameters _vhc12 =
 {
     IDR_VEHICLE12E,
     IDR_VEHICLE12S,
@@ -301,7 +301,7 @@ Car::Parameters _vhc12 =
     66
 };
 
-Car::Parameters vehicles[NVEHICLES] = {_vhc1, _vhc2, _vhc3, _vhc4, _vhc5, _vhc6, _vhc7, _vhc8, _vhc9, _vhc10, _vhc11, _vhc12};
+CarPhysics::Parameters vehicles[NVEHICLES] = {_vhc1, _vhc2, _vhc3, _vhc4, _vhc5, _vhc6, _vhc7, _vhc8, _vhc9, _vhc10, _vhc11, _vhc12};
 
 
 #endif /* __RACING_CARDEFS_H__ */
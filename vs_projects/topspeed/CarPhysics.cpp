@@ -0,0 +1,342 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#include "CarPhysics.h"
+#include "resource.h"
+#include "CarDefs.h"
+#include <math.h>
+
+#define PI 3.141592654f
+
+
+static inline Int
+absInt(Int a)
+{
+    return (a < 0) ? -a : a;
+}
+
+
+void
+CarPhysics::surfaceGrip(const Parameters& p, Int surface, Boolean computer, Int& acceleration, Int& deceleration)
+{
+    acceleration = p.acceleration;
+    deceleration = p.deceleration;
+    switch (surface)
+    {
+        case TrackGeometry::gravel:
+            acceleration = (acceleration*2)/3;
+            deceleration = (deceleration*2)/3;
+            break;
+        case TrackGeometry::water:
+            acceleration = (acceleration*3)/5;
+            deceleration = (deceleration*3)/5;
+            break;
+        case TrackGeometry::sand:
+            if (computer)
+            {
+                acceleration = (acceleration*3)/8;
+                deceleration = (deceleration*5)/4;
+            }
+            else
+            {
+                acceleration = (acceleration)/2;
+                deceleration = (deceleration*3)/2;
+            }
+            break;
+        case TrackGeometry::snow:
+            deceleration = (deceleration)/2;
+            break;
+        default:
+            break;
+    }
+}
+
+
+Int
+CarPhysics::thrust(Int throttle, Int brake)
+{
+    if (throttle == 0)
+        return brake;
+    else if (brake == 0)
+        return throttle;
+    else if (-brake > throttle)
+        return brake;
+    return throttle;
+}
+
+
+Double
+CarPhysics::corneringFactor(const Parameters& p, Int speed, Int steering)
+{
+    if ((steering != 0) && (speed > p.topspeed/2))
+        return 1.0 - (1.5*speed/p.topspeed)*absInt(steering)/100;
+    return 1.0;
+}
+
+
+Int
+CarPhysics::accelerate(const Parameters& p, Float elapsed, Int speed, Int thrust,
+                       Int acceleration, Int deceleration, Int gearFactor, Double corneringFactor)
+{
+    Int speedDiff = 0;
+    if (thrust > 10)
+        speedDiff = Int((elapsed*thrust*acceleration*gearFactor*corneringFactor)/100);
+    else if (thrust < -10)
+        speedDiff = Int(elapsed*thrust*deceleration);
+    else
+        speedDiff = Int(elapsed*-1000);
+    if (speedDiff > 0)
+        speedDiff = (Int)(speedDiff * (2.0f - ((p.topspeed + speed)*1.0f/(2.0f*p.topspeed))));
+    speed += speedDiff;
+    if (speed > p.topspeed)
+        speed = p.topspeed;
+    if (speed < 0)
+        speed = 0;
+    return speed;
+}
+
+
+Int
+CarPhysics::decelerate(const Parameters& p, Float elapsed, Int speed)
+{
+    speed -= Int(elapsed*100*p.deceleration);
+    if (speed < 0)
+        speed = 0;
+    return speed;
+}
+
+
+Int
+CarPhysics::steer(const Parameters& p, Float elapsed, Int speed, Int surface, Int steering)
+{
+    if (surface != TrackGeometry::snow)
+        return Int(steering*elapsed*p.steering*((5000.0f + speed*p.steeringFactor/100)/p.topspeed));
+    else
+        return Int(steering*elapsed*(p.steering*1.44f)*((5000.0f + speed*p.steeringFactor/100)/p.topspeed));
+}
+
+
+Int
+CarPhysics::gearAcceleration(const Parameters& p, Int speed, Int gear)
+{
+    Int gearSpeed = p.topspeed/p.gears;
+    Int gearCenter = Int(Float(gearSpeed) * (Float(gear) - 0.82f));
+    Float relSpeedDiff = Float(speed - gearCenter) / Float(gearSpeed);
+    Int acceleration;
+    if (fabs(relSpeedDiff) < 1.9f)
+        acceleration = Int(100.0f * (0.5f + cosf(relSpeedDiff * PI * 0.5f)));
+    else
+        acceleration = Int(100.0f * (0.5f + cosf(0.95f * PI)));
+    if (acceleration < 5)
+        return 5;
+    return acceleration;
+}
+
+
+Int
+CarPhysics::engineFrequency(const Parameters& p, Int speed, Int& gear, Boolean& shifting)
+{
+    Int gearRange = p.topspeed / (p.gears + 1);
+    shifting = false;
+    if ((speed / gearRange) < 2)
+    {
+        Float gearSpeed = (Float(speed) / (2.0f * Float(gearRange)));
+        return Int(gearSpeed * (p.topfreq - p.idlefreq)) + p.idlefreq;
+    }
+    gear = speed / gearRange;
+    if (gear > p.gears)
+        gear = p.gears;
+    Float gearSpeed = (Float(speed) - Float(gear) * Float(gearRange)) / Float(gearRange);
+    if (gearSpeed < 0.07f)
+    {
+        shifting = true;
+        return Int(((0.07f - gearSpeed) / 0.07f) * Float(p.topfreq - p.shiftfreq) + p.shiftfreq);
+    }
+    return Int(gearSpeed * (p.topfreq - p.shiftfreq) + p.shiftfreq);
+}
+
+
+Int
+CarPhysics::engineFrequencyManual(const Parameters& p, Int speed, Int gear, Int switchingGear, Int prevFrequency)
+{
+    Int gearRange = p.topspeed / p.gears;
+    Int frequency;
+    if (gear == 1)
+    {
+        if (speed < Int((4.0f / 3.0f) * Float(gearRange)))
+            frequency = p.idlefreq + Int((Float(speed) * 3.0f / Float(2 * gearRange)) * Float(p.topfreq - p.idlefreq));
+        else
+            frequency = p.idlefreq + 2 * (p.topfreq - p.idlefreq);
+    }
+    else
+    {
+        Float shiftPoint = ((2.0f / 3.0f) + Float(gear-1)) * Float(gearRange);
+        frequency = Int((Float(speed) / shiftPoint) * Float(p.topfreq));
+        if (frequency > 2 * p.topfreq)
+            frequency = 2 * p.topfreq;
+        if (frequency < p.idlefreq / 2)
+            frequency = p.idlefreq / 2;
+    }
+    if (switchingGear != 0)
+        frequency = (2 * prevFrequency + frequency) / 3;
+    return frequency;
+}
+
+
+void
+CarPhysics::bump(Int& positionX, Int& positionY, Int& speed, Int bumpX, Int bumpY, Int bumpSpeed)
+{
+    if (bumpY != 0)
+    {
+        speed -= bumpSpeed;
+        positionY += bumpY;
+    }
+    if (bumpX != 0)
+    {
+        positionX += 2*bumpX;
+        speed -= speed/5;
+    }
+    if (speed < 0)
+        speed = 0;
+}
+
+
+Float
+CarPhysics::relativePosition(Int positionX, const TrackGeometry::Road& road, Float width)
+{
+    return Float(positionX - road.left) / width;
+}
+
+
+void
+CarPhysics::computerControls(const TrackGeometry::Road& road, const TrackGeometry::Road& nextRoad,
+                             Float relPos, Int difficulty, Int random, Controls& controls)
+{
+    controls.throttle = 100;
+    controls.steering = 0;
+    if ((road.type == TrackGeometry::hairpinLeft) || (nextRoad.type == TrackGeometry::hairpinLeft))
+    {
+        switch (difficulty)
+        {
+        case 0: // easy
+            if (relPos > 0.65f)
+                controls.steering = -100;
+            break;
+        case 1: // normal
+            if (relPos > 0.55f)
+                controls.steering = -100;
+            controls.throttle = 66;
+            break;
+        case 2: // hard
+            if (relPos > 0.55f)
+                controls.steering = -100;
+            controls.throttle = 33;
+            break;
+        default:
+            break;
+        }
+    }
+    else if ((road.type == TrackGeometry::hairpinRight) || (nextRoad.type == TrackGeometry::hairpinRight))
+    {
+        switch (difficulty)
+        {
+        case 0: // easy
+            if (relPos < 0.35f)
+                controls.steering = 100;
+            break;
+        case 1: // normal
+            if (relPos < 0.45f)
+                controls.steering = 100;
+            controls.throttle = 66;
+            break;
+        case 2: // hard
+            if (relPos < 0.45f)
+                controls.steering = 100;
+            controls.throttle = 33;
+            break;
+        default:
+            break;
+        }
+    }
+    else if (relPos < 0.40f)
+    {
+        if (relPos > 0.2f)
+        {
+            switch (difficulty)
+            {
+            case 0: // easy
+                controls.steering = 100 - random/5;
+                break;
+            case 1: // normal
+                controls.steering = 100 - random/10;
+                break;
+            case 2: // hard
+                controls.steering = 100 - random/25;
+                break;
+            default:
+                break;
+            }
+        }
+        else
+        {
+            switch (difficulty)
+            {
+            case 0: // easy
+                controls.steering = 100 - random/10;
+                break;
+            case 1: // normal
+                controls.steering = 100 - random/20;
+                controls.throttle = 75;
+                break;
+            case 2: // hard
+                controls.steering = 100;
+                controls.throttle = 50;
+                break;
+            default:
+                break;
+            }
+        }
+    }
+    else if (relPos > 0.6f)
+    {
+        if (relPos < 0.8f)
+        {
+            switch (difficulty)
+            {
+            case 0: // easy
+                controls.steering = -100 + random/5;
+                break;
+            case 1: // normal
+                controls.steering = -100 + random/10;
+                break;
+            case 2: // hard
+                controls.steering = -100 + random/25;
+                break;
+            default:
+                break;
+            }
+        }
+        else
+        {
+            switch (difficulty)
+            {
+            case 0: // easy
+                controls.steering = -100 + random/10;
+                break;
+            case 1: // normal
+                controls.steering = -100 + random/20;
+                controls.throttle = 75;
+                break;
+            case 2: // hard
+                controls.steering = -100;
+                controls.throttle = 50;
+                break;
+            default:
+                break;
+            }
+        }
+    }
+}
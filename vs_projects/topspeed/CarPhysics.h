@@ -0,0 +1,72 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __RACING_CARPHYSICS_H__
+#define __RACING_CARPHYSICS_H__
+
+#include <Common/If/Types.h>
+#include "TrackGeometry.h"
+
+#define NVEHICLES 12
+
+// The driving model shared by Car, ComputerPlayer and RaceSim.
+// Everything in here is plain arithmetic on the car's state; playing
+// sounds and force feedback effects is left to the callers.
+class CarPhysics
+{
+public:
+    struct Parameters
+    {
+        // parameters
+        Int                     engineSound;
+        Int                     startSound;
+        Int                     hornSound;
+        Int                     throttleSound;
+        Int                     crashSound;
+        Int                     monoCrashSound;
+        Int                     brakeSound;
+        Int                     backfireSound;
+        Int                     hasWipers;
+        Int                     acceleration;
+        Int                     deceleration;
+        Int                     topspeed;
+        Int                     idlefreq;
+        Int                     topfreq;
+        Int                     shiftfreq;
+        Int                     gears;
+        Int                     steering;
+        Int                     steeringFactor;
+    };
+
+    struct Controls
+    {
+        Int                     steering;
+        Int                     throttle;
+        Int                     brake;
+    };
+
+public:
+    static void     surfaceGrip(const Parameters& p, Int surface, Boolean computer, Int& acceleration, Int& deceleration);
+    static Int      thrust(Int throttle, Int brake);
+    static Double   corneringFactor(const Parameters& p, Int speed, Int steering);
+    static Int      accelerate(const Parameters& p, Float elapsed, Int speed, Int thrust,
+                               Int acceleration, Int deceleration, Int gearFactor = 100, Double corneringFactor = 1.0);
+    static Int      decelerate(const Parameters& p, Float elapsed, Int speed);
+    static Int      steer(const Parameters& p, Float elapsed, Int speed, Int surface, Int steering);
+    static Int      gearAcceleration(const Parameters& p, Int speed, Int gear);
+    static Int      engineFrequency(const Parameters& p, Int speed, Int& gear, Boolean& shifting);
+    static Int      engineFrequencyManual(const Parameters& p, Int speed, Int gear, Int switchingGear, Int prevFrequency);
+    static void     bump(Int& positionX, Int& positionY, Int& speed, Int bumpX, Int bumpY, Int bumpSpeed);
+    static Float    relativePosition(Int positionX, const TrackGeometry::Road& road, Float width);
+    static void     computerControls(const TrackGeometry::Road& road, const TrackGeometry::Road& nextRoad,
+                                     Float relPos, Int difficulty, Int random, Controls& controls);
+};
+
+
+extern CarPhysics::Parameters vehicles[NVEHICLES];
+
+
+#endif // __RACING_CARPHYSICS_H__
@@ -12,6 +12,7 @@
 #include "Game.h"
 #include "Track.h"
 #include "Packets.h"
+#include "CarPhysics.h"
 
 class ComputerPlayer
 {
@@ -70,10 +71,9 @@ public:
 
 private:
     void AI(/* Int playerPosY */);
-    Int calculateAcceleration( );
 
     void updateEngineFreq( );
-    void setSoundPosition(DirectX::Sound* sound, DirectX::Vector3 relPos);
+    void setSoundPosition(DirectX::Vector3 relPos);
     void horn( );
 
 private:
@@ -92,10 +92,11 @@ private:
     DirectX::Sound*         m_soundMiniCrash;
     DirectX::Sound*         m_soundBump1;
     DirectX::Sound*	      m_soundBackfire;
+    DirectX::Emitter        m_emitter;      // owns the sounds above
 
 //    DirectX::Sound*         m_soundInFront;
 //    DirectX::Sound*         m_soundOnTail;
-    EventList               m_eventList;
+    EventQueue              m_eventList;
     Int                     m_frame;
 
     Int                     m_surface;
@@ -109,15 +110,7 @@ private:
     Int                     m_trackLength;
 
     // parameters   
-    Int                     m_acceleration;
-    Int                     m_deceleration;
-    Int                     m_topspeed;
-    Int                     m_idlefreq;
-    Int                     m_topfreq;
-    Int                     m_shiftfreq;
-    Int                     m_gears;
-    Int                     m_steering;
-    Int                     m_steeringFactor;
+    CarPhysics::Parameters  m_parameters;
 
     Int                     m_playerNumber;
     // Int                     m_position;
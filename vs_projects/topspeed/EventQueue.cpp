@@ -0,0 +1,179 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#include "EventQueue.h"
+
+#define BLOCKSIZE 32
+
+
+EventQueue::EventQueue( ) :
+    m_heap(0),
+    m_size(0),
+    m_capacity(0),
+    m_sequence(0),
+    m_free(0),
+    m_blocks(0),
+    m_nBlocks(0)
+{
+}
+
+
+EventQueue::~EventQueue( )
+{
+    for (UInt i = 0; i < m_nBlocks; ++i)
+        SAFE_DELETE_ARRAY(m_blocks[i]);
+    SAFE_DELETE_ARRAY(m_blocks);
+    SAFE_DELETE_ARRAY(m_heap);
+}
+
+
+void
+EventQueue::push(Event::Type type, Float time, DirectX::Sound* sound)
+{
+    if (m_size == m_capacity)
+    {
+        UInt capacity = (m_capacity == 0) ? BLOCKSIZE : m_capacity*2;
+        Event** heap = new Event*[capacity];
+        for (UInt i = 0; i < m_size; ++i)
+            heap[i] = m_heap[i];
+        SAFE_DELETE_ARRAY(m_heap);
+        m_heap     = heap;
+        m_capacity = capacity;
+    }
+    Event* e    = allocate( );
+    e->type     = type;
+    e->time     = time;
+    e->sound    = sound;
+    e->sequence = m_sequence++;
+    e->next     = 0;
+    m_heap[m_size] = e;
+    up(m_size);
+    ++m_size;
+}
+
+
+Event*
+EventQueue::next(Float time)
+{
+    if (!due(time))
+        return 0;
+    Event* e = m_heap[0];
+    --m_size;
+    if (m_size > 0)
+    {
+        m_heap[0] = m_heap[m_size];
+        down(0);
+    }
+    return e;
+}
+
+
+void
+EventQueue::release(Event* e)
+{
+    if (e == 0)
+        return;
+    e->sound = 0;
+    e->next  = m_free;
+    m_free   = e;
+}
+
+
+void
+EventQueue::flushSounds( )
+{
+    UInt size = 0;
+    for (UInt i = 0; i < m_size; ++i)
+    {
+        if (m_heap[i]->sound)
+            release(m_heap[i]);
+        else
+            m_heap[size++] = m_heap[i];
+    }
+    m_size = size;
+    // rebuild the heap from the events that are left
+    for (UInt i = m_size/2; i > 0; --i)
+        down(i - 1);
+}
+
+
+void
+EventQueue::clear( )
+{
+    for (UInt i = 0; i < m_size; ++i)
+        release(m_heap[i]);
+    m_size = 0;
+}
+
+
+Event*
+EventQueue::allocate( )
+{
+    if (m_free == 0)
+    {
+        Event** blocks = new Event*[m_nBlocks + 1];
+        for (UInt i = 0; i < m_nBlocks; ++i)
+            blocks[i] = m_blocks[i];
+        SAFE_DELETE_ARRAY(m_blocks);
+        m_blocks = blocks;
+        Event* block = new Event[BLOCKSIZE];
+        m_blocks[m_nBlocks++] = block;
+        for (UInt i = 0; i < BLOCKSIZE; ++i)
+        {
+            block[i].sound = 0;
+            block[i].next  = m_free;
+            m_free = &block[i];
+        }
+    }
+    Event* e = m_free;
+    m_free = e->next;
+    return e;
+}
+
+
+Boolean
+EventQueue::before(Event* a, Event* b)
+{
+    if (a->time != b->time)
+        return a->time < b->time;
+    return (Int)(a->sequence - b->sequence) < 0;
+}
+
+
+void
+EventQueue::up(UInt i)
+{
+    Event* e = m_heap[i];
+    while (i > 0)
+    {
+        UInt parent = (i - 1)/2;
+        if (!before(e, m_heap[parent]))
+            break;
+        m_heap[i] = m_heap[parent];
+        i = parent;
+    }
+    m_heap[i] = e;
+}
+
+
+void
+EventQueue::down(UInt i)
+{
+    Event* e = m_heap[i];
+    for (;;)
+    {
+        UInt child = 2*i + 1;
+        if (child >= m_size)
+            break;
+        if ((child + 1 < m_size) && (before(m_heap[child + 1], m_heap[child])))
+            ++child;
+        if (!before(m_heap[child], e))
+            break;
+        m_heap[i] = m_heap[child];
+        i = child;
+    }
+    m_heap[i] = e;
+}
@@ -0,0 +1,89 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __RACING_EVENTQUEUE_H__
+#define __RACING_EVENTQUEUE_H__
+
+#include <DxCommon\If\Common.h>
+
+struct Event
+{
+    enum Type
+    {
+        carStart,
+        carComputerStart,
+        carRestart,
+        raceStart,
+        raceFinish,
+        playSound,
+//        playSoundAndDelete,
+//        deleteSound,
+        acceptInput,
+        playRadioSound,
+        inGear,
+        stopSessionEnum,
+        stopSessionEnumAndJoin,
+        playCurrentItem,
+        serverRaceStart,
+        startHorn,
+        stopHorn,
+        raceTimeFinalize,
+        acceptPlayerInfo,
+        acceptCurrentRaceInfo
+    };
+    Float           time;
+    Type            type;
+    DirectX::Sound* sound;
+//    UInt* number;
+    UInt            sequence;   // keeps events due at the same time in the order they were pushed
+    Event*          next;       // free list link while the event is in the pool
+};
+
+
+// Events ordered by the time they are due, kept in a binary min-heap.
+// Finding out that nothing is due is a single compare, and the events
+// themselves come from a pool, so pushing them doesn't allocate once
+// the queue has warmed up.
+//
+//     Event* e;
+//     while (e = m_eventList.next(now))
+//     {
+//         ... handle e ...
+//         m_eventList.release(e);
+//     }
+class EventQueue
+{
+public:
+    EventQueue( );
+    virtual ~EventQueue( );
+
+public:
+    void        push(Event::Type type, Float time, DirectX::Sound* sound = 0);
+    Boolean     due(Float time)    { return (m_size > 0) && (m_heap[0]->time <= time); }
+    Event*      next(Float time);
+    void        release(Event* e);
+    void        flushSounds( );
+    void        clear( );
+    UInt        size( )            { return m_size; }
+
+private:
+    Event*      allocate( );
+    Boolean     before(Event* a, Event* b);
+    void        up(UInt i);
+    void        down(UInt i);
+
+private:
+    Event**     m_heap;
+    UInt        m_size;
+    UInt        m_capacity;
+    UInt        m_sequence;
+    Event*      m_free;
+    Event**     m_blocks;
+    UInt        m_nBlocks;
+};
+
+
+#endif // __RACING_EVENTQUEUE_H__
@@ -20,6 +20,13 @@
 #include "resource.h"
 #include "Common\If\Algorithm.h"
 
+// The levels, cars and computer players always run with the same
+// timestep, no matter how often Windows gives us the idle loop.
+#define STEPFREQUENCY 120
+#define STEPTIME (1000000 / STEPFREQUENCY)   // microseconds
+#define MAXSTEPS 12                          // steps to catch up on at most per frame
+#define SOUNDPACK "Sounds.pak"               // the decoded sounds, built by the soundpack tool
+
 
 Tracer  _raceTracer("race");
 
@@ -27,6 +34,7 @@ Tracer  _raceTracer("race");
 Game::Game( ) :
     m_initialized(false),
     m_soundManager(0),
+    m_soundLoader(0),
     m_raceInput(0),
     m_menu(0),
     m_levelTimeTrial(0),
@@ -37,9 +45,12 @@ Game::Game( ) :
     m_nextVehicle(0),
     m_nextVehicleFile(NULL),
     m_raceServer(0),
+    m_serverTransport(0),
     m_raceClient(0),
+    m_accumulator(0),
     m_serverStarted(false),
     m_threeD(m_raceSettings.threeD),
+    m_loadingState(menu),
     m_pauseKeyReleased(true)
 {
     RACE("(+) Game");
@@ -49,6 +60,8 @@ Game::Game( ) :
     {
         RACE("Game : initializing COM failed with errorcode 0x%x", hres);
     }
+    // Let ::Sleep wake us up within a millisecond instead of a full scheduler quantum
+    timeBeginPeriod(1);
 }
 
 
@@ -60,16 +73,19 @@ Game::~Game( )
     m_raceInput->finalize( );
     SAFE_DELETE(m_raceInput);
     SAFE_DELETE(m_raceServer);
+    SAFE_DELETE(m_serverTransport);
     SAFE_DELETE(m_raceClient);
     SAFE_DELETE(m_menu);
     SAFE_DELETE(m_levelTimeTrial);
     SAFE_DELETE(m_levelSingleRace);
     SAFE_DELETE(m_levelMultiplayer);
+    SAFE_DELETE(m_soundLoader);
     SAFE_DELETE(m_soundManager);
     SAFE_DELETE(m_inputManager);
     RACE("~Game : uninitializing COM");
     CoUninitialize();
     RACE("~Game : uninitialized COM");
+    timeEndPeriod(1);
 }
 
 
@@ -81,22 +97,36 @@ Game::initialize(::Window::Handle handle)
     if (!m_raceSettings.hardwareAcceleration)
         m_soundManager->playInSoftware(true);
     m_soundManager->reverseStereo(m_raceSettings.reverseStereo);
+    // without a pack, every sound is read and decoded from its own file
+    if (m_soundManager->openPack(SOUNDPACK))
+        RACE("Game::initialize : sounds are taken from %s", SOUNDPACK);
+    m_soundLoader = new DirectX::SoundLoader(m_soundManager);
     strcpy(m_language, m_raceSettings.language);
     m_inputManager = new DirectX::InputManager;
     m_inputManager->initialize(handle);
     m_raceInput = new RaceInput(this);
     m_raceInput->initialize( );
-    m_raceServer = new RaceServer(this);
+    m_raceServer = new RaceServer;
     m_raceClient = new RaceClient(this);
 
+    // decode the numbers on all the loader threads, then pick them up from the cache
     Char numberSound[12];
     for (UInt i = 0; i <= 100; ++i)
+    {
+        sprintf(numberSound, "numbers\\%d", i);
+        prefetchLanguageSound(numberSound);
+    }
+    while (m_soundLoader->pending( ) > 0)
+        ::Sleep(1);
+    for (UInt i = 0; i <= 100; ++i)
     {
         sprintf(numberSound, "numbers\\%d", i);
         m_soundNumbers[i] = loadLanguageSound(numberSound);
     }
+    m_soundLoader->release( );
 
     m_timer.microElapsed( );
+    m_accumulator = 0;
     m_currentTime = 0.0f;
     state(menu);        
     m_initialized = true;
@@ -105,130 +135,229 @@ Game::initialize(::Window::Handle handle)
 void
 Game::run( )
 {
-    if (m_initialized)
+    if (!m_initialized)
+        return;
+    m_accumulator += m_timer.microElapsed( );
+    if (m_accumulator > MAXSTEPS * STEPTIME)
+    {
+        // we fell too far behind (loading, a debugger), drop the time instead of racing to catch up
+        m_accumulator = MAXSTEPS * STEPTIME;
+    }
+    if (m_accumulator >= STEPTIME)
     {
-        Huge helapsed = m_timer.microElapsed( );
-        Float elapsed = helapsed / 1000000.0f;
-        m_currentTime += elapsed;
         m_inputManager->update( );
         m_inputState = m_inputManager->state( );
         m_raceInput->run(m_inputState);
-        switch (m_state)
+        while (m_accumulator >= STEPTIME)
         {
-        case menu:
-            if (m_menu)
-                m_menu->run(elapsed);
-                    if (m_raceClient->raceAborted( ))
-                        m_raceClient->raceAborted(false);
-            break;
-        case quickStart:
-        case singleRace:
-            if (m_levelSingleRace)
+            State state = m_state;
+            m_accumulator -= STEPTIME;
+            step(STEPTIME / 1000000.0f);
+            if (m_state != state)
             {
-                m_levelSingleRace->run(elapsed);
-                if (m_inputState.keys[DIK_ESCAPE])
-                    state(menu);
+                // the next state starts with fresh input and a fresh clock
+                m_accumulator = 0;
+                break;
             }
-            break;
-        case timeTrial:
-            if (m_levelTimeTrial)
+        }
+        // the steps moved and played the sounds, now rank their voices
+        // and write what they set to DirectSound in one go
+        m_soundManager->voiceManager( )->update( );
+        m_soundManager->commit( );
+    }
+    wait( );
+}
+
+
+void
+Game::step(Float elapsed)
+{
+    m_currentTime += elapsed;
+    switch (m_state)
+    {
+    case menu:
+        if (m_menu)
+            m_menu->run(elapsed);
+                if (m_raceClient->raceAborted( ))
+                    m_raceClient->raceAborted(false);
+        break;
+    case quickStart:
+    case singleRace:
+        if (m_levelSingleRace)
+        {
+            m_levelSingleRace->run(elapsed);
+            if (m_inputState.keys[DIK_ESCAPE])
+                state(menu);
+        }
+        break;
+    case timeTrial:
+        if (m_levelTimeTrial)
+        {
+            m_levelTimeTrial->run(elapsed);
+            if (m_inputState.keys[DIK_ESCAPE])
+                state(menu);
+        }
+        break;
+    case multiplayer:
+        if (m_levelMultiplayer)
+        {
+            m_levelMultiplayer->run(elapsed);
+            if (((m_inputState.keys[DIK_ESCAPE]) && (!m_serverStarted)) || (m_raceClient->sessionLost( )) || (m_raceClient->forceDisconnected( )) || (m_raceClient->raceAborted( )))
             {
-                m_levelTimeTrial->run(elapsed);
-                if (m_inputState.keys[DIK_ESCAPE])
-                    state(menu);
+                if (m_raceClient->raceAborted( ))
+                    m_raceClient->raceAborted(false);
+                state(menu);
+                break;
             }
-            break;
-        case multiplayer:
-            if (m_levelMultiplayer)
+            if ((m_inputState.keys[DIK_ESCAPE]) && (m_serverStarted))
             {
-                m_levelMultiplayer->run(elapsed);
-                if (((m_inputState.keys[DIK_ESCAPE]) && (!m_serverStarted)) || (m_raceClient->sessionLost( )) || (m_raceClient->forceDisconnected( )) || (m_raceClient->raceAborted( )))
-                {
-                    if (m_raceClient->raceAborted( ))
-                        m_raceClient->raceAborted(false);
-                    state(menu);
-                    break;
-                }
-                if ((m_inputState.keys[DIK_ESCAPE]) && (m_serverStarted))
-                {
-                    m_raceServer->abortRace( );
-                    break;
-                }
+                m_raceServer->abortRace( );
+                break;
             }
+        }
+        break;
+    case loading:
+        if ((m_inputState.keys[DIK_ESCAPE]) && (m_loadingState != multiplayer))
+        {
+            m_soundLoader->cancel( );
+            m_soundLoader->release( );
+            // back to the menu as if the level had run
+            m_state = m_loadingState;
+            state(menu);
             break;
-        case awaitingGame:
-                if ((m_inputState.keys[DIK_ESCAPE]) || (m_raceClient->sessionLost( )) || (m_raceClient->forceDisconnected( )))
+        }
+        if (m_soundLoader->pending( ) == 0)
+            startLevel(m_loadingState);
+        break;
+    case awaitingGame:
+            if ((m_inputState.keys[DIK_ESCAPE]) || (m_raceClient->sessionLost( )) || (m_raceClient->forceDisconnected( )))
+        {
+            state(menu);
+            break;
+        }
+        if (m_raceClient->raceAborted( ))
+            m_raceClient->raceAborted(false);
+        if ((m_serverStarted) && (!m_raceServer->trackSelected( )))
+        {
+            m_raceServer->loadCustomTrack(m_nextTrack, m_raceSettings.nrOfLaps);
+            // RACE("*** Server selected track! Track name = '%s'", m_raceServer->track( ));
+            nextTrack(m_raceServer->track( ));
+            nextTrackData(m_raceServer->trackData( ));
+            if ((m_raceClient) && (m_raceClient->connected( )))
             {
-                state(menu);
+                state(multiplayer);
                 break;
             }
-            if (m_raceClient->raceAborted( ))
-                m_raceClient->raceAborted(false);
-            if ((m_serverStarted) && (!m_raceServer->trackSelected( )))
-            {
-                m_raceServer->loadCustomTrack(m_nextTrack);
-                // RACE("*** Server selected track! Track name = '%s'", m_raceServer->track( ));
-                nextTrack(m_raceServer->track( ));
-                nextTrackData(m_raceServer->trackData( ));
-                if ((m_raceClient) && (m_raceClient->connected( )))
-                {
-                    state(multiplayer);
-                    break;
-                }
-            }
-            if (m_raceClient)
+        }
+        if (m_raceClient)
+        {
+            if ((!m_serverStarted) && (m_raceClient->connected( )) && (m_raceClient->trackSelected( )))
             {
-                if ((!m_serverStarted) && (m_raceClient->connected( )) && (m_raceClient->trackSelected( )))
-                {
-                    // RACE("*** Client selected track! Track name = '%s'", m_raceClient->track( ));
-                    nextTrack(m_raceClient->track( ));
-                    nextTrackData(m_raceClient->trackData( ));
-                    state(multiplayer);
-                    break;
-                }
-                else if ((m_serverStarted) && (m_raceClient->connected( )) && (m_raceServer->trackSelected( )))
-                {
-                    state(multiplayer);
-                    break;
-                }
+                // RACE("*** Client selected track! Track name = '%s'", m_raceClient->track( ));
+                nextTrack(m_raceClient->track( ));
+                nextTrackData(m_raceClient->trackData( ));
+                state(multiplayer);
+                break;
             }
-            else
+            else if ((m_serverStarted) && (m_raceClient->connected( )) && (m_raceServer->trackSelected( )))
             {
-                state(menu);
-                break;            
+                state(multiplayer);
+                break;
             }
+        }
+        else
+        {
+            state(menu);
             break;            
-        case paused:
-            if ((!m_pauseKeyReleased) && (!m_raceInput->getPause( )))
-            {
-                m_pauseKeyReleased = true;
-            }
-            else if ((m_pauseKeyReleased) && (m_raceInput->getPause( )))
+        }
+        break;            
+    case paused:
+        if ((!m_pauseKeyReleased) && (!m_raceInput->getPause( )))
+        {
+            m_pauseKeyReleased = true;
+        }
+        else if ((m_pauseKeyReleased) && (m_raceInput->getPause( )))
+        {
+            m_pauseKeyReleased = false;
+            switch (m_pausedState)
             {
-                m_pauseKeyReleased = false;
-                switch (m_pausedState)
-                {
-                    case timeTrial:
-                        m_levelTimeTrial->unpause( );
-                        m_levelTimeTrial->stopStopwatchDiff( );
-                        break;
-                    case quickStart:
-                    case singleRace:
-                        m_levelSingleRace->unpause( );
-                        m_levelSingleRace->stopStopwatchDiff( );
-                        break;
-                }
-                m_state = m_pausedState;
+                case timeTrial:
+                    m_levelTimeTrial->unpause( );
+                    m_levelTimeTrial->stopStopwatchDiff( );
+                    break;
+                case quickStart:
+                case singleRace:
+                    m_levelSingleRace->unpause( );
+                    m_levelSingleRace->stopStopwatchDiff( );
+                    break;
             }
+            m_state = m_pausedState;
+        }
+        break;
+    default:
+        break;            
+    }
+}
+
+
+void
+Game::wait( )
+{
+    // Sleep until the next step is due, but leave the last
+    // millisecond to ::Sleep(0) so we don't oversleep it.
+    Huge remaining = STEPTIME - m_accumulator - m_timer.microElapsed(false);
+    if (remaining > 2000)
+        ::Sleep(DWORD((remaining - 1000) / 1000));
+    else if (remaining > 0)
+        ::Sleep(0);
+}
+
+// Queues the sounds of a level on the loader threads and waits for them in the
+// loading state, so the window keeps responding. The level itself is created
+// by startLevel once everything is in the sound cache.
+void
+Game::load(State state)
+{
+    if ((m_menu) && (m_state == menu))
+        m_menu->finalize( );
+    RACE("Game::load : loading sounds for state %d", state);
+    Level::prefetch(this, m_nextVehicle, m_nextVehicleFile);
+    m_loadingState = state;
+    m_timer.microElapsed( );
+    m_state = loading;
+}
+
+void
+Game::startLevel(State state)
+{
+    RACE("Game::startLevel : state %d", state);
+    switch (state)
+    {
+        case timeTrial:
+            m_levelTimeTrial = new LevelTimeTrial(this, m_raceSettings.nrOfLaps, m_nextTrack, m_nextAutomaticTransmission, m_nextVehicle, m_nextVehicleFile);
+            m_levelTimeTrial->initialize( );
+            break;
+        case quickStart:
+        case singleRace:
+            m_levelSingleRace = new LevelSingleRace(this, m_raceSettings.nrOfLaps, m_nextTrack, m_nextAutomaticTransmission, m_nextVehicle, m_nextVehicleFile);
+            m_levelSingleRace->initialize(random(m_raceSettings.nrOfComputers+1));
+            break;
+        case multiplayer:
+            UInt nrOfLaps;
+            if (m_serverStarted)
+                nrOfLaps = m_raceSettings.nrOfLaps;
+            else
+                nrOfLaps = m_raceClient->nrOfLaps( );
+            m_levelMultiplayer = new LevelMultiplayer(this, nrOfLaps, m_nextTrack, m_nextTrackData, m_nextAutomaticTransmission, m_nextVehicle, m_nextVehicleFile);
+            m_levelMultiplayer->initialize(m_serverStarted);
             break;
         default:
-            break;            
-        }
-        if (elapsed < 10.0f)
-            ::Sleep(10);
-        else if (elapsed < 20.0f)
-            ::Sleep(10 - floatToDWORD(elapsed - 10.0f));
+            break;
     }
+    // the levels now hold their own references to the cached sounds
+    m_soundLoader->release( );
+    m_timer.microElapsed( );
+    m_state = state;
 }
 
 void
@@ -255,7 +384,9 @@ Game::state(State state)
                     SAFE_DELETE(m_levelMultiplayer);
                 }
             }
-            m_menu = new Menu(this);
+            // the menu keeps its sounds between races, so it is only created once
+            if (m_menu == 0)
+                m_menu = new Menu(this);
             switch (m_state)
             {
             case quickStart:
@@ -311,51 +442,15 @@ Game::state(State state)
             m_state = menu;
             break;
         case timeTrial:
-            if (m_menu)
-            {
-                m_menu->finalize( );
-                SAFE_DELETE(m_menu);
-            }
-            m_levelTimeTrial = new LevelTimeTrial(this, m_raceSettings.nrOfLaps, m_nextTrack, m_nextAutomaticTransmission, m_nextVehicle, m_nextVehicleFile);
-            m_levelTimeTrial->initialize( );
-            m_timer.microElapsed( );
-            m_state = state;
-            break;
         case quickStart:
         case singleRace:
-            if (m_menu)
-            {
-                m_menu->finalize( );
-                SAFE_DELETE(m_menu);
-            }
-            m_levelSingleRace = new LevelSingleRace(this, m_raceSettings.nrOfLaps, m_nextTrack, m_nextAutomaticTransmission, m_nextVehicle, m_nextVehicleFile);
-            m_levelSingleRace->initialize(random(m_raceSettings.nrOfComputers+1));
-            m_timer.microElapsed( );
-            m_state = state;
-            break;
         case multiplayer:
-            if (m_menu)
-            {
-                m_menu->finalize( );
-                SAFE_DELETE(m_menu);
-            }
-            UInt nrOfLaps;
-            if (m_serverStarted)
-                nrOfLaps = m_raceSettings.nrOfLaps;
-            else
-                nrOfLaps = m_raceClient->nrOfLaps( );
-            m_levelMultiplayer = new LevelMultiplayer(this, nrOfLaps, m_nextTrack, m_nextTrackData, m_nextAutomaticTransmission, m_nextVehicle, m_nextVehicleFile);
-            m_levelMultiplayer->initialize(m_serverStarted);
-            m_timer.microElapsed( );
-            m_state = state;
+            load(state);
             break;
         case awaitingGame:
             // RACE("Game::awaitingGame");
-            if (m_menu)
-            {
+            if ((m_menu) && (m_state == menu))
                 m_menu->finalize( );
-                SAFE_DELETE(m_menu);
-            }
             m_timer.microElapsed( );
             m_state = state;
             break;
@@ -444,13 +539,6 @@ Game::playerConnected(playerNr)
 }
 */
 
-void
-Game::playerDisconnected(UByte playerNr)
-{
-	if(m_state == multiplayer)
-        m_levelMultiplayer->playerDisconnected(playerNr);
-}
-
 void
 Game::startEnumSessions(char* ipAddress)
 {
@@ -483,7 +571,12 @@ Game::joinSessionAt(char* ipAddress)
 Boolean
 Game::startServer( )
 {
-    m_raceServer->initialize( );
+    SAFE_DELETE(m_serverTransport);
+    GUID guid = gameGuid( );
+    m_serverTransport = new DirectX::ServerAdapter(gameTransport( ), guid);
+    Char sessionName[64];
+    sprintf(sessionName, "%d", m_raceSettings.serverNumber);
+    m_raceServer->initialize(m_serverTransport, sessionName, gamePort( ));
     m_serverStarted = true;
     return true;
 }
@@ -493,6 +586,7 @@ void
 Game::stopServer( )
 {
     m_raceServer->finalize( );
+    SAFE_DELETE(m_serverTransport);
     m_serverStarted = false;
 }
 
@@ -552,6 +646,55 @@ Game::loadLanguageSound(Char* file, Boolean threeD, Boolean ignoreNonexistence)
     return result;
 }
 
+// Queues the file loadLanguageSound would load on the loader threads.
+// Returns false if there is no such file.
+Boolean
+Game::prefetchLanguageSound(Char* file, Boolean threeD)
+{
+    Char filename[128];
+    #ifdef _USE_WAV_
+        sprintf(filename, "Sounds\\%s\\%s.wav", m_language, file);
+        Boolean vorbis = false;
+    #else
+        sprintf(filename, "Sounds\\%s\\%s.ogg", m_language, file);
+        Boolean vorbis = true;
+    #endif
+    if ((!m_soundManager->packed(filename)) && (GetFileAttributes(filename) == INVALID_FILE_ATTRIBUTES))
+    {
+        sprintf(filename, "Sounds\\en\\%s.ogg", file);
+        vorbis = true;
+        if ((!m_soundManager->packed(filename)) && (GetFileAttributes(filename) == INVALID_FILE_ATTRIBUTES))
+            return false;
+    }
+    m_soundLoader->prefetch(filename, threeD, vorbis);
+    return true;
+}
+
+// Like loadLanguageSound, but the file is decoded while it plays.
+// Used for music, which would take tens of megabytes fully decoded.
+DirectX::Sound* 
+Game::loadLanguageStream(Char* file)
+{
+    #ifdef _USE_WAV_
+        return loadLanguageSound(file);
+    #else
+        Char filename[128];
+        sprintf(filename, "Sounds\\%s\\%s.ogg", m_language, file);
+        DirectX::Sound* result = m_soundManager->createVorbisStream(filename);
+        if (result == 0)
+        {
+            sprintf(filename, "Sounds\\en\\%s.ogg", file);
+            result = m_soundManager->createVorbisStream(filename);
+        }
+        if (result == 0)
+        {
+            RACE("(!) Game::loadLanguageStream : failed to load %s.ogg", file);
+            result = m_soundManager->create(IDR_ERROR);
+        }
+        return result;
+    #endif
+}
+
 
 /*
 void
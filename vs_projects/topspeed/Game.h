@@ -8,49 +8,13 @@
 #define __RACING_GAME_H__
 
 #include <DxCommon\If\Common.h>
-#include <Common\If\TList.h>
 
 #include "RaceSettings.h"
+#include "EventQueue.h"
 #include "Track.h"
+#include "Packets.h"
+#include "RaceTracer.h"
 
-extern Tracer  _raceTracer;
-#define  RACE _raceTracer.trace
-
-struct Event
-{
-    enum Type
-    {
-        carStart,
-        carComputerStart,
-        carRestart,
-        raceStart,
-        raceFinish,
-        playSound,
-//        playSoundAndDelete,
-//        deleteSound,
-        acceptInput,
-        playRadioSound,
-        inGear,
-        stopSessionEnum,
-        stopSessionEnumAndJoin,
-        playCurrentItem,
-        serverRaceStart,
-        startHorn,
-        stopHorn,
-        raceTimeFinalize,
-        acceptPlayerInfo,
-        acceptCurrentRaceInfo
-    };
-    Float           time;
-    Type            type;
-    DirectX::Sound* sound;
-//    UInt* number;
-    Event*          next;
-    Event*          previous;
-};
-
-
-typedef TList<Event>  EventList;
 
 class Menu;
 class LevelTimeTrial;
@@ -71,6 +35,10 @@ public:
     void initialize(::Window::Handle handle);
     void run( );
 
+private:
+    void step(Float elapsed);
+    void wait( );
+
 public:
     enum State
     {
@@ -81,9 +49,14 @@ public:
         singleRace,
         multiplayer,
         awaitingGame,
-        paused
+        paused,
+        loading
     };
 
+private:
+    void load(State state);
+    void startLevel(State state);
+
 public:
     void                   state(State state);
     State                  state( ) { return m_state; }
@@ -101,6 +74,9 @@ public:
     DirectX::Input::State& input( )          { return m_inputState;   }
     Boolean                started( );
     DirectX::Sound*        loadLanguageSound(Char* file, Boolean threeD = false, Boolean ignoreNonexistence = false);
+    DirectX::Sound*        loadLanguageStream(Char* file);
+    Boolean                prefetchLanguageSound(Char* file, Boolean threeD = false);
+    void                   prefetchResource(Int resource, Boolean threeD = false) { m_soundLoader->prefetch(resource, threeD); }
 
 public:
     void hardwareAcceleration(Boolean b)     { m_hardwareAcceleration = b; }    
@@ -114,7 +90,6 @@ public:
     Boolean startClient( );
     void    stopClient( );
 //    void    playerConnected(UByte playerNr);
-    void    playerDisconnected(UByte playerNr);
     void    startEnumSessions(char* ipAddress = 0);
     void    stopEnumSessions( );
     UInt    joinSession(UInt session);
@@ -126,11 +101,12 @@ public:
 
 
 public:
-    GUID     gameGuid( )     { GUID gameGuid = {0xede9493e, 0x6ac8, 0x4f15, {0x8d, 0x1, 0x8b, 0x16, 0x32, 0x0, 0xb9, 0x66}}; return gameGuid; }
-    UInt     gamePort( )     { return 25255; }
+    GUID     gameGuid( )     { GUID gameGuid = {RACEAPPLICATION, 0x6ac8, 0x4f15, {0x8d, 0x1, 0x8b, 0x16, 0x32, 0x0, 0xb9, 0x66}}; return gameGuid; }
+    UInt     gamePort( )     { return RACEPORT; }
+    DirectX::Transport gameTransport( ) { return (m_raceSettings.udpTransport) ? DirectX::udp : DirectX::directPlay; }
 
 public:
-    void    resetTimer( ) { m_timer.microElapsed( ); }
+    void    resetTimer( ) { m_timer.microElapsed( ); m_accumulator = 0; }
     void    pauseKeyReleased(Boolean b) { m_pauseKeyReleased = b; }
     Boolean pauseKeyReleased( ) { return m_pauseKeyReleased; }
     Boolean serverStarted( ) { return m_serverStarted; }
@@ -139,7 +115,9 @@ private:
     Boolean                         m_initialized;
     State                           m_state;
     DirectX::Timer                  m_timer;
+    Huge                            m_accumulator;      // microseconds not yet simulated
     DirectX::SoundManager*          m_soundManager;
+    DirectX::SoundLoader*           m_soundLoader;
     DirectX::InputManager*          m_inputManager;
     RaceInput*                      m_raceInput;
     DirectX::Input::State           m_inputState;
@@ -165,10 +143,12 @@ private:
 
     // multiplayer
     RaceServer*                     m_raceServer;    
+    DirectX::ServerTransport*       m_serverTransport;
     RaceClient*                     m_raceClient;
     Boolean                         m_serverStarted;
     Boolean                         m_threeD;
     State                           m_pausedState;
+    State                           m_loadingState;     // the level we are loading sounds for
     Boolean                         m_pauseKeyReleased;
 
     // numbers
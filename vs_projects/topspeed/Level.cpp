@@ -295,6 +295,70 @@ Level::~Level( )
 }
 
 
+// Queues the sounds a level loads when it is created, so Game can load
+// them in the background before it creates the level. The sounds for the
+// positions and vehicles of the other players are queued for every player,
+// as the number of players and their cars are only chosen later.
+void
+Level::prefetch(Game* game, UInt vehicle, Char* vehicleFile)
+{
+    Car::prefetch(game, vehicle, vehicleFile);
+    game->prefetchLanguageSound("race\\start321");
+    game->prefetchLanguageSound("race\\time\\trackrecord");
+    game->prefetchLanguageSound("race\\time\\newrecord");
+    game->prefetchLanguageSound("race\\time\\yourtime");
+    game->prefetchLanguageSound("race\\time\\minute");
+    game->prefetchLanguageSound("race\\time\\minutes");
+    game->prefetchLanguageSound("race\\time\\second");
+    game->prefetchLanguageSound("race\\time\\seconds");
+    game->prefetchLanguageSound("race\\time\\point");
+    game->prefetchLanguageSound("race\\time\\percent");
+    for (UInt i = 0; i < NUNKEYS; ++i)
+        game->prefetchResource(IDR_UNKEY1 + i);
+    prefetchRandomSounds(game, "race\\copilot\\easyleft");
+    prefetchRandomSounds(game, "race\\copilot\\left");
+    prefetchRandomSounds(game, "race\\copilot\\hardleft");
+    prefetchRandomSounds(game, "race\\copilot\\hairpinleft");
+    prefetchRandomSounds(game, "race\\copilot\\easyright");
+    prefetchRandomSounds(game, "race\\copilot\\right");
+    prefetchRandomSounds(game, "race\\copilot\\hardright");
+    prefetchRandomSounds(game, "race\\copilot\\hairpinright");
+    prefetchRandomSounds(game, "race\\copilot\\asphalt");
+    prefetchRandomSounds(game, "race\\copilot\\gravel");
+    prefetchRandomSounds(game, "race\\copilot\\water");
+    prefetchRandomSounds(game, "race\\copilot\\sand");
+    prefetchRandomSounds(game, "race\\copilot\\snow");
+    prefetchRandomSounds(game, "race\\info\\finish");
+    prefetchRandomSounds(game, "race\\info\\front");
+    prefetchRandomSounds(game, "race\\info\\tail");
+    Char filename[32];
+    for (UInt i = 0; i < NLAPS-1; ++i)
+    {
+        sprintf(filename, "race\\info\\laps2go%d", i+1);
+        game->prefetchLanguageSound(filename);
+    }
+    for (UInt i = 0; i < NPLAYERSOUNDS; ++i)
+    {
+        sprintf(filename, "race\\info\\player%d", i+1);
+        game->prefetchLanguageSound(filename);
+        sprintf(filename, "race\\info\\youarepos%d", i+1);
+        game->prefetchLanguageSound(filename);
+        sprintf(filename, "race\\info\\finished%d", i+1);
+        game->prefetchLanguageSound(filename);
+    }
+    for (UInt i = 0; i < NVEHICLES; ++i)
+    {
+        sprintf(filename, "vehicles\\vehicle%d", i+1);
+        game->prefetchLanguageSound(filename);
+    }
+    game->prefetchLanguageSound("race\\youare");
+    game->prefetchLanguageSound("race\\player");
+    game->prefetchLanguageSound("race\\pause");
+    game->prefetchLanguageSound("race\\unpause");
+    game->prefetchLanguageSound("music\\theme4");
+}
+
+
 void
 Level::initializeLevel( )
 {
@@ -389,11 +453,7 @@ Level::callNextRoad(Track::Road& nextRoad)
 void 
 Level::pushEvent(Event::Type type, Float time, DirectX::Sound* sound)
 {
-    Event* e = new Event;
-    e->type = type;
-    e->time = m_elapsedTotal + time;
-    e->sound = sound;
-    m_eventList.push(e);
+    m_eventList.push(type, m_elapsedTotal + time, sound);
 }
 
 
@@ -439,20 +499,21 @@ RACE("Level::loadRandomSounds : Finished loading %d sounds for a total of %d", p
 }
 
 void
-Level::flushPendingSounds( )
+Level::prefetchRandomSounds(Game* game, Char* temp)
 {
-    Event* e = 0;
-    while (e = m_eventList.next(e))
+    Char filename[32];
+    for (UInt i = 0; i < 32; ++i)
     {
-        if (e->sound)
-        {
-            m_eventList.purge(e);
-            delete e;
-            e = 0;
-        }
+        sprintf(filename, "%s%d", temp, i+1);
+        if (!game->prefetchLanguageSound(filename))
+            break;
     }
-    delete e;
-    e = 0;
+}
+
+void
+Level::flushPendingSounds( )
+{
+    m_eventList.flushSounds( );
 }
 
 void
@@ -463,6 +524,8 @@ Level::fadeIn( )
     {
         volume += 5;
         m_soundTheme4->volume(volume);
+        // the fade does not wait for the next frame to be heard
+        m_game->soundManager( )->commit( );
         ::Sleep(25);
         m_game->resetTimer( );
     }
@@ -476,6 +539,7 @@ Level::fadeOut( )
     {
         volume -= 5;
         m_soundTheme4->volume(volume);
+        m_game->soundManager( )->commit( );
         ::Sleep(25);
         m_game->resetTimer( );
     }
@@ -16,6 +16,7 @@
 #define NLAPS 16
 #define NVEHICLES 12
 #define NUNKEYS 12
+#define NPLAYERSOUNDS 8         // the players, positions and finishes there are announcements for
 #define ADVLANEWIDTH 8000
 
 class Level
@@ -24,6 +25,7 @@ public:
     Level(Game* game, Char* track, Boolean automaticTransmission, UInt nrOfLaps, UInt vehicle, Char* vehicleFile = NULL);
 	Level(Game* game, Char* track, Track::TrackData trackData, Boolean automaticTransmission, UInt nrOfLaps, UInt vehicle, Char* vehicleFile = NULL);
     virtual ~Level( );
+    static void prefetch(Game* game, UInt vehicle, Char* vehicleFile = NULL);
     void startStopwatchDiff( ) { m_oldStopwatch = m_stopwatch.elapsed(false); }
     void stopStopwatchDiff( ) { m_stopwatchDiff += (m_stopwatch.elapsed(false) - m_oldStopwatch); }
     void fadeIn( );
@@ -60,6 +62,7 @@ protected:
     void pushEvent(Event::Type type, Float time, DirectX::Sound* sound = 0);
     void speak(DirectX::Sound* sound, Boolean unKey = false);
     void loadRandomSounds(RandomSound pos, Char* temp);
+    static void prefetchRandomSounds(Game* game, Char* temp);
     void flushPendingSounds( );
 
 protected:
@@ -89,7 +92,7 @@ protected:
     Int                     m_raceTime;
     UInt                    m_lap;
     Track::Road             m_currentRoad;
-    EventList               m_eventList;
+    EventQueue              m_eventList;
     Boolean                 m_started;
     Boolean                 m_finished;
     Boolean                 m_acceptPlayerInfo;
@@ -10,7 +10,7 @@
 
 LevelMultiplayer::LevelMultiplayer(Game* game, UInt nrOfLaps, Char* track, Track::TrackData trackData, Boolean automaticTransmission, UInt vehicle, Char* vehicleFile) :
     Level(game, track, trackData, automaticTransmission, nrOfLaps, vehicle, vehicleFile),
-//    m_soundYouAre(0),
+    m_soundYouAre(0),
     m_soundPlayer(0),
     m_soundWaitingForPlayers(0),
     m_soundPressEnterToStart(0),
@@ -25,6 +25,8 @@ LevelMultiplayer::LevelMultiplayer(Game* game, UInt nrOfLaps, Char* track, Track
 //    UInt playerNr = m_game->raceClient()->playerNumber();
     Char filename[64];
     for (UInt i = 0; i < NMAXPLAYERS; ++i)
+        m_playerUpdates[i] = 0;
+    for (UInt i = 0; i < NPLAYERSOUNDS; ++i)
     {
         sprintf(filename, "race\\info\\youarepos%d", i+1);
         m_soundPosition[i] = m_game->loadLanguageSound(filename);
@@ -46,7 +48,7 @@ LevelMultiplayer::LevelMultiplayer(Game* game, UInt nrOfLaps, Char* track, Track
     loadRandomSounds(tail, "race\\info\\tail");
 //    if (playerNr < NMAXPLAYERS)
 //    {
-//        m_soundYouAre    = m_game->loadLanguageSound("race\\youare");
+        m_soundYouAre    = m_game->loadLanguageSound("race\\youare");
         m_soundPlayer    = m_game->loadLanguageSound("race\\player");
 //        RACE("LevelMultiplayer : saying my name: Player %d", playerNr);
 //        speak(m_soundYouAre);
@@ -61,9 +63,9 @@ LevelMultiplayer::LevelMultiplayer(Game* game, UInt nrOfLaps, Char* track, Track
 LevelMultiplayer::~LevelMultiplayer( )
 {
     RACE("(-) LevelMultiplayer");
-//    SAFE_DELETE(m_soundYouAre);
+    SAFE_DELETE(m_soundYouAre);
     SAFE_DELETE(m_soundPlayer);
-    for (UInt i = 0; i < NMAXPLAYERS; ++i)
+    for (UInt i = 0; i < NPLAYERSOUNDS; ++i)
     {
         SAFE_DELETE(m_soundPosition[i]);
         SAFE_DELETE(m_soundPlayerNr[i]);
@@ -219,7 +221,7 @@ LevelMultiplayer::run(Float elapsed)
 
         // send our data to the server
         m_updateClient += elapsed;
-        if (m_updateClient > SERVER_UPDATE_TIME)
+        if (m_updateClient > CLIENT_SEND_TIME)
         {
             m_updateClient = 0.0f;
             // did we bump other cars?
@@ -247,19 +249,23 @@ LevelMultiplayer::run(Float elapsed)
         // update playerData 
         for (UInt player = 0; player < NMAXPLAYERS; ++player)
         {
-            PlayerData playerData = m_game->raceClient()->playerData(player);
+            if (m_game->raceClient()->playerDisconnected(player))
+                playerDisconnected(player);
+            UInt updates = 0;
+            PlayerData playerData = m_game->raceClient()->playerData(player, updates);
             if ((playerData.playerNumber != m_game->raceClient()->playerNumber()) && (playerData.state != undefined) && (playerData.state != notReady))
             {
                 if (m_players[player].initialized())
                 {
-                    m_players[player].position(playerData.posX, playerData.posY);
                     if (playerData.state != finished)
                     {
-                        m_players[player].speed(playerData.speed);
-                        m_players[player].frequency(playerData.frequency);
+                        if (updates != m_playerUpdates[player])
+                            m_players[player].receive(playerData.posX, playerData.posY, playerData.speed, playerData.frequency);
                         m_players[player].engineRunning(playerData.engineRunning);
                         m_players[player].braking(playerData.braking);
                     }
+                    else
+                        m_players[player].position(playerData.posX, playerData.posY);
                     m_players[player].horning(playerData.horning);
                     m_players[player].backfiring(playerData.backfiring);
                 }
@@ -269,6 +275,7 @@ LevelMultiplayer::run(Float elapsed)
                     m_players[player].position(playerData.posX, playerData.posY);
                     if (playerData.state != finished)
                     {
+                        m_players[player].receive(playerData.posX, playerData.posY, playerData.speed, playerData.frequency);
                         m_players[player].speed(playerData.speed);
                         m_players[player].frequency(playerData.frequency);
                         m_players[player].engineRunning(playerData.engineRunning);
@@ -281,6 +288,7 @@ speak(m_soundPlayer);
                     speak(m_game->m_soundNumbers[player+1]);
                     speak(m_soundHasJoinedRace);
                 }
+                m_playerUpdates[player] = updates;
                 // started?
                 if (m_game->raceClient()->playerStarted(player))
                     m_players[player].start( );
@@ -474,79 +482,73 @@ speak(m_soundPlayer);
 
     // Handle events
     Event* e = 0;
-    while (e = m_eventList.next(e))
+    while (e = m_eventList.next(m_elapsedTotal))
     {
-        if (e->time <= m_elapsedTotal)
+        switch (e->type)
         {
-            switch (e->type)
+        case Event::carStart:
+            m_car->start( );
+            break;
+        case Event::raceStart:
+            m_raceTime = 0;
+            // start stopwatch
+            m_stopwatch.elapsed( );
+            m_lap = 0;
+            m_started = true;
+            break;
+        case Event::raceFinish:
+            m_acceptCurrentRaceInfo = false;
+            flushPendingSounds( );
+            m_sayTimeLength = 0.0f;
+            pushEvent(Event::playSound, m_sayTimeLength, m_soundYourTime);
+            m_sayTimeLength += m_soundYourTime->length() + 0.5f;
+            sayTime(m_raceTime);
+            pushEvent(Event::raceTimeFinalize, m_sayTimeLength);
+            break;
+        case Event::playSound:
+            if (e->sound)
             {
-            case Event::carStart:
-                m_car->start( );
-                break;
-            case Event::raceStart:
-                m_raceTime = 0;
-                // start stopwatch
-                m_stopwatch.elapsed( );
-                m_lap = 0;
-                m_started = true;
-                break;
-            case Event::raceFinish:
-                m_acceptCurrentRaceInfo = false;
-                flushPendingSounds( );
-                m_sayTimeLength = 0.0f;
-                pushEvent(Event::playSound, m_sayTimeLength, m_soundYourTime);
-                m_sayTimeLength += m_soundYourTime->length() + 0.5f;
-                sayTime(m_raceTime);
-                pushEvent(Event::raceTimeFinalize, m_sayTimeLength);
-                break;
-            case Event::playSound:
-                if (e->sound)
-                {
-                    e->sound->reset( );
-                    e->sound->play( );
-                }
-                break;
-            /* case Event::playSoundAndDelete:
-                if (e->sound)
-                {
-                    e->sound->play( );
-                    pushEvent(Event::deleteSound, e->sound->length( ), e->sound);
-                }
-                break;
-            case Event::deleteSound:
-                if (e->sound)
-                {
-                    SAFE_DELETE(e->sound);
-                }
-                break; */
-            case Event::serverRaceStart:
-                if (m_isServer)
-                    m_game->raceServer()->startRace( );
-                break;
-            case Event::raceTimeFinalize:
-                m_sayTimeLength = 0.0f;
-                delete e;
-                e = 0;
-                m_game->state(Game::menu);
-                return;
-             case Event::playRadioSound:
-                --m_unkeyQueue;
-                if (m_unkeyQueue == 0)
-                    speak(m_soundUnkey[random(NUNKEYS)]);
-                break;
-            case Event::acceptPlayerInfo:
-                m_acceptPlayerInfo = true;
-                break;
-            case Event::acceptCurrentRaceInfo:
-                m_acceptCurrentRaceInfo = true;
-                break;
-            default:
-                break;
+                e->sound->reset( );
+                e->sound->play( );
             }
-            m_eventList.purge(e);
-            delete e;
-            e = 0;
+            break;
+        /* case Event::playSoundAndDelete:
+            if (e->sound)
+            {
+                e->sound->play( );
+                pushEvent(Event::deleteSound, e->sound->length( ), e->sound);
+            }
+            break;
+        case Event::deleteSound:
+            if (e->sound)
+            {
+                SAFE_DELETE(e->sound);
+            }
+            break; */
+        case Event::serverRaceStart:
+            if (m_isServer)
+                m_game->raceServer()->startRace( );
+            break;
+        case Event::raceTimeFinalize:
+            m_sayTimeLength = 0.0f;
+            m_eventList.release(e);
+            m_game->state(Game::menu);
+            return;
+         case Event::playRadioSound:
+            --m_unkeyQueue;
+            if (m_unkeyQueue == 0)
+                speak(m_soundUnkey[random(NUNKEYS)]);
+            break;
+        case Event::acceptPlayerInfo:
+            m_acceptPlayerInfo = true;
+            break;
+        case Event::acceptCurrentRaceInfo:
+            m_acceptCurrentRaceInfo = true;
+            break;
+        default:
+            break;
         }
+        m_eventList.release(e);
     }
 
     m_car->run(elapsed);
@@ -640,16 +642,7 @@ LevelMultiplayer::comment(/* Float elapsed, */ Boolean automatic)
     {
         // if (position != m_position)
         // {
-            if (position == nPlayers)
-            {
-//                RACE("LevelMultiplayer : 'you're in last position'");
-                speak(m_soundPosition[NMAXPLAYERS-1], true);
-            }
-            else
-            {
-//                RACE("LevelMultiplayer : 'you're in %d position'", position);
-                speak(m_soundPosition[position-1], true);
-            }
+            speakPosition(position, nPlayers);
             m_position = position;
             return;
         // }
@@ -663,7 +656,7 @@ LevelMultiplayer::comment(/* Float elapsed, */ Boolean automatic)
             RACE("Comment : player %d is in front of you", inFront+1);
 //            speak(m_players[inFront].inFront( ));
 //            m_players[inFront].sayInFront( );
-            speak(m_soundPlayerNr[inFront], true);
+            speakPlayer(inFront);
             speak(m_randomSounds[front][random(m_totalRandomSounds[front])], true);
             return;
             // }
@@ -678,7 +671,7 @@ LevelMultiplayer::comment(/* Float elapsed, */ Boolean automatic)
             RACE("Comment : player %d is on your tail", onTail+1);
 //            speak(m_players[onTail].onTail( ));
 //            m_players[onTail].sayOnTail( );
-            speak(m_soundPlayerNr[onTail], true);
+            speakPlayer(onTail);
             speak(m_randomSounds[tail][random(m_totalRandomSounds[tail])], true);
             return;
             // }
@@ -686,22 +679,43 @@ LevelMultiplayer::comment(/* Float elapsed, */ Boolean automatic)
     }
     if ((inFront == -1) && (onTail == -1) && (!automatic))
     {
-        if (position == nPlayers)
-        {
-            RACE("LevelMultiplayer : 'you're in last position'");
-            speak(m_soundPosition[NMAXPLAYERS-1], true);
-        }
-        else
-        {
-            RACE("LevelMultiplayer : 'you're in %d position'", position);
-            speak(m_soundPosition[position-1], true);
-        }
+        RACE("LevelMultiplayer : 'you're in %d position' of %d", position, nPlayers);
+        speakPosition(position, nPlayers);
         m_position = position;
         return;
     }
 }
 
 
+// Players and positions past the recorded announcements are said with a number.
+void
+LevelMultiplayer::speakPlayer(UInt player)
+{
+    if (player < NPLAYERSOUNDS)
+    {
+        speak(m_soundPlayerNr[player], true);
+        return;
+    }
+    speak(m_soundPlayer, true);
+    speak(m_game->m_soundNumbers[player+1], true);
+}
+
+
+void
+LevelMultiplayer::speakPosition(UInt position, UInt nPlayers)
+{
+    if (position == nPlayers)
+        speak(m_soundPosition[NPLAYERSOUNDS-1], true);
+    else if (position < NPLAYERSOUNDS)
+        speak(m_soundPosition[position-1], true);
+    else
+    {
+        speak(m_soundYouAre, true);
+        speak(m_game->m_soundNumbers[position], true);
+    }
+}
+
+
 void
 LevelMultiplayer::updateResults( )
 {
@@ -713,21 +727,37 @@ LevelMultiplayer::updateResults( )
         Float totalTime = 4.0f;
         for (UInt i = 0; i < nResults; ++i)
         {
-            pushEvent(Event::playSound, totalTime, m_soundPlayerNr[results[i]]);
-            totalTime += m_soundPlayerNr[results[i]]->length( );
+            // there are only announcements for the first NPLAYERSOUNDS players and places
+            if (results[i] < NPLAYERSOUNDS)
+            {
+                pushEvent(Event::playSound, totalTime, m_soundPlayerNr[results[i]]);
+                totalTime += m_soundPlayerNr[results[i]]->length( );
+            }
+            else
+            {
+                pushEvent(Event::playSound, totalTime, m_soundPlayer);
+                totalTime += m_soundPlayer->length( );
+                pushEvent(Event::playSound, totalTime, m_game->m_soundNumbers[results[i]+1]);
+                totalTime += m_game->m_soundNumbers[results[i]+1]->length( );
+            }
             if (i == nResults-1)
             {
-                pushEvent(Event::playSound, totalTime, m_soundFinished[NMAXPLAYERS-1]);
-                totalTime += m_soundFinished[NMAXPLAYERS-1]->length( );
+                pushEvent(Event::playSound, totalTime, m_soundFinished[NPLAYERSOUNDS-1]);
+                totalTime += m_soundFinished[NPLAYERSOUNDS-1]->length( );
                 UInt randomNr = random(NUNKEYS);
                 pushEvent(Event::playSound, totalTime, m_soundUnkey[randomNr]);
                 totalTime += m_soundUnkey[randomNr]->length( );
             }
-            else
+            else if (i < NPLAYERSOUNDS-1)
             {
                 pushEvent(Event::playSound, totalTime, m_soundFinished[i]);
                 totalTime += m_soundFinished[i]->length( );
             }
+            else
+            {
+                pushEvent(Event::playSound, totalTime, m_game->m_soundNumbers[i+1]);
+                totalTime += m_game->m_soundNumbers[i+1]->length( );
+            }
         }
         m_game->raceClient()->resetResults( );
         pushEvent(Event::raceFinish, totalTime + 1.0f, 0);
@@ -40,17 +40,20 @@ private:
     // void    handleFinish( );
     void    comment(/* Float elapsed, */ Boolean automatic = true);
     void    updateResults( );
+    void    speakPlayer(UInt player);
+    void    speakPosition(UInt position, UInt nPlayers);
 
 private:
     Boolean                 m_isServer;
     // Float                   m_lastLoadTrack;
     Float                   m_updateClient;
     NetworkPlayer           m_players[NMAXPLAYERS];
+    UInt                    m_playerUpdates[NMAXPLAYERS];   // the update counts from RaceClient::playerData passed on to m_players
     DirectX::Sound*         m_soundYouAre;
     DirectX::Sound*         m_soundPlayer;
-    DirectX::Sound*         m_soundPosition[NMAXPLAYERS];
-    DirectX::Sound*         m_soundPlayerNr[NMAXPLAYERS];
-    DirectX::Sound*         m_soundFinished[NMAXPLAYERS];
+    DirectX::Sound*         m_soundPosition[NPLAYERSOUNDS];
+    DirectX::Sound*         m_soundPlayerNr[NPLAYERSOUNDS];
+    DirectX::Sound*         m_soundFinished[NPLAYERSOUNDS];
     DirectX::Sound*         m_soundVehicle[NVEHICLES];
     DirectX::Sound*         m_soundWaitingForPlayers;
     DirectX::Sound*         m_soundHasJoinedServer;
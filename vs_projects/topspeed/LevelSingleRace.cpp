@@ -68,9 +68,9 @@ LevelSingleRace::initialize(Int playerNumber)
             m_soundPlayerNr[i] = m_game->loadLanguageSound(filename);
         if (i == m_nComputerPlayers)
         {
-            sprintf(filename, "race\\info\\youarepos%d", NMAXPLAYERS);
+            sprintf(filename, "race\\info\\youarepos%d", NPLAYERSOUNDS);
             m_soundPosition[i] = m_game->loadLanguageSound(filename);
-            sprintf(filename, "race\\info\\finished%d", NMAXPLAYERS);
+            sprintf(filename, "race\\info\\finished%d", NPLAYERSOUNDS);
             m_soundFinished[i] = m_game->loadLanguageSound(filename);
         }
         else
@@ -154,72 +154,66 @@ LevelSingleRace::run(Float elapsed)
     }
     // Handle events
     Event* e = 0;
-    while (e = m_eventList.next(e))
+    while (e = m_eventList.next(m_elapsedTotal))
     {
-        if (e->time <= m_elapsedTotal)
+        switch (e->type)
         {
-            switch (e->type)
+        case Event::carStart:
+            m_car->start( );
+            break;
+        case Event::raceStart:
+            m_raceTime = 0;
+            // start stopwatch
+            m_stopwatch.elapsed( );
+            m_lap = 0;
+            m_started = true;
+            break;
+        case Event::raceFinish:
+            pushEvent(Event::playSound, m_sayTimeLength, m_soundYourTime);
+            m_sayTimeLength += m_soundYourTime->length() + 0.5f;
+            sayTime(m_raceTime);
+            pushEvent(Event::raceTimeFinalize, m_sayTimeLength);
+            break;
+        case Event::playSound:
+            if (e->sound)
             {
-            case Event::carStart:
-                m_car->start( );
-                break;
-            case Event::raceStart:
-                m_raceTime = 0;
-                // start stopwatch
-                m_stopwatch.elapsed( );
-                m_lap = 0;
-                m_started = true;
-                break;
-            case Event::raceFinish:
-                pushEvent(Event::playSound, m_sayTimeLength, m_soundYourTime);
-                m_sayTimeLength += m_soundYourTime->length() + 0.5f;
-                sayTime(m_raceTime);
-                pushEvent(Event::raceTimeFinalize, m_sayTimeLength);
-                break;
-            case Event::playSound:
-                if (e->sound)
-                {
-                    e->sound->reset( );
-                    e->sound->play( );
-                }
-                break;
-            /* case Event::playSoundAndDelete:
-                if (e->sound)
-                {
-                    e->sound->play( );
-                    pushEvent(Event::deleteSound, e->sound->length( ), e->sound);
-                }
-                break;
-            case Event::deleteSound:
-                if (e->sound)
-                {
-                    SAFE_DELETE(e->sound);
-                }
-                break; */
-            case Event::raceTimeFinalize:
-                m_sayTimeLength = 0.0f;
-                delete e;
-                e = 0;
-                m_game->state(Game::menu);
-                return;
-            case Event::playRadioSound:
-                --m_unkeyQueue;
-                if (m_unkeyQueue == 0)
-                    speak(m_soundUnkey[random(NUNKEYS)]);
-                break;
-            case Event::acceptPlayerInfo:
-                m_acceptPlayerInfo = true;
-                break;
-            case Event::acceptCurrentRaceInfo:
-                m_acceptCurrentRaceInfo = true;
-                break;
-            default:
-                break;
+                e->sound->reset( );
+                e->sound->play( );
             }
-            m_eventList.purge(e);
-            delete e;
-            e = 0;
+            break;
+        /* case Event::playSoundAndDelete:
+            if (e->sound)
+            {
+                e->sound->play( );
+                pushEvent(Event::deleteSound, e->sound->length( ), e->sound);
+            }
+            break;
+        case Event::deleteSound:
+            if (e->sound)
+            {
+                SAFE_DELETE(e->sound);
+            }
+            break; */
+        case Event::raceTimeFinalize:
+            m_sayTimeLength = 0.0f;
+            m_eventList.release(e);
+            m_game->state(Game::menu);
+            return;
+        case Event::playRadioSound:
+            --m_unkeyQueue;
+            if (m_unkeyQueue == 0)
+                speak(m_soundUnkey[random(NUNKEYS)]);
+            break;
+        case Event::acceptPlayerInfo:
+            m_acceptPlayerInfo = true;
+            break;
+        case Event::acceptCurrentRaceInfo:
+            m_acceptCurrentRaceInfo = true;
+            break;
+        default:
+            break;
         }
+        m_eventList.release(e);
     }
 
     updatePositions( );
@@ -545,22 +539,34 @@ LevelSingleRace::comment(/* Float elapsed, */ Boolean automatic)
 void
 LevelSingleRace::checkForBumps( )
 {
+    // the computer players have ids 0..n-1, the car of the player has id n
+    m_bumpSweep.reset(m_track->length( ));
     for (UInt i = 0; i < m_nComputerPlayers; ++i)
     {
-        if ((m_car->state( ) == Car::running) && (m_computerPlayer[i]->finished( ) == false))
-        {
-            // Int bumpX = 0;
-            // Int bumpY = 0;
-            if ((absval<Int>(m_car->positionX() - m_computerPlayer[i]->positionX()) < 1000) && (absval<Int>(m_car->positionY() - m_computerPlayer[i]->positionY()) < 500))
-            {
-                Int bumpX = m_car->positionX() - m_computerPlayer[i]->positionX();
-                Int bumpY = m_car->positionY() - m_computerPlayer[i]->positionY();
-                Int bumpSpeed = m_car->speed() - m_computerPlayer[i]->speed();
-                m_car->bump(bumpX, bumpY, bumpSpeed);
-                m_computerPlayer[i]->bump(-bumpX, -bumpY, -bumpSpeed);
-            }
-        }
+        if (m_computerPlayer[i]->finished( ) == false)
+            m_bumpSweep.add(i, m_computerPlayer[i]->positionX( ), m_computerPlayer[i]->positionY( ));
     }
+    if (m_car->state( ) == Car::running)
+        m_bumpSweep.add(m_nComputerPlayers, m_car->positionX( ), m_car->positionY( ));
+    m_bumpSweep.sweep( );
+    for (UInt i = 0; i < m_bumpSweep.nPairs( ); ++i)
+    {
+        const BumpSweep::Pair& pair = m_bumpSweep.pair(i);
+        Int speedA = (pair.a == m_nComputerPlayers) ? m_car->speed( ) : m_computerPlayer[pair.a]->speed( );
+        Int speedB = (pair.b == m_nComputerPlayers) ? m_car->speed( ) : m_computerPlayer[pair.b]->speed( );
+        bump(pair.a, pair.bumpX, pair.bumpY, speedA - speedB);
+        bump(pair.b, -pair.bumpX, -pair.bumpY, speedB - speedA);
+    }
+}
+
+
+void
+LevelSingleRace::bump(UInt id, Int bumpX, Int bumpY, Int bumpSpeed)
+{
+    if (id == m_nComputerPlayers)
+        m_car->bump(bumpX, bumpY, bumpSpeed);
+    else
+        m_computerPlayer[id]->bump(bumpX, bumpY, bumpSpeed);
 }
 
 
@@ -12,6 +12,7 @@
 #include "Track.h"
 #include "ComputerPlayer.h"
 #include "Level.h"
+#include "BumpSweep.h"
 
 
 #define NCOMPUTERPLAYERS    7
@@ -41,6 +42,7 @@ private:
     void    updatePositions( );    
     void    comment(/* Float elapsed, */ Boolean automatic = true);
     void    checkForBumps( );
+    void    bump(UInt id, Int bumpX, Int bumpY, Int bumpSpeed);
     Boolean checkFinish( );
     ComputerPlayer* generateRandomPlayer(int playerNumber);
 
@@ -53,6 +55,7 @@ private:
     ComputerPlayer*         m_computerPlayer[NCOMPUTERPLAYERS];
     Float                   m_lastComment;
     Boolean                 m_infoKeyReleased;
+    BumpSweep               m_bumpSweep;
     DirectX::Sound*         m_soundYouAre;
     DirectX::Sound*         m_soundPlayer;
     DirectX::Sound*         m_soundPosition[NCOMPUTERPLAYERS+1];
@@ -200,7 +200,20 @@ Menu::Menu(Game* game) :
     m_nSessions(0),
     m_sayTimeLength(0),
     m_goto(none),
-    m_soundNSessions(0)
+    m_soundNSessions(0),
+    m_soundLogo1(0),
+    m_optionsLanguage(0),
+    m_timeTrialCustomTrackTrack(0),
+    m_singleRaceCustomTrackTrack(0),
+    m_multiHostCustomTrackTrack(0),
+    m_timeTrialCircuitVehicle(0),
+    m_nLanguages(0),
+    m_nCustomTracks(0),
+    m_nVehicles(0),
+    m_languageStamp(0),
+    m_trackStamp(0),
+    m_vehicleStamp(0),
+    m_loaded(false)
 {
     RACE("(+) Menu");
 }
@@ -209,6 +222,31 @@ Menu::Menu(Game* game) :
 Menu::~Menu( )
 {
     RACE("(-) Menu");
+    if (m_loaded)
+        unload( );
+}
+
+
+// Combines the names, sizes and modification times of the files matching
+// pattern, so refresh( ) can tell whether a folder changed since its scan.
+static UInt
+folderStamp(const Char* pattern)
+{
+    WIN32_FIND_DATA findFileData;
+    HANDLE          findHandle = ::FindFirstFile(pattern, &findFileData);
+    if (findHandle == INVALID_HANDLE_VALUE)
+        return 0;
+    UInt stamp = 2166136261u;
+    do
+    {
+        for (const Char* c = findFileData.cFileName; *c; ++c)
+            stamp = (stamp ^ UByte(*c)) * 16777619u;
+        stamp = (stamp ^ findFileData.nFileSizeLow) * 16777619u;
+        stamp = (stamp ^ findFileData.ftLastWriteTime.dwLowDateTime) * 16777619u;
+        stamp = (stamp ^ findFileData.ftLastWriteTime.dwHighDateTime) * 16777619u;
+    } while (::FindNextFile(findHandle, &findFileData) != 0);
+    ::FindClose(findHandle);
+    return stamp;
 }
 
 
@@ -216,6 +254,12 @@ void
 Menu::initialize(Goto nextGoto)
 {
     RACE("Menu::initialize");
+    // The sounds and menus stay loaded between races,
+    // only the folders that changed meanwhile are scanned again.
+    if (m_loaded)
+        refresh( );
+    else
+        load( );
     m_elapsedTotal = 0;
     m_b1released = false;
     m_nextReleased = false;
@@ -226,13 +270,6 @@ Menu::initialize(Goto nextGoto)
     m_calibratingKeyboard = false;
     m_calibratingStep = 0;
     m_goto = nextGoto;
-
-	RACE("Menu::initialize : creating sounds...");
-    // m_soundButton               = m_soundManager->create(IDR_BUTTON);
-//	RACE("Menu::initialize : loading theme song...");
-    m_soundTheme1                = m_game->loadLanguageSound("music\\theme1");
-    m_soundTheme2                = m_game->loadLanguageSound("music\\theme2");
-    m_soundTheme3                = m_game->loadLanguageSound("music\\theme3");
     m_soundTheme1->volume(0);
     m_soundTheme2->volume(0);
     m_soundTheme3->volume(0);
@@ -256,6 +293,22 @@ Menu::initialize(Goto nextGoto)
             m_activeTheme = m_soundTheme1;
             break;
     }
+    m_currentMenu     = m_mainMenu;
+    m_currentMenuSize = sizeof(m_mainMenu);
+    m_currentMenuItem = 0;
+    m_listServers     = 0;
+}
+
+
+void
+Menu::load( )
+{
+	RACE("Menu::load : creating sounds...");
+    // m_soundButton               = m_soundManager->create(IDR_BUTTON);
+//	RACE("Menu::initialize : loading theme song...");
+    m_soundTheme1                = m_game->loadLanguageStream("music\\theme1");
+    m_soundTheme2                = m_game->loadLanguageStream("music\\theme2");
+    m_soundTheme3                = m_game->loadLanguageStream("music\\theme3");
 //    RACE("Menu::initialize : loading menu sounds...");    
 	m_soundIntro                = m_game->loadLanguageSound("menu\\usearrowkeys");
     m_soundBack                 = m_game->loadLanguageSound("menu\\goback");
@@ -385,7 +438,7 @@ m_soundServerStarted            = m_game->loadLanguageSound("menu\\serverstarted
 	m_soundLeft                 = m_game->loadLanguageSound("race\\copilot\\left1");
     m_soundLeft->pan(-100);
 
-	RACE("Menu::initialize : building the menus.");    
+	RACE("Menu::load : building the menus.");    
     m_currentMenu     = 0;
     m_currentMenuItem = 0;
     // Initialize main menu
@@ -1098,45 +1151,12 @@ m_soundServerStarted            = m_game->loadLanguageSound("menu\\serverstarted
     m_optionsRestore[1].sound   = m_soundNo;
     m_optionsRestore[1].action  = a_back;
 
-    m_currentMenu     = m_mainMenu;
-    m_currentMenuSize = sizeof(m_mainMenu);
-    m_listServers     = 0;
-
 //    RACE("Menu::initialize : ready to initialize the language menu.");    
     initializeLanguageMenu( );
 //    RACE("Menu::initialize : ready to initialize the track menu.");    
     initializeTrackMenu( );
 //    RACE("Menu::initialize : ready to initialize the vehicle menu.");    
     initializeVehicleMenu( );
-    for (UInt i = 0; i < NVEHICLES; ++i)
-    {
-        m_timeTrialCircuitVehicle[i].sound = m_soundVehicles[i];
-        m_timeTrialCircuitVehicle[i].action = a_timeCircuitOfficialVehicle;
-        m_timeTrialAdventureVehicle[i].sound = m_soundVehicles[i];
-        m_timeTrialAdventureVehicle[i].action = a_timeAdventureOfficialVehicle;
-        m_timeTrialCustomTrackVehicle[i].sound = m_soundVehicles[i];
-        m_timeTrialCustomTrackVehicle[i].action = a_timeCustomTrackOfficialVehicle;
-        m_timeTrialRandomVehicle[i].sound = m_soundVehicles[i];
-        m_timeTrialRandomVehicle[i].action = a_timeRandomOfficialVehicle;
-        m_singleRaceCircuitVehicle[i].sound = m_soundVehicles[i];
-        m_singleRaceCircuitVehicle[i].action = a_singleCircuitOfficialVehicle;
-        m_singleRaceAdventureVehicle[i].sound = m_soundVehicles[i];
-        m_singleRaceAdventureVehicle[i].action = a_singleAdventureOfficialVehicle;
-        m_singleRaceCustomTrackVehicle[i].sound = m_soundVehicles[i];
-        m_singleRaceCustomTrackVehicle[i].action = a_singleCustomTrackOfficialVehicle;
-        m_singleRaceRandomVehicle[i].sound = m_soundVehicles[i];
-        m_singleRaceRandomVehicle[i].action = a_singleRandomOfficialVehicle;
-        m_multiHostCircuitVehicle[i].sound = m_soundVehicles[i];
-        m_multiHostCircuitVehicle[i].action = a_multiHostCircuitOfficialVehicle;
-        m_multiHostAdventureVehicle[i].sound = m_soundVehicles[i];
-        m_multiHostAdventureVehicle[i].action = a_multiHostAdventureOfficialVehicle;
-        m_multiHostCustomTrackVehicle[i].sound = m_soundVehicles[i];
-        m_multiHostCustomTrackVehicle[i].action = a_multiHostCustomTrackOfficialVehicle;
-        m_multiHostRandomVehicle[i].sound = m_soundVehicles[i];
-        m_multiHostRandomVehicle[i].action = a_multiHostRandomOfficialVehicle;
-        m_multiJoinVehicle[i].sound = m_soundVehicles[i];
-        m_multiJoinVehicle[i].action = a_multiJoinOfficialVehicle;
-    }
     if (g_firstRun)
     {
 //		RACE("Menu::initialize : creating the logo...");    
@@ -1145,7 +1165,8 @@ m_soundServerStarted            = m_game->loadLanguageSound("menu\\serverstarted
     }
     else
         m_soundLogo1 = 0;
-	RACE("Menu::initialize : done (at last).");
+    m_loaded = true;
+	RACE("Menu::load : done (at last).");
 }
 
 void
@@ -1158,6 +1179,7 @@ Menu::initializeLanguageMenu( )
     DirectX::Sound* languageSounds[64];
     UInt            nLanguages = 0;
 
+    m_languageStamp = folderStamp("Sounds\\*.ogg");
     findHandle = ::FindFirstFile("Sounds\\*.ogg", &findFileData);
 
     if (findHandle == INVALID_HANDLE_VALUE) 
@@ -1171,6 +1193,7 @@ Menu::initializeLanguageMenu( )
         languageSounds[nLanguages] = m_game->soundManager()->createVorbis(soundFile);
         Int length = ::strlen(findFileData.cFileName);
         ::strncpy(m_languageFiles[nLanguages], findFileData.cFileName, length-4);
+        m_languageFiles[nLanguages][length-4] = '\0';
         ++nLanguages;
         while ((nLanguages < 64) && (::FindNextFile(findHandle, &findFileData) != 0)) 
         {
@@ -1178,6 +1201,7 @@ Menu::initializeLanguageMenu( )
             languageSounds[nLanguages] = m_game->soundManager()->createVorbis(soundFile);
             length = ::strlen(findFileData.cFileName);
             ::strncpy(m_languageFiles[nLanguages], findFileData.cFileName, length-4);
+            m_languageFiles[nLanguages][length-4] = '\0';
             ++nLanguages;
         }
         error = GetLastError();
@@ -1210,6 +1234,7 @@ Menu::initializeTrackMenu( )
     
     DirectX::Sound* trackSounds[MAXCUSTOMTRACKS];
     UInt            nTracks = 0;
+    m_trackStamp = folderStamp("Tracks\\*");
     findHandle = ::FindFirstFile("Tracks\\*.trk", &findFileData);
     if (findHandle == INVALID_HANDLE_VALUE) 
     {
@@ -1306,6 +1331,7 @@ Menu::initializeVehicleMenu( )
     
     DirectX::Sound* vehicleSounds[MAXCUSTOMVEHICLES];
     UInt            nVehicles = 0;
+    m_vehicleStamp = folderStamp("Vehicles\\*");
     findHandle = ::FindFirstFile("Vehicles\\*.vhc", &findFileData);
     if (findHandle == INVALID_HANDLE_VALUE) 
     {
@@ -1463,6 +1489,36 @@ Menu::initializeVehicleMenu( )
     m_singleRaceRandomVehicle[m_nVehicles-2].action = a_singleRandomRandom;
     m_singleRaceRandomVehicle[m_nVehicles-1].sound  = m_soundBack;
     m_singleRaceRandomVehicle[m_nVehicles-1].action = a_back;
+    // the official vehicles come first in all of them
+    for (UInt i = 0; i < NVEHICLES; ++i)
+    {
+        m_timeTrialCircuitVehicle[i].sound = m_soundVehicles[i];
+        m_timeTrialCircuitVehicle[i].action = a_timeCircuitOfficialVehicle;
+        m_timeTrialAdventureVehicle[i].sound = m_soundVehicles[i];
+        m_timeTrialAdventureVehicle[i].action = a_timeAdventureOfficialVehicle;
+        m_timeTrialCustomTrackVehicle[i].sound = m_soundVehicles[i];
+        m_timeTrialCustomTrackVehicle[i].action = a_timeCustomTrackOfficialVehicle;
+        m_timeTrialRandomVehicle[i].sound = m_soundVehicles[i];
+        m_timeTrialRandomVehicle[i].action = a_timeRandomOfficialVehicle;
+        m_singleRaceCircuitVehicle[i].sound = m_soundVehicles[i];
+        m_singleRaceCircuitVehicle[i].action = a_singleCircuitOfficialVehicle;
+        m_singleRaceAdventureVehicle[i].sound = m_soundVehicles[i];
+        m_singleRaceAdventureVehicle[i].action = a_singleAdventureOfficialVehicle;
+        m_singleRaceCustomTrackVehicle[i].sound = m_soundVehicles[i];
+        m_singleRaceCustomTrackVehicle[i].action = a_singleCustomTrackOfficialVehicle;
+        m_singleRaceRandomVehicle[i].sound = m_soundVehicles[i];
+        m_singleRaceRandomVehicle[i].action = a_singleRandomOfficialVehicle;
+        m_multiHostCircuitVehicle[i].sound = m_soundVehicles[i];
+        m_multiHostCircuitVehicle[i].action = a_multiHostCircuitOfficialVehicle;
+        m_multiHostAdventureVehicle[i].sound = m_soundVehicles[i];
+        m_multiHostAdventureVehicle[i].action = a_multiHostAdventureOfficialVehicle;
+        m_multiHostCustomTrackVehicle[i].sound = m_soundVehicles[i];
+        m_multiHostCustomTrackVehicle[i].action = a_multiHostCustomTrackOfficialVehicle;
+        m_multiHostRandomVehicle[i].sound = m_soundVehicles[i];
+        m_multiHostRandomVehicle[i].action = a_multiHostRandomOfficialVehicle;
+        m_multiJoinVehicle[i].sound = m_soundVehicles[i];
+        m_multiJoinVehicle[i].action = a_multiJoinOfficialVehicle;
+    }
 }
 
 
@@ -1488,6 +1544,34 @@ Menu::finalize( )
     m_soundTheme1->stop( );
     m_soundTheme2->stop( );
     m_soundTheme3->stop( );
+    // start the music from the top when we come back
+    m_soundTheme1->reset( );
+    m_soundTheme2->reset( );
+    m_soundTheme3->reset( );
+    flushEvents( );
+    if (m_soundLogo1)
+    {
+        SAFE_DELETE(m_soundLogo1);
+    }
+    if (m_soundNSessions)
+    {
+        SAFE_DELETE(m_soundNSessions);
+    }
+    if (m_listServers)
+    {
+        SAFE_DELETE_ARRAY(m_listServers);
+    }
+    if ((m_calibratingJoystick) || (m_calibratingKeyboard))
+    {
+        stopCalibrating( );
+    }
+}
+
+
+void
+Menu::unload( )
+{
+    RACE("Menu::unload");
     // SAFE_DELETE(m_soundButton);
     SAFE_DELETE(m_soundTheme1);
     SAFE_DELETE(m_soundTheme2);
@@ -1589,36 +1673,97 @@ Menu::finalize( )
     SAFE_DELETE(m_soundReverseStereo);
     SAFE_DELETE(m_soundRestoreDefaults);
     SAFE_DELETE(m_soundLeft);
+    SAFE_DELETE(m_soundNoHighScores);
+    SAFE_DELETE(m_soundLaps);
+    SAFE_DELETE(m_soundChangeOption);
+    SAFE_DELETE(m_soundSelectTrans);
+    SAFE_DELETE(m_soundYouAre);
+    SAFE_DELETE(m_soundPlayer);
+    SAFE_DELETE(m_soundLanguage);
+    SAFE_DELETE(m_soundRandomCustomTracks);
+    SAFE_DELETE(m_soundRandomCustomVehicles);
+    SAFE_DELETE(m_soundLapsOnly);
+    SAFE_DELETE(m_soundRaceSettings);
+    SAFE_DELETE(m_soundMinute);
+    SAFE_DELETE(m_soundMinutes);
+    SAFE_DELETE(m_soundSecond);
+    SAFE_DELETE(m_soundSeconds);
+    SAFE_DELETE(m_soundPoint);
+    finalizeLanguageMenu( );
+    finalizeTrackMenu( );
+    finalizeVehicleMenu( );
+    m_loaded = false;
+}
+
+
+void
+Menu::refresh( )
+{
+    // Only rebuild the menus of the folders that changed since they were
+    // scanned, e.g. because a custom track was added while racing.
+    if (folderStamp("Sounds\\*.ogg") != m_languageStamp)
+    {
+        RACE("Menu::refresh : languages changed");
+        finalizeLanguageMenu( );
+        initializeLanguageMenu( );
+    }
+    if (folderStamp("Tracks\\*") != m_trackStamp)
+    {
+        RACE("Menu::refresh : custom tracks changed");
+        finalizeTrackMenu( );
+        initializeTrackMenu( );
+    }
+    if (folderStamp("Vehicles\\*") != m_vehicleStamp)
+    {
+        RACE("Menu::refresh : custom vehicles changed");
+        finalizeVehicleMenu( );
+        initializeVehicleMenu( );
+    }
+}
+
+
+void
+Menu::finalizeLanguageMenu( )
+{
+    if (m_optionsLanguage == 0)
+        return;
+    for (UInt i = 0; i < m_nLanguages - 1; ++i)
+        SAFE_DELETE(m_optionsLanguage[i].sound);
     SAFE_DELETE_ARRAY(m_optionsLanguage);
+    m_nLanguages = 0;
+}
+
+
+void
+Menu::finalizeTrackMenu( )
+{
+    if (m_timeTrialCustomTrackTrack == 0)
+        return;
     for (UInt i = 0; i < m_nCustomTracks - 2; ++i)
         SAFE_DELETE(m_timeTrialCustomTrackTrack[i].sound);
-//    RACE("Menu::finalize : single race tracksounds deleted, time to delete arrays");
     SAFE_DELETE_ARRAY(m_timeTrialCustomTrackTrack);
     SAFE_DELETE_ARRAY(m_singleRaceCustomTrackTrack);
     SAFE_DELETE_ARRAY(m_multiHostCustomTrackTrack);
-//    RACE("Menu::finalize : single race trackarrays deleted");
+    m_nCustomTracks = 0;
+}
+
+
+void
+Menu::finalizeVehicleMenu( )
+{
+    if (m_timeTrialCircuitVehicle == 0)
+        return;
     for (UInt i = NVEHICLES; i < m_nVehicles - 2; ++i)
         SAFE_DELETE(m_timeTrialCircuitVehicle[i].sound);
     SAFE_DELETE_ARRAY(m_timeTrialCircuitVehicle);
     SAFE_DELETE_ARRAY(m_timeTrialAdventureVehicle);
+    SAFE_DELETE_ARRAY(m_timeTrialCustomTrackVehicle);
+    SAFE_DELETE_ARRAY(m_timeTrialRandomVehicle);
     SAFE_DELETE_ARRAY(m_singleRaceCircuitVehicle);
     SAFE_DELETE_ARRAY(m_singleRaceAdventureVehicle);
-    if (m_soundLogo1)
-    {
-        SAFE_DELETE(m_soundLogo1);
-    }
-    if (m_soundNSessions)
-    {
-        SAFE_DELETE(m_soundNSessions);
-    }
-    if (m_listServers)
-    {
-        SAFE_DELETE_ARRAY(m_listServers);
-    }
-    if ((m_calibratingJoystick) || (m_calibratingKeyboard))
-    {
-        stopCalibrating( );
-    }
+    SAFE_DELETE_ARRAY(m_singleRaceCustomTrackVehicle);
+    SAFE_DELETE_ARRAY(m_singleRaceRandomVehicle);
+    m_nVehicles = 0;
 }
 
 
@@ -1937,91 +2082,86 @@ Menu::run(Float elapsed)
     }
     // Handle events
     Event* e = 0;
-    while (e = m_eventList.next(e))
+    while (e = m_eventList.next(m_elapsedTotal))
     {
-        if (e->time <= m_elapsedTotal)
+        switch (e->type)
         {
-            switch (e->type)
+        case Event::playSound:
+            // ugly hack, please fix properly
+            /* if (e->sound == m_soundMainMenu)
             {
-            case Event::playSound:
-                // ugly hack, please fix properly
-                /* if (e->sound == m_soundMainMenu)
-                {
-                    m_acceptInput = false;
-                    stopCurrentMenuItem( );
-                    pushEvent(Event::playCurrentItem, m_soundMainMenu->length());
-                    pushEvent(Event::acceptInput, m_soundMainMenu->length());
-                } */
-                // play a sound
-                if (e->sound)
-                {
-                    e->sound->reset( );
-                    e->sound->play( );
-                }
-                break;
-            case Event::acceptInput:
-                // start accepting input
-                m_acceptInput = true;
-                break;
-            case Event::stopSessionEnum:
-                // give session enumerating result
-                m_game->stopEnumSessions( );
-                m_nSessions = m_game->raceClient()->nSessions( );
-                if (m_nSessions > 59)
-                    m_nSessions = 59;
-                    sprintf(m_nSessionsSound, "numbers\\%d", m_nSessions);
-                if (m_soundNSessions)
-                    SAFE_DELETE(m_soundNSessions)
-                m_soundNSessions = m_game->loadLanguageSound(m_nSessionsSound);
-                m_soundNSessions->play( );
-                ::Sleep(DWORD(m_soundNSessions->length() * 1000.0f));
+                m_acceptInput = false;
+                stopCurrentMenuItem( );
+                pushEvent(Event::playCurrentItem, m_soundMainMenu->length());
+                pushEvent(Event::acceptInput, m_soundMainMenu->length());
+            } */
+            // play a sound
+            if (e->sound)
+            {
+                e->sound->reset( );
+                e->sound->play( );
+            }
+            break;
+        case Event::acceptInput:
+            // start accepting input
+            m_acceptInput = true;
+            break;
+        case Event::stopSessionEnum:
+            // give session enumerating result
+            m_game->stopEnumSessions( );
+            m_nSessions = m_game->raceClient()->nSessions( );
+            if (m_nSessions > 59)
+                m_nSessions = 59;
+                sprintf(m_nSessionsSound, "numbers\\%d", m_nSessions);
+            if (m_soundNSessions)
+                SAFE_DELETE(m_soundNSessions)
+            m_soundNSessions = m_game->loadLanguageSound(m_nSessionsSound);
+            m_soundNSessions->play( );
+            ::Sleep(DWORD(m_soundNSessions->length() * 1000.0f));
+            m_game->resetTimer();
+            if (m_nSessions == 0)
+            {
+                m_soundServersFound->play();
+                ::Sleep(DWORD(m_soundServersFound->length() * 1000.0f));
                 m_game->resetTimer();
-                if (m_nSessions == 0)
-                {
-                    m_soundServersFound->play();
-                    ::Sleep(DWORD(m_soundServersFound->length() * 1000.0f));
-                    m_game->resetTimer();
-                    gotoMultiplayer();
-                }
-                else if (m_nSessions == 1)
-                {
-                    m_soundServerFound->play();
-                    ::Sleep(DWORD(m_soundServerFound->length() * 1000.0f));
-                    m_game->resetTimer();
-                    gotoMultiplayerListServers();
-                }
-                else
-                {
-                    m_soundServersFound->play();
-                    ::Sleep(DWORD(m_soundServersFound->length() * 1000.0f));
-                    m_game->resetTimer();
-                    gotoMultiplayerListServers();
-                }
-                break;
-            case Event::stopSessionEnumAndJoin:
-                m_game->stopEnumSessions( );
-                if (m_game->raceClient()->nSessions( ) > 0)
-                {
-                    RACE("Menu::run : server joining own game...");
-                    m_game->joinSession(0);
-                    gotoMultiHost( );            
-                }
-                else
-                {
-                    RACE("(!) Menu::run : server not successfully started...");
-                    gotoMultiplayer( );
-                }
-                break;
-            case Event::playCurrentItem:
-                playCurrentMenuItem( );
-                break;
-            default:
-                break;
+                gotoMultiplayer();
+            }
+            else if (m_nSessions == 1)
+            {
+                m_soundServerFound->play();
+                ::Sleep(DWORD(m_soundServerFound->length() * 1000.0f));
+                m_game->resetTimer();
+                gotoMultiplayerListServers();
+            }
+            else
+            {
+                m_soundServersFound->play();
+                ::Sleep(DWORD(m_soundServersFound->length() * 1000.0f));
+                m_game->resetTimer();
+                gotoMultiplayerListServers();
+            }
+            break;
+        case Event::stopSessionEnumAndJoin:
+            m_game->stopEnumSessions( );
+            if (m_game->raceClient()->nSessions( ) > 0)
+            {
+                RACE("Menu::run : server joining own game...");
+                m_game->joinSession(0);
+                gotoMultiHost( );            
             }
-            m_eventList.purge(e);
-            delete e;
-            e = 0;
+            else
+            {
+                RACE("(!) Menu::run : server not successfully started...");
+                gotoMultiplayer( );
+            }
+            break;
+        case Event::playCurrentItem:
+            playCurrentMenuItem( );
+            break;
+        default:
+            break;
         }
+        m_eventList.release(e);
     }
     m_elapsedTotal += elapsed;
 }
@@ -2030,23 +2170,13 @@ Menu::run(Float elapsed)
 void 
 Menu::pushEvent(Event::Type type, Float time, DirectX::Sound* sound)
 {
-    Event* e = new Event;
-    e->type = type;
-    e->time = m_elapsedTotal + time;
-    e->sound = sound;
-    m_eventList.push(e);
+    m_eventList.push(type, m_elapsedTotal + time, sound);
 }
 
 void 
 Menu::flushEvents()
 {
-    Event* e = 0;
-    while (e = m_eventList.next(e))
-    {
-        m_eventList.purge(e);
-        delete e;
-        e = 0;
-    }
+    m_eventList.clear( );
 }
 
 void
@@ -2964,7 +3094,9 @@ Menu::handleMenuItem(Item& item)
         m_soundSaved->play( );
         ::Sleep(DWORD(m_soundSaved->length( ) * 1000.0f));
         m_game->language(m_game->raceSettings( ).language);
+        // every sound has to come from the new language folder
         finalize( );
+        unload( );
         initialize(optionsGameSettings);
         m_game->resetTimer( );
 //        gotoOptionsGameSettings( );
@@ -3339,6 +3471,7 @@ m_game->threeD(true);
         m_soundSaved->play( );
         ::Sleep(DWORD(m_soundSaved->length( ) * 1000.0f));
         finalize( );
+        unload( );
         initialize(optionsGameSettings);
         m_game->resetTimer( );
 //        gotoOptionsGameSettings( );
@@ -3351,6 +3484,7 @@ m_game->threeD(false);
         m_soundSaved->play( );
         ::Sleep(DWORD(m_soundSaved->length( ) * 1000.0f));
         finalize( );
+        unload( );
         initialize(optionsGameSettings);
         m_game->resetTimer( );
 //        gotoOptionsGameSettings( );
@@ -3363,6 +3497,7 @@ m_game->threeD(false);
         ::Sleep(DWORD(m_soundSaved->length( ) * 1000.0f));
 m_soundManager->playInSoftware(false);
         finalize( );
+        unload( );
         initialize(optionsGameSettings);
         m_game->resetTimer( );
 //        gotoOptionsGameSettings( );
@@ -3375,6 +3510,7 @@ m_soundManager->playInSoftware(false);
         ::Sleep(DWORD(m_soundSaved->length( ) * 1000.0f));
         m_soundManager->playInSoftware(true);
         finalize( );
+        unload( );
         initialize(optionsGameSettings);
         m_game->resetTimer( );
 //        gotoOptionsGameSettings( );
@@ -3387,6 +3523,7 @@ m_soundManager->playInSoftware(false);
         ::Sleep(DWORD(m_soundSaved->length( ) * 1000.0f));
         m_soundManager->reverseStereo(m_game->raceSettings( ).reverseStereo);
         finalize( );
+        unload( );
         initialize(optionsGameSettings);
         m_game->resetTimer( );
 //        gotoOptionsGameSettings( );
@@ -3399,6 +3536,7 @@ m_soundManager->playInSoftware(false);
         ::Sleep(DWORD(m_soundSaved->length( ) * 1000.0f));
         m_soundManager->reverseStereo(m_game->raceSettings( ).reverseStereo);
         finalize( );
+        unload( );
         initialize(optionsGameSettings);
         m_game->resetTimer( );
 //        gotoOptionsGameSettings( );
@@ -3416,6 +3554,7 @@ m_soundManager->playInSoftware(false);
 m_soundManager->playInSoftware(false);
         m_soundManager->reverseStereo((Boolean)m_game->raceSettings( ).reverseStereo);
         finalize( );
+        unload( );
         m_game->raceInput( )->finalize( );
         m_game->raceInput( )->initialize( );
         initialize(options);
@@ -84,9 +84,15 @@ private:
     void    playCurrentMenuItem( );
     void    stopCurrentMenuItem( );
 
+    void load( );
+    void unload( );
+    void refresh( );
     void initializeLanguageMenu( );
     void initializeTrackMenu( );
     void initializeVehicleMenu( );
+    void finalizeLanguageMenu( );
+    void finalizeTrackMenu( );
+    void finalizeVehicleMenu( );
 
     void gotoTimeTrialCircuitVehicle( );
     void gotoSingleRaceCircuitVehicle( );
@@ -150,7 +156,7 @@ private:
 private:
     Game*                   m_game;
     DirectX::SoundManager*  m_soundManager;
-    EventList               m_eventList;
+    EventQueue              m_eventList;
     Float                   m_elapsedTotal;
     Boolean                 m_b1released;
     Boolean                 m_nextReleased;
@@ -385,6 +391,12 @@ private:
 
     UInt                    m_nLanguages;
     Goto                    m_goto;
+
+    // folder contents the custom menus were built from, see refresh( )
+    UInt                    m_languageStamp;
+    UInt                    m_trackStamp;
+    UInt                    m_vehicleStamp;
+    Boolean                 m_loaded;
 };
 
 
@@ -39,7 +39,8 @@ NetworkPlayer::NetworkPlayer( ) :
     m_state(running),
     m_speed(0),
     m_positionX(0),
-    m_positionY(0)
+    m_positionY(0),
+    m_time(0.0f)
 {
     RACE("(+) NetworkPlayer");
 }
@@ -60,6 +61,8 @@ NetworkPlayer::initialize(Game* game, UInt number, UInt vehicle, Int trackLength
     m_trackLength = trackLength;
     m_laneWidth   = laneWidth;
     m_carType     = (CarType)vehicle;
+    m_states.reset( );
+    m_time        = 0.0f;
 
     m_topspeed      = vehicles[vehicle].topspeed;
     m_deceleration  = vehicles[vehicle].deceleration;
@@ -68,15 +71,15 @@ NetworkPlayer::initialize(Game* game, UInt number, UInt vehicle, Int trackLength
     m_shiftfreq     = vehicles[vehicle].shiftfreq;
     m_gears         = vehicles[vehicle].gears;
     m_frequency     = m_idlefreq;
-    m_soundEngine   = m_game->soundManager()->create(vehicles[vehicle].engineSound, m_game->threeD( ));
-    m_soundStart    = m_game->soundManager()->create(vehicles[vehicle].startSound, m_game->threeD( ));
-    m_soundHorn     = m_game->soundManager()->create(vehicles[vehicle].hornSound, m_game->threeD( ));
+    m_soundEngine   = m_emitter.add(m_game->soundManager()->create(vehicles[vehicle].engineSound, m_game->threeD( )));
+    m_soundStart    = m_emitter.add(m_game->soundManager()->create(vehicles[vehicle].startSound, m_game->threeD( )));
+    m_soundHorn     = m_emitter.add(m_game->soundManager()->create(vehicles[vehicle].hornSound, m_game->threeD( )));
     if (vehicles[vehicle].backfireSound)
-        m_soundBackfire = m_game->soundManager()->create(vehicles[vehicle].backfireSound, m_game->threeD( ));
-    m_soundCrash     = m_game->soundManager()->create(vehicles[vehicle].monoCrashSound, m_game->threeD( ));
+        m_soundBackfire = m_emitter.add(m_game->soundManager()->create(vehicles[vehicle].backfireSound, m_game->threeD( )));
+    m_soundCrash     = m_emitter.add(m_game->soundManager()->create(vehicles[vehicle].monoCrashSound, m_game->threeD( )));
     if (m_game->threeD( ))
     {
-        m_soundBrake     = m_game->soundManager()->create(vehicles[vehicle].brakeSound, m_game->threeD( ));
+        m_soundBrake     = m_emitter.add(m_game->soundManager()->create(vehicles[vehicle].brakeSound, m_game->threeD( )));
         m_soundEngine->initializeBuffer3D( );
         m_soundStart->initializeBuffer3D( );
         m_soundHorn->initializeBuffer3D( );
@@ -85,6 +88,8 @@ NetworkPlayer::initialize(Game* game, UInt number, UInt vehicle, Int trackLength
         m_soundCrash->initializeBuffer3D( );
         m_soundBrake->initializeBuffer3D( );
     }
+    // the cars of the opponents share a budget of voices
+    m_emitter.voiceManager(m_game->soundManager()->voiceManager( ));
 /*
     Char soundFile[64];
     sprintf(soundFile, "race\\info\\front%d", m_number+1);
@@ -102,21 +107,39 @@ NetworkPlayer::finalize( )
     RACE("NetworkPlayer[%d]::finalize", m_number);
     m_initialized = false;
     m_number = 0;
-    SAFE_DELETE(m_soundEngine);
-    SAFE_DELETE(m_soundHorn);
-    if (m_soundBackfire != 0)
-        SAFE_DELETE(m_soundBackfire);
-    SAFE_DELETE(m_soundStart);
-    SAFE_DELETE(m_soundCrash);
-    if (m_soundBrake != 0)
-        SAFE_DELETE(m_soundBrake);
+    m_emitter.clear( );
+    m_soundEngine = 0;
+    m_soundHorn = 0;
+    m_soundBackfire = 0;
+    m_soundStart = 0;
+    m_soundCrash = 0;
+    m_soundBrake = 0;
 //    SAFE_DELETE(m_soundInFront);
 //    SAFE_DELETE(m_soundOnTail);
 }
 
+// Keeps a state that arrived from the server, to be played back smoothly by run.
+void
+NetworkPlayer::receive(Int x, Int y, Int speed, Int frequency)
+{
+    m_states.push(m_time, x, y, speed, frequency);
+}
+
 void
 NetworkPlayer::run(Float elapsed, Int playerX, Int playerY)
 {
+    m_time += elapsed;
+    if (m_state == running)
+    {
+        StateBuffer::State state;
+        if (m_states.sample(m_time, state))
+        {
+            m_positionX = Int(state.positionX);
+            m_positionY = Int(state.positionY);
+            m_speed     = Int(state.speed);
+            m_frequency = Int(state.frequency);
+        }
+    }
     m_diffX = m_positionX - playerX;
     m_diffY = m_positionY - playerY;
     m_diffY = ((m_diffY%m_trackLength) + m_trackLength) % m_trackLength;
@@ -124,35 +147,20 @@ NetworkPlayer::run(Float elapsed, Int playerX, Int playerY)
         m_diffY = (m_diffY - m_trackLength)%m_trackLength;
     DirectX::Vector3 relPos(Float(m_diffX) / Float(m_laneWidth), Float(m_diffY) / 12000.0f, 0.0f);
     if (m_game->threeD( ))
-    {
-        m_soundEngine->position(relPos);
-        m_soundStart->position(relPos);
-        m_soundHorn->position(relPos);
-        if (m_soundBackfire != 0)
-            m_soundBackfire->position(relPos);
-        m_soundCrash->position(relPos);
-        m_soundBrake->position(relPos);
-    }
+        m_emitter.position(relPos);
     else
-    {
-        setSoundPosition(m_soundEngine, relPos);
-        setSoundPosition(m_soundStart, relPos);
-        setSoundPosition(m_soundHorn, relPos);
-        if (m_soundBackfire != 0)
-            setSoundPosition(m_soundBackfire, relPos);
-        setSoundPosition(m_soundCrash, relPos);
-//        setSoundPosition(m_soundBrake, relPos);
-    }
+        setSoundPosition(relPos);
     if (m_state == running)
     {
+        // the interpolated pitch changes a little every frame, so follow it every frame
+        if (m_frequency != m_prevFrequency)
+        {
+            m_soundEngine->frequency(m_frequency);
+            m_prevFrequency = m_frequency;
+        }
         if (m_frame % 4 == 0)
         {
             m_frame = 0;
-            if (m_frequency != m_prevFrequency)
-            {
-                m_soundEngine->frequency(m_frequency);
-                m_prevFrequency = m_frequency;
-            }
     if (m_game->threeD( ))
 {
             m_brakeFrequency = 11025 + 22050*m_speed/m_topspeed;
@@ -292,17 +300,19 @@ NetworkPlayer::sayOnTail( )
 }
 */
 
+// The pan law of the game without 3D sound, worked out once for all the
+// sounds of the car.
 void
-NetworkPlayer::setSoundPosition(DirectX::Sound* sound, DirectX::Vector3 relPos)
+NetworkPlayer::setSoundPosition(DirectX::Vector3 relPos)
 {
     Float distance = sqrt(sqrt(relPos.x*relPos.x) + sqrt(relPos.y*relPos.y));
     if (relPos.x < -2.0f)
-        sound->pan(-100);
+        m_emitter.pan(-100);
     else if (relPos.x > 2.0f)
-        sound->pan(100);
+        m_emitter.pan(100);
     else
-        sound->pan(Int(relPos.x*50.0f));
-sound->volume(Int(100.0f - (distance*10.0f)));
+        m_emitter.pan(Int(relPos.x*50.0f));
+    m_emitter.volume(Int(100.0f - (distance*10.0f)));
 }
 
 void
@@ -12,6 +12,7 @@
 
 #include "Packets.h"
 #include "Game.h"
+#include "StateBuffer.h"
 
 class NetworkPlayer
 {
@@ -29,6 +30,7 @@ public:
     void    initialize(Game* game, UInt number, UInt vehicle, Int trackLength, UInt laneWidth);
     void    finalize( );
     void    run(Float elapsed, Int playerX, Int playerY);
+    void    receive(Int x, Int y, Int speed, Int frequency);
     void    position(Int x, Int y)  { m_positionX = x; m_positionY = y; }
     void    speed(Int speed)        { m_speed = speed;                  }
     void    frequency(Int frequency)        { m_frequency = frequency;                  }
@@ -61,7 +63,7 @@ public:
 
 private:
     void    updateEngineFreq( );
-    void    setSoundPosition(DirectX::Sound* sound, DirectX::Vector3 relPos);
+    void    setSoundPosition(DirectX::Vector3 relPos);
 
 private:
     UInt                    m_number;
@@ -86,6 +88,7 @@ private:
 //    DirectX::Sound*         m_soundInFront;
 //    DirectX::Sound*         m_soundOnTail;
     DirectX::Sound*         m_soundCrash;
+    DirectX::Emitter        m_emitter;      // owns the sounds above
     Boolean                 m_initialized;
     Boolean                 m_finished;
     Boolean                 m_backfirePlayed;
@@ -101,6 +104,8 @@ private:
     UInt                    m_laneWidth;
     Int                     m_diffX;
     Int                     m_diffY;
+    StateBuffer             m_states;
+    Float                   m_time;
 };
 
 
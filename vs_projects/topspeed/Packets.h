@@ -8,12 +8,24 @@
 #define __RACING_PACKETS_H__
 
 #include <Common/If/Common.h>
-#include "Track.h"
+#include "TrackGeometry.h"
 
-#define         NMAXPLAYERS     8
-#define         MAXMULTITRACKLENGTH    8192
+#define         NMAXPLAYERS     32
+#define         PLAYERNUMBERBITS       5              // enough for NMAXPLAYERS-1
+#define         MAXMULTITRACKLENGTH    1048576        // definitions a client accepts for a track
+#define         TRACKCHUNKSIZE         1024           // bytes of the track stream in a PacketTrackChunk
+#define         TRACKWINDOW            8              // chunks the server sends for one PacketTrackRequest
+#define         TRACKCACHESIZE         16             // tracks a client keeps after the race
+#define         RACEAPPLICATION        0xede9493e     // the first part of the game GUID
+#define         RACEPORT               25255
+#define         SNAPSHOTHISTORY        32
+#define         SNAPSHOTENTRYSIZE      30             // the most bytes a packed player entry takes
+#define         PLAYERDATASIZE         32             // the most bytes the packed data of PacketPlayerDataToServer takes
+#define         POSITIONQUANTUM        8              // positions are rounded to this many units on the wire
+#define         NOECHO                 0xFFFF         // echoDelay of a client that has not applied a snapshot yet
+#define         CLIENT_SEND_TIME       0.1f           // seconds between two PacketPlayerDataToServer of a racer
 
-const UByte _TopSpeedVersion = 0x1E;
+const UByte _TopSpeedVersion = 0x23;
 
 #pragma pack(push)
 #pragma pack(1)
@@ -80,7 +92,29 @@ enum Command
     cmdPlayerCrashed,
     cmdPlayerBumped,
     cmdPlayerDisconnected,
-    cmdLoadCustomTrack
+    cmdLoadCustomTrack,
+    cmdPlayerSnapshot,
+    cmdTrackRequest,
+    cmdTrackChunk
+};
+
+// The fields of a player in a PacketPlayerSnapshot entry. Each entry is
+// the player number in PLAYERNUMBERBITS and a mask of these bits in 8,
+// followed by the fields in the mask in this order, packed by PlayerCodec.
+// Fields that did not change since the baseline snapshot are left out,
+// and so are players that did not change at all.
+enum SnapshotField
+{
+    snapshotId          = 0x01,     // varint
+    snapshotCar         = 0x02,     // 4 bits
+    snapshotPosition    = 0x04,     // posX signed varint, posY lap and distance into it
+    snapshotSpeed       = 0x08,     // varint
+    snapshotFrequency   = 0x10,     // varint
+    snapshotState       = 0x20,     // 3 bits
+    snapshotFlags       = 0x40,     // 4 bits: engineRunning, braking, horning, backfiring
+    snapshotAll         = 0x7F,
+    snapshotRemoved     = 0x80,     // no fields, the player is no longer racing
+    snapshotToServer    = 0x5E      // what a client sends the server about itself
 };
 
 
@@ -93,14 +127,6 @@ struct PlayerRaceData
     Int            frequency;    
 };
 
-struct MultiplayerDefinition
-{
-    UByte           type;
-    UByte           surface;
-    UByte           noise;
-    UInt            length;
-};
-
 class PacketBase
 {
 public:
@@ -119,10 +145,37 @@ public:
     UShort          trackLength;
 };
 
-class PacketLoadCustomTrack : public PacketLoadTrack
+// Tells a client which track the next race is on. The definitions follow
+// in PacketTrackChunks of the stream TrackStream packs them into, which
+// the client asks for with PacketTrackRequests, unless it kept a track
+// with the same hash from an earlier race.
+class PacketLoadCustomTrack : public PacketBase
 {
 public:
-    MultiplayerDefinition trackDefinition[MAXMULTITRACKLENGTH];
+    UByte           nrOfLaps;
+    Char            trackname[12];
+    UByte           trackWeather;
+    UByte           trackAmbience;
+    UInt            trackLength;        // number of definitions
+    UInt            streamSize;
+    UInt            streamHash;
+};
+
+// Asks the server for the TRACKWINDOW chunks of the track stream from offset.
+class PacketTrackRequest : public PacketBase
+{
+public:
+    UInt            streamHash;
+    UInt            offset;
+};
+
+class PacketTrackChunk : public PacketBase
+{
+public:
+    UInt            streamHash;
+    UInt            offset;
+    UShort          size;
+    UByte           data[TRACKCHUNKSIZE];
 };
 
 
@@ -156,6 +209,36 @@ public:
     Boolean         backfiring;
 };
 
+// The data of a client, sent to the server once per update. The data is
+// packed like a snapshot entry: the lap length as a varint, then the
+// snapshotToServer fields. The client echoes the serverTime of the last
+// snapshot it applied and how long it held it, which gives the server
+// the round trip, and says when it took the data on its own clock. The
+// count of snapshots it applied tells the server how many were lost.
+class PacketPlayerDataToServer : public PacketBase
+{
+public:
+    UShort          snapshotAck;        // last snapshot the client applied
+    UShort          snapshotsApplied;   // wraps around
+    UInt            sendTime;           // ms on the client's clock
+    UInt            echoTime;
+    UShort          echoDelay;          // ms between applying that snapshot and sending this
+    UByte           playerNumber;
+    UByte           data[PLAYERDATASIZE];
+};
+
+// The data of all racers, sent to each client at the rate of its link. The
+// entries are packed behind the lap length, which is a varint.
+class PacketPlayerSnapshot : public PacketBase
+{
+public:
+    UShort          sequence;
+    UShort          baseline;           // 0 if the entries are complete
+    UInt            serverTime;         // ms on the server's clock when it was sent
+    UByte           nEntries;
+    UByte           entries[5 + NMAXPLAYERS*SNAPSHOTENTRYSIZE];
+};
+
 class PacketPlayerState : public PacketPlayer
 {
 public:
@@ -185,4 +268,12 @@ public:
 
 #pragma pack(pop)
 
+// What the server sent, or the client applied, in one snapshot.
+struct PlayerSnapshot
+{
+    UShort          sequence;
+    Boolean         present[NMAXPLAYERS];
+    PlayerData      player[NMAXPLAYERS];
+};
+
 #endif /* __RACING_PACKETS_H__ */
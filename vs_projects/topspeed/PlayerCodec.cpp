@@ -0,0 +1,123 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#include "PlayerCodec.h"
+
+#define CARBITS         4
+#define STATEBITS       3
+#define FLAGBITS        4
+#define LAPGROUPBITS    3       // a race has few laps
+#define VALUEGROUPBITS  8       // speed and frequency nearly always fit in two groups
+
+
+static Int
+floorDiv(Int a, Int b)
+{
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+
+UInt
+PlayerCodec::changed(const PlayerData& player, const PlayerData& old)
+{
+    UInt changed = 0;
+    if (player.id != old.id)
+        changed |= snapshotId;
+    if (player.car != old.car)
+        changed |= snapshotCar;
+    if ((player.posX != old.posX) || (player.posY != old.posY))
+        changed |= snapshotPosition;
+    if (player.speed != old.speed)
+        changed |= snapshotSpeed;
+    if (player.frequency != old.frequency)
+        changed |= snapshotFrequency;
+    if (player.state != old.state)
+        changed |= snapshotState;
+    if (flags(player) != flags(old))
+        changed |= snapshotFlags;
+    return changed;
+}
+
+
+UInt
+PlayerCodec::flags(const PlayerData& player)
+{
+    return (player.engineRunning ? 0x01 : 0) | (player.braking ? 0x02 : 0) |
+           (player.horning ? 0x04 : 0) | (player.backfiring ? 0x08 : 0);
+}
+
+
+void
+PlayerCodec::write(BitWriter& writer, const PlayerData& player, UInt fields, UInt lapLength)
+{
+    if (fields & snapshotId)
+        writer.writeVarint(player.id);
+    if (fields & snapshotCar)
+        writer.write(player.car, CARBITS);
+    if (fields & snapshotPosition)
+    {
+        writer.writeSigned(floorDiv(player.posX, POSITIONQUANTUM));
+        if (lapLength >= POSITIONQUANTUM)
+        {
+            Int lap = floorDiv(player.posY, (Int)lapLength);
+            UInt distance = UInt(player.posY - lap*(Int)lapLength);
+            writer.writeSigned(lap, LAPGROUPBITS);
+            writer.write(distance / POSITIONQUANTUM, BitWriter::bitsFor((lapLength - 1) / POSITIONQUANTUM));
+        }
+        else
+        {
+            writer.writeSigned(floorDiv(player.posY, POSITIONQUANTUM));
+        }
+    }
+    if (fields & snapshotSpeed)
+        writer.writeVarint(player.speed, VALUEGROUPBITS);
+    if (fields & snapshotFrequency)
+        writer.writeVarint(UInt(player.frequency), VALUEGROUPBITS);
+    if (fields & snapshotState)
+        writer.write(player.state, STATEBITS);
+    if (fields & snapshotFlags)
+        writer.write(flags(player), FLAGBITS);
+}
+
+
+// Positions come back in the middle of the step they were rounded down to.
+Boolean
+PlayerCodec::read(BitReader& reader, PlayerData& player, UInt fields, UInt lapLength)
+{
+    if (fields & snapshotId)
+        player.id = reader.readVarint( );
+    if (fields & snapshotCar)
+        player.car = (UByte)reader.read(CARBITS);
+    if (fields & snapshotPosition)
+    {
+        player.posX = reader.readSigned( )*POSITIONQUANTUM + POSITIONQUANTUM/2;
+        if (lapLength >= POSITIONQUANTUM)
+        {
+            Int lap = reader.readSigned(LAPGROUPBITS);
+            UInt distance = reader.read(BitWriter::bitsFor((lapLength - 1) / POSITIONQUANTUM))*POSITIONQUANTUM;
+            player.posY = lap*(Int)lapLength + (Int)distance + POSITIONQUANTUM/2;
+        }
+        else
+        {
+            player.posY = reader.readSigned( )*POSITIONQUANTUM + POSITIONQUANTUM/2;
+        }
+    }
+    if (fields & snapshotSpeed)
+        player.speed = (UShort)reader.readVarint(VALUEGROUPBITS);
+    if (fields & snapshotFrequency)
+        player.frequency = (Int)reader.readVarint(VALUEGROUPBITS);
+    if (fields & snapshotState)
+        player.state = (UByte)reader.read(STATEBITS);
+    if (fields & snapshotFlags)
+    {
+        UInt flags = reader.read(FLAGBITS);
+        player.engineRunning  = (flags & 0x01) != 0;
+        player.braking        = (flags & 0x02) != 0;
+        player.horning        = (flags & 0x04) != 0;
+        player.backfiring     = (flags & 0x08) != 0;
+    }
+    return !reader.failed( );
+}
@@ -0,0 +1,32 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __RACING_PLAYERCODEC_H__
+#define __RACING_PLAYERCODEC_H__
+
+#include "Packets.h"
+#include "BitStream.h"
+
+
+// Packs the SnapshotFields of a PlayerData for the wire, the same way for
+// the snapshots of the server and the data the clients send it.
+// Positions are rounded down to POSITIONQUANTUM. Along the track a
+// position is sent as the lap it is in and the distance into that lap,
+// which takes just enough bits for the length of the lap; the sender
+// puts that length in the packet, so both ends always agree on it.
+// Speed and frequency are varints, the state and the flags a few bits.
+class PlayerCodec
+{
+public:
+    static UInt     changed(const PlayerData& player, const PlayerData& old);
+    static UInt     flags(const PlayerData& player);
+
+    static void     write(BitWriter& writer, const PlayerData& player, UInt fields, UInt lapLength);
+    static Boolean  read(BitReader& reader, PlayerData& player, UInt fields, UInt lapLength);
+};
+
+
+#endif /* __RACING_PLAYERCODEC_H__ */
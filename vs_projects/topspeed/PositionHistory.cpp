@@ -0,0 +1,116 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#include "PositionHistory.h"
+
+
+PositionHistory::PositionHistory( ) :
+    m_first(0),
+    m_nEntries(0),
+    m_offset(0)
+{
+}
+
+
+PositionHistory::~PositionHistory( )
+{
+}
+
+
+void
+PositionHistory::reset( )
+{
+    m_first = 0;
+    m_nEntries = 0;
+    m_offset = 0;
+}
+
+
+// Times on both clocks wrap around, so they are only ever compared by
+// their difference.
+void
+PositionHistory::add(UInt clientTime, UInt received, UInt roundTrip, Int posX, Int posY, Int speed)
+{
+    if ((m_nEntries > 0) && (Int(clientTime - entry(m_nEntries - 1).clientTime) <= 0))
+        return;
+    if (m_nEntries == POSITIONHISTORY)
+    {
+        m_first = (m_first + 1) % POSITIONHISTORY;
+        --m_nEntries;
+    }
+    Entry& added = m_entries[(m_first + m_nEntries) % POSITIONHISTORY];
+    ++m_nEntries;
+    added.clientTime = clientTime;
+    added.roundTrip  = roundTrip;
+    added.offset     = Int(received - ((roundTrip == NOROUNDTRIP) ? 0 : roundTrip / 2) - clientTime);
+    added.posX       = posX;
+    added.posY       = posY;
+    added.speed      = speed;
+
+    const Entry* best = &entry(0);
+    for (UInt i = 1; i < m_nEntries; ++i)
+    {
+        if (entry(i).roundTrip <= best->roundTrip)
+            best = &entry(i);
+    }
+    m_offset = best->offset;
+}
+
+
+UInt
+PositionHistory::latest( ) const
+{
+    return sample(entry(m_nEntries - 1)).time;
+}
+
+
+// Between two updates the car is where it would be had it moved evenly
+// from the one to the other. Before the first update it is where that
+// update had it, and after the last one it stays where the last one had
+// it, as there is nothing to tell which way it went.
+PositionHistory::Sample
+PositionHistory::at(UInt time) const
+{
+    Sample after = sample(entry(0));
+    if (Int(time - after.time) <= 0)
+        return after;
+    for (UInt i = 1; i < m_nEntries; ++i)
+    {
+        Sample before = after;
+        after = sample(entry(i));
+        if (Int(time - after.time) < 0)
+        {
+            Int span = Int(after.time - before.time);
+            Int part = Int(time - before.time);
+            Sample between;
+            between.time  = time;
+            between.posX  = before.posX + Int(Huge(after.posX - before.posX) * part / span);
+            between.posY  = before.posY + Int(Huge(after.posY - before.posY) * part / span);
+            between.speed = before.speed + (after.speed - before.speed) * part / span;
+            return between;
+        }
+    }
+    return after;
+}
+
+
+const PositionHistory::Entry&
+PositionHistory::entry(UInt i) const
+{
+    return m_entries[(m_first + i) % POSITIONHISTORY];
+}
+
+
+PositionHistory::Sample
+PositionHistory::sample(const Entry& entry) const
+{
+    Sample sample;
+    sample.time  = entry.clientTime + UInt(m_offset);
+    sample.posX  = entry.posX;
+    sample.posY  = entry.posY;
+    sample.speed = entry.speed;
+    return sample;
+}
@@ -0,0 +1,69 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __RACING_POSITIONHISTORY_H__
+#define __RACING_POSITIONHISTORY_H__
+
+#include <Common/If/Types.h>
+
+#define POSITIONHISTORY     16              // updates kept per player, over a second at the usual rate
+#define NOROUNDTRIP         0xFFFFFFFF      // the round trip of an update sent before any snapshot arrived
+
+
+// The last POSITIONHISTORY positions a client sent the server, each at the
+// time on the server's clock that the client took it, so the server can
+// tell where the car was at any moment of that time instead of only where
+// it was when its last update came in.
+// An update carries the time on the client's clock. The offset between
+// the clocks is the time the update arrived, less half its round trip,
+// less the client's time; the update with the shortest round trip gives
+// the best offset, as it was held up least on the way, so that offset is
+// used for all updates in the history.
+class PositionHistory
+{
+public:
+    struct Sample
+    {
+        UInt        time;               // on the server's clock, in ms
+        Int         posX;
+        Int         posY;
+        Int         speed;
+    };
+
+public:
+    PositionHistory( );
+    virtual ~PositionHistory( );
+
+public:
+    void        reset( );
+    void        add(UInt clientTime, UInt received, UInt roundTrip, Int posX, Int posY, Int speed);
+    Boolean     empty( ) const          { return (m_nEntries == 0);   }
+    UInt        latest( ) const;
+    Sample      at(UInt time) const;
+
+private:
+    struct Entry
+    {
+        UInt        clientTime;
+        Int         offset;
+        UInt        roundTrip;
+        Int         posX;
+        Int         posY;
+        Int         speed;
+    };
+
+    const Entry&    entry(UInt i) const;
+    Sample          sample(const Entry& entry) const;
+
+private:
+    Entry       m_entries[POSITIONHISTORY];
+    UInt        m_first;
+    UInt        m_nEntries;
+    Int         m_offset;
+};
+
+
+#endif /* __RACING_POSITIONHISTORY_H__ */
@@ -7,15 +7,27 @@
 #include "Game.h"
 #include "RaceClient.h"
 #include "Packets.h"
+#include "PlayerCodec.h"
+#include "TrackStream.h"
+#include <DxCommon/If/UdpTransport.h>
+#include <Common/If/Algorithm.h>
+
 
 RaceClient::RaceClient(Game* game) :
     m_game(game),
     m_client(0),
     m_trackSelected(false),
     m_nrOfLaps(3),
+    m_lapLength(0),
+    m_trackStreamSize(0),
+    m_trackHash(0),
+    m_trackRequested(0),
+    m_snapshotTimed(false),
     m_playerNumber(0),
     m_playerId(0),
     m_connected(false),
+    m_sessionLost(false),
+    m_forceDisconnected(false),
     m_raceAborted(false),
     m_startRace(false),
     m_playerBumped(false),
@@ -25,6 +37,7 @@ RaceClient::RaceClient(Game* game) :
     Mutex::Guard guard(m_mutex);
     RACE("(+) RaceClient");
     m_trackData.definition = NULL;
+    publish( );
 }
 
 
@@ -42,12 +55,14 @@ RaceClient::initialize( )
     RACE("RaceClient::initialize");
     if (m_client == 0)
     {
-        m_client = new DirectX::Client( );
+        m_client = new DirectX::Client(m_game->gameTransport( ));
         m_client->setGUID(m_game->gameGuid());
         m_client->setIClient(this);
         m_client->initialize( );
     }
     m_trackSelected = false;
+    // a track that was cut off is asked for again from where it stopped
+    m_trackRequested = 0;
     // state flags
     m_connected = false;
     m_startRace = false;
@@ -68,25 +83,38 @@ RaceClient::initialize( )
         m_playerData[player].braking = false;
         m_playerData[player].horning = false;
         m_playerData[player].backfiring = false;
+        m_playerUpdates[player] = 0;
         m_playerFinished[player] = false;
         m_playerFinalize[player] = false;
         m_playerStarted[player] = false;
         m_playerCrashed[player] = false;
+        m_playerDisconnected[player] = false;
     }
+    // what is still queued belongs to the session before
+    m_events.clear( );
+    m_snapshotReceiver.reset( );
+    m_sentSnapshotAck = 0;
+    m_snapshotTimed = false;
     m_playerState = undefined;
     resetResults( );
+    publish( );
 }
 
 void
 RaceClient::finalize( )
 {
-    Mutex::Guard guard(m_mutex);
-    RACE("RaceClient::finalize");
-    if (m_client)
+    DirectX::Client* client;
     {
-        m_client->finalize( );
-        SAFE_DELETE(m_client);
+        Mutex::Guard guard(m_mutex);
+        RACE("RaceClient::finalize");
+        client = m_client;
     }
+    // finalizing waits for the network thread, which may be waiting for m_mutex
+    if (client)
+        client->finalize( );
+
+    Mutex::Guard guard(m_mutex);
+    SAFE_DELETE(m_client);
     m_trackSelected = false;
 	SAFE_DELETE_ARRAY(m_trackData.definition);
     // state flags
@@ -96,6 +124,7 @@ RaceClient::finalize( )
     m_sessionLost = false;
     m_forceDisconnected = false;
     m_raceAborted = false;
+    publish( );
 }
 
 
@@ -152,13 +181,24 @@ RaceClient::joinSessionAt(Char* ipAddress)
 {
     Mutex::Guard guard(m_mutex);
     RACE("RaceClient::joinSessionAt : joining session at %s...", ipAddress);
-    return m_client->joinSessionAt(m_game->gamePort(), ipAddress);
+    // "address:port" reaches a session on another port, like the lobbies of a dedicated server
+    Char address[256];
+    strncpy(address, ipAddress, sizeof(address) - 1);
+    address[sizeof(address) - 1] = '\0';
+    UInt port = m_game->gamePort();
+    Char* colon = strrchr(address, ':');
+    if ((colon) && (atoi(colon + 1) > 0))
+    {
+        port = atoi(colon + 1);
+        *colon = '\0';
+    }
+    return m_client->joinSessionAt(port, address);
 }
 
 Boolean
 RaceClient::playerFinished(UInt player)
 {
-    Mutex::Guard guard(m_mutex);
+    takeEvents( );
     if (m_playerFinished[player])
     {
         RACE("RaceClient::playerFinished : player %d finished!", player);
@@ -172,7 +212,7 @@ RaceClient::playerFinished(UInt player)
 Boolean
 RaceClient::playerFinalize(UInt player)
 {
-    Mutex::Guard guard(m_mutex);
+    takeEvents( );
     if (m_playerFinalize[player])
     {
 //        RACE("RaceClient::playerFinalize : player %d", player);
@@ -187,7 +227,7 @@ RaceClient::playerFinalize(UInt player)
 Boolean
 RaceClient::playerStarted(UInt player)
 {
-    Mutex::Guard guard(m_mutex);
+    takeEvents( );
     if (m_playerStarted[player])
     {
         RACE("RaceClient::playerStarted : player %d started!", player);
@@ -202,7 +242,7 @@ RaceClient::playerStarted(UInt player)
 Boolean
 RaceClient::playerCrashed(UInt player)
 {
-    Mutex::Guard guard(m_mutex);
+    takeEvents( );
     if (m_playerCrashed[player])
     {
 //        RACE("RaceClient::playerCrashed : player %d crashed!", player);
@@ -213,10 +253,25 @@ RaceClient::playerCrashed(UInt player)
         return false;
 }
 
+
+Boolean
+RaceClient::playerDisconnected(UInt player)
+{
+    takeEvents( );
+    if (m_playerDisconnected[player])
+    {
+        m_playerDisconnected[player] = false;
+        return true;
+    }
+    else
+        return false;
+}
+
+
 Boolean     
 RaceClient::playerBumped(Int& bumpX, Int& bumpY, Int& bumpSpeed)
 {
-    Mutex::Guard guard(m_mutex);
+    takeEvents( );
     if (m_playerBumped)
     {
         bumpX = m_playerBumpX;
@@ -238,6 +293,7 @@ RACE("RaceClient::resetTrack");
     m_trackSelected = false;
 
 	SAFE_DELETE_ARRAY(m_trackData.definition);
+    publish( );
 }
 
 /*
@@ -316,24 +372,23 @@ void
 RaceClient::sendData(PlayerData data, Boolean secure)
 {
     Mutex::Guard guard(m_mutex);
-    if ((secure) || (m_playerData[m_playerNumber].car != data.car) || (m_playerData[m_playerNumber].posX != data.posX) || (m_playerData[m_playerNumber].posY != data.posY) || (m_playerData[m_playerNumber].speed != data.speed) || (m_playerData[m_playerNumber].frequency != data.frequency) || (m_playerData[m_playerNumber].engineRunning != data.engineRunning) || (m_playerData[m_playerNumber].braking != data.braking) || (m_playerData[m_playerNumber].horning != data.horning) || (m_playerData[m_playerNumber].backfiring != data.backfiring))
+    if ((secure) || (m_playerData[m_playerNumber].car != data.car) || (m_playerData[m_playerNumber].posX != data.posX) || (m_playerData[m_playerNumber].posY != data.posY) || (m_playerData[m_playerNumber].speed != data.speed) || (m_playerData[m_playerNumber].frequency != data.frequency) || (m_playerData[m_playerNumber].engineRunning != data.engineRunning) || (m_playerData[m_playerNumber].braking != data.braking) || (m_playerData[m_playerNumber].horning != data.horning) || (m_playerData[m_playerNumber].backfiring != data.backfiring) || (m_snapshotReceiver.ack( ) != m_sentSnapshotAck))
     {
-        PacketPlayerData packet;
+        UInt now = DirectX::UdpTransport::now( );
+        PacketPlayerDataToServer packet;
         packet.command              = cmdPlayerDataToServer;
-        packet.playerId             = data.id;
+        packet.snapshotAck          = m_snapshotReceiver.ack( );
+        packet.snapshotsApplied     = m_snapshotReceiver.nApplied( );
+        packet.sendTime             = now;
+        packet.echoTime             = m_snapshotTime;
+        packet.echoDelay            = (m_snapshotTimed) ? (UShort)minimum<UInt>(now - m_snapshotApplied, NOECHO - 1) : NOECHO;
         packet.playerNumber         = data.playerNumber;
-        packet.car                  = data.car;
-        packet.racedata.positionX   = data.posX;
-        packet.racedata.positionY   = data.posY;
-        packet.racedata.speed       = data.speed;
-        packet.racedata.frequency       = data.frequency;
-        // RACE("RaceClient::sendData : Sending packet with speed=%d and frequency=%d", packet.racedata.speed, packet.racedata.frequency);
-        packet.state                = (UByte)m_playerState;
-        packet.engineRunning        = data.engineRunning;
-        packet.braking              = data.braking;
-        packet.horning              = data.horning;
-        packet.backfiring           = data.backfiring;
-        sendPacket(&packet, sizeof(PacketPlayerData), secure);
+        // RACE("RaceClient::sendData : Sending packet with speed=%d and frequency=%d", data.speed, data.frequency);
+        BitWriter writer(packet.data, sizeof(packet.data));
+        writer.writeVarint(m_lapLength);
+        PlayerCodec::write(writer, data, snapshotToServer, m_lapLength);
+        sendPacket(&packet, sizeof(PacketPlayerDataToServer) - sizeof(packet.data) + writer.size( ), secure);
+        m_sentSnapshotAck = m_snapshotReceiver.ack( );
         m_playerData[m_playerNumber].id = data.id;
         m_playerData[m_playerNumber].playerNumber = data.playerNumber;
         m_playerData[m_playerNumber].car = data.car;
@@ -345,6 +400,7 @@ RaceClient::sendData(PlayerData data, Boolean secure)
         m_playerData[m_playerNumber].braking = data.braking;
         m_playerData[m_playerNumber].horning = data.horning;
         m_playerData[m_playerNumber].backfiring = data.backfiring;
+        publish( );
     }
 }
 
@@ -442,9 +498,13 @@ RACE("***client received packet %d, command %d with a size of %d", packet, packe
                         m_playerData[player].braking        = playerData->braking;
                         m_playerData[player].horning        = playerData->horning;
                         m_playerData[player].backfiring     = playerData->backfiring;
+                        ++m_playerUpdates[player];
                     }
                     break;
                 }
+                case cmdPlayerSnapshot :
+                    applySnapshot(reinterpret_cast<PacketPlayerSnapshot*>(packet), size);
+                    break;
                 case cmdPlayerState :
                 {
                     // Update the playerstate for this client
@@ -487,76 +547,182 @@ else
                 {
                     PacketPlayer* playerFinished = static_cast<PacketPlayer*>(buffer);
                     RACE("RaceClient::onPacket : received 'PlayerFinished' from player %d", playerFinished->playerNumber);
-                    m_playerFinished[playerFinished->playerNumber] = true;
+                    pushEvent(Event::finished, playerFinished->playerNumber);
                     break;
                 }
                 case cmdPlayerFinalize :
                 {
                     PacketPlayerState* playerFinalize = static_cast<PacketPlayerState*>(buffer);
                     // RACE("RaceClient::onPacket : received 'PlayerFinalize' from player %d", playerFinalize->playerNumber);
-                    m_playerData[playerFinalize->playerNumber].state = playerFinalize->state;
-                    m_playerFinalize[playerFinalize->playerNumber] = true;
+                    if (playerFinalize->playerNumber < NMAXPLAYERS)
+                        m_playerData[playerFinalize->playerNumber].state = playerFinalize->state;
+                    pushEvent(Event::finalize, playerFinalize->playerNumber);
                     break;
                 }
                 case cmdPlayerStarted :
                 {
                     PacketPlayer* playerStarted = static_cast<PacketPlayer*>(buffer);
                     RACE("RaceClient::onPacket : received 'PlayerStarted' from player %d", playerStarted->playerNumber);
-                    m_playerStarted[playerStarted->playerNumber] = true;
+                    pushEvent(Event::started, playerStarted->playerNumber);
                     break;
                 }
                 case cmdPlayerCrashed :
                 {
                     PacketPlayer* playerCrashed = static_cast<PacketPlayer*>(buffer);
                     // RACE("RaceClient::onPacket : received 'PlayerCrashed' from player %d", playerCrashed->playerNumber);
-                    m_playerCrashed[playerCrashed->playerNumber] = true;
+                    pushEvent(Event::crashed, playerCrashed->playerNumber);
                     break;
                 }
                 case cmdPlayerBumped :
                 {
                     PacketPlayerBumped* playerBumped = static_cast<PacketPlayerBumped*>(buffer);
                     // RACE("RaceClient::onPacket : received 'PlayerBumped', bumpX = %d, bumpY = %d", playerBumped->bumpX, playerBumped->bumpY);
-                    m_playerBumped = true;
-                    m_playerBumpX = playerBumped->bumpX;
-                    m_playerBumpY = playerBumped->bumpY;
-                    m_playerBumpSpeed = playerBumped->bumpSpeed;
+                    pushEvent(Event::bumped, m_playerNumber, playerBumped->bumpX, playerBumped->bumpY, playerBumped->bumpSpeed);
                     break;
                 }
                 case cmdPlayerDisconnected :
                 {
                     PacketPlayer* player = static_cast<PacketPlayer*>(buffer);
                     RACE("RaceClient::onPacket : received 'PlayerDisconnected' for player %d", player->playerNumber);
-                    m_playerData[player->playerNumber].state = undefined;
-                    m_game->playerDisconnected((UInt)player->playerNumber);
+                    if (player->playerNumber < NMAXPLAYERS)
+                        m_playerData[player->playerNumber].state = undefined;
+                    pushEvent(Event::disconnected, player->playerNumber);
                     break;
                 }
                 case cmdLoadCustomTrack :
                     if (!m_trackSelected)
                     {
                         PacketLoadCustomTrack* loadTrack = reinterpret_cast<PacketLoadCustomTrack*>(packet);
-                        RACE("RaceClient::onPacket : received 'LoadCustomTrack(%s)', nrOfLaps = %d, trackLength = %d", loadTrack->trackname, loadTrack->nrOfLaps, loadTrack->trackLength);
+                        if ((size < sizeof(PacketLoadCustomTrack)) || (loadTrack->trackLength > MAXMULTITRACKLENGTH))
+                            break;
+                        RACE("RaceClient::onPacket : received 'LoadCustomTrack(%s)', nrOfLaps = %d, trackLength = %d, hash = %08x", loadTrack->trackname, loadTrack->nrOfLaps, loadTrack->trackLength, loadTrack->streamHash);
                         m_nrOfLaps = loadTrack->nrOfLaps;
-                        strcpy(m_track, loadTrack->trackname);
+                        strncpy(m_track, loadTrack->trackname, sizeof(loadTrack->trackname));
+                        m_track[sizeof(loadTrack->trackname)] = '\0';
                         m_trackData.weather = (Track::Weather)loadTrack->trackWeather;
                         m_trackData.ambience = (Track::Ambience)loadTrack->trackAmbience;
                         m_trackData.length = loadTrack->trackLength;
-                        SAFE_DELETE_ARRAY(m_trackData.definition);
-                        m_trackData.definition = new Track::Definition[loadTrack->trackLength];
-        				for (UInt i = 0; i < loadTrack->trackLength; ++i)
+                        TTrackCache::iterator cached = m_trackCache.find(loadTrack->streamHash);
+                        if ((cached != m_trackCache.end( )) && ((*cached).second.size( ) == loadTrack->trackLength))
                         {
-                            m_trackData.definition[i].type = (Track::Type)loadTrack->trackDefinition[i].type;
-                            m_trackData.definition[i].surface = (Track::Surface)loadTrack->trackDefinition[i].surface;
-                            m_trackData.definition[i].noise = (Track::Noise)loadTrack->trackDefinition[i].noise;
-                            m_trackData.definition[i].length = loadTrack->trackDefinition[i].length;
+                            RACE("RaceClient::onPacket : track %08x is in the cache", loadTrack->streamHash);
+                            selectTrack((*cached).second);
+                            break;
                         }
-                        m_trackSelected = true;
+                        if ((loadTrack->streamHash != m_trackHash) || (loadTrack->streamSize != m_trackStreamSize))
+                        {
+                            m_trackStream.clear( );
+                            m_trackStreamSize = loadTrack->streamSize;
+                            m_trackHash = loadTrack->streamHash;
+                        }
+                        m_trackRequested = 0;
+                        continueTrack( );
                     }
                     break;
+                case cmdTrackChunk :
+                {
+                    PacketTrackChunk* chunk = reinterpret_cast<PacketTrackChunk*>(packet);
+                    UInt header = sizeof(PacketTrackChunk) - TRACKCHUNKSIZE;
+                    if ((m_trackSelected) || (size < header) || (chunk->size > size - header) || (chunk->streamHash != m_trackHash) ||
+                        (chunk->offset != m_trackStream.size( )) || (chunk->offset + chunk->size > m_trackStreamSize))
+                        break;
+                    m_trackStream.insert(m_trackStream.end( ), chunk->data, chunk->data + chunk->size);
+                    continueTrack( );
+                    break;
+                }
                 default:
                     break;
             }
         }
     }
+    publish( );
+}
+
+
+// Takes over the players the snapshot has entries for, except ourselves.
+void
+RaceClient::applySnapshot(PacketPlayerSnapshot* packet, UInt size)
+{
+    Mutex::Guard guard(m_mutex);
+    Boolean updated[NMAXPLAYERS];
+    const PlayerSnapshot* snapshot = m_snapshotReceiver.apply(packet, size, updated);
+    if (snapshot == 0)
+        return;
+    m_snapshotTimed = true;
+    m_snapshotTime = packet->serverTime;
+    m_snapshotApplied = DirectX::UdpTransport::now( );
+    for (UInt i = 0; i < NMAXPLAYERS; ++i)
+    {
+        // a player left out of a delta snapshot may have moved on since the
+        // baseline and only be throttled, so that is no new state of them
+        if ((updated[i]) && (i != m_playerNumber))
+        {
+            m_playerData[i] = snapshot->player[i];
+            ++m_playerUpdates[i];
+        }
+    }
+}
+
+
+void
+RaceClient::requestTrack(UInt offset)
+{
+    Mutex::Guard guard(m_mutex);
+    PacketTrackRequest packet;
+    packet.command = cmdTrackRequest;
+    packet.streamHash = m_trackHash;
+    packet.offset = offset;
+    sendPacket(&packet, sizeof(PacketTrackRequest), true);
+    m_trackRequested = offset + TRACKWINDOW*TRACKCHUNKSIZE;
+}
+
+
+// Asks for the next window once the last one is in, and unpacks the track
+// when the whole stream is.
+void
+RaceClient::continueTrack( )
+{
+    Mutex::Guard guard(m_mutex);
+    UInt received = (UInt)m_trackStream.size( );
+    if (received < m_trackStreamSize)
+    {
+        if (received >= m_trackRequested)
+            requestTrack(received);
+        return;
+    }
+    const UByte* stream = (m_trackStream.empty( )) ? 0 : &m_trackStream[0];
+    std::vector<Track::Definition> definitions(m_trackData.length);
+    if ((TrackStream::hash(stream, received) != m_trackHash) ||
+        (!TrackStream::unpack(stream, received, (definitions.empty( )) ? 0 : &definitions[0], m_trackData.length)))
+    {
+        RACE("(!) RaceClient::continueTrack : track %08x does not unpack", m_trackHash);
+        m_trackStream.clear( );
+        m_trackStreamSize = 0;
+        m_trackHash = 0;
+        return;
+    }
+    if (m_trackCache.size( ) >= TRACKCACHESIZE)
+        m_trackCache.erase(m_trackCache.begin( ));
+    m_trackCache[m_trackHash] = definitions;
+    m_trackStream.clear( );
+    selectTrack(definitions);
+}
+
+
+void
+RaceClient::selectTrack(const std::vector<Track::Definition>& definitions)
+{
+    Mutex::Guard guard(m_mutex);
+    SAFE_DELETE_ARRAY(m_trackData.definition);
+    m_trackData.length = (UInt)definitions.size( );
+    m_trackData.definition = new Track::Definition[m_trackData.length];
+    m_lapLength = 0;
+    for (UInt i = 0; i < m_trackData.length; ++i)
+    {
+        m_trackData.definition[i] = definitions[i];
+        m_lapLength += definitions[i].length;
+    }
+    m_trackSelected = true;
 }
 
 
@@ -567,12 +733,105 @@ RaceClient::onSessionLost( )
     RACE("RaceClient::onSessionLost");
     m_connected = false;
     m_sessionLost = true;
+    publish( );
 
 //        m_sessionLost = false;
 //        m_game->state(Game::menu);
 //return;
 }
 
+// The data of a player together with the count of the states received for
+// them that came with an entry of their own, both from the same publish, so
+// the count never runs ahead of the data.
+PlayerData
+RaceClient::playerData(UInt player, UInt& updates)
+{
+    const Shared& shared = m_shared.front( );
+    updates = shared.playerUpdates[player];
+    return shared.playerData[player];
+}
+
+
+// Copies what the game thread reads into the back buffer and hands it over.
+// Whoever changes that state holds m_mutex, so there is only one producer.
+void
+RaceClient::publish( )
+{
+    Mutex::Guard guard(m_mutex);
+    Shared& shared = m_shared.back( );
+    for (UInt i = 0; i < NMAXPLAYERS; ++i)
+    {
+        shared.playerData[i]    = m_playerData[i];
+        shared.playerUpdates[i] = m_playerUpdates[i];
+    }
+    shared.playerNumber      = m_playerNumber;
+    shared.playerId          = m_playerId;
+    shared.playerState       = m_playerState;
+    shared.trackSelected     = m_trackSelected;
+    shared.connected         = m_connected;
+    shared.startRace         = m_startRace;
+    shared.sessionLost       = m_sessionLost;
+    shared.forceDisconnected = m_forceDisconnected;
+    shared.raceAborted       = m_raceAborted;
+    m_shared.publish( );
+}
+
+
+// Called by the network thread only.
+void
+RaceClient::pushEvent(UInt type, UInt player, Int bumpX, Int bumpY, Int bumpSpeed)
+{
+    if (player >= NMAXPLAYERS)
+        return;
+    Event event;
+    event.type      = type;
+    event.player    = player;
+    event.bumpX     = bumpX;
+    event.bumpY     = bumpY;
+    event.bumpSpeed = bumpSpeed;
+    if (!m_events.push(event))
+        RACE("(!) RaceClient::pushEvent : event queue full, dropping event %d for player %d", type, player);
+}
+
+
+// Called by the game thread only; turns the queued events back into the
+// flags the level asks for one player at a time.
+void
+RaceClient::takeEvents( )
+{
+    Event event;
+    while (m_events.pop(event))
+    {
+        switch (event.type)
+        {
+            case Event::started :
+                m_playerStarted[event.player] = true;
+                break;
+            case Event::crashed :
+                m_playerCrashed[event.player] = true;
+                break;
+            case Event::finished :
+                m_playerFinished[event.player] = true;
+                break;
+            case Event::finalize :
+                m_playerFinalize[event.player] = true;
+                break;
+            case Event::disconnected :
+                m_playerDisconnected[event.player] = true;
+                break;
+            case Event::bumped :
+                m_playerBumped = true;
+                m_playerBumpX = event.bumpX;
+                m_playerBumpY = event.bumpY;
+                m_playerBumpSpeed = event.bumpSpeed;
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+
 void 
 RaceClient::sendPacket(PacketBase* packet, UInt size, Boolean secure)
 {
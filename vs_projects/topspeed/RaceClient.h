@@ -9,7 +9,15 @@
 
 #include <DxCommon/If/Network.h>
 #include <Common/If/Mutex.h>
+#include <Common/If/TTripleBuffer.h>
+#include <Common/If/TRing.h>
 #include "Packets.h"
+#include "SnapshotReceiver.h"
+#include "Track.h"
+#include <map>
+#include <vector>
+
+#define NCLIENTEVENTS   256         // one-shot events the network thread can queue between two frames
 
 class Game;
 class Menu;
@@ -31,30 +39,34 @@ public:
     UInt joinSessionAt(Char* ipAddress);
     void sendData(PlayerData data, Boolean secure = false);
 
-    Boolean     trackSelected( )        { Mutex::Guard guard(m_mutex); return m_trackSelected;       }
+    // Read by the game thread from what the network thread published last,
+    // without waiting for it.
+    Boolean     trackSelected( )        { return m_shared.front( ).trackSelected;      }
     Char*       track( )                { Mutex::Guard guard(m_mutex); return m_track;               }
 	Track::TrackData  trackData()		{ Mutex::Guard guard(m_mutex); return m_trackData;			}
     UInt        nrOfLaps( )             { Mutex::Guard guard(m_mutex); return m_nrOfLaps;            }
     void        resetTrack( );
-    PlayerData  playerData(UInt player) { Mutex::Guard guard(m_mutex); return m_playerData[player];  }
-    Boolean     connected( )            { Mutex::Guard guard(m_mutex); return m_connected;           }
-    void        sessionLost(Boolean b)          { Mutex::Guard guard(m_mutex); m_sessionLost = b;         }
-    Boolean     sessionLost( )          { Mutex::Guard guard(m_mutex); return m_sessionLost;         }
-    void        forceDisconnected(Boolean b)          { Mutex::Guard guard(m_mutex); m_forceDisconnected = b;        }
-    Boolean     forceDisconnected( )          { Mutex::Guard guard(m_mutex); return m_forceDisconnected;         }
-    void        raceAborted(Boolean b)          { Mutex::Guard guard(m_mutex); m_raceAborted = b;         }
-    Boolean     raceAborted( )          { Mutex::Guard guard(m_mutex); return m_raceAborted;         }
-    Boolean     startRace( )            { Mutex::Guard guard(m_mutex); return m_startRace;           }
-    void        startRace(Boolean b)    { Mutex::Guard guard(m_mutex); m_startRace = b;              }
-    UInt        playerNumber( )         { Mutex::Guard guard(m_mutex); return m_playerNumber;        }
-    UInt        playerId( )             { Mutex::Guard guard(m_mutex); return m_playerId;            }
+    PlayerData  playerData(UInt player) { return m_shared.front( ).playerData[player]; }
+    PlayerData  playerData(UInt player, UInt& updates);
+    Boolean     connected( )            { return m_shared.front( ).connected;          }
+    void        sessionLost(Boolean b)          { Mutex::Guard guard(m_mutex); m_sessionLost = b; publish( );         }
+    Boolean     sessionLost( )          { return m_shared.front( ).sessionLost;        }
+    void        forceDisconnected(Boolean b)          { Mutex::Guard guard(m_mutex); m_forceDisconnected = b; publish( );       }
+    Boolean     forceDisconnected( )          { return m_shared.front( ).forceDisconnected;  }
+    void        raceAborted(Boolean b)          { Mutex::Guard guard(m_mutex); m_raceAborted = b; publish( );         }
+    Boolean     raceAborted( )          { return m_shared.front( ).raceAborted;        }
+    Boolean     startRace( )            { return m_shared.front( ).startRace;          }
+    void        startRace(Boolean b)    { Mutex::Guard guard(m_mutex); m_startRace = b; publish( );             }
+    UInt        playerNumber( )         { return m_shared.front( ).playerNumber;       }
+    UInt        playerId( )             { return m_shared.front( ).playerId;           }
     Boolean     playerFinished(UInt player);
     Boolean     playerFinalize(UInt player);
     Boolean     playerStarted(UInt player);
     Boolean     playerCrashed(UInt player);
+    Boolean     playerDisconnected(UInt player);
     Boolean     playerBumped(Int& bumpX, Int& bumpY, Int& bumpSpeed);
-    void        playerState(PlayerState state)  { Mutex::Guard guard(m_mutex); m_prevPlayerState = m_playerState; m_playerState = state;    }
-    PlayerState playerState( )                  { Mutex::Guard guard(m_mutex); return m_playerState;     }
+    void        playerState(PlayerState state)  { Mutex::Guard guard(m_mutex); m_prevPlayerState = m_playerState; m_playerState = state; publish( );   }
+    PlayerState playerState( )                  { return m_shared.front( ).playerState;    }
 
 public:
     // void playerReadyToStart(CarType car);
@@ -72,6 +84,54 @@ public:
 
     void sendPacket(PacketBase* packet, UInt size, Boolean secure);
 
+private:
+    void applySnapshot(PacketPlayerSnapshot* packet, UInt size);
+    void requestTrack(UInt offset);
+    void continueTrack( );
+    void selectTrack(const std::vector<Track::Definition>& definitions);
+    void publish( );
+    void pushEvent(UInt type, UInt player, Int bumpX = 0, Int bumpY = 0, Int bumpSpeed = 0);
+    void takeEvents( );
+
+private:
+    typedef std::map<UInt, std::vector<Track::Definition> >  TTrackCache;
+
+    // The copy of the state the game thread reads every frame.
+    struct Shared
+    {
+        PlayerData      playerData[NMAXPLAYERS];
+        UInt            playerUpdates[NMAXPLAYERS];
+        UInt            playerNumber;
+        UInt            playerId;
+        PlayerState     playerState;
+        Boolean         trackSelected;
+        Boolean         connected;
+        Boolean         startRace;
+        Boolean         sessionLost;
+        Boolean         forceDisconnected;
+        Boolean         raceAborted;
+    };
+
+    // Something that happened once to a player, queued by the network thread
+    // until the game thread takes it.
+    struct Event
+    {
+        enum Type
+        {
+            started,
+            crashed,
+            finished,
+            finalize,
+            disconnected,
+            bumped
+        };
+        UInt            type;
+        UInt            player;
+        Int             bumpX;
+        Int             bumpY;
+        Int             bumpSpeed;
+    };
+
 private:
     UInt                m_playerNumber;
     UInt                m_playerId;
@@ -81,13 +141,29 @@ private:
     Mutex               m_mutex;
     Char                m_track[32];
     UInt                m_nrOfLaps;
+    UInt                m_lapLength;        // of the last track the server sent
     Boolean             m_trackSelected;
     Track::TrackData	m_trackData;
+    std::vector<UByte>  m_trackStream;      // what arrived of the stream the definitions are packed in
+    UInt                m_trackStreamSize;
+    UInt                m_trackHash;
+    UInt                m_trackRequested;   // the end of the window asked for last
+    TTrackCache         m_trackCache;       // definitions of earlier tracks by hash
     PlayerData          m_playerData[NMAXPLAYERS];
+    UInt                m_playerUpdates[NMAXPLAYERS];
+    SnapshotReceiver    m_snapshotReceiver;
+    UShort              m_sentSnapshotAck;
+    Boolean             m_snapshotTimed;        // a snapshot was applied, so there is a time to echo
+    UInt                m_snapshotTime;         // the serverTime of the last snapshot applied
+    UInt                m_snapshotApplied;      // and when it was applied, on our clock
+    TTripleBuffer<Shared>           m_shared;       // published under m_mutex
+    TRing<Event, NCLIENTEVENTS>     m_events;
+    // what the game thread has taken from m_events and not yet asked for
     Boolean             m_playerFinished[NMAXPLAYERS];
     Boolean             m_playerFinalize[NMAXPLAYERS];
     Boolean             m_playerStarted[NMAXPLAYERS];
     Boolean             m_playerCrashed[NMAXPLAYERS];
+    Boolean             m_playerDisconnected[NMAXPLAYERS];
     Boolean             m_playerBumped;
     Int                 m_playerBumpX;
     Int                 m_playerBumpY;
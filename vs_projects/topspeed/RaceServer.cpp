@@ -4,18 +4,60 @@
 * Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
 * This program is distributed under the terms of the GNU General Public License version 3.
 */
-#include "Game.h"
-#include "Raceserver.h"
-#include "RaceClient.h"
+#include "RaceServer.h"
+#include "RaceTracer.h"
+#include "PlayerCodec.h"
+#include "TrackStream.h"
+#include <DxCommon/If/UdpTransport.h>
 #include <Common/If/Algorithm.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
 
-RaceServer::RaceServer(Game* game) :
-    m_game(game),
+#define MOVINGFIELDS    (snapshotPosition | snapshotSpeed | snapshotFrequency)
+
+
+// Adventure tracks are raced once, whatever the number of laps.
+static Boolean
+adventure(const Char* trackname)
+{
+    Char name[32];
+    UInt i;
+    for (i = 0; (trackname[i] != '\0') && (i < sizeof(name) - 1); ++i)
+        name[i] = (Char)tolower((UByte)trackname[i]);
+    name[i] = '\0';
+    return (strstr(name, "adv") != NULL);
+}
+
+
+// How long a car may go without an entry in the snapshots of a racer,
+// by how far apart they are along the track, the short way round the lap.
+static UInt
+entryInterval(Int posY, Int otherY, UInt lapLength)
+{
+    UInt distance = (otherY > posY) ? UInt(otherY - posY) : UInt(posY - otherY);
+    if (lapLength > 0)
+    {
+        distance %= lapLength;
+        distance = minimum(distance, lapLength - distance);
+    }
+    if (distance < SERVER_NEARDISTANCE)
+        return 0;
+    if (distance < SERVER_FARDISTANCE)
+        return SERVER_MIDDLEUPDATE;
+    return SERVER_FARUPDATE;
+}
+
+
+RaceServer::RaceServer( ) :
     m_server(0),
+    m_tickTime(0.0f),
     m_raceStarted(false),
     m_finalizing(false),
-    m_lastUpdateTime(0.0f),
-    m_trackSelected(false)
+    m_trackSelected(false),
+    m_nrOfLaps(0),
+    m_lapLength(0),
+    m_trackHash(0)
 {
     Mutex::Guard guard(m_mutex);
     RACE("(+) RaceServer");
@@ -31,33 +73,43 @@ RaceServer::~RaceServer( )
 }
 
 void
-RaceServer::initialize( )
+RaceServer::initialize(DirectX::ServerTransport* transport, const Char* sessionName, UInt port)
 {
     Mutex::Guard guard(m_mutex);
-    RACE("RaceServer::initialize");
+    RACE("RaceServer::initialize : session %s on port %d", sessionName, port);
     if (m_server == 0)
     {
-        m_server = new DirectX::Server( );
-        m_server->setGUID(m_game->gameGuid());
+        m_server = transport;
         m_server->setIServer(this);
-        char sessionName[64];
-        sprintf(sessionName, "%d", m_game->raceSettings().serverNumber);
-        m_server->startSession(sessionName, m_game->gamePort());
+        m_server->startSession(sessionName, port);
         m_playerMap.clear( );
+        m_recipients.clear( );
+        m_histories.clear( );
     }
 }
 
 void
 RaceServer::finalize( )
 {
+    DirectX::ServerTransport* server;
+    {
+        Mutex::Guard guard(m_mutex);
+        RACE("RaceServer::finalize");
+        m_finalizing = true;
+        server = m_server;
+    }
+    // stopping waits for the network thread, which may be waiting for m_mutex
+    if (server)
+        server->stopSession( );
+
     Mutex::Guard guard(m_mutex);
-    RACE("RaceServer::finalize");
-    m_finalizing = true;
     if (m_server)
     {
-        m_server->stopSession( );
-        SAFE_DELETE(m_server);
+        m_server->setIServer(0);
+        m_server = 0;
         m_playerMap.clear( );
+        m_recipients.clear( );
+        m_histories.clear( );
     }
     resetTrack( );
     m_finalizing = false;
@@ -68,61 +120,94 @@ void
 RaceServer::run(Float elapsed)
 {
     Mutex::Guard guard(m_mutex);
-    m_lastUpdateTime += elapsed;
-    if (m_lastUpdateTime > SERVER_UPDATE_TIME)
+    UInt now = DirectX::UdpTransport::now( );
+    sendSnapshots(now);
+    m_tickTime += elapsed;
+    if (m_tickTime > SERVER_TICK_TIME)
     {
+        // check for bumps, with every racer where they were at the same moment
+        UInt time = rewindTime(now);
+        m_bumpSweep.reset(m_lapLength);
         TPlayerDataMap::iterator it;
         for (it = m_playerMap.begin( ); it != m_playerMap.end( ); ++it)
         {
-            PlayerData player = (*it).second;
-            if ((player.state != undefined) && (player.state != notReady))
-            {
-                PacketPlayerData packet;
-                packet.command              = cmdPlayerData;
-                packet.playerId             = player.id;
-                packet.playerNumber         = player.playerNumber;
-                packet.car                  = (CarType)player.car;
-                packet.racedata.positionX   = player.posX;
-                packet.racedata.positionY   = player.posY;
-                packet.racedata.speed       = player.speed;
-                packet.racedata.frequency       = player.frequency;
-                packet.state                = (PlayerState)player.state;
-                packet.engineRunning        = player.engineRunning;
-                packet.braking              = player.braking;
-                packet.horning              = player.horning;
-                packet.backfiring           = player.backfiring;
-                sendPacketToRacersExceptTo(player.id, &packet, sizeof(PacketPlayerData), false);
-            }
-            if (player.state == racing)
+            if ((*it).second.state == racing)
             {
-                // check for bumps
-                for (TPlayerDataMap::iterator it2 = m_playerMap.begin( ); it2 != m_playerMap.end( ); ++it2)
-                {
-                    if (it2 != it)
-                    {
-                        PlayerData player2 = (*it2).second;
-                        if (player2.state == racing)
-                        {
-                            if ((absval<Int>(player.posX - player2.posX) < 1000) && (absval<Int>(player.posY - player2.posY) < 500))
-                            {
-                                PacketPlayerBumped packetBumped;
-                                packetBumped.command        = cmdPlayerBumped;
-                                packetBumped.playerId       = player.id;
-                                packetBumped.playerNumber   = player.playerNumber;
-                                packetBumped.bumpX = player.posX - player2.posX;
-                                packetBumped.bumpY = player.posY - player2.posY;
-                                packetBumped.bumpSpeed      = player.speed - player2.speed;
-                                sendPacketTo(player.id, &packetBumped, sizeof(PacketPlayerBumped), true);
-                            }
-                        }
-                    }
-                }
+                PositionHistory::Sample sample = position((*it).first, time);
+                m_bumpSweep.add((*it).first, sample.posX, sample.posY);
             }
-        }        
-        m_lastUpdateTime = 0.0f;
+        }
+        m_bumpSweep.sweep( );
+        for (UInt i = 0; i < m_bumpSweep.nPairs( ); ++i)
+        {
+            const BumpSweep::Pair& pair = m_bumpSweep.pair(i);
+            Int speed = position(pair.a, time).speed;
+            Int speed2 = position(pair.b, time).speed;
+            sendBump(m_playerMap[pair.a], pair.bumpX, pair.bumpY, speed - speed2);
+            sendBump(m_playerMap[pair.b], -pair.bumpX, -pair.bumpY, speed2 - speed);
+        }
+        m_tickTime = 0.0f;
     }
 }
 
+
+void
+RaceServer::sendBump(const PlayerData& player, Int bumpX, Int bumpY, Int bumpSpeed)
+{
+    PacketPlayerBumped packetBumped;
+    packetBumped.command        = cmdPlayerBumped;
+    packetBumped.playerId       = player.id;
+    packetBumped.playerNumber   = player.playerNumber;
+    packetBumped.bumpX          = bumpX;
+    packetBumped.bumpY          = bumpY;
+    packetBumped.bumpSpeed      = bumpSpeed;
+    sendPacketTo(player.id, &packetBumped, sizeof(PacketPlayerBumped), true);
+}
+
+
+// The latest moment every racer has sent their position for, so nobody is
+// judged by where a slower connection has not told us they went yet. A
+// racer who has sent nothing for SERVER_MAXREWIND does not hold the others
+// back; they are taken to be where they were last.
+UInt
+RaceServer::rewindTime(UInt now)
+{
+    Mutex::Guard guard(m_mutex);
+    UInt time = now;
+    TPlayerDataMap::iterator it;
+    for (it = m_playerMap.begin( ); it != m_playerMap.end( ); ++it)
+    {
+        if ((*it).second.state != racing)
+            continue;
+        const PositionHistory& history = m_histories[(*it).first];
+        if (history.empty( ))
+            continue;
+        UInt latest = history.latest( );
+        if ((Int(now - latest) <= SERVER_MAXREWIND) && (Int(latest - time) < 0))
+            time = latest;
+    }
+    return time;
+}
+
+
+// Where a player was at a time on the server's clock. Players who have
+// not sent a timed update yet are where their last update had them.
+PositionHistory::Sample
+RaceServer::position(UInt id, UInt time)
+{
+    Mutex::Guard guard(m_mutex);
+    const PositionHistory& history = m_histories[id];
+    if (!history.empty( ))
+        return history.at(time);
+    const PlayerData& player = m_playerMap[id];
+    PositionHistory::Sample sample;
+    sample.time  = time;
+    sample.posX  = player.posX;
+    sample.posY  = player.posY;
+    sample.speed = player.speed;
+    return sample;
+}
+
 /*
 void 
 RaceServer::loadTrack(Char* trackname, UInt nrOfLaps)
@@ -137,48 +222,78 @@ RaceServer::loadTrack(Char* trackname, UInt nrOfLaps)
 */
 
 void
-RaceServer::loadCustomTrack(Char* trackname)
+RaceServer::loadCustomTrack(const Char* trackname, UInt nrOfLaps)
 {
     Mutex::Guard guard(m_mutex);
     RACE("RaceServer::loadCustomTrack : sending track to all pending players, trackname = %s", trackname);
+    strncpy(m_track, trackname, sizeof(m_track) - 1);
+    m_track[sizeof(m_track) - 1] = '\0';
+    m_nrOfLaps = (adventure(m_track)) ? 1 : nrOfLaps;
+    TrackGeometry track;
+    track.load(trackname);
+    m_trackData.userDefined = track.userDefined( );
+    m_trackData.weather = track.weather( );
+    m_trackData.ambience = track.ambience( );
+    m_trackData.length = minimum<UInt>(track.trackLength( ), MAXMULTITRACKLENGTH);
+    SAFE_DELETE_ARRAY(m_trackData.definition);
+    m_trackData.definition = new TrackGeometry::Definition[m_trackData.length];
+    m_lapLength = 0;
+    for (UInt i = 0; i < m_trackData.length; ++i)
+    {
+        m_trackData.definition[i] = track.definition( )[i];
+        m_lapLength += m_trackData.definition[i].length;
+    }
+    TrackStream::pack(m_trackData.definition, m_trackData.length, m_trackStream);
+    m_trackHash = TrackStream::hash((m_trackStream.empty( )) ? 0 : &m_trackStream[0], (UInt)m_trackStream.size( ));
+    RACE("RaceServer::loadCustomTrack : %d definitions packed into %d bytes, hash %08x", m_trackData.length, (UInt)m_trackStream.size( ), m_trackHash);
+    m_trackSelected = true;
+    TPlayerDataMap::iterator it;
+    for (it = m_playerMap.begin( ); it != m_playerMap.end( ); ++it)
+    {
+        if ((*it).second.state == notReady)
+            sendTrackTo((*it).first);
+    }
+}
+
+void
+RaceServer::sendTrackTo(UInt to)
+{
+    Mutex::Guard guard(m_mutex);
     PacketLoadCustomTrack packet;
     packet.command = cmdLoadCustomTrack;
-    strcpy(m_track, trackname);
-    if (strstr(_strlwr(m_track), "adv") == NULL)
-        packet.nrOfLaps = (UByte)m_game->raceSettings().nrOfLaps;
-    else
-        packet.nrOfLaps = 1;
-    Track* track = Track::readTrack(trackname);
-    m_trackData.userDefined = track->userDefined( );
+    packet.nrOfLaps = (UByte)m_nrOfLaps;
     if (!m_trackData.userDefined)
-        strcpy(packet.trackname, trackname);
+    {
+        strncpy(packet.trackname, m_track, sizeof(packet.trackname) - 1);
+        packet.trackname[sizeof(packet.trackname) - 1] = '\0';
+    }
     else
         sprintf(packet.trackname, "custom");
-    m_trackData.weather = track->weather( );
-    packet.trackWeather = (UByte)track->weather( );
-    m_trackData.ambience = track->ambience( );
-    packet.trackAmbience = (UByte)track->ambience( );
-    m_trackData.length = track->trackLength( );
-    packet.trackLength = (UShort)track->trackLength( );
-    SAFE_DELETE_ARRAY(m_trackData.definition);
-    m_trackData.definition = new Track::Definition[track->trackLength()];
-    Track::Definition* trackDefinition = track->definition();
-    for (UInt i = 0; i < track->trackLength(); ++i)
+    packet.trackWeather = (UByte)m_trackData.weather;
+    packet.trackAmbience = (UByte)m_trackData.ambience;
+    packet.trackLength = m_trackData.length;
+    packet.streamSize = (UInt)m_trackStream.size( );
+    packet.streamHash = m_trackHash;
+    sendPacketTo(to, &packet, sizeof(PacketLoadCustomTrack), true);
+}
+
+// Sends the chunks a client asked for. Clients ask for the next window once
+// they have this one, so a large track never piles up in the transport.
+void
+RaceServer::sendTrackChunks(UInt to, UInt offset)
+{
+    Mutex::Guard guard(m_mutex);
+    PacketTrackChunk packet;
+    packet.command = cmdTrackChunk;
+    packet.streamHash = m_trackHash;
+    for (UInt i = 0; (i < TRACKWINDOW) && (offset < m_trackStream.size( )); ++i)
     {
-        m_trackData.definition[i] = trackDefinition[i];
-        packet.trackDefinition[i].type = (UByte)trackDefinition[i].type;
-        packet.trackDefinition[i].surface = (UByte)trackDefinition[i].surface;
-        packet.trackDefinition[i].noise = (UByte)trackDefinition[i].noise;
-        packet.trackDefinition[i].length = trackDefinition[i].length;
-        if (i == MAXMULTITRACKLENGTH-1)
-        {
-           m_trackData.length = MAXMULTITRACKLENGTH;
-           packet.trackLength = MAXMULTITRACKLENGTH;
-           break;
-        }
+        packet.offset = offset;
+        packet.size = (UShort)minimum<UInt>((UInt)m_trackStream.size( ) - offset, TRACKCHUNKSIZE);
+        memcpy(packet.data, &m_trackStream[offset], packet.size);
+        sendPacketTo(to, &packet, sizeof(PacketTrackChunk) - TRACKCHUNKSIZE + packet.size, true);
+        offset += packet.size;
     }
-    sendPacketToNotReady(&packet, sizeof(PacketLoadTrack) + (sizeof(MultiplayerDefinition) * track->trackLength()), true);
-    m_trackSelected = true;
 }
 
 void 
@@ -323,6 +438,182 @@ RACE("***** sending packet with command %d to racers except to %d, %d with a siz
     }
 }
 
+// Sends every racer a single packet with the data of all other racers,
+// instead of one packet per other racer. The entries only hold what
+// changed since the last snapshot the racer acknowledged, as long as
+// that one is still in the history.
+// Each racer gets a snapshot when the time its link allows has passed,
+// against the last one they acknowledged.
+void
+RaceServer::sendSnapshots(UInt now)
+{
+    Mutex::Guard guard(m_mutex);
+    PlayerSnapshot snapshot;
+    snapshot.sequence = 0;
+    for (UInt i = 0; i < NMAXPLAYERS; ++i)
+        snapshot.present[i] = false;
+    TPlayerDataMap::iterator it;
+    for (it = m_playerMap.begin( ); it != m_playerMap.end( ); ++it)
+    {
+        const PlayerData& player = (*it).second;
+        if ((player.state != undefined) && (player.state != notReady) && (player.playerNumber < NMAXPLAYERS))
+        {
+            snapshot.present[player.playerNumber] = true;
+            snapshot.player[player.playerNumber]  = player;
+        }
+    }
+
+    PacketPlayerSnapshot packet;
+    packet.command  = cmdPlayerSnapshot;
+    packet.serverTime = now;
+    for (it = m_playerMap.begin( ); it != m_playerMap.end( ); ++it)
+    {
+        const PlayerData& player = (*it).second;
+        if ((player.state != awaitingStart) && (player.state != racing) && (player.state != finished))
+            continue;
+        TRecipientMap::iterator recipient = m_recipients.find(player.id);
+        if ((recipient == m_recipients.end( )) || (now - (*recipient).second.lastSnapshot < (*recipient).second.interval))
+            continue;
+        (*recipient).second.lastSnapshot = now;
+        PlayerSnapshot result;
+        UInt size = encodeSnapshot(packet, snapshot, (*recipient).second, player.playerNumber, result, now);
+        // nothing new for this racer
+        if ((packet.baseline != 0) && (packet.nEntries == 0))
+            continue;
+        (*recipient).second.sent[result.sequence % SNAPSHOTHISTORY] = result;
+        (*recipient).second.sequence = result.sequence;
+        sendPacketTo(player.id, &packet, size, false);
+    }
+}
+
+// Cars further from the recipient move on in the snapshot only when their
+// turn comes; anything else they do is sent at once. The result is the
+// snapshot as the recipient will rebuild it.
+UInt
+RaceServer::encodeSnapshot(PacketPlayerSnapshot& packet, const PlayerSnapshot& snapshot, Recipient& recipient,
+                           UInt recipientNumber, PlayerSnapshot& result, UInt now)
+{
+    UShort sequence = recipient.sequence + 1;
+    if (sequence == 0)
+        sequence = 1;
+    const PlayerSnapshot* baseline = 0;
+    UShort ack = recipient.ack;
+    if ((ack != 0) && (UShort(sequence - ack) < SNAPSHOTHISTORY) &&
+        (recipient.sent[ack % SNAPSHOTHISTORY].sequence == ack))
+        baseline = &recipient.sent[ack % SNAPSHOTHISTORY];
+    if (baseline)
+        result = *baseline;
+    else
+    {
+        for (UInt i = 0; i < NMAXPLAYERS; ++i)
+            result.present[i] = false;
+    }
+    result.sequence = sequence;
+
+    packet.sequence = sequence;
+    packet.baseline = (baseline) ? ack : 0;
+    packet.nEntries = 0;
+    Boolean located = (recipientNumber < NMAXPLAYERS) && (snapshot.present[recipientNumber]);
+    BitWriter writer(packet.entries, sizeof(packet.entries));
+    writer.writeVarint(m_lapLength);
+    for (UInt i = 0; i < NMAXPLAYERS; ++i)
+    {
+        if (i == recipientNumber)
+            continue;
+        Boolean known = (baseline) && (baseline->present[i]);
+        if (!snapshot.present[i])
+        {
+            if (known)
+            {
+                writer.write(i, PLAYERNUMBERBITS);
+                writer.write(snapshotRemoved, 8);
+                ++packet.nEntries;
+                result.present[i] = false;
+            }
+            continue;
+        }
+        const PlayerData& player = snapshot.player[i];
+        UInt changed = snapshotAll;
+        if (known)
+        {
+            changed = PlayerCodec::changed(player, baseline->player[i]);
+            if (changed == 0)
+                continue;
+            if ((located) && ((changed & ~MOVINGFIELDS) == 0) &&
+                (now - recipient.lastEntry[i] < entryInterval(snapshot.player[recipientNumber].posY, player.posY, m_lapLength)))
+                continue;
+        }
+        writer.write(i, PLAYERNUMBERBITS);
+        writer.write(changed, 8);
+        PlayerCodec::write(writer, player, changed, m_lapLength);
+        ++packet.nEntries;
+        result.present[i] = true;
+        result.player[i]  = player;
+        recipient.lastEntry[i] = now;
+    }
+    return (UInt)(packet.entries - reinterpret_cast<UByte*>(&packet)) + writer.size( );
+}
+
+
+void
+RaceServer::addRecipient(UInt id)
+{
+    Recipient& recipient = m_recipients[id];
+    recipient.sequence      = 0;
+    recipient.ack           = 0;
+    recipient.nApplied      = 0;
+    for (UInt i = 0; i < SNAPSHOTHISTORY; ++i)
+        recipient.sent[i].sequence = 0;
+    recipient.lastSnapshot  = 0;
+    for (UInt i = 0; i < NMAXPLAYERS; ++i)
+        recipient.lastEntry[i] = 0;
+    recipient.interval      = SERVER_MINSNAPSHOT_TIME;
+    recipient.roundTrip     = NOROUNDTRIP;
+    recipient.minRoundTrip  = NOROUNDTRIP;
+    recipient.loss          = 0.0f;
+    recipient.lastBackoff   = 0;
+}
+
+
+// Sends a client snapshots a little faster with every report that shows
+// its link keeps up, and half as fast again once a round trip when
+// snapshots get lost or the round trip grows over the shortest one seen,
+// which means they are queueing somewhere.
+void
+RaceServer::adaptRate(Recipient& recipient, UShort ack, UShort nApplied, UInt roundTrip, UInt now)
+{
+    if (roundTrip != NOROUNDTRIP)
+    {
+        recipient.roundTrip = (recipient.roundTrip == NOROUNDTRIP) ? roundTrip : (7*recipient.roundTrip + roundTrip) / 8;
+        recipient.minRoundTrip = minimum(recipient.minRoundTrip, roundTrip);
+    }
+    if ((ack != 0) && ((recipient.ack == 0) || (Short(ack - recipient.ack) > 0)))
+    {
+        if (recipient.ack != 0)
+        {
+            UInt nSent = UShort(ack - recipient.ack);
+            UInt nArrived = minimum<UInt>(UShort(nApplied - recipient.nApplied), nSent);
+            recipient.loss += (Float(nSent - nArrived) / Float(nSent) - recipient.loss) / 8.0f;
+        }
+        recipient.ack = ack;
+        recipient.nApplied = nApplied;
+    }
+
+    Boolean queueing = (recipient.roundTrip != NOROUNDTRIP) && (recipient.roundTrip > recipient.minRoundTrip + SERVER_MAXQUEUEING);
+    if ((recipient.loss > SERVER_MAXLOSS) || (queueing))
+    {
+        // the reports of the round trip after a change still show the old rate
+        UInt wait = (recipient.roundTrip != NOROUNDTRIP) ? recipient.roundTrip : recipient.interval;
+        if (now - recipient.lastBackoff >= wait)
+        {
+            recipient.interval = minimum<UInt>(recipient.interval * 3 / 2, SERVER_MAXSNAPSHOT_TIME);
+            recipient.lastBackoff = now;
+        }
+    }
+    else if (recipient.interval > SERVER_MINSNAPSHOT_TIME)
+        recipient.interval = maximum<UInt>(recipient.interval - SERVER_SNAPSHOT_STEP, SERVER_MINSNAPSHOT_TIME);
+}
+
 void
 RaceServer::sendPlayerDisconnected(UInt player)
 {
@@ -341,6 +632,8 @@ RaceServer::onPacket(UInt from, void* buffer, UInt size)
 {
     Mutex::Guard guard(m_mutex);
     PacketBase* packet = static_cast<PacketBase*>(buffer);
+    if ((size < sizeof(PacketBase)) || (packet->version != _TopSpeedVersion))
+        return;
 RACE("***server received packet %d, command %d with a size of %d", packet, packet->command, size);
     switch (packet->command)
     {
@@ -361,18 +654,33 @@ RACE("***server received packet %d, command %d with a size of %d", packet, packe
         */
     case cmdPlayerDataToServer:
         {
-            PacketPlayerData* playerData = static_cast<PacketPlayerData*>(buffer);
+            PacketPlayerDataToServer* playerData = static_cast<PacketPlayerDataToServer*>(buffer);
+            UInt header = sizeof(PacketPlayerDataToServer) - sizeof(playerData->data);
+            if (size < header)
+                break;
+            BitReader reader(playerData->data, size - header);
+            UInt lapLength = reader.readVarint( );
+            PlayerData data = m_playerMap[from];
+            if (!PlayerCodec::read(reader, data, snapshotToServer, lapLength))
+                break;
 //            RACE("RaceServer::onPacket : PlayerDataToServer for player %d, posX=%d, posY=%d, speed=%d, frequency=%d)", m_playerMap[from].playerNumber, m_playerMap[from].posX, m_playerMap[from].posY, m_playerMap[from].speed, m_playerMap[from].frequency);
-            m_playerMap[from].car           = playerData->car;
-            m_playerMap[from].playerNumber  = playerData->playerNumber;
-            m_playerMap[from].posX          = playerData->racedata.positionX;
-            m_playerMap[from].posY          = playerData->racedata.positionY;
-            m_playerMap[from].speed         = playerData->racedata.speed;
-            m_playerMap[from].frequency         = playerData->racedata.frequency;
-            m_playerMap[from].engineRunning = playerData->engineRunning;
-            m_playerMap[from].braking       = playerData->braking;
-            m_playerMap[from].horning       = playerData->horning;
-            m_playerMap[from].backfiring    = playerData->backfiring;
+            data.playerNumber = playerData->playerNumber;
+            m_playerMap[from] = data;
+            UInt received = DirectX::UdpTransport::now( );
+            UInt roundTrip = NOROUNDTRIP;
+            if ((playerData->echoDelay != NOECHO) && (Int(received - playerData->echoTime) >= playerData->echoDelay))
+                roundTrip = received - playerData->echoTime - playerData->echoDelay;
+            m_histories[from].add(playerData->sendTime, received, roundTrip, data.posX, data.posY, data.speed);
+            TRecipientMap::iterator recipient = m_recipients.find(from);
+            if (recipient != m_recipients.end( ))
+                adaptRate((*recipient).second, playerData->snapshotAck, playerData->snapshotsApplied, roundTrip, received);
+        }
+        break;
+    case cmdTrackRequest:
+        {
+            PacketTrackRequest* request = static_cast<PacketTrackRequest*>(buffer);
+            if ((size >= sizeof(PacketTrackRequest)) && (m_trackSelected) && (request->streamHash == m_trackHash))
+                sendTrackChunks(from, request->offset);
         }
         break;
     case cmdPlayerState:
@@ -382,32 +690,7 @@ RACE("***server received packet %d, command %d with a size of %d", packet, packe
             if ((playerState->state == notReady) && (m_playerMap[from].state != notReady) && (m_trackSelected))
             {
                 RACE("RaceServer::onPacket : sending track to player %d, trackname = %s", playerState->playerNumber, m_track);
-                PacketLoadCustomTrack packetCustomTrack;
-                packetCustomTrack.command = cmdLoadCustomTrack;
-                if (strstr(_strlwr(m_track), "adv") == NULL)
-                    packetCustomTrack.nrOfLaps = (UByte)m_game->raceSettings().nrOfLaps;
-                else
-                    packetCustomTrack.nrOfLaps = 1;
-                if (!m_trackData.userDefined)
-                    strcpy(packetCustomTrack.trackname, m_track);
-                else
-                    sprintf(packetCustomTrack.trackname, "custom");
-                packetCustomTrack.trackWeather = (UByte)m_trackData.weather;
-                packetCustomTrack.trackAmbience = (UByte)m_trackData.ambience;
-                packetCustomTrack.trackLength = (UShort)m_trackData.length;
-                for (UInt i = 0; i < m_trackData.length; ++i)
-                {
-                    packetCustomTrack.trackDefinition[i].type = (UByte)m_trackData.definition[i].type;
-                    packetCustomTrack.trackDefinition[i].surface = (UByte)m_trackData.definition[i].surface;
-                    packetCustomTrack.trackDefinition[i].noise = (UByte)m_trackData.definition[i].noise;
-                    packetCustomTrack.trackDefinition[i].length = m_trackData.definition[i].length;
-                    if (i == MAXMULTITRACKLENGTH-1)
-                    {
-                       packetCustomTrack.trackLength = MAXMULTITRACKLENGTH;
-                       break;
-                    }
-                }
-                sendPacketTo(from, &packetCustomTrack, sizeof(PacketLoadTrack) + (sizeof(MultiplayerDefinition) * m_trackData.length), true);
+                sendTrackTo(from);
             }
             RACE("RaceServer::onPacket : updating the state for client %d from %d to %d", from, m_playerMap[from].state, playerState->state);
             m_playerMap[from].state         = playerState->state;
@@ -499,6 +782,7 @@ RaceServer::onAddConnection(UInt id)
     // if arrived here, a valid playernumber was found, it is contained in i
     playerData.playerNumber = (UByte)i;
     m_playerMap[id] = playerData;
+    addRecipient(id);
     // send over the playernumber
     PacketPlayer packet;
     packet.command = cmdPlayerNumber;
@@ -518,32 +802,7 @@ RaceServer::onAddConnection(UInt id)
         else
         {
             RACE("RaceServer::onPacket : sending track to player %d, trackname = %s", playerData.playerNumber, m_track);
-            PacketLoadCustomTrack packetCustomTrack;
-            packetCustomTrack.command = cmdLoadCustomTrack;
-            if (strstr(_strlwr(m_track), "adv") == NULL)
-                packetCustomTrack.nrOfLaps = (UByte)m_game->raceSettings().nrOfLaps;
-            else
-                packetCustomTrack.nrOfLaps = 1;
-            if (!m_trackData.userDefined)
-                strcpy(packetCustomTrack.trackname, m_track);
-            else
-                sprintf(packetCustomTrack.trackname, "custom");
-            packetCustomTrack.trackWeather = (UByte)m_trackData.weather;
-            packetCustomTrack.trackAmbience = (UByte)m_trackData.ambience;
-            packetCustomTrack.trackLength = (UShort)m_trackData.length;
-            for (UInt i = 0; i < m_trackData.length; ++i)
-            {
-                packetCustomTrack.trackDefinition[i].type = (UByte)m_trackData.definition[i].type;
-                packetCustomTrack.trackDefinition[i].surface = (UByte)m_trackData.definition[i].surface;
-                packetCustomTrack.trackDefinition[i].noise = (UByte)m_trackData.definition[i].noise;
-                packetCustomTrack.trackDefinition[i].length = m_trackData.definition[i].length;
-                if (i == MAXMULTITRACKLENGTH-1)
-                {
-                   packetCustomTrack.trackLength = MAXMULTITRACKLENGTH;
-                   break;
-                }
-            }
-            sendPacketTo(id, &packetCustomTrack, sizeof(PacketLoadTrack) + (sizeof(MultiplayerDefinition) * m_trackData.length), true);
+            sendTrackTo(id);
         }
     }
 }
@@ -558,6 +817,8 @@ RaceServer::onRemoveConnection(UInt id)
     {
         sendPlayerDisconnected(id);
         m_playerMap.erase(id);
+        m_recipients.erase(id);
+        m_histories.erase(id);
         if ((m_raceStarted) && (nRacers() == 0))
             stopRace( );
     }
@@ -585,6 +846,19 @@ RaceServer::nRacers( )
     return nRacers;
 }
 
+UInt
+RaceServer::nPlayers(PlayerState state)
+{
+    Mutex::Guard guard(m_mutex);
+    UInt nPlayers = 0;
+    for (TPlayerDataMap::iterator it = m_playerMap.begin( ); it != m_playerMap.end( ); ++it)
+    {
+         if ((*it).second.state == state)
+             ++nPlayers;
+    }
+    return nPlayers;
+}
+
 void
 RaceServer::resetTrack( )
 {
@@ -7,21 +7,32 @@
 #ifndef __RACING_RACESERVER_H__
 #define __RACING_RACESERVER_H__
 
-#include <DxCommon/If/Network.h>
+#include <DxCommon/If/Transport.h>
 #include <Common/If/Mutex.h>
 #include "Packets.h"
+#include "TrackGeometry.h"
+#include "BumpSweep.h"
+#include "PositionHistory.h"
 #include <map>
-#include "RaceClient.h"
-#include "Track.h"
+#include <vector>
 
-#define SERVER_UPDATE_TIME      0.1f
-
-
-class Game;
+#define SERVER_TICK_TIME        0.1f        // seconds between two checks for bumps
+#define SERVER_MAXREWIND        300         // ms bumps are looked for in the past at most
+#define SERVER_MINSNAPSHOT_TIME 100         // ms between two snapshots to a client at least; the racers send no faster
+#define SERVER_MAXSNAPSHOT_TIME 300         // and at most
+#define SERVER_SNAPSHOT_STEP    2           // ms a good report takes off the time between snapshots
+#define SERVER_MAXLOSS          0.1f        // part of the snapshots lost before a link is congested
+#define SERVER_MAXQUEUEING      100         // ms a round trip may take over the shortest before that
+#define SERVER_NEARDISTANCE     24000       // cars this close along the track get into every snapshot
+#define SERVER_FARDISTANCE      120000
+#define SERVER_MIDDLEUPDATE     200         // ms between the positions of a car further away
+#define SERVER_FARUPDATE        500         // and of one beyond SERVER_FARDISTANCE
 
 
 
 
+// Runs a multiplayer race over any DirectX::ServerTransport. It does not
+// need a Game, so the dedicated server can host it as well as the game.
 class RaceServer : public DirectX::IServer
 {
 public:
@@ -35,24 +46,28 @@ public:
     };
     */
 public:
-    RaceServer(Game* game);
+    RaceServer( );
     virtual ~RaceServer( );
 
 public:
-    void initialize( );
+    // The transport stays owned by the caller, and must outlive finalize.
+    void initialize(DirectX::ServerTransport* transport, const Char* sessionName, UInt port);
     void finalize( );
     void run(Float elapsed);
 
 public:
     // void loadTrack(Char* trackname, UInt nrOfLaps);
-	void loadCustomTrack(Char* trackname);
+    void loadCustomTrack(const Char* trackname, UInt nrOfLaps);
     void sendDisconnect(Int id);
     void startRace( );
     void stopRace( );
     void abortRace( );
     Boolean     trackSelected( )        { Mutex::Guard guard(m_mutex); return m_trackSelected;       }
     Char*       track( )                { Mutex::Guard guard(m_mutex); return m_track;               }
-	Track::TrackData  trackData()		{ Mutex::Guard guard(m_mutex); return m_trackData;			}
+    TrackGeometry::TrackData  trackData()		{ Mutex::Guard guard(m_mutex); return m_trackData;			}
+    Boolean     raceStarted( )          { Mutex::Guard guard(m_mutex); return m_raceStarted;         }
+    UInt        nPlayers( )             { Mutex::Guard guard(m_mutex); return (UInt)m_playerMap.size( ); }
+    UInt        nPlayers(PlayerState state);
     void resetTrack( );
 private:
     void sendPacket(PacketBase* packet, UInt size, Boolean secure);
@@ -62,6 +77,7 @@ private:
     void sendPacketToRacers(PacketBase* packet, UInt size, Boolean secure);
     void sendPacketToRacersExceptTo(UInt to, PacketBase* packet, UInt size, Boolean secure);
     void sendPlayerDisconnected(UInt player);
+    void sendSnapshots(UInt now);
 
 public:
     virtual void    onPacket(UInt from, void* buffer, UInt size);
@@ -70,20 +86,57 @@ public:
     virtual void    onSessionLost( );
 private:
     UInt        nRacers( );
+    void        sendTrackTo(UInt to);
+    void        sendTrackChunks(UInt to, UInt offset);
+    void        sendBump(const PlayerData& player, Int bumpX, Int bumpY, Int bumpSpeed);
+    UInt        rewindTime(UInt now);
+    PositionHistory::Sample  position(UInt id, UInt time);
 private:
+    // What the server knows of the snapshots of one client. Each client
+    // gets its own sequence at its own rate, and the snapshots are kept as
+    // the client rebuilds them, so a car left out of one stays where that
+    // client last heard of it.
+    struct Recipient
+    {
+        UShort          sequence;           // of the last snapshot sent
+        UShort          ack;
+        UShort          nApplied;           // as the client last counted them
+        PlayerSnapshot  sent[SNAPSHOTHISTORY];
+        UInt            lastSnapshot;       // ms
+        UInt            lastEntry[NMAXPLAYERS];     // ms a snapshot last had each car
+        UInt            interval;           // ms between two snapshots
+        UInt            roundTrip;          // ms, smoothed; NOROUNDTRIP until measured
+        UInt            minRoundTrip;
+        Float           loss;               // part of the snapshots lost, smoothed
+        UInt            lastBackoff;        // ms
+    };
+
+    void        addRecipient(UInt id);
+    void        adaptRate(Recipient& recipient, UShort ack, UShort nApplied, UInt roundTrip, UInt now);
+    UInt        encodeSnapshot(PacketPlayerSnapshot& packet, const PlayerSnapshot& snapshot, Recipient& recipient,
+                               UInt recipientNumber, PlayerSnapshot& result, UInt now);
+
     typedef std::map<UInt, PlayerData>   TPlayerDataMap;
-    Game*                           m_game;
-    DirectX::Server*                m_server;
+    typedef std::map<UInt, Recipient>    TRecipientMap;
+    typedef std::map<UInt, PositionHistory>  TPositionHistoryMap;
+    DirectX::ServerTransport*       m_server;
     Mutex                           m_mutex;
     TPlayerDataMap                  m_playerMap;
-    Float                           m_lastUpdateTime;
+    TRecipientMap                   m_recipients;
+    TPositionHistoryMap             m_histories;
+    Float                           m_tickTime;
     Boolean                         m_raceStarted;
     UInt                            m_raceResults[NMAXPLAYERS];
     UInt                            m_nRaceResults;
     Boolean                         m_finalizing;
     Boolean                         m_trackSelected;
     Char                            m_track[32];
-    Track::TrackData	             m_trackData;
+    UInt                            m_nrOfLaps;
+    TrackGeometry::TrackData         m_trackData;
+    UInt                            m_lapLength;
+    std::vector<UByte>              m_trackStream;      // the definitions packed by TrackStream
+    UInt                            m_trackHash;
+    BumpSweep                       m_bumpSweep;
 };
 
 
@@ -63,6 +63,7 @@ RaceSettings::RaceSettings( ) :
     randomCustomTracks(0),
     randomCustomVehicles(0),
     singleRaceCustomVehicles(0),
+    udpTransport(0),
     serverNumber(random(4999) + 1000)
 {
     RACE("(+) RaceSettings");
@@ -141,6 +142,7 @@ RaceSettings::read( )
         randomCustomTracks          = settingsFile.readInt( );
         randomCustomVehicles          = settingsFile.readInt( );
         singleRaceCustomVehicles          = settingsFile.readInt( );
+        settingsFile.readInt("udp", udpTransport, 0);
     }
 }
     
@@ -200,6 +202,7 @@ settingsFile.writeKeyString("lang", language);
     settingsFile.writeInt((Int) randomCustomTracks);
     settingsFile.writeInt((Int) randomCustomVehicles);
     settingsFile.writeInt((Int) singleRaceCustomVehicles);
+    settingsFile.writeKeyInt("udp", udpTransport);
 }
 
 
@@ -250,4 +253,5 @@ RaceSettings::restoreDefaults( )
     randomCustomTracks          = 0;
     randomCustomVehicles          = 0;
     singleRaceCustomVehicles          = 0;
+    udpTransport          = 0;
 }
@@ -68,6 +68,7 @@ public: /* yeah, I know, just being lazy */
     Int                         randomCustomTracks;
     Int                         randomCustomVehicles;
     Int                         singleRaceCustomVehicles;
+    Int                         udpTransport;       // host and join over UDP instead of DirectPlay
 };
 
 
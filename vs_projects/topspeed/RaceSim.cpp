@@ -0,0 +1,236 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#include "RaceSim.h"
+
+#define CALLLENGTH 3000
+#define RACESTART 6.5f
+
+
+RaceSim::RaceSim(TrackGeometry* track, const Settings& settings) :
+    m_track(track),
+    m_settings(settings),
+    m_seed(settings.seed),
+    m_nRacers(0),
+    m_nFinished(0),
+    m_time(0.0f),
+    m_started(false),
+    m_done(false)
+{
+}
+
+
+RaceSim::~RaceSim( )
+{
+}
+
+
+RaceSim::Settings
+RaceSim::defaultSettings( )
+{
+    Settings settings;
+    settings.laps       = 3;
+    settings.difficulty = 1;
+    settings.timeStep   = 0.01f;
+    settings.seed       = 1;
+    settings.startDelay = 1.0f;
+    settings.crashDelay = 1.5f;
+    settings.maxTime    = 3600.0f;
+    return settings;
+}
+
+
+Boolean
+RaceSim::addRacer(UInt vehicle)
+{
+    if ((m_nRacers >= RACESIM_MAXRACERS) || (vehicle >= NVEHICLES))
+        return false;
+    Racer& racer = m_racer[m_nRacers];
+    racer.vehicle       = vehicle;
+    racer.parameters    = vehicles[vehicle];
+    racer.state         = waiting;
+    racer.stateTime     = 0.0f;
+    // grid positions as in LevelSingleRace::initialize
+    racer.positionX     = (m_nRacers % 2) ? 3000 : -3000;
+    racer.positionY     = 14000 - m_nRacers*2000;
+    racer.speed         = 0;
+    racer.surface       = m_track->definition()[0].surface;
+    racer.random        = nextRandom(100);
+    racer.frame         = 0;
+    racer.crashes       = 0;
+    racer.miniCrashes   = 0;
+    racer.bumps         = 0;
+    racer.finishTime    = 0.0f;
+    ++m_nRacers;
+    return true;
+}
+
+
+void
+RaceSim::start( )
+{
+    m_time      = 0.0f;
+    m_started   = false;
+    m_done      = (m_nRacers == 0);
+    m_nFinished = 0;
+    for (UInt i = 0; i < m_nRacers; ++i)
+    {
+        m_racer[i].state     = waiting;
+        m_racer[i].stateTime = 1.5f + (3.0f*nextRandom(100))/100;
+    }
+}
+
+
+Boolean
+RaceSim::step( )
+{
+    if (m_done)
+        return false;
+    Float elapsed = m_settings.timeStep;
+    m_time += elapsed;
+    if ((!m_started) && (m_time >= RACESTART))
+        m_started = true;
+    for (UInt i = 0; i < m_nRacers; ++i)
+        runRacer(m_racer[i], elapsed);
+    checkForBumps( );
+    for (UInt i = 0; i < m_nRacers; ++i)
+    {
+        Racer& racer = m_racer[i];
+        if ((racer.state != finished) && (m_track->lap(racer.positionY) > m_settings.laps))
+        {
+            racer.state      = finished;
+            racer.finishTime = m_time - RACESTART;
+            ++m_nFinished;
+        }
+    }
+    if ((m_nFinished == m_nRacers) || (m_time - RACESTART > m_settings.maxTime))
+        m_done = true;
+    return !m_done;
+}
+
+
+void
+RaceSim::run( )
+{
+    start( );
+    while (step( ))
+        ;
+}
+
+
+Int
+RaceSim::nextRandom(Int max)
+{
+    // Our own generator instead of rand( ), so every platform
+    // and every run produces the same sequence for a seed.
+    m_seed = m_seed*1103515245 + 12345;
+    return Int((m_seed >> 16) & 0x7fff) % max;
+}
+
+
+void
+RaceSim::startRacer(Racer& racer, Float delay)
+{
+    racer.speed     = 0;
+    racer.state     = starting;
+    racer.stateTime = m_time + delay;
+}
+
+
+void
+RaceSim::runRacer(Racer& racer, Float elapsed)
+{
+    switch (racer.state)
+    {
+    case waiting:
+        if (racer.stateTime < m_time)
+            startRacer(racer, m_settings.startDelay - 0.1f);
+        return;
+    case starting:
+        if (racer.stateTime < m_time)
+            racer.state = running;
+        return;
+    case crashing:
+        if (racer.stateTime < m_time)
+            startRacer(racer, m_settings.startDelay - 0.1f);
+        return;
+    case finished:
+        racer.speed = CarPhysics::decelerate(racer.parameters, elapsed, racer.speed);
+        return;
+    default:
+        break;
+    }
+    if (!m_started)
+        return;
+
+    Float width = Float(m_track->laneWidth( )) * 2.0f;
+    TrackGeometry::Road road     = m_track->roadComputer(racer.positionY);
+    TrackGeometry::Road nextRoad = m_track->roadComputer(racer.positionY + CALLLENGTH);
+    Float relPos = CarPhysics::relativePosition(racer.positionX, road, width);
+    CarPhysics::Controls controls;
+    CarPhysics::computerControls(road, nextRoad, relPos, m_settings.difficulty, racer.random, controls);
+
+    Int acceleration, deceleration;
+    CarPhysics::surfaceGrip(racer.parameters, racer.surface, true, acceleration, deceleration);
+    Int thrust = CarPhysics::thrust(controls.throttle, 0);
+    racer.speed = CarPhysics::accelerate(racer.parameters, elapsed, racer.speed, thrust, acceleration, deceleration);
+    racer.positionY += Int(racer.speed*elapsed);
+    racer.positionX += CarPhysics::steer(racer.parameters, elapsed, racer.speed, racer.surface, controls.steering);
+
+    evaluate(racer, m_track->roadComputer(racer.positionY));
+}
+
+
+void
+RaceSim::evaluate(Racer& racer, const TrackGeometry::Road& road)
+{
+    if (racer.frame % 4 == 0)
+    {
+        Float relPos = CarPhysics::relativePosition(racer.positionX, road, Float(m_track->laneWidth( )) * 2.0f);
+        if ((relPos < 0) || (relPos > 1))
+        {
+            racer.positionX = (road.right + road.left)/2;
+            if (racer.speed < racer.parameters.topspeed/2)
+            {
+                racer.speed = racer.speed / 4;
+                ++racer.miniCrashes;
+            }
+            else
+            {
+                racer.speed = 0;
+                racer.state = crashing;
+                racer.stateTime = m_time + m_settings.crashDelay + 1.25f;
+                ++racer.crashes;
+            }
+        }
+    }
+    racer.surface = road.surface;
+    ++racer.frame;
+}
+
+
+void
+RaceSim::checkForBumps( )
+{
+    m_bumpSweep.reset(m_track->length( ));
+    for (UInt i = 0; i < m_nRacers; ++i)
+    {
+        if (m_racer[i].state == running)
+            m_bumpSweep.add(i, m_racer[i].positionX, m_racer[i].positionY);
+    }
+    m_bumpSweep.sweep( );
+    for (UInt i = 0; i < m_bumpSweep.nPairs( ); ++i)
+    {
+        const BumpSweep::Pair& pair = m_bumpSweep.pair(i);
+        Racer& a = m_racer[pair.a];
+        Racer& b = m_racer[pair.b];
+        Int bumpSpeed = a.speed - b.speed;
+        CarPhysics::bump(a.positionX, a.positionY, a.speed, pair.bumpX, pair.bumpY, bumpSpeed);
+        CarPhysics::bump(b.positionX, b.positionY, b.speed, -pair.bumpX, -pair.bumpY, -bumpSpeed);
+        ++a.bumps;
+        ++b.bumps;
+    }
+}
@@ -0,0 +1,99 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __RACING_RACESIM_H__
+#define __RACING_RACESIM_H__
+
+#include <Common/If/Types.h>
+#include "TrackGeometry.h"
+#include "CarPhysics.h"
+#include "BumpSweep.h"
+
+#define RACESIM_MAXRACERS 8
+
+// Runs a complete race between computer players at a fixed timestep,
+// without sounds, input or a window. The same settings and seed always
+// give the same race, so results can be compared between builds.
+class RaceSim
+{
+public:
+    struct Settings
+    {
+        UInt            laps;
+        Int             difficulty;     // 0 = easy, 1 = normal, 2 = hard
+        Float           timeStep;       // seconds per step
+        UInt            seed;
+        Float           startDelay;     // length of the start sound
+        Float           crashDelay;     // length of the crash sound
+        Float           maxTime;        // give up after this many seconds of racing
+    };
+
+    enum State
+    {
+        waiting         = 0,
+        starting        = 1,
+        running         = 2,
+        crashing        = 3,
+        finished        = 4
+    };
+
+    struct Racer
+    {
+        UInt                    vehicle;
+        CarPhysics::Parameters  parameters;
+        State                   state;
+        Float                   stateTime;      // race time at which the pending state change happens
+        Int                     positionX;
+        Int                     positionY;
+        Int                     speed;
+        Int                     surface;
+        Int                     random;
+        UInt                    frame;
+        UInt                    crashes;
+        UInt                    miniCrashes;
+        UInt                    bumps;
+        Float                   finishTime;
+    };
+
+public:
+    RaceSim(TrackGeometry* track, const Settings& settings);
+    virtual ~RaceSim( );
+
+public:
+    static Settings defaultSettings( );
+
+    Boolean     addRacer(UInt vehicle);
+    void        start( );
+    Boolean     step( );
+    void        run( );
+
+    UInt        nRacers( )                  { return m_nRacers;         }
+    const Racer& racer(UInt i)              { return m_racer[i];        }
+    Float       time( )                     { return m_time;            }
+    Boolean     done( )                     { return m_done;            }
+
+private:
+    Int         nextRandom(Int max);
+    void        startRacer(Racer& racer, Float delay);
+    void        runRacer(Racer& racer, Float elapsed);
+    void        evaluate(Racer& racer, const TrackGeometry::Road& road);
+    void        checkForBumps( );
+
+private:
+    TrackGeometry*      m_track;
+    Settings            m_settings;
+    UInt                m_seed;
+    Racer               m_racer[RACESIM_MAXRACERS];
+    BumpSweep           m_bumpSweep;
+    UInt                m_nRacers;
+    UInt                m_nFinished;
+    Float               m_time;
+    Boolean             m_started;
+    Boolean             m_done;
+};
+
+
+#endif // __RACING_RACESIM_H__
@@ -0,0 +1,17 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __RACING_RACETRACER_H__
+#define __RACING_RACETRACER_H__
+
+#include <Common/If/Common.h>
+
+// The game and the dedicated server each define _raceTracer themselves.
+extern Tracer  _raceTracer;
+#define  RACE _raceTracer.trace
+
+
+#endif /* __RACING_RACETRACER_H__ */
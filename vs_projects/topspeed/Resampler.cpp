@@ -0,0 +1,146 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#include "Resampler.h"
+#include <math.h>
+#ifdef RESAMPLER_SSE2
+#include <emmintrin.h>
+#endif
+
+#define PI          3.14159265358979323846
+#define FRACTIONONE 4294967296.0
+
+
+// The modified Bessel function of the first kind, of order 0, which shapes
+// the Kaiser window.
+static Double
+besselI0(Double x)
+{
+    Double sum  = 1.0;
+    Double term = 1.0;
+    for (UInt k = 1; k < 50; ++k)
+    {
+        term *= (x / (2.0*k)) * (x / (2.0*k));
+        sum  += term;
+        if (term < sum * 1e-12)
+            break;
+    }
+    return sum;
+}
+
+
+Resampler::Resampler( )
+{
+    for (UInt band = 0; band < RESAMPLER_BANDS; ++band)
+        buildBand(band);
+}
+
+
+Resampler::~Resampler( )
+{
+}
+
+
+// The band whose cutoff is low enough for a voice that moves step source
+// frames, in 32.32 fixed point, per output frame.
+UInt
+Resampler::band(UHuge step)
+{
+    Double frames = Double(step) / FRACTIONONE;
+    UInt band = 0;
+    while ((band + 1 < RESAMPLER_BANDS) && (ratio(band) < frames))
+        ++band;
+    return band;
+}
+
+
+Double
+Resampler::ratio(UInt band)
+{
+    return pow(2.0, 0.5*band);
+}
+
+
+// Phase p is the filter for a position (p + 0.5)/RESAMPLER_PHASES of a frame
+// past a source frame, so truncating a fraction picks the nearest one.
+// Every phase is scaled to a gain of exactly RESAMPLER_ONE, so a constant
+// stays constant whatever the fraction.
+void
+Resampler::buildBand(UInt band)
+{
+    Double cutoff = 0.5 * RESAMPLER_CUTOFF / ratio(band);
+    Double half = RESAMPLER_TAPS / 2.0;
+    Double window = besselI0(RESAMPLER_KAISERBETA);
+    for (UInt phase = 0; phase < RESAMPLER_PHASES; ++phase)
+    {
+        Double fraction = (phase + 0.5) / RESAMPLER_PHASES;
+        Double weight[RESAMPLER_TAPS];
+        Double sum = 0.0;
+        for (UInt tap = 0; tap < RESAMPLER_TAPS; ++tap)
+        {
+            // tap 0 is the frame RESAMPLER_TAPS/2 - 1 before the position
+            Double t = Double(tap) - (half - 1.0) - fraction;
+            Double x = 2.0 * cutoff * t;
+            Double sinc = (fabs(x) < 1e-9) ? 1.0 : sin(PI * x) / (PI * x);
+            Double r = t / half;
+            Double kaiser = (fabs(r) >= 1.0) ? 0.0 : besselI0(RESAMPLER_KAISERBETA * sqrt(1.0 - r*r)) / window;
+            weight[tap] = 2.0 * cutoff * sinc * kaiser;
+            sum += weight[tap];
+        }
+        Short* filter = m_filter[band][phase];
+        Int total = 0;
+        UInt largest = 0;
+        for (UInt tap = 0; tap < RESAMPLER_TAPS; ++tap)
+        {
+            filter[tap] = Short(floor(weight[tap] / sum * RESAMPLER_ONE + 0.5));
+            total += filter[tap];
+            if (filter[tap] > filter[largest])
+                largest = tap;
+        }
+        // the rounding error goes where it matters least
+        filter[largest] = Short(filter[largest] + RESAMPLER_ONE - total);
+    }
+}
+
+
+/*************************************************************************************
+ * Adds up to nFrames resampled frames to left and right, starting at position
+ * and moving step source frames each, both in 32.32 fixed point, and stops
+ * early once position reaches end. Returns the number of frames added.
+ *************************************************************************************/
+UInt
+Resampler::mix(const Short* data, UHuge& position, UHuge step, UHuge end,
+               Float gainLeft, Float gainRight, Float* left, Float* right, UInt nFrames) const
+{
+    const Short (*filters)[RESAMPLER_TAPS] = m_filter[band(step)];
+    // the filters add RESAMPLER_ONE times the source
+    gainLeft  /= RESAMPLER_ONE;
+    gainRight /= RESAMPLER_ONE;
+    UInt i = 0;
+    for (; (i < nFrames) && (position < end); ++i)
+    {
+        const Short* source = data + Int(position >> 32) - (RESAMPLER_TAPS/2 - 1);
+        const Short* filter = filters[UInt(position) >> (32 - RESAMPLER_PHASEBITS)];
+#ifdef RESAMPLER_SSE2
+        __m128i sum = _mm_madd_epi16(_mm_loadu_si128((const __m128i*)source), _mm_loadu_si128((const __m128i*)filter));
+        for (UInt tap = 8; tap < RESAMPLER_TAPS; tap += 8)
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_loadu_si128((const __m128i*)(source + tap)),
+                                                    _mm_loadu_si128((const __m128i*)(filter + tap))));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+        Float s = Float(_mm_cvtsi128_si32(sum));
+#else
+        Int sum = 0;
+        for (UInt tap = 0; tap < RESAMPLER_TAPS; ++tap)
+            sum += Int(source[tap]) * Int(filter[tap]);
+        Float s = Float(sum);
+#endif
+        left[i]  += s*gainLeft;
+        right[i] += s*gainRight;
+        position += step;
+    }
+    return i;
+}
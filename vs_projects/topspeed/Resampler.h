@@ -0,0 +1,55 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __RACING_RESAMPLER_H__
+#define __RACING_RESAMPLER_H__
+
+#include <Common/If/Types.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define RESAMPLER_SSE2
+#endif
+
+#define RESAMPLER_TAPS          32          // source frames each output frame is filtered from
+#define RESAMPLER_PHASEBITS     8
+#define RESAMPLER_PHASES        (1 << RESAMPLER_PHASEBITS)  // fractional positions with a filter of their own
+#define RESAMPLER_BANDS         5           // cutoffs, for steps of up to 1, 1.4, 2, 2.8 and 4 source frames
+#define RESAMPLER_CUTOFF        0.88        // of the Nyquist frequency, leaving room for the transition
+#define RESAMPLER_KAISERBETA    6.0         // about 60 dB of stopband attenuation
+#define RESAMPLER_ONE           16384       // 1.0 in the filter coefficients
+
+
+// A band-limited resampler: every output frame is the sum of RESAMPLER_TAPS
+// source frames around its position, weighted by a windowed sinc. The filters
+// are worked out up front for RESAMPLER_PHASES fractions of a frame, the
+// nearest of which is used, and for several cutoffs. A voice that is pitched
+// up skips source frames, so it uses a lower cutoff to keep what it skips
+// from aliasing back down. The coefficients are 16 bit, so with SSE2 a frame
+// takes four multiply-adds.
+// The source must hold RESAMPLER_TAPS/2 valid frames before its first frame
+// and after its last one.
+class Resampler
+{
+public:
+    Resampler( );
+    virtual ~Resampler( );
+
+public:
+    static UInt     band(UHuge step);
+    static Double   ratio(UInt band);
+
+    UInt        mix(const Short* data, UHuge& position, UHuge step, UHuge end,
+                    Float gainLeft, Float gainRight, Float* left, Float* right, UInt nFrames) const;
+
+private:
+    void        buildBand(UInt band);
+
+private:
+    Short       m_filter[RESAMPLER_BANDS][RESAMPLER_PHASES][RESAMPLER_TAPS];
+};
+
+
+#endif // __RACING_RESAMPLER_H__
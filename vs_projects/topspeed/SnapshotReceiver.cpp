@@ -0,0 +1,83 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#include "SnapshotReceiver.h"
+#include "PlayerCodec.h"
+
+
+SnapshotReceiver::SnapshotReceiver( )
+{
+    reset( );
+}
+
+
+SnapshotReceiver::~SnapshotReceiver( )
+{
+}
+
+
+void
+SnapshotReceiver::reset( )
+{
+    for (UInt i = 0; i < SNAPSHOTHISTORY; ++i)
+        m_snapshots[i].sequence = 0;
+    m_ack = 0;
+    m_nApplied = 0;
+}
+
+
+const PlayerSnapshot*
+SnapshotReceiver::apply(const PacketPlayerSnapshot* packet, UInt size, Boolean* updated)
+{
+    // a truncated datagram must not be read past its end
+    UInt header = (UInt)(packet->entries - reinterpret_cast<const UByte*>(packet));
+    if (size < header)
+        return 0;
+    if ((m_ack != 0) && (Short(packet->sequence - m_ack) <= 0))
+        return 0;
+    PlayerSnapshot snapshot;
+    if (packet->baseline != 0)
+    {
+        const PlayerSnapshot& baseline = m_snapshots[packet->baseline % SNAPSHOTHISTORY];
+        if (baseline.sequence != packet->baseline)
+            return 0;
+        snapshot = baseline;
+    }
+    else
+    {
+        for (UInt i = 0; i < NMAXPLAYERS; ++i)
+            snapshot.present[i] = false;
+    }
+    snapshot.sequence = packet->sequence;
+
+    for (UInt i = 0; i < NMAXPLAYERS; ++i)
+        updated[i] = false;
+    BitReader reader(packet->entries, size - header);
+    UInt lapLength = reader.readVarint( );
+    for (UInt entry = 0; entry < packet->nEntries; ++entry)
+    {
+        UInt player  = reader.read(PLAYERNUMBERBITS);
+        UInt changed = reader.read(8);
+        if ((reader.failed( )) || (player >= NMAXPLAYERS))
+            return 0;
+        if (changed & snapshotRemoved)
+        {
+            snapshot.present[player] = false;
+            continue;
+        }
+        PlayerData& data = snapshot.player[player];
+        data.playerNumber = (UByte)player;
+        if (!PlayerCodec::read(reader, data, changed, lapLength))
+            return 0;
+        snapshot.present[player] = true;
+        updated[player] = true;
+    }
+    PlayerSnapshot& applied = m_snapshots[snapshot.sequence % SNAPSHOTHISTORY];
+    applied = snapshot;
+    m_ack = snapshot.sequence;
+    ++m_nApplied;
+    return &applied;
+}
@@ -0,0 +1,39 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __RACING_SNAPSHOTRECEIVER_H__
+#define __RACING_SNAPSHOTRECEIVER_H__
+
+#include "Packets.h"
+
+
+// The client end of the snapshots RaceServer sends: rebuilds each one from
+// the baseline it was compressed against and remembers it as a baseline
+// for the ones to come. Snapshots that arrive after a newer one, or against
+// a baseline that is no longer here, are dropped; the server falls back to
+// a complete snapshot when the acknowledgement it has is too old.
+class SnapshotReceiver
+{
+public:
+    SnapshotReceiver( );
+    virtual ~SnapshotReceiver( );
+
+public:
+    void                    reset( );
+    // The rebuilt snapshot, or 0 when it is dropped. The players with an
+    // entry in the packet are marked in updated.
+    const PlayerSnapshot*   apply(const PacketPlayerSnapshot* packet, UInt size, Boolean* updated);
+    UShort                  ack( ) const        { return m_ack;         }
+    UShort                  nApplied( ) const   { return m_nApplied;    }
+
+private:
+    PlayerSnapshot          m_snapshots[SNAPSHOTHISTORY];
+    UShort                  m_ack;              // the last snapshot applied
+    UShort                  m_nApplied;         // wraps around
+};
+
+
+#endif /* __RACING_SNAPSHOTRECEIVER_H__ */
@@ -0,0 +1,545 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#include "SoundMixer.h"
+#include <string.h>
+#include <math.h>
+#ifdef SOUNDMIXER_SSE2
+#include <emmintrin.h>
+#endif
+
+#define FRACTIONONE 4294967296.0
+
+
+static UInt
+readUInt(const UByte* p)
+{
+    return UInt(p[0]) | (UInt(p[1]) << 8) | (UInt(p[2]) << 16) | (UInt(p[3]) << 24);
+}
+
+static UInt
+readUShort(const UByte* p)
+{
+    return UInt(p[0]) | (UInt(p[1]) << 8);
+}
+
+static void
+writeUInt(UByte* p, UInt value)
+{
+    p[0] = UByte(value);
+    p[1] = UByte(value >> 8);
+    p[2] = UByte(value >> 16);
+    p[3] = UByte(value >> 24);
+}
+
+static void
+writeUShort(UByte* p, UInt value)
+{
+    p[0] = UByte(value);
+    p[1] = UByte(value >> 8);
+}
+
+// Rounds to the nearest value and saturates, like the SSE2 conversion does.
+static inline Short
+toShort(Float value)
+{
+    if (value >= 32767.0f)
+        return 32767;
+    if (value <= -32768.0f)
+        return -32768;
+    return Short(Int(floor(value + 0.5f)));
+}
+
+// DirectSound takes volume and pan in hundredths of a decibel,
+// DirectX::Sound maps 0..100 onto -100..0 dB.
+static Float
+decibels(Float dB)
+{
+    return Float(pow(10.0, dB / 20.0));
+}
+
+
+WaveFileAudioDevice::WaveFileAudioDevice(const Char* fileName) :
+    m_file(0),
+    m_sampleRate(0),
+    m_nFrames(0)
+{
+    strncpy(m_fileName, fileName, sizeof(m_fileName) - 1);
+    m_fileName[sizeof(m_fileName) - 1] = '\0';
+}
+
+
+WaveFileAudioDevice::~WaveFileAudioDevice( )
+{
+    close( );
+}
+
+
+Boolean
+WaveFileAudioDevice::open(UInt sampleRate)
+{
+    close( );
+    m_file = fopen(m_fileName, "wb");
+    if (m_file == 0)
+        return false;
+    m_sampleRate = sampleRate;
+    m_nFrames    = 0;
+    // the sizes are filled in by close( )
+    writeHeader( );
+    return true;
+}
+
+
+void
+WaveFileAudioDevice::write(const Short* frames, UInt nFrames)
+{
+    if (m_file == 0)
+        return;
+    UByte buffer[SOUNDMIXER_BLOCKFRAMES*4];
+    while (nFrames > 0)
+    {
+        UInt n = (nFrames < SOUNDMIXER_BLOCKFRAMES) ? nFrames : SOUNDMIXER_BLOCKFRAMES;
+        for (UInt i = 0; i < n*2; ++i)
+            writeUShort(buffer + i*2, UShort(frames[i]));
+        fwrite(buffer, 4, n, m_file);
+        frames    += n*2;
+        nFrames   -= n;
+        m_nFrames += n;
+    }
+}
+
+
+void
+WaveFileAudioDevice::close( )
+{
+    if (m_file == 0)
+        return;
+    fseek(m_file, 0, SEEK_SET);
+    writeHeader( );
+    fclose(m_file);
+    m_file = 0;
+}
+
+
+void
+WaveFileAudioDevice::writeHeader( )
+{
+    UByte header[44];
+    UInt dataSize = m_nFrames*4;
+    memcpy(header, "RIFF", 4);
+    writeUInt(header + 4, 36 + dataSize);
+    memcpy(header + 8, "WAVEfmt ", 8);
+    writeUInt(header + 16, 16);
+    writeUShort(header + 20, 1);                // PCM
+    writeUShort(header + 22, 2);                // stereo
+    writeUInt(header + 24, m_sampleRate);
+    writeUInt(header + 28, m_sampleRate*4);
+    writeUShort(header + 32, 4);
+    writeUShort(header + 34, 16);
+    memcpy(header + 36, "data", 4);
+    writeUInt(header + 40, dataSize);
+    fwrite(header, 1, sizeof(header), m_file);
+}
+
+
+SoundMixer::SoundMixer(AudioDevice* device, UInt sampleRate) :
+    m_device(device),
+    m_sampleRate(sampleRate),
+    m_interpolation(linear),
+    m_resampler(0)
+{
+    for (UInt i = 0; i < SOUNDMIXER_MAXVOICES; ++i)
+    {
+        m_voice[i].sample  = 0;
+        m_voice[i].playing = false;
+    }
+    if (m_device)
+        m_device->open(m_sampleRate);
+}
+
+
+SoundMixer::~SoundMixer( )
+{
+    if (m_device)
+        m_device->close( );
+    delete m_resampler;
+}
+
+
+Boolean
+SoundMixer::loadWave(const Char* fileName, Sample& sample)
+{
+    sample.data      = 0;
+    sample.loopData  = 0;
+    sample.length    = 0;
+    sample.frequency = 0;
+    FILE* file = fopen(fileName, "rb");
+    if (file == 0)
+        return false;
+
+    UByte chunk[8];
+    UByte format[16];
+    Boolean haveFormat = false;
+    if ((fread(chunk, 1, 8, file) != 8) || (memcmp(chunk, "RIFF", 4) != 0) ||
+        (fread(chunk, 1, 4, file) != 4) || (memcmp(chunk, "WAVE", 4) != 0))
+    {
+        fclose(file);
+        return false;
+    }
+    while (fread(chunk, 1, 8, file) == 8)
+    {
+        UInt size = readUInt(chunk + 4);
+        if ((memcmp(chunk, "fmt ", 4) == 0) && (size >= 16))
+        {
+            if (fread(format, 1, 16, file) != 16)
+                break;
+            fseek(file, long(size - 16 + (size & 1)), SEEK_CUR);
+            haveFormat = true;
+        }
+        else if ((memcmp(chunk, "data", 4) == 0) && (haveFormat))
+        {
+            UInt channels   = readUShort(format + 2);
+            UInt frequency  = readUInt(format + 4);
+            UInt bits       = readUShort(format + 14);
+            if ((readUShort(format) != 1) || (channels == 0) || ((bits != 8) && (bits != 16)))
+                break;
+            UInt frameSize = channels*bits/8;
+            UInt length = size / frameSize;
+            UByte* raw = new UByte[length*frameSize];
+            length = UInt(fread(raw, frameSize, length, file));
+            // keep a mono 16 bit copy, that is all the mixer plays
+            allocate(length, frequency, sample);
+            for (UInt i = 0; i < length; ++i)
+            {
+                Int sum = 0;
+                for (UInt c = 0; c < channels; ++c)
+                {
+                    if (bits == 8)
+                        sum += (Int(raw[i*frameSize + c]) - 128) << 8;
+                    else
+                        sum += Short(readUShort(raw + i*frameSize + c*2));
+                }
+                sample.data[i] = Short(sum / Int(channels));
+            }
+            if (length > 0)
+                fillGuards(sample);
+            delete[] raw;
+            fclose(file);
+            return length > 0;
+        }
+        else
+            fseek(file, long(size + (size & 1)), SEEK_CUR);
+    }
+    fclose(file);
+    return false;
+}
+
+
+void
+SoundMixer::freeWave(Sample& sample)
+{
+    if (sample.data)
+        delete[] (sample.data - SOUNDMIXER_GUARDFRAMES);
+    sample.data     = 0;
+    sample.loopData = 0;
+    sample.length   = 0;
+}
+
+
+// A sample of a copy of the given frames, for sounds that are not read
+// from a file.
+Boolean
+SoundMixer::makeSample(const Short* frames, UInt length, UInt frequency, Sample& sample)
+{
+    sample.data      = 0;
+    sample.loopData  = 0;
+    sample.length    = 0;
+    sample.frequency = 0;
+    if (length == 0)
+        return false;
+    allocate(length, frequency, sample);
+    memcpy(sample.data, frames, length*sizeof(Short));
+    fillGuards(sample);
+    return true;
+}
+
+
+// Makes room for the frames of a sample twice, each copy with its guard
+// frames, in a single block that starts SOUNDMIXER_GUARDFRAMES before data.
+void
+SoundMixer::allocate(UInt length, UInt frequency, Sample& sample)
+{
+    UInt size = length + 2*SOUNDMIXER_GUARDFRAMES;
+    sample.data      = new Short[2*size] + SOUNDMIXER_GUARDFRAMES;
+    sample.loopData  = sample.data + size;
+    sample.length    = length;
+    sample.frequency = frequency;
+}
+
+
+// Fills the guard frames once the frames are in data, so neither
+// interpolation needs to check for the ends of a voice. A voice that plays
+// once fades in from and out to silence; a looping voice plays from the
+// copy whose guards hold the other end, so it runs on across the loop.
+void
+SoundMixer::fillGuards(Sample& sample)
+{
+    Short* data      = sample.data;
+    Short* loopData  = sample.loopData;
+    UInt   length    = sample.length;
+    memcpy(loopData, data, length*sizeof(Short));
+    for (UInt i = 1; i <= SOUNDMIXER_GUARDFRAMES; ++i)
+    {
+        data[-Int(i)]            = 0;
+        data[length + i - 1]     = 0;
+        loopData[-Int(i)]        = loopData[(length - i % length) % length];
+        loopData[length + i - 1] = loopData[(i - 1) % length];
+    }
+}
+
+
+Int
+SoundMixer::play(const Sample* sample, Boolean loop)
+{
+    if ((sample == 0) || (sample->length == 0))
+        return -1;
+    for (UInt i = 0; i < SOUNDMIXER_MAXVOICES; ++i)
+    {
+        Voice& voice = m_voice[i];
+        if (voice.playing)
+            continue;
+        voice.sample   = sample;
+        voice.position = 0;
+        voice.volume   = 100;
+        voice.pan      = 0;
+        voice.loop     = loop;
+        voice.playing  = true;
+        frequency(i, sample->frequency);
+        updateGain(voice);
+        return i;
+    }
+    return -1;
+}
+
+
+void
+SoundMixer::stop(Int voice)
+{
+    if ((voice >= 0) && (voice < SOUNDMIXER_MAXVOICES))
+        m_voice[voice].playing = false;
+}
+
+
+Boolean
+SoundMixer::playing(Int voice)
+{
+    if ((voice < 0) || (voice >= SOUNDMIXER_MAXVOICES))
+        return false;
+    return m_voice[voice].playing;
+}
+
+
+UInt
+SoundMixer::nPlaying( )
+{
+    UInt n = 0;
+    for (UInt i = 0; i < SOUNDMIXER_MAXVOICES; ++i)
+        if (m_voice[i].playing)
+            ++n;
+    return n;
+}
+
+
+void
+SoundMixer::frequency(Int voice, Int value)
+{
+    if ((voice < 0) || (voice >= SOUNDMIXER_MAXVOICES))
+        return;
+    // the range DirectSound accepts
+    if (value < 100)
+        value = 100;
+    else if (value > 200000)
+        value = 200000;
+    m_voice[voice].step = UHuge(Double(value) / Double(m_sampleRate) * FRACTIONONE);
+}
+
+
+void
+SoundMixer::interpolation(Interpolation value)
+{
+    if ((value == sinc) && (m_resampler == 0))
+        m_resampler = new Resampler;
+    m_interpolation = value;
+}
+
+
+void
+SoundMixer::volume(Int voice, Int value)
+{
+    if ((voice < 0) || (voice >= SOUNDMIXER_MAXVOICES))
+        return;
+    m_voice[voice].volume = value;
+    updateGain(m_voice[voice]);
+}
+
+
+void
+SoundMixer::pan(Int voice, Int value)
+{
+    if ((voice < 0) || (voice >= SOUNDMIXER_MAXVOICES))
+        return;
+    m_voice[voice].pan = value;
+    updateGain(m_voice[voice]);
+}
+
+
+void
+SoundMixer::updateGain(Voice& voice)
+{
+    Float gain;
+    if (voice.volume < 0)
+        gain = 0.0f;
+    else if (voice.volume > 100)
+        gain = 1.0f;
+    else
+        gain = decibels(Float(voice.volume - 100));
+    // scale to -1..1 here, so mixing needs a single multiply per channel
+    gain /= 32768.0f;
+    voice.left  = gain;
+    voice.right = gain;
+    if (voice.pan > 0)
+        voice.left  *= decibels(-Float((voice.pan > 100) ? 100 : voice.pan));
+    else if (voice.pan < 0)
+        voice.right *= decibels(Float((voice.pan < -100) ? -100 : voice.pan));
+}
+
+
+void
+SoundMixer::mixVoice(Voice& voice, Float* left, Float* right, UInt nFrames)
+{
+    const Short* data = (voice.loop) ? voice.sample->loopData : voice.sample->data;
+    UInt  length      = voice.sample->length;
+    UHuge end         = UHuge(length) << 32;
+    UInt  i = 0;
+    if (m_interpolation == sinc)
+    {
+        while (i < nFrames)
+        {
+            if (voice.position >= end)
+            {
+                if (!voice.loop)
+                {
+                    voice.playing = false;
+                    return;
+                }
+                voice.position %= end;
+            }
+            i += m_resampler->mix(data, voice.position, voice.step, end, voice.left, voice.right,
+                                  left + i, right + i, nFrames - i);
+        }
+        return;
+    }
+#ifdef SOUNDMIXER_SSE2
+    // the fractions are halved to fit a signed 32 bit integer
+    const __m128 scale  = _mm_set1_ps(Float(2.0 / FRACTIONONE));
+    const __m128 gainL  = _mm_set1_ps(voice.left);
+    const __m128 gainR  = _mm_set1_ps(voice.right);
+#endif
+    while (i < nFrames)
+    {
+        if (voice.position >= end)
+        {
+            if (!voice.loop)
+            {
+                voice.playing = false;
+                return;
+            }
+            voice.position %= end;
+        }
+#ifdef SOUNDMIXER_SSE2
+        // Four frames at a time for as long as none of them wraps around.
+        // The sample data has guard frames after its length, so reading
+        // index + 1 at the last frame is fine.
+        while ((i + 4 <= nFrames) && (voice.position + 3*voice.step < end))
+        {
+            UHuge p0 = voice.position;
+            UHuge p1 = p0 + voice.step;
+            UHuge p2 = p1 + voice.step;
+            UHuge p3 = p2 + voice.step;
+            UInt  i0 = UInt(p0 >> 32), i1 = UInt(p1 >> 32), i2 = UInt(p2 >> 32), i3 = UInt(p3 >> 32);
+            __m128 a = _mm_set_ps(data[i3], data[i2], data[i1], data[i0]);
+            __m128 b = _mm_set_ps(data[i3 + 1], data[i2 + 1], data[i1 + 1], data[i0 + 1]);
+            __m128i f = _mm_set_epi32(Int(UInt(p3) >> 1), Int(UInt(p2) >> 1), Int(UInt(p1) >> 1), Int(UInt(p0) >> 1));
+            __m128 frac = _mm_mul_ps(_mm_cvtepi32_ps(f), scale);
+            __m128 s = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), frac));
+            _mm_storeu_ps(left + i,  _mm_add_ps(_mm_loadu_ps(left + i),  _mm_mul_ps(s, gainL)));
+            _mm_storeu_ps(right + i, _mm_add_ps(_mm_loadu_ps(right + i), _mm_mul_ps(s, gainR)));
+            voice.position = p3 + voice.step;
+            i += 4;
+        }
+        if (i >= nFrames)
+            break;
+        if (voice.position >= end)
+            continue;
+#endif
+        UInt  index = UInt(voice.position >> 32);
+        Float frac  = Float(Double(UInt(voice.position)) / FRACTIONONE);
+        Float s     = data[index] + (data[index + 1] - data[index])*frac;
+        left[i]  += s*voice.left;
+        right[i] += s*voice.right;
+        voice.position += voice.step;
+        ++i;
+    }
+}
+
+
+void
+SoundMixer::mix(Short* frames, UInt nFrames)
+{
+    while (nFrames > 0)
+    {
+        UInt n = (nFrames < SOUNDMIXER_BLOCKFRAMES) ? nFrames : SOUNDMIXER_BLOCKFRAMES;
+        memset(m_left, 0, n*sizeof(Float));
+        memset(m_right, 0, n*sizeof(Float));
+        for (UInt v = 0; v < SOUNDMIXER_MAXVOICES; ++v)
+            if (m_voice[v].playing)
+                mixVoice(m_voice[v], m_left, m_right, n);
+
+        UInt i = 0;
+#ifdef SOUNDMIXER_SSE2
+        // convert with saturation and interleave left and right
+        const __m128 full = _mm_set1_ps(32767.0f);
+        for (; i + 4 <= n; i += 4)
+        {
+            __m128i l = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(m_left + i), full));
+            __m128i r = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(m_right + i), full));
+            __m128i lr = _mm_packs_epi32(_mm_unpacklo_epi32(l, r), _mm_unpackhi_epi32(l, r));
+            _mm_storeu_si128((__m128i*)(frames + i*2), lr);
+        }
+#endif
+        for (; i < n; ++i)
+        {
+            frames[i*2]     = toShort(m_left[i]*32767.0f);
+            frames[i*2 + 1] = toShort(m_right[i]*32767.0f);
+        }
+        frames  += n*2;
+        nFrames -= n;
+    }
+}
+
+
+void
+SoundMixer::render(UInt nFrames)
+{
+    while (nFrames > 0)
+    {
+        UInt n = (nFrames < SOUNDMIXER_BLOCKFRAMES) ? nFrames : SOUNDMIXER_BLOCKFRAMES;
+        mix(m_output, n);
+        if (m_device)
+            m_device->write(m_output, n);
+        nFrames -= n;
+    }
+}
@@ -0,0 +1,155 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __RACING_SOUNDMIXER_H__
+#define __RACING_SOUNDMIXER_H__
+
+#include <Common/If/Types.h>
+#include "Resampler.h"
+#include <stdio.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define SOUNDMIXER_SSE2
+#endif
+
+#define SOUNDMIXER_MAXVOICES    64
+#define SOUNDMIXER_BLOCKFRAMES  512
+#define SOUNDMIXER_GUARDFRAMES  (RESAMPLER_TAPS/2)     // frames kept before and after a sample for the interpolation
+
+
+// Receives the output of the SoundMixer as interleaved 16 bit stereo frames.
+class AudioDevice
+{
+public:
+    virtual ~AudioDevice( )                                 { }
+
+public:
+    virtual Boolean open(UInt sampleRate) = 0;
+    virtual void    write(const Short* frames, UInt nFrames) = 0;
+    virtual void    close( ) = 0;
+};
+
+
+// Throws the output away, so the mixer can run and be profiled without a sound card.
+class NullAudioDevice : public AudioDevice
+{
+public:
+    NullAudioDevice( ) : m_nFrames(0)                       { }
+
+public:
+    Boolean     open(UInt sampleRate)                       { m_nFrames = 0; return true; }
+    void        write(const Short* frames, UInt nFrames)    { m_nFrames += nFrames; }
+    void        close( )                                    { }
+    UHuge       nFrames( )                                  { return m_nFrames; }
+
+private:
+    UHuge       m_nFrames;
+};
+
+
+// Writes the output to a PCM wave file.
+class WaveFileAudioDevice : public AudioDevice
+{
+public:
+    WaveFileAudioDevice(const Char* fileName);
+    virtual ~WaveFileAudioDevice( );
+
+public:
+    Boolean     open(UInt sampleRate);
+    void        write(const Short* frames, UInt nFrames);
+    void        close( );
+
+private:
+    void        writeHeader( );
+
+private:
+    Char        m_fileName[256];
+    FILE*       m_file;
+    UInt        m_sampleRate;
+    UInt        m_nFrames;
+};
+
+
+// Mixes sounds in software, for when there is no DirectSound to do it.
+// Every voice is resampled to the output rate, so its frequency can be
+// changed while it plays like the engine sounds do, and volume and pan
+// follow the same scales as DirectX::Sound. It interpolates linearly
+// between two frames, or with the band-limited Resampler, which costs more
+// but keeps an engine that is pitched up from aliasing.
+class SoundMixer
+{
+public:
+    struct Sample
+    {
+        Short*          data;           // mono, with SOUNDMIXER_GUARDFRAMES of silence around it
+        Short*          loopData;       // the same, with copies of the other end around it
+        UInt            length;         // in frames
+        UInt            frequency;
+    };
+
+    enum Interpolation
+    {
+        linear,
+        sinc
+    };
+
+public:
+    SoundMixer(AudioDevice* device, UInt sampleRate = 44100);
+    virtual ~SoundMixer( );
+
+public:
+    static Boolean  loadWave(const Char* fileName, Sample& sample);
+    static void     freeWave(Sample& sample);
+    static Boolean  makeSample(const Short* frames, UInt length, UInt frequency, Sample& sample);
+
+    Int         play(const Sample* sample, Boolean loop = false);
+    void        stop(Int voice);
+    Boolean     playing(Int voice);
+    void        frequency(Int voice, Int value);
+    void        volume(Int voice, Int value);
+    void        pan(Int voice, Int value);
+
+    void        mix(Short* frames, UInt nFrames);
+    void        render(UInt nFrames);
+
+    UInt        sampleRate( )                   { return m_sampleRate;      }
+    UInt        nPlaying( );
+    void        interpolation(Interpolation value);
+    Interpolation interpolation( )              { return m_interpolation;   }
+
+private:
+    struct Voice
+    {
+        const Sample*   sample;
+        UHuge           position;       // in source frames, 32.32 fixed point
+        UHuge           step;           // source frames per output frame
+        Int             volume;
+        Int             pan;
+        Float           left;
+        Float           right;
+        Boolean         loop;
+        Boolean         playing;
+    };
+
+private:
+    static void allocate(UInt length, UInt frequency, Sample& sample);
+    static void fillGuards(Sample& sample);
+    void        updateGain(Voice& voice);
+    void        mixVoice(Voice& voice, Float* left, Float* right, UInt nFrames);
+
+private:
+    AudioDevice*    m_device;
+    UInt            m_sampleRate;
+    Interpolation   m_interpolation;
+    Resampler*      m_resampler;    // built the first time sinc is chosen
+    Voice           m_voice[SOUNDMIXER_MAXVOICES];
+    Float           m_left[SOUNDMIXER_BLOCKFRAMES];
+    Float           m_right[SOUNDMIXER_BLOCKFRAMES];
+    Short           m_output[SOUNDMIXER_BLOCKFRAMES*2];
+};
+
+
+#endif // __RACING_SOUNDMIXER_H__
@@ -0,0 +1,154 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#include "StateBuffer.h"
+
+#define INITIALINTERVAL     0.1f
+#define SMOOTHING           0.1f
+#define DRIFT               0.05f       // the playback runs at most 5% faster or slower to follow the delay
+
+
+StateBuffer::StateBuffer( ) :
+    m_first(0),
+    m_nStates(0),
+    m_interval(INITIALINTERVAL),
+    m_jitter(0.0f),
+    m_delay(INITIALINTERVAL),
+    m_lastSample(0.0f)
+{
+}
+
+
+StateBuffer::~StateBuffer( )
+{
+}
+
+
+void
+StateBuffer::reset( )
+{
+    m_first    = 0;
+    m_nStates  = 0;
+    m_interval = INITIALINTERVAL;
+    m_jitter   = 0.0f;
+    m_delay    = INITIALINTERVAL;
+    m_lastSample = 0.0f;
+}
+
+
+void
+StateBuffer::push(Float time, Int positionX, Int positionY, Int speed, Int frequency)
+{
+    if (m_nStates > 0)
+    {
+        const State& newest = at(m_nStates - 1);
+        if (time <= newest.time)
+            return;
+        // a gap of several updates means the car stood still, not that the updates slowed down
+        Float gap = time - newest.time;
+        if (gap < 4.0f*m_interval)
+        {
+            Float deviation = gap - m_interval;
+            m_interval += SMOOTHING*deviation;
+            m_jitter   += SMOOTHING*(((deviation < 0.0f) ? -deviation : deviation) - m_jitter);
+        }
+    }
+    if (m_nStates == STATEBUFFER_SIZE)
+    {
+        m_first = (m_first + 1) % STATEBUFFER_SIZE;
+        --m_nStates;
+    }
+    State& state    = m_states[(m_first + m_nStates) % STATEBUFFER_SIZE];
+    state.time      = time;
+    state.positionX = Float(positionX);
+    state.positionY = Float(positionY);
+    state.speed     = Float(speed);
+    state.frequency = Float(frequency);
+    ++m_nStates;
+}
+
+
+Float
+StateBuffer::targetDelay( )
+{
+    Float delay = m_interval + 2.0f*m_jitter;
+    if (delay < STATEBUFFER_MINDELAY)
+        return STATEBUFFER_MINDELAY;
+    if (delay > STATEBUFFER_MAXDELAY)
+        return STATEBUFFER_MAXDELAY;
+    return delay;
+}
+
+
+// The sideways speed at state i, from its neighbours; the first and last
+// states only have one.
+Float
+StateBuffer::slopeX(UInt i)
+{
+    UInt previous = (i > 0) ? i - 1 : i;
+    UInt next     = (i + 1 < m_nStates) ? i + 1 : i;
+    if (previous == next)
+        return 0.0f;
+    return (at(next).positionX - at(previous).positionX) / (at(next).time - at(previous).time);
+}
+
+
+Boolean
+StateBuffer::sample(Float time, State& state)
+{
+    if (m_nStates == 0)
+        return false;
+    // follow changes of the delay gradually, a jump would move the car with it
+    Float step   = DRIFT*(time - m_lastSample);
+    Float target = targetDelay( );
+    if ((m_lastSample == 0.0f) || (time < m_lastSample))
+        m_delay = target;
+    else if (target > m_delay + step)
+        m_delay += step;
+    else if (target < m_delay - step)
+        m_delay -= step;
+    else
+        m_delay = target;
+    m_lastSample = time;
+    Float playback = time - m_delay;
+    const State& newest = at(m_nStates - 1);
+    if (playback >= newest.time)
+    {
+        Float ahead = playback - newest.time;
+        if (ahead > STATEBUFFER_EXTRAPOLATION)
+            ahead = STATEBUFFER_EXTRAPOLATION;
+        state = newest;
+        state.time       = playback;
+        state.positionX += slopeX(m_nStates - 1)*ahead;
+        state.positionY += newest.speed*ahead;
+        return true;
+    }
+    if (playback <= at(0).time)
+    {
+        state = at(0);
+        state.time = playback;
+        return true;
+    }
+    UInt i = m_nStates - 1;
+    while (at(i - 1).time > playback)
+        --i;
+    const State& a = at(i - 1);
+    const State& b = at(i);
+    Float h  = b.time - a.time;
+    Float t  = (playback - a.time) / h;
+    Float t2 = t*t;
+    Float t3 = t2*t;
+    Float h00 = 2.0f*t3 - 3.0f*t2 + 1.0f;
+    Float h10 = t3 - 2.0f*t2 + t;
+    Float h01 = -2.0f*t3 + 3.0f*t2;
+    Float h11 = t3 - t2;
+    state.time      = playback;
+    state.positionX = h00*a.positionX + h10*h*slopeX(i - 1) + h01*b.positionX + h11*h*slopeX(i);
+    state.positionY = h00*a.positionY + h10*h*a.speed + h01*b.positionY + h11*h*b.speed;
+    state.speed     = a.speed + t*(b.speed - a.speed);
+    state.frequency = a.frequency + t*(b.frequency - a.frequency);
+    return true;
+}
@@ -0,0 +1,66 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __RACING_STATEBUFFER_H__
+#define __RACING_STATEBUFFER_H__
+
+#include <Common/If/Types.h>
+
+#define STATEBUFFER_SIZE            16
+#define STATEBUFFER_MINDELAY        0.05f   // seconds the playback stays behind the newest state
+#define STATEBUFFER_MAXDELAY        0.5f
+#define STATEBUFFER_EXTRAPOLATION   0.25f   // seconds to carry on past the newest state
+
+
+// The states received for a remote car, stamped with the time they arrived.
+// They are played back a little in the past, a bit more than the time
+// between two updates, so there is nearly always a newer state to move
+// towards. Between two states the position follows a Hermite curve; along
+// the track its tangent is the speed, which is exactly how fast positionY
+// changes. When the updates stop the car carries on at its last speed for
+// a short while, then waits for the next state.
+class StateBuffer
+{
+public:
+    struct State
+    {
+        Float           time;
+        Float           positionX;
+        Float           positionY;
+        Float           speed;
+        Float           frequency;
+    };
+
+public:
+    StateBuffer( );
+    virtual ~StateBuffer( );
+
+public:
+    void        reset( );
+    void        push(Float time, Int positionX, Int positionY, Int speed, Int frequency);
+    Boolean     sample(Float time, State& state);
+
+    UInt        nStates( )                  { return m_nStates;     }
+    Float       interval( )                 { return m_interval;    }
+    Float       delay( )                    { return m_delay;       }
+
+private:
+    const State&    at(UInt i)              { return m_states[(m_first + i) % STATEBUFFER_SIZE]; }
+    Float           slopeX(UInt i);
+    Float           targetDelay( );
+
+private:
+    State       m_states[STATEBUFFER_SIZE];
+    UInt        m_first;
+    UInt        m_nStates;
+    Float       m_interval;         // smoothed time between two states
+    Float       m_jitter;           // smoothed deviation from it
+    Float       m_delay;            // how far the playback is behind
+    Float       m_lastSample;
+};
+
+
+#endif /* __RACING_STATEBUFFER_H__ */
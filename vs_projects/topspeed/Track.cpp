@@ -7,19 +7,10 @@
 #include "Track.h"
 #include "Game.h"
 #include "resource.h"
-#include "TrackDefs.h"
 
-#define LANEWIDTH 15000
 #define CALLLENGTH 3000
-#define TYPES 9
-#define SURFACES 5
-#define NOISES 12
-#define MINPARTLENGTH 5000
 
 Track::Track() :
-    m_userDefined(false),
-    m_weather(sunny),
-    m_ambience(noAmbience),
     m_soundCrowd(NULL),
     m_soundOcean(NULL),
     m_soundRain(NULL),
@@ -36,8 +27,6 @@ Track::Track() :
     m_soundRiver(NULL),
     m_soundHelicopter(NULL),
     m_soundOwl(NULL),
-    m_lapDistance(0),
-    m_lapCenter(0),
     m_currentRoad(0),
     m_relPos(0),
     m_lastCalled(0),
@@ -52,11 +41,8 @@ Track::Track() :
 
 Track::Track(Char* trackName, TrackData data, Game* game) :
     m_game(game),
-    m_laneWidth(LANEWIDTH),
     m_callLength(CALLLENGTH),
     m_relPos(0),
-    m_weather(data.weather),
-    m_ambience(data.ambience),
     m_soundCrowd(NULL),
     m_soundOcean(NULL),
     m_soundRain(NULL),
@@ -73,10 +59,6 @@ Track::Track(Char* trackName, TrackData data, Game* game) :
     m_soundRiver(NULL),
     m_soundHelicopter(NULL),
     m_soundOwl(NULL),
-    m_userDefined(true),
-    m_length(data.length),
-    m_lapDistance(0),
-    m_lapCenter(0),
     m_currentRoad(0),
     m_lastCalled(0),
     m_factor(0),
@@ -94,6 +76,10 @@ Track::Track(Char* trackName, TrackData data, Game* game) :
     {
         strcpy(m_trackName, "");
     }
+    m_userDefined = true;
+    m_weather = data.weather;
+    m_ambience = data.ambience;
+    m_length = data.length;
     m_definition = new Definition[m_length];
     for (UInt i = 0; i < m_length; ++i)
     {
@@ -128,12 +114,8 @@ Track::Track(Char* trackName, TrackData data, Game* game) :
 
 Track::Track(Char* filename, Game* game) :
     m_game(game),
-    m_laneWidth(LANEWIDTH),
     m_callLength(CALLLENGTH),
     m_relPos(0),
-    m_userDefined(false),
-    m_weather(sunny),
-    m_ambience(noAmbience),
     m_soundCrowd(NULL),
     m_soundOcean(NULL),
     m_soundRain(NULL),
@@ -150,8 +132,6 @@ Track::Track(Char* filename, Game* game) :
     m_soundRiver(NULL),
     m_soundHelicopter(NULL),
     m_soundOwl(NULL),
-    m_lapDistance(0),
-    m_lapCenter(0),
     m_currentRoad(0),
     m_lastCalled(0),
     m_factor(0),
@@ -169,202 +149,9 @@ Track::Track(Char* filename, Game* game) :
     {
         strcpy(m_trackName, "");
     }
-    if (strcmp(filename, "america") == 0)
-    {
-        m_definition = _trAmerica;
-        m_length     = sizeof(_trAmerica)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "austria") == 0)
-    {
-        m_definition = _trAustria;
-        m_length     = sizeof(_trAustria)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "belgium") == 0)
-    {
-        m_definition = _trBelgium;
-        m_length     = sizeof(_trBelgium)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "brazil") == 0)
-    {
-        m_definition = _trBrazil;
-        m_length     = sizeof(_trBrazil)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "china") == 0)
-    {
-        m_definition = _trChina;
-        m_length     = sizeof(_trChina)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "england") == 0)
-    {
-        m_definition = _trEngland;
-        m_length     = sizeof(_trEngland)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "finland") == 0)
-    {
-        m_definition = _trFinland;
-        m_length     = sizeof(_trFinland)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "france") == 0)
-    {
-        m_definition = _trFrance;
-        m_length     = sizeof(_trFrance)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "germany") == 0)
-    {
-        m_definition = _trGermany;
-        m_length     = sizeof(_trGermany)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "ireland") == 0)
-    {
-        m_definition = _trIreland;
-        m_length     = sizeof(_trIreland)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "italy") == 0)
-    {
-        m_definition = _trItaly;
-        m_length     = sizeof(_trItaly)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "netherlands") == 0)
-    {
-        m_definition = _trNetherlands;
-        m_length     = sizeof(_trNetherlands)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "portugal") == 0)
-    {
-        m_definition = _trPortugal;
-        m_length     = sizeof(_trPortugal)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "russia") == 0)
-    {
-        m_definition = _trRussia;
-        m_length     = sizeof(_trRussia)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "spain") == 0)
-    {
-        m_definition = _trSpain;
-        m_length     = sizeof(_trSpain)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "sweden") == 0)
-    {
-        m_definition = _trSweden;
-        m_length     = sizeof(_trSweden)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "switserland") == 0)
-    {
-        m_definition = _trSwitserland;
-        m_length     = sizeof(_trSwitserland)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "advHills") == 0)
-    {
-        m_definition = _trAdvHills;
-        m_length     = sizeof(_trAdvHills)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "advCoast") == 0)
-    {
-        m_definition = _trAdvCoast;
-        m_length     = sizeof(_trAdvCoast)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "advCountry") == 0)
-    {
-        m_definition = _trAdvCountry;
-        m_length     = sizeof(_trAdvCountry)/sizeof(Definition);
-        m_weather = rain;
-    }
-    else if (strcmp(filename, "advAirport") == 0)
-    {
-        m_definition = _trAirport;
-        m_length     = sizeof(_trAirport)/sizeof(Definition);
-        m_ambience = airport;
-    }
-    else if (strcmp(filename, "advDesert") == 0)
-    {
-        m_definition = _trDesert;
-        m_length     = sizeof(_trDesert)/sizeof(Definition);
-        m_ambience = desert;
-    }
-    else if (strcmp(filename, "advRush") == 0)
-    {
-        m_definition = _trAdvRush;
-        m_length     = sizeof(_trAdvRush)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "advEscape") == 0)
-    {
-        m_definition = _trAdvEscape;
-        m_length     = sizeof(_trAdvEscape)/sizeof(Definition);
-        m_weather = wind;
-    }
-    else
-    {
-        m_userDefined = true;
-        File file(filename, File::read);
-        // Find out the length
-        m_length = 0;
-        while (file.readInt( ) >= 0)
-        {
-            file.readInt( );
-            if (file.readInt( ) < MINPARTLENGTH)
-                file.readInt( );
-            ++m_length;
-        }
-        file.rewind( );
-        RACE("Track : reading trackfile, length of track = %d", m_length);
-        if (m_length == 0)
-        {
-            m_length = 1;
-            m_definition = new Definition[1];
-            m_definition[0].type = (Type)0;
-            m_definition[0].surface = (Surface)0;
-            m_definition[0].noise = (Noise)0;
-            m_definition[0].length = MINPARTLENGTH;
-            m_weather  = (Weather)0;
-            m_ambience = (Ambience)0;
-        }
-        else
-        {
-            m_definition = new Definition[m_length];
-            Int temp = 0;
-            for (UInt i = 0; i < m_length; ++i)
-            {
-                m_definition[i].type    = (Type)file.readInt( );
-                m_definition[i].surface = (Surface)file.readInt( );
-                temp = file.readInt( );
-                if (temp < NOISES)
-                {
-                    m_definition[i].noise   = (Noise)temp;
-                    m_definition[i].length  = file.readInt( );
-                }
-                else
-                {
-                    if (m_definition[i].type >= TYPES)
-                    {
-                        m_definition[i].noise = (Noise)((m_definition[i].type - TYPES) + 1);
-                        m_definition[i].type = (Type)0;
-                    }
-                    else
-                    {
-                        m_definition[i].noise = (Noise)0;
-                    }
-                    m_definition[i].length = temp;
-                }
-                if (m_definition[i].type >= TYPES)
-                    m_definition[i].type = (Type)0;
-                if (m_definition[i].surface >= SURFACES)
-                    m_definition[i].surface = (Surface)0;
-                if (m_definition[i].noise >= NOISES)
-                    m_definition[i].noise = (Noise)0;
-                if (m_definition[i].length < MINPARTLENGTH)
-                    m_definition[i].length = MINPARTLENGTH;
-            }
-            file.readInt( ); // -1
-            m_weather  = (Weather)file.readInt( );
-            if (m_weather < 0)
-                m_weather = (Weather)0;
-            m_ambience = (Ambience)file.readInt( );
-            if (m_ambience < 0)
-                m_ambience = (Ambience)0;
-        }
-        RACE("Track : done reading trackfile");
-    }
+    load(filename);
+    if (m_userDefined)
+        RACE("Track : read trackfile, length of track = %d", m_length);
     m_soundCrowd        = m_game->soundManager( )->create(IDR_CROWD);
     m_soundOcean        = m_game->soundManager( )->create(IDR_OCEAN);
     if (m_weather == rain)
@@ -388,216 +175,20 @@ Track::Track(Char* filename, Game* game) :
     m_soundOwl        = m_game->soundManager( )->create(IDR_OWL);
 }
 
+
 Track* 
 Track::readTrack(Char* filename)
 {
     Track* result = new Track();
-    if (strcmp(filename, "america") == 0)
-    {
-        result->m_definition = _trAmerica;
-        result->m_length     = sizeof(_trAmerica)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "austria") == 0)
-    {
-        result->m_definition = _trAustria;
-        result->m_length     = sizeof(_trAustria)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "belgium") == 0)
-    {
-        result->m_definition = _trBelgium;
-        result->m_length     = sizeof(_trBelgium)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "brazil") == 0)
-    {
-        result->m_definition = _trBrazil;
-        result->m_length     = sizeof(_trBrazil)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "china") == 0)
-    {
-        result->m_definition = _trChina;
-        result->m_length     = sizeof(_trChina)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "england") == 0)
-    {
-        result->m_definition = _trEngland;
-        result->m_length     = sizeof(_trEngland)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "finland") == 0)
-    {
-        result->m_definition = _trFinland;
-        result->m_length     = sizeof(_trFinland)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "france") == 0)
-    {
-        result->m_definition = _trFrance;
-        result->m_length     = sizeof(_trFrance)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "germany") == 0)
-    {
-        result->m_definition = _trGermany;
-        result->m_length     = sizeof(_trGermany)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "ireland") == 0)
-    {
-        result->m_definition = _trIreland;
-        result->m_length     = sizeof(_trIreland)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "italy") == 0)
-    {
-        result->m_definition = _trItaly;
-        result->m_length     = sizeof(_trItaly)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "netherlands") == 0)
-    {
-        result->m_definition = _trNetherlands;
-        result->m_length     = sizeof(_trNetherlands)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "portugal") == 0)
-    {
-        result->m_definition = _trPortugal;
-        result->m_length     = sizeof(_trPortugal)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "russia") == 0)
-    {
-        result->m_definition = _trRussia;
-        result->m_length     = sizeof(_trRussia)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "spain") == 0)
-    {
-        result->m_definition = _trSpain;
-        result->m_length     = sizeof(_trSpain)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "sweden") == 0)
-    {
-        result->m_definition = _trSweden;
-        result->m_length     = sizeof(_trSweden)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "switserland") == 0)
-    {
-        result->m_definition = _trSwitserland;
-        result->m_length     = sizeof(_trSwitserland)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "advHills") == 0)
-    {
-        result->m_definition = _trAdvHills;
-        result->m_length     = sizeof(_trAdvHills)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "advCoast") == 0)
-    {
-        result->m_definition = _trAdvCoast;
-        result->m_length     = sizeof(_trAdvCoast)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "advCountry") == 0)
-    {
-        result->m_definition = _trAdvCountry;
-        result->m_length     = sizeof(_trAdvCountry)/sizeof(Definition);
-        result->m_weather = rain;
-    }
-    else if (strcmp(filename, "advAirport") == 0)
-    {
-        result->m_definition = _trAirport;
-        result->m_length     = sizeof(_trAirport)/sizeof(Definition);
-        result->m_ambience = airport;
-    }
-    else if (strcmp(filename, "advDesert") == 0)
-    {
-        result->m_definition = _trDesert;
-        result->m_length     = sizeof(_trDesert)/sizeof(Definition);
-        result->m_ambience = desert;
-    }
-    else if (strcmp(filename, "advRush") == 0)
-    {
-        result->m_definition = _trAdvRush;
-        result->m_length     = sizeof(_trAdvRush)/sizeof(Definition);
-    }
-    else if (strcmp(filename, "advEscape") == 0)
-    {
-        result->m_definition = _trAdvEscape;
-        result->m_length     = sizeof(_trAdvEscape)/sizeof(Definition);
-        result->m_weather = wind;
-    }
-    else
-    {
-        result->m_userDefined = true;
-        File file(filename, File::read);
-        // Find out the length
-        result->m_length = 0;
-        while (file.readInt( ) >= 0)
-        {
-            file.readInt( );
-            if (file.readInt( ) < MINPARTLENGTH)
-                file.readInt( );
-            ++result->m_length;
-        }
-        file.rewind( );
-        RACE("Track : reading trackfile, length of track = %d", result->m_length);
-        if (result->m_length == 0)
-        {
-            result->m_length = 1;
-            result->m_definition = new Definition[1];
-            result->m_definition[0].type = (Type)0;
-            result->m_definition[0].surface = (Surface)0;
-            result->m_definition[0].noise = (Noise)0;
-            result->m_definition[0].length = MINPARTLENGTH;
-            result->m_weather  = (Weather)0;
-            result->m_ambience = (Ambience)0;
-        }
-        else
-        {
-            result->m_definition = new Definition[result->m_length];
-            Int temp = 0;
-            for (UInt i = 0; i < result->m_length; ++i)
-            {
-                result->m_definition[i].type    = (Type)file.readInt( );
-                result->m_definition[i].surface = (Surface)file.readInt( );
-                temp = file.readInt( );
-                if (temp < NOISES)
-                {
-                    result->m_definition[i].noise   = (Noise)temp;
-                    result->m_definition[i].length  = file.readInt( );
-                }
-                else
-                {
-                    if (result->m_definition[i].type >= TYPES)
-                    {
-                        result->m_definition[i].noise = (Noise)((result->m_definition[i].type - TYPES) + 1);
-                        result->m_definition[i].type = (Type)0;
-                    }
-                    else
-                    {
-                        result->m_definition[i].noise = (Noise)0;
-                    }
-                    result->m_definition[i].length = temp;
-                }
-                if (result->m_definition[i].type >= TYPES)
-                    result->m_definition[i].type = (Type)0;
-                if (result->m_definition[i].surface >= SURFACES)
-                    result->m_definition[i].surface = (Surface)0;
-                if (result->m_definition[i].noise >= NOISES)
-                    result->m_definition[i].noise = (Noise)0;
-                if (result->m_definition[i].length < MINPARTLENGTH)
-                    result->m_definition[i].length = MINPARTLENGTH;
-            }
-            file.readInt( ); // -1
-            result->m_weather = (Weather)file.readInt( );
-            if (result->m_weather < 0)
-                result->m_weather = (Weather)0;
-            result->m_ambience = (Ambience)file.readInt( );
-            if (result->m_ambience < 0)
-                result->m_ambience = (Ambience)0;
-        }
-        RACE("Track : done reading trackfile");
-    }
+    result->load(filename);
     return result;
 }
 
+
+
 Track::~Track( )
 {
     RACE("(-) Track");
-    if (m_userDefined)
-    {
-        SAFE_DELETE_ARRAY(m_definition);
-    }
     if (m_weather == rain)
 	{
         SAFE_DELETE(m_soundRain);
@@ -636,42 +227,7 @@ void
 Track::initialize( )
 {
     RACE("Track::initialize");
-    // calculate tracklength
-    for (UInt i = 0; i < m_length; ++i)
-    {
-        m_lapDistance += m_definition[i].length;
-        switch (m_definition[i].type)
-        {
-        case straight :
-            break;
-        case easyLeft :
-            m_lapCenter -= m_definition[i].length/2; 
-            break;
-        case left :
-            m_lapCenter -= m_definition[i].length*2/3;
-            break;
-        case hardLeft :
-            m_lapCenter -= m_definition[i].length;
-            break;
-        case hairpinLeft :
-            m_lapCenter -= m_definition[i].length*3/2;
-            break;
-        case easyRight :
-            m_lapCenter += m_definition[i].length/2;
-            break;
-        case right :
-            m_lapCenter += m_definition[i].length*2/3;
-            break;
-        case hardRight :
-            m_lapCenter += m_definition[i].length;
-            break;
-        case hairpinRight :
-            m_lapCenter += m_definition[i].length*3/2;
-            break;
-        default :
-            break;
-        }
-    }
+    buildIndex( );
     if (m_weather == rain)
         m_soundRain->play(0, true);
     else if (m_weather == wind)
@@ -866,205 +422,11 @@ Track::road(Int position)
 {
     UInt lap = (UInt)(position / m_lapDistance);
     UInt pos = position % m_lapDistance;
-    UInt dist = 0;
-    UInt center = lap*m_lapCenter;
-    for (UInt i = 0; i < m_length; ++i)
-    {
-        if ((dist <= pos) && (dist + m_definition[i].length > pos))
-        {
-            m_prevRelPos = m_relPos;
-            m_relPos = pos - dist;
-            m_currentRoad = i;
-            Road road;
-            road.type    = m_definition[i].type;
-            road.surface = m_definition[i].surface;
-                        road.length  = m_definition[i].length;
-            switch (m_definition[i].type)
-            {
-            case straight :
-                road.left  = center - m_laneWidth;
-                road.right = center + m_laneWidth;
-                break;
-            case easyLeft :
-                road.left  = center - m_laneWidth - m_relPos/2;
-                road.right = center + m_laneWidth - m_relPos/2;
-                break;
-            case left :
-                road.left  = center - m_laneWidth - m_relPos*2/3;
-                road.right = center + m_laneWidth - m_relPos*2/3;
-                break;
-            case hardLeft :
-                road.left  = center - m_laneWidth - m_relPos;
-                road.right = center + m_laneWidth - m_relPos;
-                break;
-            case hairpinLeft :
-                road.left  = center - m_laneWidth - m_relPos*3/2;
-                road.right = center + m_laneWidth - m_relPos*3/2;
-                break;
-            case easyRight :
-                road.left  = center - m_laneWidth + m_relPos/2;
-                road.right = center + m_laneWidth + m_relPos/2;
-                break;
-            case right :
-                road.left  = center - m_laneWidth + m_relPos*2/3;
-                road.right = center + m_laneWidth + m_relPos*2/3;
-                break;
-            case hardRight :
-                road.left  = center - m_laneWidth + m_relPos;
-                road.right = center + m_laneWidth + m_relPos;
-                break;
-            case hairpinRight :
-                road.left  = center - m_laneWidth + m_relPos*3/2;
-                road.right = center + m_laneWidth + m_relPos*3/2;
-                break;
-            default :
-                road.left  = center - m_laneWidth;
-                road.right = center + m_laneWidth;
-                break;
-            }
-            
-            return road;
-        }
-        switch (m_definition[i].type)
-        {
-        case straight :
-            break;
-        case easyLeft :
-            center -= m_definition[i].length/2; 
-            break;
-        case left :
-            center -= m_definition[i].length*2/3;
-            break;
-        case hardLeft :
-            center -= m_definition[i].length;
-            break;
-        case hairpinLeft :
-            center -= m_definition[i].length*3/2;
-            break;
-        case easyRight :
-            center += m_definition[i].length/2;
-            break;
-        case right :
-            center += m_definition[i].length*2/3;
-            break;
-        case hardRight :
-            center += m_definition[i].length;
-            break;
-        case hairpinRight :
-            center += m_definition[i].length*3/2;
-            break;
-        default :
-            break;
-        }
-        
-        dist += m_definition[i].length;
-    }
-    // shouldn't arrive here
-    Road road = {0, 0, asphalt, straight, 5000};
-    return road;
-}
-
-
-Track::Road
-Track::roadComputer(Int position)
-{
-    UInt lap = (UInt)(position / m_lapDistance);
-    UInt pos = position % m_lapDistance;
-    UInt dist = 0;
-    UInt center = lap*m_lapCenter;
-    Int relPos = 0;
-    for (UInt i = 0; i < m_length; ++i)
-    {
-        if ((dist <= pos) && (dist + m_definition[i].length > pos))
-        {
-            relPos = pos - dist;
-            Road road;
-            road.type    = m_definition[i].type;
-            road.surface = m_definition[i].surface;
-            road.length  = m_definition[i].length;
-            switch (m_definition[i].type)
-            {
-            case straight :
-                road.left  = center - m_laneWidth;
-                road.right = center + m_laneWidth;
-                break;
-            case easyLeft :
-                road.left  = center - m_laneWidth - relPos/2;
-                road.right = center + m_laneWidth - relPos/2;
-                break;
-            case left :
-                road.left  = center - m_laneWidth - relPos*2/3;
-                road.right = center + m_laneWidth - relPos*2/3;
-                break;
-            case hardLeft :
-                road.left  = center - m_laneWidth - relPos;
-                road.right = center + m_laneWidth - relPos;
-                break;
-            case hairpinLeft :
-                road.left  = center - m_laneWidth - relPos*3/2;
-                road.right = center + m_laneWidth - relPos*3/2;
-                break;
-            case easyRight :
-                road.left  = center - m_laneWidth + relPos/2;
-                road.right = center + m_laneWidth + relPos/2;
-                break;
-            case right :
-                road.left  = center - m_laneWidth + relPos*2/3;
-                road.right = center + m_laneWidth + relPos*2/3;
-                break;
-            case hardRight :
-                road.left  = center - m_laneWidth + relPos;
-                road.right = center + m_laneWidth + relPos;
-                break;
-            case hairpinRight :
-                road.left  = center - m_laneWidth + relPos*3/2;
-                road.right = center + m_laneWidth + relPos*3/2;
-                break;
-            default :
-                road.left  = center - m_laneWidth;
-                road.right = center + m_laneWidth;
-                break;
-            }
-            
-            return road;
-        }
-        switch (m_definition[i].type)
-        {
-        case straight :
-            break;
-        case easyLeft :
-            center -= m_definition[i].length/2; 
-            break;
-        case left :
-            center -= m_definition[i].length*2/3;
-            break;
-        case hardLeft :
-            center -= m_definition[i].length;
-            break;
-        case hairpinLeft :
-            center -= m_definition[i].length*3/2;
-            break;
-        case easyRight :
-            center += m_definition[i].length/2;
-            break;
-        case right :
-            center += m_definition[i].length*2/3;
-            break;
-        case hardRight :
-            center += m_definition[i].length;
-            break;
-        case hairpinRight :
-            center += m_definition[i].length*3/2;
-            break;
-        default :
-            break;
-        }
-        
-        dist += m_definition[i].length;
-    }
-    // shouldn't arrive here
-    Road road = {0, 0, asphalt, straight, 5000};
-    return road;
+    UInt i = segmentAt(pos, m_currentRoad);
+    m_prevRelPos = m_relPos;
+    m_relPos = pos - m_segmentStart[i];
+    m_currentRoad = i;
+    return roadInSegment(i, m_relPos, lap*m_lapCenter + m_segmentCenter[i]);
 }
 
 
@@ -1107,22 +469,6 @@ Track::nextRoad(Road& road, Int position, Int speed)
 }
 
 
-Int
-Track::roadAt(Int position)
-{
-    UInt pos = position % m_lapDistance;
-    UInt dist = 0;
-    for (UInt i = 0; i < m_length; ++i)
-    {
-        if ((dist <= pos) && (dist + m_definition[i].length > pos))
-        {
-            return i;
-        }
-        dist += m_definition[i].length;
-    }
-    return -1;
-}
-
 void
 Track::calculateNoiseLength( )
 {
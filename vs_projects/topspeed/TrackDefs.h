@@ -34,740 +34,740 @@
         owl        = 11
 */
 
-Track::Definition _trAmerica[] =
+TrackGeometry::Definition _trAmerica[] =
 {
-    { Track::straight, Track::asphalt, Track::noNoise,     40000 },
-    { Track::easyLeft,   Track::asphalt, Track::noNoise,     30000 },
-    { Track::left,          Track::asphalt, Track::noNoise,     50000 },
-    { Track::easyLeft,   Track::asphalt, Track::noNoise,     30000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     80000 },
-    { Track::easyLeft,   Track::asphalt, Track::noNoise,     30000 },
-    { Track::left,          Track::asphalt, Track::noNoise,     50000 },
-    { Track::easyLeft,   Track::asphalt, Track::noNoise,     30000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 }
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::left,          TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     80000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::left,          TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 }
 };
 
-Track::Definition _trAustria[] =
+TrackGeometry::Definition _trAustria[] =
 {
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 },
-    { Track::hardLeft,    Track::asphalt, Track::noNoise,     30000 },
-    { Track::hairpinLeft,   Track::asphalt, Track::noNoise,     40000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     20000 },
-    { Track::easyLeft,   Track::asphalt, Track::noNoise,     40000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     50000 },
-    { Track::hardRight,   Track::asphalt, Track::noNoise,     30000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::hairpinLeft,   Track::asphalt, Track::noNoise,     30000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     60000 },
-    { Track::easyRight,  Track::asphalt, Track::noNoise,     20000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     20000 }
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::hardLeft,    TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::hairpinLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     20000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::hardRight,   TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::hairpinLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     60000 },
+    { TrackGeometry::easyRight,  TrackGeometry::asphalt, TrackGeometry::noNoise,     20000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     20000 }
 };
 
-Track::Definition _trBelgium[] = 
+TrackGeometry::Definition _trBelgium[] = 
 {
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 },
-    { Track::easyLeft,   Track::asphalt, Track::noNoise,     30000 },
-    { Track::hardRight,   Track::asphalt, Track::noNoise,     30000 },
-    { Track::straight, Track::asphalt, Track::noNoise,      7000 },
-    { Track::left,          Track::asphalt, Track::noNoise,     30000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::hairpinRight,  Track::asphalt, Track::noNoise,     30000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::easyRight,  Track::asphalt, Track::noNoise,     20000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     20000 },
-    { Track::right,         Track::asphalt, Track::noNoise,     25000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     10000 }
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::hardRight,   TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::noNoise,      7000 },
+    { TrackGeometry::left,          TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::hairpinRight,  TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::easyRight,  TrackGeometry::asphalt, TrackGeometry::noNoise,     20000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     20000 },
+    { TrackGeometry::right,         TrackGeometry::asphalt, TrackGeometry::noNoise,     25000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     10000 }
 };
 
-Track::Definition _trBrazil[] =
+TrackGeometry::Definition _trBrazil[] =
 {
-    { Track::straight,      Track::asphalt, Track::noNoise,     50000 },
-    { Track::hardRight,          Track::asphalt, Track::noNoise,     50000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::right,   Track::asphalt, Track::noNoise,     40000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     50000 },
-    { Track::easyLeft,  Track::asphalt, Track::noNoise,     60000 },
-    { Track::hardRight,         Track::asphalt, Track::noNoise,     40000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     50000 },
-    { Track::left,  Track::asphalt, Track::noNoise,     40000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 }
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::hardRight,          TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::right,   TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::easyLeft,  TrackGeometry::asphalt, TrackGeometry::noNoise,     60000 },
+    { TrackGeometry::hardRight,         TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::left,  TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 }
 };
 
-Track::Definition _trChina[] =
+TrackGeometry::Definition _trChina[] =
 {
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 },
-    { Track::right,         Track::asphalt, Track::noNoise,     40000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 },
-    { Track::left,      Track::asphalt, Track::noNoise,     50000 },
-    { Track::easyRight,   Track::asphalt, Track::noNoise,     60000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 },
-    { Track::hardLeft,      Track::asphalt, Track::noNoise,     50000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::hardLeft,          Track::asphalt, Track::noNoise,     40000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     50000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::right,         TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::left,      TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::easyRight,   TrackGeometry::asphalt, TrackGeometry::noNoise,     60000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::hardLeft,      TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::hardLeft,          TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
 };
 
-Track::Definition _trEngland[] =
+TrackGeometry::Definition _trEngland[] =
 {
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::left,          Track::asphalt, Track::noNoise,     30000 },
-    { Track::easyLeft,   Track::asphalt, Track::noNoise,     40000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::hairpinRight,  Track::asphalt, Track::noNoise,     28000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::right,         Track::asphalt, Track::noNoise,     40000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     50000 },
-    { Track::easyRight,  Track::asphalt, Track::noNoise,     40000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 },
-    { Track::left,          Track::asphalt, Track::noNoise,     50000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 }
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::left,          TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::hairpinRight,  TrackGeometry::asphalt, TrackGeometry::noNoise,     28000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::right,         TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::easyRight,  TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::left,          TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 }
 };
 
-Track::Definition _trFinland[] =
+TrackGeometry::Definition _trFinland[] =
 {
-    { Track::straight,      Track::asphalt, Track::noNoise,     50000 },
-    { Track::hairpinLeft,         Track::asphalt, Track::noNoise,     40000 },
-    { Track::right,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::hardRight,   Track::asphalt, Track::noNoise,     60000 },
-    { Track::easyLeft,      Track::asphalt, Track::noNoise,     30000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     20000 },
-    { Track::right,         Track::asphalt, Track::noNoise,     40000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 },
-    { Track::left,          Track::asphalt, Track::noNoise,     50000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::hairpinLeft,         TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::right,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::hardRight,   TrackGeometry::asphalt, TrackGeometry::noNoise,     60000 },
+    { TrackGeometry::easyLeft,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     20000 },
+    { TrackGeometry::right,         TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::left,          TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
 };
 
-Track::Definition _trFrance[] = 
+TrackGeometry::Definition _trFrance[] = 
 {
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::easyRight,  Track::asphalt, Track::noNoise,     40000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     20000 },
-    { Track::right,         Track::asphalt, Track::noNoise,     30000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::hairpinLeft,   Track::asphalt, Track::noNoise,     60000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::hardLeft,    Track::asphalt, Track::noNoise,     40000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 },
-    { Track::right,        Track::asphalt, Track::noNoise,     30000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::easyLeft,   Track::asphalt, Track::noNoise,     30000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 }
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::easyRight,  TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     20000 },
+    { TrackGeometry::right,         TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::hairpinLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     60000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::hardLeft,    TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::right,        TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 }
 };
 
-Track::Definition _trGermany[] =
+TrackGeometry::Definition _trGermany[] =
 {
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::right,         Track::asphalt, Track::noNoise,     40000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     20000 },
-    { Track::easyLeft,   Track::asphalt, Track::noNoise,     40000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 },
-    { Track::right,         Track::asphalt, Track::noNoise,     30000 },
-    { Track::left,          Track::asphalt, Track::noNoise,     30000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     50000 },
-    { Track::easyLeft,   Track::asphalt, Track::noNoise,     20000 },
-    { Track::hardLeft,    Track::asphalt, Track::noNoise,     30000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 }
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::right,         TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     20000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::right,         TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::left,          TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     20000 },
+    { TrackGeometry::hardLeft,    TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 }
 };
 
-Track::Definition _trIreland[] = 
+TrackGeometry::Definition _trIreland[] = 
 {
-    { Track::straight,      Track::asphalt, Track::noNoise,     70000 },
-    { Track::right,         Track::asphalt, Track::noNoise,     50000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     50000 },
-    { Track::easyLeft,   Track::asphalt, Track::noNoise,     30000 },    
-    { Track::straight,      Track::asphalt, Track::noNoise,     20000 },
-    { Track::hardRight,   Track::asphalt, Track::noNoise,     40000 },
-    { Track::easyLeft,   Track::asphalt, Track::noNoise,     20000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     20000 },
-    { Track::right,         Track::asphalt, Track::noNoise,     50000 },
-    { Track::left,          Track::asphalt, Track::noNoise,     30000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     10000 }
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     70000 },
+    { TrackGeometry::right,         TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },    
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     20000 },
+    { TrackGeometry::hardRight,   TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     20000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     20000 },
+    { TrackGeometry::right,         TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::left,          TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     10000 }
 };
 
-Track::Definition _trItaly[] =
+TrackGeometry::Definition _trItaly[] =
 {
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::easyLeft,   Track::asphalt, Track::noNoise,     25000 },
-    { Track::easyRight,  Track::asphalt, Track::noNoise,     25000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     50000 },
-    { Track::hardLeft,    Track::asphalt, Track::noNoise,     30000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     20000 },
-    { Track::hardRight,   Track::asphalt, Track::noNoise,     30000 },
-    { Track::left,          Track::asphalt, Track::noNoise,     30000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::right,         Track::asphalt, Track::noNoise,     30000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::right,         Track::asphalt, Track::noNoise,     70000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 }
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     25000 },
+    { TrackGeometry::easyRight,  TrackGeometry::asphalt, TrackGeometry::noNoise,     25000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::hardLeft,    TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     20000 },
+    { TrackGeometry::hardRight,   TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::left,          TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::right,         TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::right,         TrackGeometry::asphalt, TrackGeometry::noNoise,     70000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 }
 };
 
-Track::Definition _trNetherlands[] =
+TrackGeometry::Definition _trNetherlands[] =
 {
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::left,          Track::asphalt, Track::noNoise,     20000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,      6000 },
-    { Track::easyLeft,   Track::asphalt, Track::noNoise,     20000 },
-    { Track::right,         Track::asphalt, Track::noNoise,     30000 },
-    { Track::easyLeft,   Track::asphalt, Track::noNoise,     25000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     20000 },
-    { Track::left,          Track::asphalt, Track::noNoise,     50000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 },
-    { Track::easyRight,  Track::asphalt, Track::noNoise,     18000 },
-    { Track::hardLeft,    Track::asphalt, Track::noNoise,     20000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     18000 }
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::left,          TrackGeometry::asphalt, TrackGeometry::noNoise,     20000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,      6000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     20000 },
+    { TrackGeometry::right,         TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     25000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     20000 },
+    { TrackGeometry::left,          TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::easyRight,  TrackGeometry::asphalt, TrackGeometry::noNoise,     18000 },
+    { TrackGeometry::hardLeft,    TrackGeometry::asphalt, TrackGeometry::noNoise,     20000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     18000 }
 };
 
-Track::Definition _trPortugal[] =
+TrackGeometry::Definition _trPortugal[] =
 {
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 },
-    { Track::easyLeft,   Track::asphalt, Track::noNoise,     40000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 },
-    { Track::right,         Track::asphalt, Track::noNoise,     30000 },
-    { Track::hardRight,   Track::asphalt, Track::noNoise,     40000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 },
-    { Track::easyLeft,   Track::asphalt, Track::noNoise,     50000 },
-    { Track::left,          Track::asphalt, Track::noNoise,     60000 },
-    { Track::easyRight,  Track::asphalt, Track::noNoise,     50000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     20000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::right,         TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::hardRight,   TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::left,          TrackGeometry::asphalt, TrackGeometry::noNoise,     60000 },
+    { TrackGeometry::easyRight,  TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     20000 },
 };
 
-Track::Definition _trRussia[] =
+TrackGeometry::Definition _trRussia[] =
 {
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::easyRight,         Track::asphalt, Track::noNoise,     40000 },
-    { Track::left,      Track::asphalt, Track::noNoise,     30000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 },
-    { Track::hardRight,   Track::asphalt, Track::noNoise,     50000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 },
-    { Track::easyRight,      Track::asphalt, Track::noNoise,     50000 },
-    { Track::left,         Track::asphalt, Track::noNoise,     40000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 },
-    { Track::easyLeft,          Track::asphalt, Track::noNoise,     40000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::easyRight,         TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::left,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::hardRight,   TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::easyRight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::left,         TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::easyLeft,          TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
 };
 
-Track::Definition _trSpain[] =
+TrackGeometry::Definition _trSpain[] =
 {
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::hardLeft,    Track::asphalt, Track::noNoise,     30000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::easyLeft,   Track::asphalt, Track::noNoise,     30000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 },
-    { Track::right,         Track::asphalt, Track::noNoise,     40000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     70000 },
-    { Track::left,          Track::asphalt, Track::noNoise,     40000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     50000 },
-    { Track::easyLeft,   Track::asphalt, Track::noNoise,     40000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::left,          Track::asphalt, Track::noNoise,     30000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     20000 }
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::hardLeft,    TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::right,         TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     70000 },
+    { TrackGeometry::left,          TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::left,          TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     20000 }
 };
 
-Track::Definition _trSweden[] =
+TrackGeometry::Definition _trSweden[] =
 {
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 },
-    { Track::hardRight,   Track::asphalt, Track::noNoise,     50000 },
-    { Track::hardLeft,   Track::asphalt, Track::noNoise,     50000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::left,         Track::asphalt, Track::noNoise,     40000 },
-    { Track::easyLeft,      Track::asphalt, Track::noNoise,     50000 },
-    { Track::easyRight,   Track::asphalt, Track::noNoise,     40000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 },
-    { Track::right,   Track::asphalt, Track::noNoise,     40000 },
-    { Track::easyRight,      Track::asphalt, Track::noNoise,     50000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::hardRight,   TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::hardLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::left,         TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::easyLeft,      TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::easyRight,   TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::right,   TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::easyRight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     50000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
 };
 
-Track::Definition _trSwitserland[] =
+TrackGeometry::Definition _trSwitserland[] =
 {
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::hairpinRight,   Track::asphalt, Track::noNoise,     31000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 },
-    { Track::right,         Track::asphalt, Track::noNoise,     30000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 },
-    { Track::hardLeft,   Track::asphalt, Track::noNoise,     40000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     20000 },
-    { Track::easyLeft,   Track::asphalt, Track::noNoise,     39000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     20000 },
-    { Track::hardRight,          Track::asphalt, Track::noNoise,     40000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     20000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::hairpinRight,   TrackGeometry::asphalt, TrackGeometry::noNoise,     31000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::right,         TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::hardLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     20000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     39000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     20000 },
+    { TrackGeometry::hardRight,          TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     20000 },
 };
 
-Track::Definition _trAdvHills[] =
+TrackGeometry::Definition _trAdvHills[] =
 {
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::left,          Track::gravel, Track::noNoise,      15000 },
-    { Track::straight,      Track::gravel, Track::noNoise,      25000 },
-    { Track::easyLeft,   Track::gravel, Track::noNoise,      15000 },
-    { Track::straight,      Track::gravel, Track::noNoise,      28000 },
-    { Track::right,         Track::gravel, Track::noNoise,      22000 },
-    { Track::easyLeft,   Track::gravel, Track::noNoise,      15000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     15000 },
-    { Track::left,          Track::asphalt, Track::noNoise,     25000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     19000 },
-    { Track::easyRight,  Track::gravel, Track::noNoise,      17000 },
-    { Track::right,         Track::gravel, Track::noNoise,      17000 },
-    { Track::straight,      Track::gravel, Track::noNoise,      15000 },
-    { Track::easyLeft,   Track::gravel, Track::noNoise,      15000 },
-    { Track::left,          Track::gravel, Track::noNoise,      10000 },
-    { Track::hardLeft,    Track::gravel, Track::noNoise,      10000 },
-    { Track::straight, Track::gravel, Track::crowd,      40000 },
-    { Track::easyRight,  Track::gravel, Track::noNoise,      10000 },
-    { Track::straight,      Track::snow, Track::noNoise,     45000 },
-    { Track::easyRight,  Track::snow, Track::noNoise,     17500 },
-    { Track::straight,      Track::snow, Track::noNoise,      9500 },
-    { Track::easyLeft,   Track::snow, Track::noNoise,       9000 },
-    { Track::right,         Track::gravel, Track::noNoise,      15000 },
-    { Track::straight,      Track::gravel, Track::noNoise,      10000 },
-    { Track::easyLeft,   Track::gravel, Track::noNoise,      15000 },
-    { Track::straight,      Track::gravel, Track::noNoise,       6000 },
-    { Track::easyRight,  Track::gravel, Track::noNoise,      15000 },
-    { Track::left,          Track::gravel, Track::noNoise,      15000 },
-    { Track::straight,      Track::gravel, Track::noNoise,      11000 },
-    { Track::easyLeft,   Track::gravel, Track::noNoise,      30000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     20000 },
-    { Track::straight, Track::asphalt, Track::crowd,     40000 },
-    { Track::easyRight,  Track::asphalt, Track::noNoise,     20000 },
-    { Track::right,         Track::gravel, Track::noNoise,      20000 },
-    { Track::straight,      Track::gravel, Track::noNoise,      15000 },
-    { Track::easyLeft,   Track::gravel, Track::noNoise,      20000 },
-    { Track::straight,      Track::gravel, Track::noNoise,      20000 },
-    { Track::left,          Track::gravel, Track::noNoise,      15000 },
-    { Track::easyRight,  Track::gravel, Track::noNoise,      15000 },
-    { Track::straight,      Track::gravel, Track::noNoise,      10000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     30000 },
-    { Track::right,         Track::asphalt, Track::noNoise,     15000 },
-    { Track::straight, Track::asphalt, Track::crowd,     40000 }
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::left,          TrackGeometry::gravel, TrackGeometry::noNoise,      15000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::noNoise,      25000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::gravel, TrackGeometry::noNoise,      15000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::noNoise,      28000 },
+    { TrackGeometry::right,         TrackGeometry::gravel, TrackGeometry::noNoise,      22000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::gravel, TrackGeometry::noNoise,      15000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     15000 },
+    { TrackGeometry::left,          TrackGeometry::asphalt, TrackGeometry::noNoise,     25000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     19000 },
+    { TrackGeometry::easyRight,  TrackGeometry::gravel, TrackGeometry::noNoise,      17000 },
+    { TrackGeometry::right,         TrackGeometry::gravel, TrackGeometry::noNoise,      17000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::noNoise,      15000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::gravel, TrackGeometry::noNoise,      15000 },
+    { TrackGeometry::left,          TrackGeometry::gravel, TrackGeometry::noNoise,      10000 },
+    { TrackGeometry::hardLeft,    TrackGeometry::gravel, TrackGeometry::noNoise,      10000 },
+    { TrackGeometry::straight, TrackGeometry::gravel, TrackGeometry::crowd,      40000 },
+    { TrackGeometry::easyRight,  TrackGeometry::gravel, TrackGeometry::noNoise,      10000 },
+    { TrackGeometry::straight,      TrackGeometry::snow, TrackGeometry::noNoise,     45000 },
+    { TrackGeometry::easyRight,  TrackGeometry::snow, TrackGeometry::noNoise,     17500 },
+    { TrackGeometry::straight,      TrackGeometry::snow, TrackGeometry::noNoise,      9500 },
+    { TrackGeometry::easyLeft,   TrackGeometry::snow, TrackGeometry::noNoise,       9000 },
+    { TrackGeometry::right,         TrackGeometry::gravel, TrackGeometry::noNoise,      15000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::noNoise,      10000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::gravel, TrackGeometry::noNoise,      15000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::noNoise,       6000 },
+    { TrackGeometry::easyRight,  TrackGeometry::gravel, TrackGeometry::noNoise,      15000 },
+    { TrackGeometry::left,          TrackGeometry::gravel, TrackGeometry::noNoise,      15000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::noNoise,      11000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::gravel, TrackGeometry::noNoise,      30000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     20000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::crowd,     40000 },
+    { TrackGeometry::easyRight,  TrackGeometry::asphalt, TrackGeometry::noNoise,     20000 },
+    { TrackGeometry::right,         TrackGeometry::gravel, TrackGeometry::noNoise,      20000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::noNoise,      15000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::gravel, TrackGeometry::noNoise,      20000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::noNoise,      20000 },
+    { TrackGeometry::left,          TrackGeometry::gravel, TrackGeometry::noNoise,      15000 },
+    { TrackGeometry::easyRight,  TrackGeometry::gravel, TrackGeometry::noNoise,      15000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::noNoise,      10000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::right,         TrackGeometry::asphalt, TrackGeometry::noNoise,     15000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::crowd,     40000 }
 };
 
-Track::Definition _trAdvCoast[] =
+TrackGeometry::Definition _trAdvCoast[] =
 {
-    { Track::straight,      Track::asphalt, Track::ocean,     40000 },
-    { Track::easyRight,  Track::asphalt, Track::ocean,     25000 },
-    { Track::left,          Track::asphalt, Track::ocean,     30000 },
-    { Track::straight,      Track::gravel, Track::ocean,      19000 },
-    { Track::left,          Track::gravel, Track::noNoise,      25000 },
-    { Track::easyRight,  Track::gravel, Track::noNoise,      38000 },
-    { Track::straight,      Track::gravel, Track::noNoise,      19000 },
-    { Track::left,          Track::gravel, Track::noNoise,      19000 },
-    { Track::straight,      Track::gravel, Track::noNoise,      22000 },
-    { Track::straight,      Track::sand, Track::ocean,     21000 },
-    { Track::left,          Track::sand, Track::ocean,     19000 },
-    { Track::easyLeft,   Track::sand, Track::ocean,     20000 },
-    { Track::straight, Track::sand, Track::ocean,     57000 },
-    { Track::easyRight,  Track::sand, Track::ocean,      19000 },
-    { Track::right,         Track::gravel, Track::noNoise,      16000 },
-    { Track::left,          Track::gravel, Track::noNoise,      22000 },
-    { Track::straight,      Track::gravel, Track::ocean,      35000 },
-    { Track::right,         Track::gravel, Track::noNoise,      15000 },
-    { Track::easyLeft,   Track::sand, Track::noNoise,     22000 },
-    { Track::left,          Track::sand, Track::noNoise,     21000 },
-    { Track::easyRight,  Track::sand, Track::noNoise,     13000 },
-    { Track::hardLeft,    Track::sand, Track::noNoise,     15000 },
-    { Track::straight,      Track::gravel, Track::ocean,     32000 },
-    { Track::easyLeft,   Track::gravel, Track::noNoise,      19000 },
-    { Track::straight,      Track::gravel, Track::noNoise,      12000 },
-    { Track::easyRight,  Track::gravel, Track::noNoise,      19000 },
-    { Track::straight,      Track::gravel, Track::noNoise,      19000 },
-    { Track::easyLeft,   Track::gravel, Track::noNoise,      14000 },
-    { Track::easyRight,  Track::gravel, Track::noNoise,      30000 },
-    { Track::straight, Track::water, Track::ocean,     60000 },
-    { Track::right,         Track::sand, Track::noNoise,     30000 },
-    { Track::straight,      Track::sand, Track::noNoise,     20000 },
-    { Track::easyLeft,   Track::sand, Track::noNoise,     30000 },
-    { Track::straight,      Track::sand, Track::noNoise,     15000 },
-    { Track::right,         Track::sand, Track::noNoise,     20000 },
-    { Track::straight,      Track::gravel, Track::noNoise,      20000 },
-    { Track::right,         Track::gravel, Track::noNoise,      15000 },
-    { Track::easyRight,  Track::gravel, Track::noNoise,      15000 },
-    { Track::straight, Track::gravel, Track::noNoise,      42000 },
-    { Track::easyLeft,   Track::gravel, Track::noNoise,      30000 },
-    { Track::straight,      Track::asphalt, Track::ocean,     50000 }
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::ocean,     40000 },
+    { TrackGeometry::easyRight,  TrackGeometry::asphalt, TrackGeometry::ocean,     25000 },
+    { TrackGeometry::left,          TrackGeometry::asphalt, TrackGeometry::ocean,     30000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::ocean,      19000 },
+    { TrackGeometry::left,          TrackGeometry::gravel, TrackGeometry::noNoise,      25000 },
+    { TrackGeometry::easyRight,  TrackGeometry::gravel, TrackGeometry::noNoise,      38000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::noNoise,      19000 },
+    { TrackGeometry::left,          TrackGeometry::gravel, TrackGeometry::noNoise,      19000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::noNoise,      22000 },
+    { TrackGeometry::straight,      TrackGeometry::sand, TrackGeometry::ocean,     21000 },
+    { TrackGeometry::left,          TrackGeometry::sand, TrackGeometry::ocean,     19000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::sand, TrackGeometry::ocean,     20000 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::ocean,     57000 },
+    { TrackGeometry::easyRight,  TrackGeometry::sand, TrackGeometry::ocean,      19000 },
+    { TrackGeometry::right,         TrackGeometry::gravel, TrackGeometry::noNoise,      16000 },
+    { TrackGeometry::left,          TrackGeometry::gravel, TrackGeometry::noNoise,      22000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::ocean,      35000 },
+    { TrackGeometry::right,         TrackGeometry::gravel, TrackGeometry::noNoise,      15000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::sand, TrackGeometry::noNoise,     22000 },
+    { TrackGeometry::left,          TrackGeometry::sand, TrackGeometry::noNoise,     21000 },
+    { TrackGeometry::easyRight,  TrackGeometry::sand, TrackGeometry::noNoise,     13000 },
+    { TrackGeometry::hardLeft,    TrackGeometry::sand, TrackGeometry::noNoise,     15000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::ocean,     32000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::gravel, TrackGeometry::noNoise,      19000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::noNoise,      12000 },
+    { TrackGeometry::easyRight,  TrackGeometry::gravel, TrackGeometry::noNoise,      19000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::noNoise,      19000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::gravel, TrackGeometry::noNoise,      14000 },
+    { TrackGeometry::easyRight,  TrackGeometry::gravel, TrackGeometry::noNoise,      30000 },
+    { TrackGeometry::straight, TrackGeometry::water, TrackGeometry::ocean,     60000 },
+    { TrackGeometry::right,         TrackGeometry::sand, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::straight,      TrackGeometry::sand, TrackGeometry::noNoise,     20000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::sand, TrackGeometry::noNoise,     30000 },
+    { TrackGeometry::straight,      TrackGeometry::sand, TrackGeometry::noNoise,     15000 },
+    { TrackGeometry::right,         TrackGeometry::sand, TrackGeometry::noNoise,     20000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::noNoise,      20000 },
+    { TrackGeometry::right,         TrackGeometry::gravel, TrackGeometry::noNoise,      15000 },
+    { TrackGeometry::easyRight,  TrackGeometry::gravel, TrackGeometry::noNoise,      15000 },
+    { TrackGeometry::straight, TrackGeometry::gravel, TrackGeometry::noNoise,      42000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::gravel, TrackGeometry::noNoise,      30000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::ocean,     50000 }
 };
 
-Track::Definition _trAdvCountry[] =
+TrackGeometry::Definition _trAdvCountry[] =
 {
-    { Track::straight,      Track::asphalt, Track::noNoise,     25000 },
-    { Track::hardLeft,    Track::asphalt, Track::noNoise,     25000 },
-    { Track::straight,      Track::gravel, Track::noNoise,      35000 },
-    { Track::right,         Track::gravel, Track::noNoise,      25000 },
-    { Track::straight,      Track::gravel, Track::noNoise,      35000 },
-    { Track::easyRight,  Track::gravel, Track::noNoise,      30000 },
-    { Track::straight,      Track::gravel, Track::river,      61000 },
-    { Track::hardLeft,    Track::gravel, Track::noNoise,      17000 },
-    { Track::straight,      Track::gravel, Track::noNoise,      25000 },
-    { Track::left,          Track::gravel, Track::noNoise,      20000 },
-    { Track::straight,      Track::water, Track::thunder,       31000 },
-    { Track::straight,      Track::gravel, Track::noNoise,      28000 },
-    { Track::right,         Track::gravel, Track::noNoise,      21000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     35000 },
-    { Track::easyLeft,      Track::asphalt, Track::noNoise,     16000 },
-    { Track::straight,      Track::water, Track::noNoise,       25000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     27000 },
-    { Track::right,         Track::asphalt, Track::noNoise,     22000 },
-    { Track::straight,      Track::gravel, Track::noNoise,      28000 },
-    { Track::easyRight,     Track::gravel, Track::noNoise,      13000 },
-    { Track::hairpinRight,  Track::gravel, Track::river,      21000 },
-    { Track::straight, Track::water, Track::river,       48000 },
-    { Track::left,          Track::gravel, Track::noNoise,      15000 },
-    { Track::right,         Track::gravel, Track::noNoise,      12000 },
-    { Track::straight,   Track::gravel, Track::thunder,      12000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     32000 },
-    { Track::left,          Track::asphalt, Track::noNoise,     15000 },
-    { Track::easyRight,     Track::asphalt, Track::noNoise,     18000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     24000 },
-    { Track::easyRight,     Track::water, Track::noNoise,       30000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     20000 },
-    { Track::hardRight,     Track::asphalt, Track::noNoise,     14000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     15000 },
-    { Track::easyLeft,      Track::asphalt, Track::noNoise,     15000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     12000 },
-    { Track::hairpinLeft,   Track::asphalt, Track::noNoise,     15000 },
-    { Track::straight, Track::gravel, Track::noNoise,      35000 },
-    { Track::right,         Track::gravel, Track::thunder,      21000 },
-    { Track::straight,      Track::gravel, Track::river,     70000 }
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     25000 },
+    { TrackGeometry::hardLeft,    TrackGeometry::asphalt, TrackGeometry::noNoise,     25000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::noNoise,      35000 },
+    { TrackGeometry::right,         TrackGeometry::gravel, TrackGeometry::noNoise,      25000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::noNoise,      35000 },
+    { TrackGeometry::easyRight,  TrackGeometry::gravel, TrackGeometry::noNoise,      30000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::river,      61000 },
+    { TrackGeometry::hardLeft,    TrackGeometry::gravel, TrackGeometry::noNoise,      17000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::noNoise,      25000 },
+    { TrackGeometry::left,          TrackGeometry::gravel, TrackGeometry::noNoise,      20000 },
+    { TrackGeometry::straight,      TrackGeometry::water, TrackGeometry::thunder,       31000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::noNoise,      28000 },
+    { TrackGeometry::right,         TrackGeometry::gravel, TrackGeometry::noNoise,      21000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     35000 },
+    { TrackGeometry::easyLeft,      TrackGeometry::asphalt, TrackGeometry::noNoise,     16000 },
+    { TrackGeometry::straight,      TrackGeometry::water, TrackGeometry::noNoise,       25000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     27000 },
+    { TrackGeometry::right,         TrackGeometry::asphalt, TrackGeometry::noNoise,     22000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::noNoise,      28000 },
+    { TrackGeometry::easyRight,     TrackGeometry::gravel, TrackGeometry::noNoise,      13000 },
+    { TrackGeometry::hairpinRight,  TrackGeometry::gravel, TrackGeometry::river,      21000 },
+    { TrackGeometry::straight, TrackGeometry::water, TrackGeometry::river,       48000 },
+    { TrackGeometry::left,          TrackGeometry::gravel, TrackGeometry::noNoise,      15000 },
+    { TrackGeometry::right,         TrackGeometry::gravel, TrackGeometry::noNoise,      12000 },
+    { TrackGeometry::straight,   TrackGeometry::gravel, TrackGeometry::thunder,      12000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     32000 },
+    { TrackGeometry::left,          TrackGeometry::asphalt, TrackGeometry::noNoise,     15000 },
+    { TrackGeometry::easyRight,     TrackGeometry::asphalt, TrackGeometry::noNoise,     18000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     24000 },
+    { TrackGeometry::easyRight,     TrackGeometry::water, TrackGeometry::noNoise,       30000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     20000 },
+    { TrackGeometry::hardRight,     TrackGeometry::asphalt, TrackGeometry::noNoise,     14000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     15000 },
+    { TrackGeometry::easyLeft,      TrackGeometry::asphalt, TrackGeometry::noNoise,     15000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     12000 },
+    { TrackGeometry::hairpinLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     15000 },
+    { TrackGeometry::straight, TrackGeometry::gravel, TrackGeometry::noNoise,      35000 },
+    { TrackGeometry::right,         TrackGeometry::gravel, TrackGeometry::thunder,      21000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::river,     70000 }
 };
 
-Track::Definition _trAirport[] =
+TrackGeometry::Definition _trAirport[] =
 {
-    { Track::straight,      Track::asphalt, Track::noNoise,     22000 },
-    { Track::hardRight,   Track::asphalt, Track::noNoise,     26000 },
-    { Track::straight,      Track::gravel, Track::noNoise,      16000 },
-    { Track::easyLeft,   Track::gravel, Track::noNoise,      23000 },
-    { Track::straight,      Track::gravel, Track::noNoise,      26000 },
-    { Track::left,          Track::gravel, Track::noNoise,      28000 },
-    { Track::easyRight,  Track::gravel, Track::noNoise,      17000 },
-    { Track::straight,Track::asphalt, Track::runway,      6000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     46000 },
-    { Track::right,         Track::asphalt, Track::noNoise,     21000 },
-    { Track::left,          Track::asphalt, Track::noNoise,     18000 },
-    { Track::easyLeft,   Track::asphalt, Track::noNoise,     16000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     27000 },
-    { Track::easyLeft,   Track::asphalt, Track::noNoise,     16000 },
-    { Track::hardRight,   Track::asphalt, Track::noNoise,     12000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     28000 },
-    { Track::right,         Track::asphalt, Track::noNoise,     27000 },
-    { Track::straight,Track::asphalt, Track::jet,      6000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     36000 },
-    { Track::left,          Track::asphalt, Track::noNoise,     19000 },
-    { Track::easyLeft,   Track::asphalt, Track::noNoise,     11000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,      7000 },
-    { Track::hardRight,   Track::asphalt, Track::helicopter,     13000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     18000 },
-    { Track::easyRight,  Track::asphalt, Track::noNoise,     17000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,      6000 },
-    { Track::left,          Track::asphalt, Track::noNoise,     12000 },
-    { Track::hairpinRight,  Track::asphalt, Track::noNoise,     11000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     17000 },
-    { Track::easyLeft,   Track::asphalt, Track::noNoise,     21000 },
-    { Track::straight,Track::asphalt, Track::jet,      6000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 },
-    { Track::easyRight,  Track::asphalt, Track::noNoise,     17000 },
-    { Track::straight,      Track::gravel, Track::noNoise,      24000 },
-    { Track::easyLeft,   Track::gravel, Track::noNoise,      17000 },
-    { Track::straight,      Track::gravel, Track::noNoise,      17000 },
-    { Track::left,          Track::gravel, Track::noNoise,      17000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     21000 },
-    { Track::right,         Track::asphalt, Track::noNoise,     16000 },
-    { Track::easyLeft,   Track::asphalt, Track::noNoise,     12000 },
-    { Track::straight,      Track::asphalt, Track::helicopter,     30000 },
-    { Track::easyRight,  Track::asphalt, Track::noNoise,     16000 },
-    { Track::straight,      Track::asphalt, Track::noNoise,     40000 }
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     22000 },
+    { TrackGeometry::hardRight,   TrackGeometry::asphalt, TrackGeometry::noNoise,     26000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::noNoise,      16000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::gravel, TrackGeometry::noNoise,      23000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::noNoise,      26000 },
+    { TrackGeometry::left,          TrackGeometry::gravel, TrackGeometry::noNoise,      28000 },
+    { TrackGeometry::easyRight,  TrackGeometry::gravel, TrackGeometry::noNoise,      17000 },
+    { TrackGeometry::straight,TrackGeometry::asphalt, TrackGeometry::runway,      6000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     46000 },
+    { TrackGeometry::right,         TrackGeometry::asphalt, TrackGeometry::noNoise,     21000 },
+    { TrackGeometry::left,          TrackGeometry::asphalt, TrackGeometry::noNoise,     18000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     16000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     27000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     16000 },
+    { TrackGeometry::hardRight,   TrackGeometry::asphalt, TrackGeometry::noNoise,     12000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     28000 },
+    { TrackGeometry::right,         TrackGeometry::asphalt, TrackGeometry::noNoise,     27000 },
+    { TrackGeometry::straight,TrackGeometry::asphalt, TrackGeometry::jet,      6000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     36000 },
+    { TrackGeometry::left,          TrackGeometry::asphalt, TrackGeometry::noNoise,     19000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     11000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,      7000 },
+    { TrackGeometry::hardRight,   TrackGeometry::asphalt, TrackGeometry::helicopter,     13000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     18000 },
+    { TrackGeometry::easyRight,  TrackGeometry::asphalt, TrackGeometry::noNoise,     17000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,      6000 },
+    { TrackGeometry::left,          TrackGeometry::asphalt, TrackGeometry::noNoise,     12000 },
+    { TrackGeometry::hairpinRight,  TrackGeometry::asphalt, TrackGeometry::noNoise,     11000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     17000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     21000 },
+    { TrackGeometry::straight,TrackGeometry::asphalt, TrackGeometry::jet,      6000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 },
+    { TrackGeometry::easyRight,  TrackGeometry::asphalt, TrackGeometry::noNoise,     17000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::noNoise,      24000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::gravel, TrackGeometry::noNoise,      17000 },
+    { TrackGeometry::straight,      TrackGeometry::gravel, TrackGeometry::noNoise,      17000 },
+    { TrackGeometry::left,          TrackGeometry::gravel, TrackGeometry::noNoise,      17000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     21000 },
+    { TrackGeometry::right,         TrackGeometry::asphalt, TrackGeometry::noNoise,     16000 },
+    { TrackGeometry::easyLeft,   TrackGeometry::asphalt, TrackGeometry::noNoise,     12000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::helicopter,     30000 },
+    { TrackGeometry::easyRight,  TrackGeometry::asphalt, TrackGeometry::noNoise,     16000 },
+    { TrackGeometry::straight,      TrackGeometry::asphalt, TrackGeometry::noNoise,     40000 }
 };
 
-Track::Definition _trDesert[] =
+TrackGeometry::Definition _trDesert[] =
 {
-    { Track::straight, Track::sand, Track::crowd, 150000 },
-    { Track::easyLeft, Track::sand, Track::noNoise, 20000 },
-    { Track::hardRight, Track::sand, Track::noNoise, 40000 },
-    { Track::hardLeft, Track::sand, Track::noNoise, 30000 },
-    { Track::hairpinLeft, Track::sand, Track::noNoise, 90000 },
-    { Track::straight, Track::sand, Track::noNoise, 100000 },
-    { Track::hardRight, Track::sand, Track::owl, 20000 },
-    { Track::straight, Track::sand, Track::noNoise, 40000 },
-    { Track::easyRight, Track::sand, Track::noNoise, 19000 },
-    { Track::hardRight, Track::sand, Track::noNoise, 11111 },
-    { Track::hardLeft, Track::sand, Track::noNoise, 40000 },
-    { Track::easyLeft, Track::sand, Track::noNoise, 9000 },
-    { Track::easyRight, Track::sand, Track::noNoise, 70000 },
-    { Track::straight, Track::sand, Track::noNoise, 8000 },
-    { Track::easyRight, Track::sand, Track::noNoise, 40000 },
-    { Track::straight, Track::sand, Track::noNoise, 40000 },
-    { Track::hardLeft, Track::sand, Track::owl, 10000 },
-    { Track::easyLeft, Track::sand, Track::noNoise, 80000 },
-    { Track::easyRight, Track::sand, Track::noNoise, 75000 },
-    { Track::straight, Track::sand, Track::noNoise, 125000 },
-    { Track::easyLeft, Track::sand, Track::noNoise, 10000 },
-    { Track::straight, Track::sand, Track::noNoise, 18000 },
-    { Track::straight, Track::sand, Track::jet, 5000 },
-    { Track::straight, Track::sand, Track::noNoise, 40000 },
-    { Track::hairpinRight, Track::sand, Track::noNoise, 46000 },
-    { Track::easyRight, Track::sand, Track::owl, 12345 },
-    { Track::straight, Track::sand, Track::noNoise, 10000 },
-    { Track::hairpinRight, Track::sand, Track::noNoise, 40000 },
-    { Track::hairpinLeft, Track::sand, Track::noNoise, 77777 },
-    { Track::easyRight, Track::sand, Track::noNoise, 54321 },
-    { Track::straight, Track::sand, Track::noNoise, 99999 },
-    { Track::hairpinRight, Track::sand, Track::owl, 6000 },
-    { Track::hardRight, Track::sand, Track::noNoise, 40000 },
-    { Track::right, Track::sand, Track::noNoise, 40000 },
-    { Track::easyRight, Track::sand, Track::noNoise, 10000 },
-    { Track::easyLeft, Track::sand, Track::noNoise, 30000 },
-    { Track::straight, Track::sand, Track::noNoise, 200000 },
-    { Track::hardRight, Track::sand, Track::noNoise, 60000 },
-    { Track::straight, Track::sand, Track::noNoise, 35000 },
-    { Track::right, Track::sand, Track::noNoise, 80000 },
-    { Track::straight, Track::sand, Track::owl, 8500 },
-    { Track::easyLeft, Track::sand, Track::noNoise, 33333 },
-    { Track::hairpinRight, Track::sand, Track::noNoise, 46000 },
-    { Track::hardLeft, Track::sand, Track::noNoise, 60000 },
-    { Track::hardRight, Track::sand, Track::noNoise, 40000 },
-    { Track::straight, Track::sand, Track::noNoise, 25000 },
-    { Track::hairpinRight, Track::sand, Track::noNoise, 42000 },
-    { Track::straight, Track::sand, Track::noNoise, 90000 },
-    { Track::hardRight, Track::sand, Track::noNoise, 20000 },
-    { Track::easyLeft, Track::sand, Track::noNoise, 30000 },
-    { Track::hairpinLeft, Track::sand, Track::noNoise, 95000 },
-    { Track::straight, Track::sand, Track::noNoise, 500000 },
-    { Track::easyRight, Track::sand, Track::owl, 6000 },
-    { Track::right, Track::sand, Track::noNoise, 6000 },
-    { Track::hardRight, Track::sand, Track::noNoise, 6000 },
-    { Track::hairpinRight, Track::sand, Track::noNoise, 40000 },
-    { Track::straight, Track::sand, Track::noNoise, 250000 },
-    { Track::easyLeft, Track::sand, Track::owl, 5000 },
-    { Track::left, Track::sand, Track::noNoise, 5000 },
-    { Track::hardLeft, Track::sand, Track::noNoise, 5000 },
-    { Track::hairpinLeft, Track::sand, Track::noNoise, 50000 },
-    { Track::straight, Track::sand, Track::noNoise, 15000 },
-    { Track::hardLeft, Track::sand, Track::noNoise, 40000 },
-	{ Track::hairpinLeft, Track::sand, Track::noNoise, 20000 },
-    { Track::straight, Track::sand, Track::noNoise, 30000 },
-    { Track::hardRight, Track::sand, Track::owl, 7500 },
-    { Track::straight, Track::sand, Track::noNoise, 100000 },
-    { Track::hairpinLeft, Track::sand, Track::noNoise, 75000 },
-    { Track::straight, Track::sand, Track::noNoise, 40000 },
-    { Track::easyLeft, Track::sand, Track::noNoise, 10000 },
-    { Track::hairpinRight, Track::sand, Track::noNoise, 60000 },
-    { Track::hardLeft, Track::sand, Track::owl, 10000 },
-    { Track::straight, Track::sand, Track::noNoise, 35000 },
-    { Track::hardLeft, Track::sand, Track::noNoise, 33333 },
-    { Track::straight, Track::sand, Track::noNoise, 5000 },
-    { Track::hardLeft, Track::sand, Track::noNoise, 33333 },
-    { Track::straight, Track::sand, Track::noNoise, 33333 },
-    { Track::hardLeft, Track::sand, Track::noNoise, 33333 },
-    { Track::straight, Track::sand, Track::noNoise, 33333 },
-    { Track::hardLeft, Track::sand, Track::noNoise, 44444 },
-    { Track::straight, Track::sand, Track::noNoise, 55555 },
-    { Track::hardLeft, Track::sand, Track::noNoise, 33333 },
-    { Track::straight, Track::sand, Track::owl, 22222 },
-    { Track::hairpinRight, Track::sand, Track::noNoise, 100000 },
-    { Track::hardRight, Track::sand, Track::noNoise, 30000 },
-    { Track::right, Track::sand, Track::noNoise, 30000 },
-    { Track::hardLeft, Track::sand, Track::noNoise, 66666 },
-    { Track::straight, Track::sand, Track::noNoise, 666666 },
-    { Track::straight, Track::sand, Track::owl, 10000 },
-    { Track::straight, Track::sand, Track::noNoise, 10000 }
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::crowd, 150000 },
+    { TrackGeometry::easyLeft, TrackGeometry::sand, TrackGeometry::noNoise, 20000 },
+    { TrackGeometry::hardRight, TrackGeometry::sand, TrackGeometry::noNoise, 40000 },
+    { TrackGeometry::hardLeft, TrackGeometry::sand, TrackGeometry::noNoise, 30000 },
+    { TrackGeometry::hairpinLeft, TrackGeometry::sand, TrackGeometry::noNoise, 90000 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::noNoise, 100000 },
+    { TrackGeometry::hardRight, TrackGeometry::sand, TrackGeometry::owl, 20000 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::noNoise, 40000 },
+    { TrackGeometry::easyRight, TrackGeometry::sand, TrackGeometry::noNoise, 19000 },
+    { TrackGeometry::hardRight, TrackGeometry::sand, TrackGeometry::noNoise, 11111 },
+    { TrackGeometry::hardLeft, TrackGeometry::sand, TrackGeometry::noNoise, 40000 },
+    { TrackGeometry::easyLeft, TrackGeometry::sand, TrackGeometry::noNoise, 9000 },
+    { TrackGeometry::easyRight, TrackGeometry::sand, TrackGeometry::noNoise, 70000 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::noNoise, 8000 },
+    { TrackGeometry::easyRight, TrackGeometry::sand, TrackGeometry::noNoise, 40000 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::noNoise, 40000 },
+    { TrackGeometry::hardLeft, TrackGeometry::sand, TrackGeometry::owl, 10000 },
+    { TrackGeometry::easyLeft, TrackGeometry::sand, TrackGeometry::noNoise, 80000 },
+    { TrackGeometry::easyRight, TrackGeometry::sand, TrackGeometry::noNoise, 75000 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::noNoise, 125000 },
+    { TrackGeometry::easyLeft, TrackGeometry::sand, TrackGeometry::noNoise, 10000 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::noNoise, 18000 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::jet, 5000 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::noNoise, 40000 },
+    { TrackGeometry::hairpinRight, TrackGeometry::sand, TrackGeometry::noNoise, 46000 },
+    { TrackGeometry::easyRight, TrackGeometry::sand, TrackGeometry::owl, 12345 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::noNoise, 10000 },
+    { TrackGeometry::hairpinRight, TrackGeometry::sand, TrackGeometry::noNoise, 40000 },
+    { TrackGeometry::hairpinLeft, TrackGeometry::sand, TrackGeometry::noNoise, 77777 },
+    { TrackGeometry::easyRight, TrackGeometry::sand, TrackGeometry::noNoise, 54321 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::noNoise, 99999 },
+    { TrackGeometry::hairpinRight, TrackGeometry::sand, TrackGeometry::owl, 6000 },
+    { TrackGeometry::hardRight, TrackGeometry::sand, TrackGeometry::noNoise, 40000 },
+    { TrackGeometry::right, TrackGeometry::sand, TrackGeometry::noNoise, 40000 },
+    { TrackGeometry::easyRight, TrackGeometry::sand, TrackGeometry::noNoise, 10000 },
+    { TrackGeometry::easyLeft, TrackGeometry::sand, TrackGeometry::noNoise, 30000 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::noNoise, 200000 },
+    { TrackGeometry::hardRight, TrackGeometry::sand, TrackGeometry::noNoise, 60000 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::noNoise, 35000 },
+    { TrackGeometry::right, TrackGeometry::sand, TrackGeometry::noNoise, 80000 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::owl, 8500 },
+    { TrackGeometry::easyLeft, TrackGeometry::sand, TrackGeometry::noNoise, 33333 },
+    { TrackGeometry::hairpinRight, TrackGeometry::sand, TrackGeometry::noNoise, 46000 },
+    { TrackGeometry::hardLeft, TrackGeometry::sand, TrackGeometry::noNoise, 60000 },
+    { TrackGeometry::hardRight, TrackGeometry::sand, TrackGeometry::noNoise, 40000 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::noNoise, 25000 },
+    { TrackGeometry::hairpinRight, TrackGeometry::sand, TrackGeometry::noNoise, 42000 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::noNoise, 90000 },
+    { TrackGeometry::hardRight, TrackGeometry::sand, TrackGeometry::noNoise, 20000 },
+    { TrackGeometry::easyLeft, TrackGeometry::sand, TrackGeometry::noNoise, 30000 },
+    { TrackGeometry::hairpinLeft, TrackGeometry::sand, TrackGeometry::noNoise, 95000 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::noNoise, 500000 },
+    { TrackGeometry::easyRight, TrackGeometry::sand, TrackGeometry::owl, 6000 },
+    { TrackGeometry::right, TrackGeometry::sand, TrackGeometry::noNoise, 6000 },
+    { TrackGeometry::hardRight, TrackGeometry::sand, TrackGeometry::noNoise, 6000 },
+    { TrackGeometry::hairpinRight, TrackGeometry::sand, TrackGeometry::noNoise, 40000 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::noNoise, 250000 },
+    { TrackGeometry::easyLeft, TrackGeometry::sand, TrackGeometry::owl, 5000 },
+    { TrackGeometry::left, TrackGeometry::sand, TrackGeometry::noNoise, 5000 },
+    { TrackGeometry::hardLeft, TrackGeometry::sand, TrackGeometry::noNoise, 5000 },
+    { TrackGeometry::hairpinLeft, TrackGeometry::sand, TrackGeometry::noNoise, 50000 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::noNoise, 15000 },
+    { TrackGeometry::hardLeft, TrackGeometry::sand, TrackGeometry::noNoise, 40000 },
+	{ TrackGeometry::hairpinLeft, TrackGeometry::sand, TrackGeometry::noNoise, 20000 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::noNoise, 30000 },
+    { TrackGeometry::hardRight, TrackGeometry::sand, TrackGeometry::owl, 7500 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::noNoise, 100000 },
+    { TrackGeometry::hairpinLeft, TrackGeometry::sand, TrackGeometry::noNoise, 75000 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::noNoise, 40000 },
+    { TrackGeometry::easyLeft, TrackGeometry::sand, TrackGeometry::noNoise, 10000 },
+    { TrackGeometry::hairpinRight, TrackGeometry::sand, TrackGeometry::noNoise, 60000 },
+    { TrackGeometry::hardLeft, TrackGeometry::sand, TrackGeometry::owl, 10000 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::noNoise, 35000 },
+    { TrackGeometry::hardLeft, TrackGeometry::sand, TrackGeometry::noNoise, 33333 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::noNoise, 5000 },
+    { TrackGeometry::hardLeft, TrackGeometry::sand, TrackGeometry::noNoise, 33333 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::noNoise, 33333 },
+    { TrackGeometry::hardLeft, TrackGeometry::sand, TrackGeometry::noNoise, 33333 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::noNoise, 33333 },
+    { TrackGeometry::hardLeft, TrackGeometry::sand, TrackGeometry::noNoise, 44444 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::noNoise, 55555 },
+    { TrackGeometry::hardLeft, TrackGeometry::sand, TrackGeometry::noNoise, 33333 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::owl, 22222 },
+    { TrackGeometry::hairpinRight, TrackGeometry::sand, TrackGeometry::noNoise, 100000 },
+    { TrackGeometry::hardRight, TrackGeometry::sand, TrackGeometry::noNoise, 30000 },
+    { TrackGeometry::right, TrackGeometry::sand, TrackGeometry::noNoise, 30000 },
+    { TrackGeometry::hardLeft, TrackGeometry::sand, TrackGeometry::noNoise, 66666 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::noNoise, 666666 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::owl, 10000 },
+    { TrackGeometry::straight, TrackGeometry::sand, TrackGeometry::noNoise, 10000 }
 };
 
-Track::Definition _trAdvRush[] =
+TrackGeometry::Definition _trAdvRush[] =
 {
-    { Track::straight, Track::asphalt, Track::clock, 35000 },
-    { Track::straight, Track::asphalt, Track::noNoise, 120000 },
-    { Track::straight, Track::asphalt, Track::construction, 53000 },
-    { Track::hardLeft, Track::asphalt, Track::construction, 70000 },
-    { Track::straight, Track::asphalt, Track::noNoise, 30000 },
-    { Track::hardLeft, Track::asphalt, Track::noNoise, 24000 },
-    { Track::left, Track::asphalt, Track::noNoise, 30000 },
-    { Track::hardLeft, Track::asphalt, Track::noNoise, 32000 },
-    { Track::straight, Track::asphalt, Track::noNoise, 19000 },
-    { Track::easyRight, Track::asphalt, Track::noNoise, 35000 },
-    { Track::straight, Track::asphalt, Track::noNoise, 15000 },
-    { Track::easyLeft, Track::asphalt, Track::noNoise, 52000 },
-    { Track::left, Track::asphalt, Track::noNoise, 23000 },
-    { Track::easyRight, Track::asphalt, Track::noNoise, 5000 },
-    { Track::straight, Track::asphalt, Track::construction, 25000 },
-    { Track::hardLeft, Track::asphalt, Track::noNoise, 20000 },
-    { Track::straight, Track::asphalt, Track::noNoise, 100000 },
-    { Track::straight, Track::asphalt, Track::pile, 85000 },
-    { Track::easyLeft, Track::asphalt, Track::pile, 32000 },
-    { Track::straight, Track::asphalt, Track::noNoise, 42000 },
-    { Track::hardRight, Track::asphalt, Track::noNoise, 20000 },
-    { Track::straight, Track::asphalt, Track::noNoise, 20000 },
-    { Track::left, Track::asphalt, Track::noNoise, 23000 },
-    { Track::straight, Track::asphalt, Track::noNoise, 21000 },
-    { Track::easyLeft, Track::asphalt, Track::noNoise, 39000 },
-    { Track::hardRight, Track::asphalt, Track::noNoise, 43000 },
-    { Track::left, Track::asphalt, Track::noNoise, 38000 },
-    { Track::straight, Track::asphalt, Track::noNoise, 50000 },
-    { Track::straight, Track::asphalt, Track::construction, 69000 },
-    { Track::straight, Track::asphalt, Track::clock, 38000 },
-    { Track::left, Track::asphalt, Track::noNoise, 30000 },
-    { Track::hardRight, Track::asphalt, Track::noNoise, 43000 },
-    { Track::right, Track::asphalt, Track::noNoise, 30000 },
-    { Track::straight, Track::asphalt, Track::noNoise, 10000 },
-    { Track::straight, Track::asphalt, Track::construction, 40000 },
-    { Track::straight, Track::asphalt, Track::clock, 76000 },
-    { Track::hardRight, Track::asphalt, Track::noNoise, 30000 },
-    { Track::hardLeft, Track::asphalt, Track::noNoise, 30000 },
-    { Track::straight, Track::asphalt, Track::noNoise, 100000 },
-    { Track::hardLeft, Track::asphalt, Track::noNoise, 34000 },
-    { Track::straight, Track::asphalt, Track::clock, 100000 },
-    { Track::straight, Track::asphalt, Track::construction, 20000 },
-    { Track::left, Track::asphalt, Track::noNoise, 20000 },
-    { Track::straight, Track::asphalt, Track::noNoise, 20000 },
-    { Track::left, Track::asphalt, Track::noNoise, 20000 },
-    { Track::straight, Track::asphalt, Track::noNoise, 10000 },
-    { Track::straight, Track::asphalt, Track::clock, 6700 },
-    { Track::straight, Track::asphalt, Track::noNoise, 82000 },
-    { Track::left, Track::asphalt, Track::noNoise, 42000 },
-    { Track::right, Track::asphalt, Track::noNoise, 30000 },
-    { Track::straight, Track::asphalt, Track::clock, 130000 },
-    { Track::left, Track::asphalt, Track::noNoise, 23000 },
-    { Track::hardRight, Track::asphalt, Track::noNoise, 28000 },
-    { Track::easyRight, Track::asphalt, Track::noNoise, 10000 },
-    { Track::straight, Track::asphalt, Track::noNoise, 20000 },
-    { Track::straight, Track::asphalt, Track::clock, 103000 },
-    { Track::easyRight, Track::asphalt, Track::noNoise, 30000 },
-    { Track::right, Track::asphalt, Track::noNoise, 34000 },
-    { Track::easyRight, Track::asphalt, Track::noNoise, 34000 },
-    { Track::straight, Track::asphalt, Track::clock, 5000 },
-    { Track::easyRight, Track::asphalt, Track::clock, 34000 },
-    { Track::left, Track::asphalt, Track::clock, 30000 },
-    { Track::right, Track::asphalt, Track::clock, 30000 },
-    { Track::left, Track::asphalt, Track::clock, 30000 },
-    { Track::straight, Track::asphalt, Track::clock, 18000 },
-    { Track::hardRight, Track::asphalt, Track::noNoise, 5000 },
-    { Track::straight, Track::asphalt, Track::noNoise, 120000 },
-    { Track::straight, Track::asphalt, Track::pile, 58000 },
-    { Track::hardRight, Track::asphalt, Track::noNoise, 62000 },
-    { Track::straight, Track::gravel, Track::noNoise, 21000 },
-    { Track::straight, Track::gravel, Track::construction, 40000 },
-    { Track::straight, Track::gravel, Track::construction, 50000 },
-    { Track::straight, Track::asphalt, Track::noNoise, 100000 },
-    { Track::easyRight, Track::asphalt, Track::noNoise, 60000 },
-    { Track::right, Track::asphalt, Track::noNoise, 45000 },
-    { Track::left, Track::asphalt, Track::noNoise, 52000 },
-    { Track::easyLeft, Track::asphalt, Track::noNoise, 31000 },
-    { Track::straight, Track::asphalt, Track::construction, 130000 },
-    { Track::easyLeft, Track::asphalt, Track::pile, 26000 },
-    { Track::easyRight, Track::asphalt, Track::pile, 30000 },
-    { Track::left, Track::asphalt, Track::pile, 30000 },
-    { Track::right, Track::asphalt, Track::pile, 31000 },
-    { Track::left, Track::asphalt, Track::pile, 30000 },
-    { Track::straight, Track::asphalt, Track::pile, 23000 },
-    { Track::left, Track::asphalt, Track::pile, 32000 },
-    { Track::straight, Track::asphalt, Track::noNoise, 35000 },
-    { Track::easyRight, Track::asphalt, Track::noNoise, 43000 },
-    { Track::right, Track::asphalt, Track::noNoise, 34000 },
-    { Track::left, Track::asphalt, Track::clock, 100000 },
-    { Track::straight, Track::asphalt, Track::clock, 16000 },
-    { Track::hardRight, Track::asphalt, Track::clock, 100000 },
-    { Track::straight, Track::gravel, Track::clock, 80000 },
-    { Track::straight, Track::gravel, Track::noNoise, 100000 },
-    { Track::left, Track::asphalt, Track::noNoise, 13000 },
-    { Track::hardLeft, Track::asphalt, Track::noNoise, 100000 },
-    { Track::easyRight, Track::asphalt, Track::noNoise, 50000 },
-    { Track::right, Track::asphalt, Track::noNoise, 50000 },
-    { Track::easyRight, Track::asphalt, Track::noNoise, 30000 },
-    { Track::easyLeft, Track::asphalt, Track::noNoise, 41000 },
-    { Track::straight, Track::gravel, Track::noNoise, 100000 },
-    { Track::straight, Track::asphalt, Track::noNoise, 100000 },
-    { Track::straight, Track::asphalt, Track::pile, 70000 },
-    { Track::straight, Track::asphalt, Track::construction, 20000 },
-    { Track::straight, Track::asphalt, Track::clock, 100000 }
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::clock, 35000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::noNoise, 120000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::construction, 53000 },
+    { TrackGeometry::hardLeft, TrackGeometry::asphalt, TrackGeometry::construction, 70000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::noNoise, 30000 },
+    { TrackGeometry::hardLeft, TrackGeometry::asphalt, TrackGeometry::noNoise, 24000 },
+    { TrackGeometry::left, TrackGeometry::asphalt, TrackGeometry::noNoise, 30000 },
+    { TrackGeometry::hardLeft, TrackGeometry::asphalt, TrackGeometry::noNoise, 32000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::noNoise, 19000 },
+    { TrackGeometry::easyRight, TrackGeometry::asphalt, TrackGeometry::noNoise, 35000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::noNoise, 15000 },
+    { TrackGeometry::easyLeft, TrackGeometry::asphalt, TrackGeometry::noNoise, 52000 },
+    { TrackGeometry::left, TrackGeometry::asphalt, TrackGeometry::noNoise, 23000 },
+    { TrackGeometry::easyRight, TrackGeometry::asphalt, TrackGeometry::noNoise, 5000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::construction, 25000 },
+    { TrackGeometry::hardLeft, TrackGeometry::asphalt, TrackGeometry::noNoise, 20000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::noNoise, 100000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::pile, 85000 },
+    { TrackGeometry::easyLeft, TrackGeometry::asphalt, TrackGeometry::pile, 32000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::noNoise, 42000 },
+    { TrackGeometry::hardRight, TrackGeometry::asphalt, TrackGeometry::noNoise, 20000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::noNoise, 20000 },
+    { TrackGeometry::left, TrackGeometry::asphalt, TrackGeometry::noNoise, 23000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::noNoise, 21000 },
+    { TrackGeometry::easyLeft, TrackGeometry::asphalt, TrackGeometry::noNoise, 39000 },
+    { TrackGeometry::hardRight, TrackGeometry::asphalt, TrackGeometry::noNoise, 43000 },
+    { TrackGeometry::left, TrackGeometry::asphalt, TrackGeometry::noNoise, 38000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::noNoise, 50000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::construction, 69000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::clock, 38000 },
+    { TrackGeometry::left, TrackGeometry::asphalt, TrackGeometry::noNoise, 30000 },
+    { TrackGeometry::hardRight, TrackGeometry::asphalt, TrackGeometry::noNoise, 43000 },
+    { TrackGeometry::right, TrackGeometry::asphalt, TrackGeometry::noNoise, 30000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::noNoise, 10000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::construction, 40000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::clock, 76000 },
+    { TrackGeometry::hardRight, TrackGeometry::asphalt, TrackGeometry::noNoise, 30000 },
+    { TrackGeometry::hardLeft, TrackGeometry::asphalt, TrackGeometry::noNoise, 30000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::noNoise, 100000 },
+    { TrackGeometry::hardLeft, TrackGeometry::asphalt, TrackGeometry::noNoise, 34000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::clock, 100000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::construction, 20000 },
+    { TrackGeometry::left, TrackGeometry::asphalt, TrackGeometry::noNoise, 20000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::noNoise, 20000 },
+    { TrackGeometry::left, TrackGeometry::asphalt, TrackGeometry::noNoise, 20000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::noNoise, 10000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::clock, 6700 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::noNoise, 82000 },
+    { TrackGeometry::left, TrackGeometry::asphalt, TrackGeometry::noNoise, 42000 },
+    { TrackGeometry::right, TrackGeometry::asphalt, TrackGeometry::noNoise, 30000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::clock, 130000 },
+    { TrackGeometry::left, TrackGeometry::asphalt, TrackGeometry::noNoise, 23000 },
+    { TrackGeometry::hardRight, TrackGeometry::asphalt, TrackGeometry::noNoise, 28000 },
+    { TrackGeometry::easyRight, TrackGeometry::asphalt, TrackGeometry::noNoise, 10000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::noNoise, 20000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::clock, 103000 },
+    { TrackGeometry::easyRight, TrackGeometry::asphalt, TrackGeometry::noNoise, 30000 },
+    { TrackGeometry::right, TrackGeometry::asphalt, TrackGeometry::noNoise, 34000 },
+    { TrackGeometry::easyRight, TrackGeometry::asphalt, TrackGeometry::noNoise, 34000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::clock, 5000 },
+    { TrackGeometry::easyRight, TrackGeometry::asphalt, TrackGeometry::clock, 34000 },
+    { TrackGeometry::left, TrackGeometry::asphalt, TrackGeometry::clock, 30000 },
+    { TrackGeometry::right, TrackGeometry::asphalt, TrackGeometry::clock, 30000 },
+    { TrackGeometry::left, TrackGeometry::asphalt, TrackGeometry::clock, 30000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::clock, 18000 },
+    { TrackGeometry::hardRight, TrackGeometry::asphalt, TrackGeometry::noNoise, 5000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::noNoise, 120000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::pile, 58000 },
+    { TrackGeometry::hardRight, TrackGeometry::asphalt, TrackGeometry::noNoise, 62000 },
+    { TrackGeometry::straight, TrackGeometry::gravel, TrackGeometry::noNoise, 21000 },
+    { TrackGeometry::straight, TrackGeometry::gravel, TrackGeometry::construction, 40000 },
+    { TrackGeometry::straight, TrackGeometry::gravel, TrackGeometry::construction, 50000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::noNoise, 100000 },
+    { TrackGeometry::easyRight, TrackGeometry::asphalt, TrackGeometry::noNoise, 60000 },
+    { TrackGeometry::right, TrackGeometry::asphalt, TrackGeometry::noNoise, 45000 },
+    { TrackGeometry::left, TrackGeometry::asphalt, TrackGeometry::noNoise, 52000 },
+    { TrackGeometry::easyLeft, TrackGeometry::asphalt, TrackGeometry::noNoise, 31000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::construction, 130000 },
+    { TrackGeometry::easyLeft, TrackGeometry::asphalt, TrackGeometry::pile, 26000 },
+    { TrackGeometry::easyRight, TrackGeometry::asphalt, TrackGeometry::pile, 30000 },
+    { TrackGeometry::left, TrackGeometry::asphalt, TrackGeometry::pile, 30000 },
+    { TrackGeometry::right, TrackGeometry::asphalt, TrackGeometry::pile, 31000 },
+    { TrackGeometry::left, TrackGeometry::asphalt, TrackGeometry::pile, 30000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::pile, 23000 },
+    { TrackGeometry::left, TrackGeometry::asphalt, TrackGeometry::pile, 32000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::noNoise, 35000 },
+    { TrackGeometry::easyRight, TrackGeometry::asphalt, TrackGeometry::noNoise, 43000 },
+    { TrackGeometry::right, TrackGeometry::asphalt, TrackGeometry::noNoise, 34000 },
+    { TrackGeometry::left, TrackGeometry::asphalt, TrackGeometry::clock, 100000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::clock, 16000 },
+    { TrackGeometry::hardRight, TrackGeometry::asphalt, TrackGeometry::clock, 100000 },
+    { TrackGeometry::straight, TrackGeometry::gravel, TrackGeometry::clock, 80000 },
+    { TrackGeometry::straight, TrackGeometry::gravel, TrackGeometry::noNoise, 100000 },
+    { TrackGeometry::left, TrackGeometry::asphalt, TrackGeometry::noNoise, 13000 },
+    { TrackGeometry::hardLeft, TrackGeometry::asphalt, TrackGeometry::noNoise, 100000 },
+    { TrackGeometry::easyRight, TrackGeometry::asphalt, TrackGeometry::noNoise, 50000 },
+    { TrackGeometry::right, TrackGeometry::asphalt, TrackGeometry::noNoise, 50000 },
+    { TrackGeometry::easyRight, TrackGeometry::asphalt, TrackGeometry::noNoise, 30000 },
+    { TrackGeometry::easyLeft, TrackGeometry::asphalt, TrackGeometry::noNoise, 41000 },
+    { TrackGeometry::straight, TrackGeometry::gravel, TrackGeometry::noNoise, 100000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::noNoise, 100000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::pile, 70000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::construction, 20000 },
+    { TrackGeometry::straight, TrackGeometry::asphalt, TrackGeometry::clock, 100000 }
 };
 
-Track::Definition _trAdvEscape[] =
+TrackGeometry::Definition _trAdvEscape[] =
 {
-    { Track::straight, Track::snow, Track::noNoise, 50000 },
-    { Track::easyLeft, Track::snow, Track::noNoise, 38000 },
-    { Track::easyRight, Track::snow, Track::noNoise, 30000 },
-    { Track::left, Track::snow, Track::noNoise, 10000 },
-    { Track::straight, Track::snow, Track::noNoise, 20000 },
-    { Track::easyLeft, Track::snow, Track::noNoise, 20000 },
-    { Track::straight, Track::snow, Track::noNoise, 20000 },
-    { Track::easyLeft, Track::snow, Track::noNoise, 68000 },
-    { Track::easyRight, Track::snow, Track::noNoise, 6000 },
-    { Track::straight, Track::snow, Track::noNoise, 103000 },
-    { Track::left, Track::snow, Track::noNoise, 20000 },
-    { Track::right, Track::snow, Track::noNoise, 30000 },
-    { Track::left, Track::snow, Track::noNoise, 130000 },
-    { Track::straight, Track::snow, Track::noNoise, 51000 },
-    { Track::easyRight, Track::snow, Track::noNoise, 40000 },
-    { Track::right, Track::snow, Track::noNoise, 5000 },
-    { Track::straight, Track::snow, Track::noNoise, 180000 },
-    { Track::easyRight, Track::snow, Track::noNoise, 139000 },
-    { Track::left, Track::snow, Track::noNoise, 25000 },
-    { Track::right, Track::snow, Track::noNoise, 35000 },
-    { Track::straight, Track::snow, Track::noNoise, 10000 },
-    { Track::easyLeft, Track::snow, Track::noNoise, 20000 },
-    { Track::straight, Track::snow, Track::noNoise, 83500 },
-    { Track::easyLeft, Track::snow, Track::noNoise, 25000 },
-    { Track::straight, Track::snow, Track::noNoise, 30000 },
-    { Track::easyRight, Track::snow, Track::noNoise, 37000 },
-    { Track::straight, Track::snow, Track::noNoise, 58000 },
-    { Track::right, Track::snow, Track::noNoise, 15000 },
-    { Track::left, Track::snow, Track::noNoise, 13000 },
-    { Track::straight, Track::snow, Track::noNoise, 10000 },
-    { Track::right, Track::snow, Track::noNoise, 5000 },
-    { Track::straight, Track::snow, Track::noNoise, 10000 },
-    { Track::easyRight, Track::snow, Track::noNoise, 60000 },
-    { Track::easyLeft, Track::snow, Track::noNoise, 30000 },
-    { Track::left, Track::snow, Track::noNoise, 53000 },
-    { Track::straight, Track::snow, Track::noNoise, 38000 },
-    { Track::easyRight, Track::snow, Track::noNoise, 34000 },
-    { Track::right, Track::snow, Track::noNoise, 35000 },
-    { Track::left, Track::snow, Track::noNoise, 80500 },
-    { Track::straight, Track::snow, Track::noNoise, 35000 },
-    { Track::easyLeft, Track::snow, Track::noNoise, 10000 },
-    { Track::left, Track::snow, Track::noNoise, 80000 },
-    { Track::straight, Track::snow, Track::noNoise, 100000 },
-    { Track::left, Track::snow, Track::noNoise, 90000 },
-    { Track::straight, Track::snow, Track::noNoise, 30000 },
-    { Track::right, Track::snow, Track::noNoise, 75000 },
-    { Track::easyRight, Track::snow, Track::noNoise, 100000 },
-    { Track::straight, Track::snow, Track::noNoise, 18000 },
-    { Track::left, Track::snow, Track::noNoise, 50000 },
-    { Track::right, Track::snow, Track::noNoise, 35000 },
-    { Track::left, Track::snow, Track::noNoise, 13000 },
-    { Track::straight, Track::snow, Track::noNoise, 60000 },
-    { Track::easyRight, Track::snow, Track::noNoise, 100000 },
-    { Track::straight, Track::snow, Track::noNoise, 58000 },
-    { Track::easyLeft, Track::snow, Track::noNoise, 10000 },
-    { Track::left, Track::snow, Track::noNoise, 100000 },
-    { Track::easyRight, Track::snow, Track::noNoise, 78000 },
-    { Track::straight, Track::snow, Track::noNoise, 6000 },
-    { Track::easyRight, Track::snow, Track::noNoise, 32000 },
-    { Track::left, Track::snow, Track::noNoise, 23000 },
-    { Track::easyLeft, Track::snow, Track::noNoise, 50000 },
-    { Track::easyRight, Track::snow, Track::noNoise, 17000 },
-    { Track::easyLeft, Track::snow, Track::noNoise, 30000 },
-    { Track::left, Track::snow, Track::noNoise, 22000 },
-    { Track::straight, Track::snow, Track::noNoise, 35000 },
-    { Track::left, Track::snow, Track::noNoise, 30000 },
-    { Track::easyLeft, Track::snow, Track::noNoise, 30000 },
-    { Track::left, Track::snow, Track::noNoise, 30000 },
-    { Track::easyLeft, Track::snow, Track::noNoise, 58000 },
-    { Track::left, Track::snow, Track::noNoise, 10000 },
-    { Track::straight, Track::snow, Track::noNoise, 59000 },
-    { Track::right, Track::snow, Track::noNoise, 70000 },
-    { Track::straight, Track::snow, Track::crowd, 52000 },
-    { Track::easyLeft, Track::snow, Track::crowd, 23000 },
-    { Track::left, Track::snow, Track::crowd, 23000 },
-    { Track::easyRight, Track::snow, Track::crowd, 37000 },
-    { Track::right, Track::snow, Track::crowd, 100000 },
-    { Track::straight, Track::snow, Track::noNoise, 28000 },
-    { Track::easyLeft, Track::snow, Track::noNoise, 9200 },
-    { Track::straight, Track::snow, Track::noNoise, 82000 },
-    { Track::right, Track::snow, Track::noNoise, 35000 },
-    { Track::straight, Track::snow, Track::river, 52000 },
-    { Track::easyRight, Track::snow, Track::river, 30000 },
-	{ Track::right, Track::snow, Track::river, 30000 },
-    { Track::easyRight, Track::snow, Track::river, 35000 },
-    { Track::straight, Track::snow, Track::river, 20000 },
-    { Track::right, Track::snow, Track::river, 47000 },
-    { Track::straight, Track::water, Track::river, 85000 }
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::noNoise, 50000 },
+    { TrackGeometry::easyLeft, TrackGeometry::snow, TrackGeometry::noNoise, 38000 },
+    { TrackGeometry::easyRight, TrackGeometry::snow, TrackGeometry::noNoise, 30000 },
+    { TrackGeometry::left, TrackGeometry::snow, TrackGeometry::noNoise, 10000 },
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::noNoise, 20000 },
+    { TrackGeometry::easyLeft, TrackGeometry::snow, TrackGeometry::noNoise, 20000 },
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::noNoise, 20000 },
+    { TrackGeometry::easyLeft, TrackGeometry::snow, TrackGeometry::noNoise, 68000 },
+    { TrackGeometry::easyRight, TrackGeometry::snow, TrackGeometry::noNoise, 6000 },
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::noNoise, 103000 },
+    { TrackGeometry::left, TrackGeometry::snow, TrackGeometry::noNoise, 20000 },
+    { TrackGeometry::right, TrackGeometry::snow, TrackGeometry::noNoise, 30000 },
+    { TrackGeometry::left, TrackGeometry::snow, TrackGeometry::noNoise, 130000 },
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::noNoise, 51000 },
+    { TrackGeometry::easyRight, TrackGeometry::snow, TrackGeometry::noNoise, 40000 },
+    { TrackGeometry::right, TrackGeometry::snow, TrackGeometry::noNoise, 5000 },
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::noNoise, 180000 },
+    { TrackGeometry::easyRight, TrackGeometry::snow, TrackGeometry::noNoise, 139000 },
+    { TrackGeometry::left, TrackGeometry::snow, TrackGeometry::noNoise, 25000 },
+    { TrackGeometry::right, TrackGeometry::snow, TrackGeometry::noNoise, 35000 },
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::noNoise, 10000 },
+    { TrackGeometry::easyLeft, TrackGeometry::snow, TrackGeometry::noNoise, 20000 },
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::noNoise, 83500 },
+    { TrackGeometry::easyLeft, TrackGeometry::snow, TrackGeometry::noNoise, 25000 },
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::noNoise, 30000 },
+    { TrackGeometry::easyRight, TrackGeometry::snow, TrackGeometry::noNoise, 37000 },
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::noNoise, 58000 },
+    { TrackGeometry::right, TrackGeometry::snow, TrackGeometry::noNoise, 15000 },
+    { TrackGeometry::left, TrackGeometry::snow, TrackGeometry::noNoise, 13000 },
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::noNoise, 10000 },
+    { TrackGeometry::right, TrackGeometry::snow, TrackGeometry::noNoise, 5000 },
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::noNoise, 10000 },
+    { TrackGeometry::easyRight, TrackGeometry::snow, TrackGeometry::noNoise, 60000 },
+    { TrackGeometry::easyLeft, TrackGeometry::snow, TrackGeometry::noNoise, 30000 },
+    { TrackGeometry::left, TrackGeometry::snow, TrackGeometry::noNoise, 53000 },
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::noNoise, 38000 },
+    { TrackGeometry::easyRight, TrackGeometry::snow, TrackGeometry::noNoise, 34000 },
+    { TrackGeometry::right, TrackGeometry::snow, TrackGeometry::noNoise, 35000 },
+    { TrackGeometry::left, TrackGeometry::snow, TrackGeometry::noNoise, 80500 },
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::noNoise, 35000 },
+    { TrackGeometry::easyLeft, TrackGeometry::snow, TrackGeometry::noNoise, 10000 },
+    { TrackGeometry::left, TrackGeometry::snow, TrackGeometry::noNoise, 80000 },
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::noNoise, 100000 },
+    { TrackGeometry::left, TrackGeometry::snow, TrackGeometry::noNoise, 90000 },
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::noNoise, 30000 },
+    { TrackGeometry::right, TrackGeometry::snow, TrackGeometry::noNoise, 75000 },
+    { TrackGeometry::easyRight, TrackGeometry::snow, TrackGeometry::noNoise, 100000 },
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::noNoise, 18000 },
+    { TrackGeometry::left, TrackGeometry::snow, TrackGeometry::noNoise, 50000 },
+    { TrackGeometry::right, TrackGeometry::snow, TrackGeometry::noNoise, 35000 },
+    { TrackGeometry::left, TrackGeometry::snow, TrackGeometry::noNoise, 13000 },
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::noNoise, 60000 },
+    { TrackGeometry::easyRight, TrackGeometry::snow, TrackGeometry::noNoise, 100000 },
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::noNoise, 58000 },
+    { TrackGeometry::easyLeft, TrackGeometry::snow, TrackGeometry::noNoise, 10000 },
+    { TrackGeometry::left, TrackGeometry::snow, TrackGeometry::noNoise, 100000 },
+    { TrackGeometry::easyRight, TrackGeometry::snow, TrackGeometry::noNoise, 78000 },
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::noNoise, 6000 },
+    { TrackGeometry::easyRight, TrackGeometry::snow, TrackGeometry::noNoise, 32000 },
+    { TrackGeometry::left, TrackGeometry::snow, TrackGeometry::noNoise, 23000 },
+    { TrackGeometry::easyLeft, TrackGeometry::snow, TrackGeometry::noNoise, 50000 },
+    { TrackGeometry::easyRight, TrackGeometry::snow, TrackGeometry::noNoise, 17000 },
+    { TrackGeometry::easyLeft, TrackGeometry::snow, TrackGeometry::noNoise, 30000 },
+    { TrackGeometry::left, TrackGeometry::snow, TrackGeometry::noNoise, 22000 },
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::noNoise, 35000 },
+    { TrackGeometry::left, TrackGeometry::snow, TrackGeometry::noNoise, 30000 },
+    { TrackGeometry::easyLeft, TrackGeometry::snow, TrackGeometry::noNoise, 30000 },
+    { TrackGeometry::left, TrackGeometry::snow, TrackGeometry::noNoise, 30000 },
+    { TrackGeometry::easyLeft, TrackGeometry::snow, TrackGeometry::noNoise, 58000 },
+    { TrackGeometry::left, TrackGeometry::snow, TrackGeometry::noNoise, 10000 },
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::noNoise, 59000 },
+    { TrackGeometry::right, TrackGeometry::snow, TrackGeometry::noNoise, 70000 },
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::crowd, 52000 },
+    { TrackGeometry::easyLeft, TrackGeometry::snow, TrackGeometry::crowd, 23000 },
+    { TrackGeometry::left, TrackGeometry::snow, TrackGeometry::crowd, 23000 },
+    { TrackGeometry::easyRight, TrackGeometry::snow, TrackGeometry::crowd, 37000 },
+    { TrackGeometry::right, TrackGeometry::snow, TrackGeometry::crowd, 100000 },
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::noNoise, 28000 },
+    { TrackGeometry::easyLeft, TrackGeometry::snow, TrackGeometry::noNoise, 9200 },
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::noNoise, 82000 },
+    { TrackGeometry::right, TrackGeometry::snow, TrackGeometry::noNoise, 35000 },
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::river, 52000 },
+    { TrackGeometry::easyRight, TrackGeometry::snow, TrackGeometry::river, 30000 },
+	{ TrackGeometry::right, TrackGeometry::snow, TrackGeometry::river, 30000 },
+    { TrackGeometry::easyRight, TrackGeometry::snow, TrackGeometry::river, 35000 },
+    { TrackGeometry::straight, TrackGeometry::snow, TrackGeometry::river, 20000 },
+    { TrackGeometry::right, TrackGeometry::snow, TrackGeometry::river, 47000 },
+    { TrackGeometry::straight, TrackGeometry::water, TrackGeometry::river, 85000 }
 };
 
 #endif /* __RACING_TRACKDEFS_H__ */
@@ -0,0 +1,340 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#include "TrackGeometry.h"
+#include "TrackDefs.h"
+#include <stdio.h>
+#include <string.h>
+
+#define LANEWIDTH 15000
+#define TYPES 9
+#define SURFACES 5
+#define NOISES 12
+#define MINPARTLENGTH 5000
+
+#define BUILTIN(name, track) { name, track, sizeof(track)/sizeof(TrackGeometry::Definition) }
+
+struct BuiltinTrack
+{
+    const Char*                 name;
+    TrackGeometry::Definition*  definition;
+    UInt                        length;
+};
+
+static BuiltinTrack _builtinTracks[] =
+{
+    BUILTIN("america",      _trAmerica),
+    BUILTIN("austria",      _trAustria),
+    BUILTIN("belgium",      _trBelgium),
+    BUILTIN("brazil",       _trBrazil),
+    BUILTIN("china",        _trChina),
+    BUILTIN("england",      _trEngland),
+    BUILTIN("finland",      _trFinland),
+    BUILTIN("france",       _trFrance),
+    BUILTIN("germany",      _trGermany),
+    BUILTIN("ireland",      _trIreland),
+    BUILTIN("italy",        _trItaly),
+    BUILTIN("netherlands",  _trNetherlands),
+    BUILTIN("portugal",     _trPortugal),
+    BUILTIN("russia",       _trRussia),
+    BUILTIN("spain",        _trSpain),
+    BUILTIN("sweden",       _trSweden),
+    BUILTIN("switserland",  _trSwitserland),
+    BUILTIN("advHills",     _trAdvHills),
+    BUILTIN("advCoast",     _trAdvCoast),
+    BUILTIN("advCountry",   _trAdvCountry),
+    BUILTIN("advAirport",   _trAirport),
+    BUILTIN("advDesert",    _trDesert),
+    BUILTIN("advRush",      _trAdvRush),
+    BUILTIN("advEscape",    _trAdvEscape)
+};
+
+
+static Int
+readInt(FILE* file)
+{
+    Int i;
+    if ((file == 0) || (fscanf(file, "%i\n", &i) != 1))
+        return -1;
+    else
+        return i;
+}
+
+
+TrackGeometry::TrackGeometry( ) :
+    m_userDefined(false),
+    m_length(0),
+    m_lapDistance(0),
+    m_lapCenter(0),
+    m_definition(0),
+    m_segmentStart(0),
+    m_segmentCenter(0),
+    m_lastSegment(0),
+    m_laneWidth(LANEWIDTH),
+    m_weather(sunny),
+    m_ambience(noAmbience)
+{
+}
+
+
+TrackGeometry::~TrackGeometry( )
+{
+    if (m_userDefined)
+    {
+        SAFE_DELETE_ARRAY(m_definition);
+    }
+    SAFE_DELETE_ARRAY(m_segmentStart);
+    SAFE_DELETE_ARRAY(m_segmentCenter);
+}
+
+
+// Returns false if the file cannot be read or holds no segment, in which
+// case the track is a single straight so the caller can still go on.
+Boolean
+TrackGeometry::load(const Char* filename)
+{
+    for (UInt i = 0; i < sizeof(_builtinTracks)/sizeof(BuiltinTrack); ++i)
+    {
+        if (strcmp(filename, _builtinTracks[i].name) == 0)
+        {
+            m_definition = _builtinTracks[i].definition;
+            m_length     = _builtinTracks[i].length;
+            if (strcmp(filename, "advCountry") == 0)
+                m_weather = rain;
+            else if (strcmp(filename, "advAirport") == 0)
+                m_ambience = airport;
+            else if (strcmp(filename, "advDesert") == 0)
+                m_ambience = desert;
+            else if (strcmp(filename, "advEscape") == 0)
+                m_weather = wind;
+            return true;
+        }
+    }
+    m_userDefined = true;
+    FILE* file = fopen(filename, "r");
+    // Find out the length
+    m_length = 0;
+    while (readInt(file) >= 0)
+    {
+        readInt(file);
+        if (readInt(file) < MINPARTLENGTH)
+            readInt(file);
+        ++m_length;
+    }
+    if (file)
+        fseek(file, 0L, SEEK_SET);
+    Boolean loaded = (m_length > 0);
+    if (m_length == 0)
+    {
+        m_length = 1;
+        m_definition = new Definition[1];
+        m_definition[0].type = (Type)0;
+        m_definition[0].surface = (Surface)0;
+        m_definition[0].noise = (Noise)0;
+        m_definition[0].length = MINPARTLENGTH;
+        m_weather  = (Weather)0;
+        m_ambience = (Ambience)0;
+    }
+    else
+    {
+        m_definition = new Definition[m_length];
+        Int temp = 0;
+        for (UInt i = 0; i < m_length; ++i)
+        {
+            m_definition[i].type    = (Type)readInt(file);
+            m_definition[i].surface = (Surface)readInt(file);
+            temp = readInt(file);
+            if (temp < NOISES)
+            {
+                m_definition[i].noise   = (Noise)temp;
+                m_definition[i].length  = readInt(file);
+            }
+            else
+            {
+                if (m_definition[i].type >= TYPES)
+                {
+                    m_definition[i].noise = (Noise)((m_definition[i].type - TYPES) + 1);
+                    m_definition[i].type = (Type)0;
+                }
+                else
+                {
+                    m_definition[i].noise = (Noise)0;
+                }
+                m_definition[i].length = temp;
+            }
+            if (m_definition[i].type >= TYPES)
+                m_definition[i].type = (Type)0;
+            if (m_definition[i].surface >= SURFACES)
+                m_definition[i].surface = (Surface)0;
+            if (m_definition[i].noise >= NOISES)
+                m_definition[i].noise = (Noise)0;
+            if (m_definition[i].length < MINPARTLENGTH)
+                m_definition[i].length = MINPARTLENGTH;
+        }
+        readInt(file); // -1
+        m_weather  = (Weather)readInt(file);
+        if (m_weather < 0)
+            m_weather = (Weather)0;
+        m_ambience = (Ambience)readInt(file);
+        if (m_ambience < 0)
+            m_ambience = (Ambience)0;
+    }
+    if (file)
+        fclose(file);
+    return loaded;
+}
+
+
+void
+TrackGeometry::buildIndex( )
+{
+    // calculate tracklength and the start of every segment
+    SAFE_DELETE_ARRAY(m_segmentStart);
+    SAFE_DELETE_ARRAY(m_segmentCenter);
+    m_segmentStart  = new UInt[m_length + 1];
+    m_segmentCenter = new UInt[m_length + 1];
+    m_lapDistance   = 0;
+    m_lapCenter     = 0;
+    m_lastSegment   = 0;
+    for (UInt i = 0; i < m_length; ++i)
+    {
+        m_segmentStart[i]  = m_lapDistance;
+        m_segmentCenter[i] = m_lapCenter;
+        m_lapDistance += m_definition[i].length;
+        m_lapCenter   += centerShift(m_definition[i].type, m_definition[i].length);
+    }
+    m_segmentStart[m_length]  = m_lapDistance;
+    m_segmentCenter[m_length] = m_lapCenter;
+}
+
+
+TrackGeometry::Road
+TrackGeometry::roadComputer(Int position)
+{
+    UInt lap = (UInt)(position / m_lapDistance);
+    UInt pos = position % m_lapDistance;
+    UInt i = segmentAt(pos, m_lastSegment);
+    m_lastSegment = i;
+    return roadInSegment(i, pos - m_segmentStart[i], lap*m_lapCenter + m_segmentCenter[i]);
+}
+
+
+Int
+TrackGeometry::roadAt(Int position)
+{
+    UInt pos = position % m_lapDistance;
+    m_lastSegment = segmentAt(pos, m_lastSegment);
+    return m_lastSegment;
+}
+
+
+UInt
+TrackGeometry::segmentAt(UInt pos, UInt hint)
+{
+    // Cars mostly stay in the same segment or move on to the next one
+    // between two calls, so try the hint first before searching.
+    if (hint < m_length)
+    {
+        if ((m_segmentStart[hint] <= pos) && (pos < m_segmentStart[hint + 1]))
+            return hint;
+        UInt next = hint + 1;
+        if ((next < m_length) && (m_segmentStart[next] <= pos) && (pos < m_segmentStart[next + 1]))
+            return next;
+    }
+    // binary search for the last segment starting at or before pos
+    UInt low  = 0;
+    UInt high = m_length;
+    while (high - low > 1)
+    {
+        UInt middle = (low + high) / 2;
+        if (m_segmentStart[middle] <= pos)
+            low = middle;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+
+TrackGeometry::Road
+TrackGeometry::roadInSegment(UInt segment, UInt relPos, UInt center)
+{
+    Road road;
+    road.type    = m_definition[segment].type;
+    road.surface = m_definition[segment].surface;
+    road.length  = m_definition[segment].length;
+    switch (m_definition[segment].type)
+    {
+    case straight :
+        road.left  = center - m_laneWidth;
+        road.right = center + m_laneWidth;
+        break;
+    case easyLeft :
+        road.left  = center - m_laneWidth - relPos/2;
+        road.right = center + m_laneWidth - relPos/2;
+        break;
+    case left :
+        road.left  = center - m_laneWidth - relPos*2/3;
+        road.right = center + m_laneWidth - relPos*2/3;
+        break;
+    case hardLeft :
+        road.left  = center - m_laneWidth - relPos;
+        road.right = center + m_laneWidth - relPos;
+        break;
+    case hairpinLeft :
+        road.left  = center - m_laneWidth - relPos*3/2;
+        road.right = center + m_laneWidth - relPos*3/2;
+        break;
+    case easyRight :
+        road.left  = center - m_laneWidth + relPos/2;
+        road.right = center + m_laneWidth + relPos/2;
+        break;
+    case right :
+        road.left  = center - m_laneWidth + relPos*2/3;
+        road.right = center + m_laneWidth + relPos*2/3;
+        break;
+    case hardRight :
+        road.left  = center - m_laneWidth + relPos;
+        road.right = center + m_laneWidth + relPos;
+        break;
+    case hairpinRight :
+        road.left  = center - m_laneWidth + relPos*3/2;
+        road.right = center + m_laneWidth + relPos*3/2;
+        break;
+    default :
+        road.left  = center - m_laneWidth;
+        road.right = center + m_laneWidth;
+        break;
+    }
+    return road;
+}
+
+
+Int
+TrackGeometry::centerShift(Type type, UInt length)
+{
+    switch (type)
+    {
+    case easyLeft :
+        return -(Int)(length/2);
+    case left :
+        return -(Int)(length*2/3);
+    case hardLeft :
+        return -(Int)length;
+    case hairpinLeft :
+        return -(Int)(length*3/2);
+    case easyRight :
+        return length/2;
+    case right :
+        return length*2/3;
+    case hardRight :
+        return length;
+    case hairpinRight :
+        return length*3/2;
+    default :
+        return 0;
+    }
+}
@@ -0,0 +1,139 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __RACING_TRACKGEOMETRY_H__
+#define __RACING_TRACKGEOMETRY_H__
+
+#include <Common/If/Types.h>
+#include <Common/If/Defs.h>
+
+// The layout of a track: its segments and the road at any position.
+// This part of the track has no sounds and no game attached, so the
+// headless race simulation can use it as well.
+class TrackGeometry
+{
+public:
+    enum Type
+    {
+        straight        = 0,
+        easyLeft        = 1,
+        left            = 2,
+        hardLeft        = 3,
+        hairpinLeft     = 4,
+        easyRight       = 5,
+        right           = 6,
+        hardRight       = 7,
+        hairpinRight    = 8
+    };
+
+    enum Surface
+    {
+        asphalt         = 0,
+        gravel          = 1,
+        water           = 2,
+        sand            = 3,
+        snow            = 4
+    };
+
+    enum Noise
+    {
+        noNoise      = 0,
+        crowd        = 1,
+        ocean        = 2,
+        runway       = 3,
+        clock        = 4,
+        jet          = 5,
+        thunder      = 6,
+        pile         = 7,
+        construction = 8,
+        river        = 9,
+        helicopter        = 10,
+        owl        = 11
+    };
+
+    enum Weather
+    {
+        sunny           = 0,
+        rain            = 1,
+        wind            = 2,
+        storm           = 3
+    };
+
+    enum Ambience
+    {
+        noAmbience      = 0,
+        desert          = 1,
+        airport         = 2
+    };
+
+    struct Definition
+    {
+        Type            type;
+        Surface         surface;
+        Noise           noise;
+        UInt            length;
+    };
+
+    struct Road
+    {
+        Int             left;
+        Int             right;
+        Surface         surface;
+        Type            type;
+        UInt            length;
+    };
+
+    struct TrackData
+    {
+        Boolean userDefined;
+        Weather		weather;
+        Ambience		ambience;
+        UInt		 length;
+        Definition*  definition;
+    };
+
+public:
+    TrackGeometry( );
+    virtual ~TrackGeometry( );
+
+public:
+    Boolean     load(const Char* filename);
+    void        buildIndex( );
+
+    void        laneWidth(UInt laneWidth)   { m_laneWidth = laneWidth;     }
+    UInt        laneWidth()   { return m_laneWidth;     }
+    Definition* definition()		 { return m_definition;			}
+    UInt        trackLength()					 { return m_length;				}
+    Weather     weather( ) { return m_weather; }
+    Ambience    ambience( ) { return m_ambience; }
+    Boolean     userDefined( ) { return m_userDefined; }
+    Road        roadComputer(Int position);
+    Int         roadAt(Int position);
+    UInt        lap(Int position)          { return (position/m_lapDistance) + 1; }
+    UInt        length( )                  { return m_lapDistance; }
+
+protected:
+    UInt        segmentAt(UInt pos, UInt hint);
+    Road        roadInSegment(UInt segment, UInt relPos, UInt center);
+    static Int  centerShift(Type type, UInt length);
+
+protected:
+    Boolean             m_userDefined;
+    UInt                m_length;
+    UInt                m_lapDistance;
+    UInt                m_lapCenter;
+    Definition*         m_definition;
+    UInt*               m_segmentStart;     // distance at the start of each segment, m_length+1 entries
+    UInt*               m_segmentCenter;    // lane center at the start of each segment within a lap
+    UInt                m_lastSegment;      // segment found by the last roadComputer/roadAt call
+    UInt                m_laneWidth;
+    Weather             m_weather;
+    Ambience            m_ambience;
+};
+
+
+
+#endif // __RACING_TRACKGEOMETRY_H__
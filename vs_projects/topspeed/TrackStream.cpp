@@ -0,0 +1,112 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#include "TrackStream.h"
+#include "BitStream.h"
+
+#define TYPEBITS        4
+#define SURFACEBITS     3
+#define NOISEBITS       4
+#define RUNGROUPBITS    3
+#define ZEROBITS        3
+#define MAXZEROS        7
+#define MAXRECORDBYTES  8           // a record with a 32 bit run and length takes less
+
+
+static Boolean
+sameKind(const TrackGeometry::Definition& a, const TrackGeometry::Definition& b)
+{
+    return (a.type == b.type) && (a.surface == b.surface) && (a.noise == b.noise);
+}
+
+
+// Each record is the number of definitions it stands for minus one, a bit
+// that says whether the kind is that of the record before it, the type,
+// surface and noise when it is not, and the length. Track lengths are
+// nearly always round numbers, so the length is written as the number of
+// zeros it ends in and what is left in front of them.
+void
+TrackStream::pack(const TrackGeometry::Definition* definition, UInt length, std::vector<UByte>& stream)
+{
+    stream.resize(length*MAXRECORDBYTES + 1);
+    BitWriter writer(&stream[0], (UInt)stream.size( ));
+    const TrackGeometry::Definition* previous = 0;
+    UInt i = 0;
+    while (i < length)
+    {
+        const TrackGeometry::Definition& record = definition[i];
+        UInt run = 1;
+        while ((i + run < length) && (sameKind(definition[i + run], record)) && (definition[i + run].length == record.length))
+            ++run;
+        writer.writeVarint(run - 1, RUNGROUPBITS);
+        Boolean same = (previous) && (sameKind(record, *previous));
+        writer.writeBoolean(same);
+        if (!same)
+        {
+            writer.write(record.type, TYPEBITS);
+            writer.write(record.surface, SURFACEBITS);
+            writer.write(record.noise, NOISEBITS);
+        }
+        UInt digits = record.length;
+        UInt zeros  = 0;
+        while ((digits != 0) && (digits % 10 == 0) && (zeros < MAXZEROS))
+        {
+            digits /= 10;
+            ++zeros;
+        }
+        writer.write(zeros, ZEROBITS);
+        writer.writeVarint(digits);
+        previous = &record;
+        i += run;
+    }
+    stream.resize(writer.size( ));
+}
+
+
+Boolean
+TrackStream::unpack(const UByte* stream, UInt size, TrackGeometry::Definition* definition, UInt length)
+{
+    BitReader reader(stream, size);
+    TrackGeometry::Definition record;
+    record.type    = TrackGeometry::straight;
+    record.surface = TrackGeometry::asphalt;
+    record.noise   = TrackGeometry::noNoise;
+    record.length  = 0;
+    UInt i = 0;
+    while (i < length)
+    {
+        UInt run = reader.readVarint(RUNGROUPBITS) + 1;
+        if (!reader.readBoolean( ))
+        {
+            record.type    = (TrackGeometry::Type)reader.read(TYPEBITS);
+            record.surface = (TrackGeometry::Surface)reader.read(SURFACEBITS);
+            record.noise   = (TrackGeometry::Noise)reader.read(NOISEBITS);
+        }
+        UInt zeros = reader.read(ZEROBITS);
+        record.length = reader.readVarint( );
+        while (zeros-- > 0)
+            record.length *= 10;
+        if ((reader.failed( )) || (run > length - i))
+            return false;
+        for (UInt j = 0; j < run; ++j)
+            definition[i++] = record;
+    }
+    return true;
+}
+
+
+// FNV-1a
+UInt
+TrackStream::hash(const UByte* data, UInt size)
+{
+    UInt hash = 2166136261u;
+    for (UInt i = 0; i < size; ++i)
+    {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
@@ -0,0 +1,30 @@
+/**
+* Top Speed 3
+* Copyright 2003-2013 Playing in the Dark (http://playinginthedark.net)
+* Code contributors: Davy Kager, Davy Loots and Leonard de Ruijter
+* This program is distributed under the terms of the GNU General Public License version 3.
+*/
+#ifndef __RACING_TRACKSTREAM_H__
+#define __RACING_TRACKSTREAM_H__
+
+#include <Common/If/Types.h>
+#include "TrackGeometry.h"
+#include <vector>
+
+
+// Packs the definitions of a track into the stream the server sends to
+// the clients in chunks. A run of equal definitions is written once with
+// its count, and a definition of the same type, surface and noise as the
+// one before it only takes its length, so the long stretches of straight
+// asphalt most tracks have cost a few bits. The hash of the stream tells
+// a client whether it already has the track.
+class TrackStream
+{
+public:
+    static void     pack(const TrackGeometry::Definition* definition, UInt length, std::vector<UByte>& stream);
+    static Boolean  unpack(const UByte* stream, UInt size, TrackGeometry::Definition* definition, UInt length);
+    static UInt     hash(const UByte* data, UInt size);
+};
+
+
+#endif /* __RACING_TRACKSTREAM_H__ */